@@ -18,12 +18,13 @@
 #define WIZTK_ASYNC_EVENT_LOOP_HPP_
 
 #include "wiztk/base/abstract-runnable.hpp"
+#include "wiztk/base/delegate.hpp"
 
 #include "wiztk/async/type.hpp"
 #include "wiztk/async/message-queue.hpp"
 #include "wiztk/async/scheduler.hpp"
 
-#include <functional>
+#include <memory>
 
 namespace wiztk {
 namespace async {
@@ -68,6 +69,10 @@ class WIZTK_EXPORT AbstractEvent : public base::AbstractRunnable<uint32_t> {
  * @endcode
  *
  * Use the Quit() in the run loop.
+ *
+ * Messages can be posted to an EventLoop from any thread by
+ * Scheduler::PostMessage(), a message from another thread is kept in an inbox
+ * guarded by a mutex, and the loop is woken up by an eventfd.
  */
 class WIZTK_EXPORT EventLoop {
 
@@ -83,7 +88,7 @@ class WIZTK_EXPORT EventLoop {
   /**
    * @brief A function object for customization of creating new EventLoop object.
    */
-  typedef std::function<EventLoop *()> FactoryType;
+  typedef base::Delegate<EventLoop *()> FactoryType;
 
  public:
 
@@ -153,6 +158,8 @@ class WIZTK_EXPORT EventLoop {
 
   class QuitEvent;
 
+  class Inbox;
+
   int epoll_fd_ = -1;
 
   int max_events_ = 16;
@@ -163,6 +170,8 @@ class WIZTK_EXPORT EventLoop {
 
   MessageQueue message_queue_;
 
+  std::unique_ptr<Inbox> inbox_;
+
 };
 
 } // namespace async
@@ -72,6 +72,12 @@ class WIZTK_EXPORT MessageQueue {
 
   Message *PopBack();
 
+  /**
+   * @brief Move all messages of another queue to the end of this one in
+   * constant time
+   */
+  void SpliceBack(MessageQueue *other);
+
  private:
 
   internal::MessageQueueTraits traits_;
@@ -0,0 +1,334 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef WIZTK_ASYNC_QUEUED_CONNECTION_HPP_
+#define WIZTK_ASYNC_QUEUED_CONNECTION_HPP_
+
+#include "wiztk/base/sigcxx.hpp"
+
+#include "wiztk/async/event-loop.hpp"
+#include "wiztk/async/message.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace wiztk {
+namespace async {
+
+namespace internal {
+
+/**
+ * @ingroup async_intern
+ * @brief The type of a slot method, in a non-deduced context so the parameter
+ * types are deduced from the signal only
+ */
+template<typename T, typename ... ParamTypes>
+struct SlotMethod {
+  typedef void (T::*Type)(ParamTypes..., base::SLOT);
+};
+
+/**
+ * @ingroup async_intern
+ * @brief The shared state of a queued connection.
+ *
+ * A queued connection has two sides:
+ *   - A QueuedTokenNode in the signal, used in the thread emitting the signal
+ *   - A relay signal connected to the slot method, used in the thread of the
+ *     receiver's event loop
+ *
+ * The token posts a Call message with the arguments copied to the event loop,
+ * which emits the relay signal. The two sides never touch the lists of each
+ * other. When the receiver is destroyed or unbinds the slot, the relay signal
+ * has no connection and the messages in flight do nothing, the token
+ * disconnects itself in the next emission. When the token is disconnected,
+ * its reference is released by a message, so this object is always deleted
+ * in the thread of the event loop.
+ *
+ * The Call messages are pooled in this object and reused.
+ */
+template<typename ... ParamTypes>
+class WIZTK_NO_EXPORT QueuedConnection {
+
+ public:
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(QueuedConnection);
+
+  typedef std::tuple<typename std::decay<ParamTypes>::type...> ArgumentsType;
+
+  QueuedConnection() = delete;
+
+  explicit QueuedConnection(EventLoop *event_loop)
+      : event_loop_(event_loop), release_message_(this) {}
+
+  /**
+   * @brief Emit the relay signal in the thread of the event loop, or post a
+   * message from other threads
+   */
+  void Send(ParamTypes ... Args) {
+    if (EventLoop::GetCurrent() == event_loop_) {
+      Deliver(Args...);
+      return;
+    }
+
+    Call *call = Acquire();
+    new(&call->storage) ArgumentsType(Args...);
+    ref_count_.fetch_add(1);
+    event_loop_->GetScheduler().PostMessage(call);
+  }
+
+  /**
+   * @brief Release the reference held by the token, in any thread
+   */
+  void ReleaseFromToken() {
+    if (EventLoop::GetCurrent() == event_loop_) {
+      Release();
+      return;
+    }
+
+    event_loop_->GetScheduler().PostMessage(&release_message_);
+  }
+
+  /**
+   * @brief True if the slot method was disconnected in the receiver's thread
+   */
+  bool IsDropped() const { return dropped_.load(); }
+
+  base::Signal<ParamTypes...> &relay() { return relay_; }
+
+  base::Trackable *token_holder() { return &token_holder_; }
+
+ private:
+
+  /**
+   * @brief A message with the arguments of an emission
+   */
+  class Call : public Message {
+
+   public:
+
+    WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(Call);
+
+    explicit Call(QueuedConnection *connection)
+        : connection_(connection) {}
+
+    ~Call() final = default;
+
+    void Exec() final {
+      connection_->Receive(this);
+    }
+
+    typename std::aligned_storage<sizeof(ArgumentsType), alignof(ArgumentsType)>::type storage;
+
+   private:
+
+    QueuedConnection *connection_;
+
+  };
+
+  /**
+   * @brief A message to release the reference of the token
+   */
+  class ReleaseMessage : public Message {
+
+   public:
+
+    WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(ReleaseMessage);
+
+    explicit ReleaseMessage(QueuedConnection *connection)
+        : connection_(connection) {}
+
+    ~ReleaseMessage() final = default;
+
+    void Exec() final {
+      connection_->Release();
+    }
+
+   private:
+
+    QueuedConnection *connection_;
+
+  };
+
+  ~QueuedConnection() {
+    for (Call *call : free_calls_) delete call;
+  }
+
+  Call *Acquire() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!free_calls_.empty()) {
+        Call *call = free_calls_.back();
+        free_calls_.pop_back();
+        return call;
+      }
+    }
+    return new Call(this);
+  }
+
+  void Receive(Call *call) {
+    auto *arguments = reinterpret_cast<ArgumentsType *>(&call->storage);
+    Apply(*arguments, std::index_sequence_for<ParamTypes...>());
+    arguments->~ArgumentsType();
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      free_calls_.push_back(call);
+    }
+    Release();
+  }
+
+  template<std::size_t ... I>
+  void Apply(ArgumentsType &arguments, std::index_sequence<I...>) {
+    Deliver(std::get<I>(arguments)...);
+  }
+
+  void Deliver(ParamTypes ... Args) {
+    if (dropped_.load()) return;
+
+    relay_.Emit(Args...);
+    if (0 == relay_.CountConnections()) dropped_.store(true);
+  }
+
+  void Release() {
+    if (1 == ref_count_.fetch_sub(1)) delete this;
+  }
+
+  EventLoop *event_loop_;
+
+  /** The token and each message in flight hold a reference */
+  std::atomic<int> ref_count_{1};
+
+  std::atomic<bool> dropped_{false};
+
+  base::Signal<ParamTypes...> relay_;
+
+  base::Trackable token_holder_;
+
+  ReleaseMessage release_message_;
+
+  std::mutex mutex_;
+
+  std::vector<Call *> free_calls_;
+
+};
+
+/**
+ * @ingroup async_intern
+ * @brief The token of a queued connection in the emitting signal
+ */
+template<typename ... ParamTypes>
+class WIZTK_NO_EXPORT QueuedTokenNode
+    : public base::internal::AbstractInvokableTokenNode<ParamTypes..., base::SLOT> {
+
+ public:
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(QueuedTokenNode);
+
+  QueuedTokenNode() = delete;
+
+  explicit QueuedTokenNode(QueuedConnection<ParamTypes...> *connection)
+      : base::internal::AbstractInvokableTokenNode<ParamTypes..., base::SLOT>(base::internal::TokenNode::kKindCustom),
+        connection_(connection) {}
+
+  ~QueuedTokenNode() final {
+    // Remove the binding from the holder before the connection may be
+    // released in another thread:
+    if (nullptr != this->binding) {
+      this->binding->token = nullptr;
+      delete this->binding;
+      this->binding = nullptr;
+    }
+    connection_->ReleaseFromToken();
+  }
+
+  void Invoke(ParamTypes ... Args, base::SLOT slot) final {
+    if (connection_->IsDropped()) {
+      delete this;  // The slot moves to the next token
+      return;
+    }
+
+    connection_->Send(Args...);
+  }
+
+ private:
+
+  QueuedConnection<ParamTypes...> *connection_;
+
+};
+
+} // namespace internal
+
+/**
+ * @ingroup async
+ * @brief Connect a signal to a slot method called in the thread of an event
+ * loop
+ * @param signal The signal, which can be emitted in any thread
+ * @param obj The receiver
+ * @param method The slot method
+ * @param event_loop The event loop in the receiver's thread
+ * @param index The position of the connection in the signal
+ *
+ * When the signal is emitted in the thread of the event loop, the slot method
+ * is called at once. When it's emitted in another thread, the arguments are
+ * copied by value into a message posted to the event loop, and the slot
+ * method is called in the next iteration of the loop. The Slot parameter in
+ * the slot method refers to the relay of the connection, so
+ * Trackable::UnbindSignal() works as usual.
+ *
+ * The connection is broken safely from both sides:
+ *   - When the receiver is destroyed or unbinds the slot method in its thread,
+ *     messages in flight are dropped
+ *   - When the signal is destroyed or disconnects with Disconnect(int, int) or
+ *     DisconnectAll() in the emitting thread, messages in flight are still
+ *     delivered
+ *
+ * Call this function in the thread of the event loop, before the signal is
+ * emitted in another thread. The event loop must outlive the connection.
+ */
+template<typename T, typename ... ParamTypes>
+void ConnectQueued(base::SignalRef<ParamTypes...> signal,
+                   T *obj,
+                   typename internal::SlotMethod<T, ParamTypes...>::Type method,
+                   EventLoop *event_loop,
+                   int index = -1) {
+  auto *connection = new internal::QueuedConnection<ParamTypes...>(event_loop);
+  connection->relay().Connect(obj, method);
+  signal.Connect(new internal::QueuedTokenNode<ParamTypes...>(connection), connection->token_holder(), index);
+}
+
+/**
+ * @ingroup async
+ * @brief Connect a signal to a slot method called in the thread of an event
+ * loop, see the SignalRef version
+ */
+template<typename T, typename ... ParamTypes>
+void ConnectQueued(base::Signal<ParamTypes...> &signal,
+                   T *obj,
+                   typename internal::SlotMethod<T, ParamTypes...>::Type method,
+                   EventLoop *event_loop,
+                   int index = -1) {
+  ConnectQueued(base::SignalRef<ParamTypes...>(signal), obj, method, event_loop, index);
+}
+
+} // namespace async
+} // namespace wiztk
+
+#endif // WIZTK_ASYNC_QUEUED_CONNECTION_HPP_
@@ -52,8 +52,21 @@ class WIZTK_EXPORT Scheduler {
 
   Scheduler &operator=(Scheduler &&) = default;
 
+  /**
+   * @brief Post a message to the end of the queue
+   * @param message A message not queued
+   *
+   * This can be called in any thread. In the thread of the event loop the
+   * message is queued at once, otherwise it's queued in the next iteration
+   * of the loop, which is woken up if it's waiting.
+   */
   void PostMessage(Message *message);
 
+  /**
+   * @brief Post a message right after another queued message
+   *
+   * This must be called in the thread of the event loop.
+   */
   void PostMessageAfter(Message *a, Message *b);
 
  private:
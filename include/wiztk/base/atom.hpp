@@ -0,0 +1,137 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef WIZTK_BASE_ATOM_HPP_
+#define WIZTK_BASE_ATOM_HPP_
+
+#include "wiztk/base/macros.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <string>
+
+namespace wiztk {
+namespace base {
+
+/**
+ * @ingroup base
+ * @brief An interned string
+ *
+ * All atoms of the same text share one entry in a global table, so an atom
+ * is a single pointer: copying is free and comparing two atoms compares the
+ * pointers. The text and its hash are computed once when the atom is first
+ * created and kept until the program exits.
+ *
+ * Use atoms for names and keys which are compared or looked up often, e.g.
+ * the name of a view or the interface name of a Wayland global. Creating an
+ * atom from text hashes the text and looks it up in the table under a lock,
+ * so keep the atom instead of creating it again.
+ *
+ * The default atom is null, it's not equal to the atom of an empty string.
+ */
+class WIZTK_EXPORT Atom {
+
+ public:
+
+  Atom() = default;
+
+  /**
+   * @brief Intern a NUL-terminated string
+   */
+  Atom(const char *str);
+
+  /**
+   * @brief Intern a string of the given length
+   */
+  Atom(const char *str, size_t length);
+
+  /**
+   * @brief Intern a std::string
+   */
+  Atom(const std::string &str)
+      : Atom(str.data(), str.size()) {}
+
+  Atom(const Atom &) = default;
+
+  ~Atom() = default;
+
+  Atom &operator=(const Atom &) = default;
+
+  /**
+   * @brief Find the atom of a string without adding it to the table
+   * @return A null atom if the string was never interned
+   */
+  static Atom Find(const char *str, size_t length);
+
+  static Atom Find(const char *str);
+
+  /**
+   * @brief The NUL-terminated text, or an empty string for a null atom
+   */
+  const char *c_str() const;
+
+  size_t size() const;
+
+  bool empty() const { return 0 == size(); }
+
+  size_t GetHash() const;
+
+  explicit operator bool() const { return nullptr != entry_; }
+
+  bool operator==(const Atom &other) const { return entry_ == other.entry_; }
+
+  bool operator!=(const Atom &other) const { return entry_ != other.entry_; }
+
+  /**
+   * @brief Order by address, stable for the life of the program but not
+   * alphabetical
+   */
+  bool operator<(const Atom &other) const { return entry_ < other.entry_; }
+
+  /**
+   * @brief The number of interned strings
+   */
+  static size_t CountAll();
+
+ private:
+
+  struct Entry;
+
+  class Table;
+
+  explicit Atom(const Entry *entry)
+      : entry_(entry) {}
+
+  const Entry *entry_ = nullptr;
+
+};
+
+WIZTK_EXPORT std::ostream &operator<<(std::ostream &out, const Atom &atom);
+
+} // namespace base
+} // namespace wiztk
+
+namespace std {
+
+template<>
+struct hash<wiztk::base::Atom> {
+  size_t operator()(const wiztk::base::Atom &atom) const { return atom.GetHash(); }
+};
+
+} // namespace std
+
+#endif // WIZTK_BASE_ATOM_HPP_
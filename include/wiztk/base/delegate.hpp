@@ -20,6 +20,9 @@
 #include "wiztk/base/macros.hpp"
 
 #include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 namespace wiztk {
 namespace base {
@@ -35,6 +38,22 @@ class GenericMultiInherit : GenericBase1, GenericBase2 {};
 
 typedef void (GenericMultiInherit::*GenericMethodPointer)();
 
+// check if a const object of T can be called with the given arguments:
+template<typename T, typename ... ParamTypes>
+class IsCallable {
+
+  template<typename U>
+  static auto Check(int) -> decltype(std::declval<const U &>()(std::declval<ParamTypes>()...), std::true_type());
+
+  template<typename U>
+  static std::false_type Check(...);
+
+ public:
+
+  static const bool value = decltype(Check<T>(0))::value;
+
+};
+
 } // namespace internal
 
 // Forward declarations
@@ -55,7 +74,8 @@ class DelegateRef;
 enum DelegateType {
   kDelegateTypeUndefined,               /**< The delegate is not bound to any method/function pointer */
   kDelegateTypeMember,                  /**< The delegate is bound to a method (member function) */
-  kDelegateTypeStatic                   /**< The delegate is bound to a static function */
+  kDelegateTypeStatic,                  /**< The delegate is bound to a static function */
+  kDelegateTypeCallable                 /**< The delegate stores a copy of a small function object */
 };
 
 /**
@@ -100,6 +120,21 @@ enum DelegateType {
  * auto foo = Delegate<int(int, int)>::FromFunction(&Foo);
  * @endcode
  *
+ * A small function object, e.g. a lambda capturing 'this' and one more
+ * pointer, can be copied into the delegate. It's stored in place of the
+ * method pointer, so the delegate does not allocate and the size does not
+ * change:
+ *
+ * @code
+ * int offset = 1;
+ * Delegate<int(int)> add = [this, offset](int x) -> int {
+ *   return x + offset;
+ * };
+ * @endcode
+ *
+ * The function object must be trivially copyable and no larger than
+ * kInlineSize, it's checked at compile time.
+ *
  * @see <a href="md_doc_delegates.html">Fast C++ Delegats</a>
  */
 template<typename ReturnType, typename ... ParamTypes>
@@ -121,7 +156,10 @@ class WIZTK_EXPORT Delegate<ReturnType(ParamTypes...)> {
   friend inline bool operator>(const Delegate<ReturnTypeAlias(ParamTypesAlias...)> &src,
                                const Delegate<ReturnTypeAlias(ParamTypesAlias...)> &dst);
 
-  typedef ReturnType (*MethodStubType)(void *object, internal::GenericMethodPointer, ParamTypes...);
+  struct Data;
+
+  // nullptr for static function:
+  typedef ReturnType (*MethodStubType)(const Data &data, ParamTypes...);
 
   struct Data {
 
@@ -146,28 +184,42 @@ class WIZTK_EXPORT Delegate<ReturnType(ParamTypes...)> {
     void reset() {
       object = nullptr;
       method_stub = nullptr;
-      pointer.function = nullptr;
+      pointer.method = nullptr;
     }
 
+    // nullptr for static function and function object:
     void *object = nullptr;
     MethodStubType method_stub = nullptr;
     union {
       internal::GenericMethodPointer method;  // member function pointer
       void *function; // static function pointer
+      unsigned char storage[sizeof(internal::GenericMethodPointer)];  // function object
     } pointer = {nullptr};
 
   };
 
   template<typename T, typename TFxn>
   struct MethodStub {
-    static ReturnType invoke(void *object, internal::GenericMethodPointer any, ParamTypes ... Args) {
-      auto *obj = static_cast<T *>(object);
-      return (obj->*reinterpret_cast<TFxn>(any))(Args...);
+    static ReturnType invoke(const Data &data, ParamTypes ... Args) {
+      auto *obj = static_cast<T *>(data.object);
+      return (obj->*reinterpret_cast<TFxn>(data.pointer.method))(Args...);
+    }
+  };
+
+  template<typename T>
+  struct CallableStub {
+    static ReturnType invoke(const Data &data, ParamTypes ... Args) {
+      return (*reinterpret_cast<const T *>(data.pointer.storage))(Args...);
     }
   };
 
  public:
 
+  /**
+   * @brief The maximum size of a function object stored in a delegate
+   */
+  static const size_t kInlineSize = sizeof(internal::GenericMethodPointer);
+
   /**
    * @brief Typedef to static method
    */
@@ -215,7 +267,8 @@ class WIZTK_EXPORT Delegate<ReturnType(ParamTypes...)> {
    * @endcode
    *
    * The my_delegate object will be invalid as the lambda here is temporary and
-   * will be destructed out of the scope.
+   * will be destructed out of the scope. Use FromCallable() to store a copy of
+   * a small lambda instead.
    */
   template<typename T>
   static inline Delegate FromFunction(const T &function) {
@@ -224,6 +277,17 @@ class WIZTK_EXPORT Delegate<ReturnType(ParamTypes...)> {
     return FromMethod(const_cast<T *>(&function), method);
   }
 
+  /**
+   * @brief Create a delegate which stores a copy of the given function object.
+   * @tparam T A trivially copyable function object type, e.g. a lambda
+   * @param callable A function object no larger than kInlineSize
+   * @return A delegate object
+   */
+  template<typename T>
+  static inline Delegate FromCallable(const T &callable) {
+    return Delegate(callable);
+  }
+
   /**
    * @brief Create a delegate from the given static function pointer.
    * @param fn A static function pointer
@@ -277,6 +341,30 @@ class WIZTK_EXPORT Delegate<ReturnType(ParamTypes...)> {
     data_.pointer.function = reinterpret_cast<void *>(fn);
   }
 
+  /**
+   * @brief Constructor to store a copy of a small function object
+   * @tparam T A trivially copyable function object type, e.g. a lambda
+   * @param callable A function object no larger than kInlineSize
+   *
+   * This is not explicit so a lambda can be passed where a delegate is
+   * expected, like std::function.
+   */
+  template<typename T,
+      typename = typename std::enable_if<std::is_class<T>::value &&
+          !std::is_same<T, Delegate>::value &&
+          internal::IsCallable<T, ParamTypes...>::value>::type>
+  Delegate(const T &callable) {
+    static_assert(sizeof(T) <= kInlineSize,
+                  "The function object is too large to be stored in a delegate");
+    static_assert(alignof(T) <= alignof(internal::GenericMethodPointer),
+                  "The function object is over-aligned");
+    static_assert(std::is_trivially_copyable<T>::value && std::is_trivially_destructible<T>::value,
+                  "The function object must be trivially copyable, e.g. capture pointers and values only");
+
+    data_.method_stub = &CallableStub<T>::invoke;
+    new(data_.pointer.storage) T(callable);
+  }
+
   /**
    * @brief Copy constructor.
    * @param orig Another delegate
@@ -328,8 +416,7 @@ class WIZTK_EXPORT Delegate<ReturnType(ParamTypes...)> {
    *
    */
   Delegate &operator=(TFunction fn) {
-    data_.object = nullptr;
-    data_.method_stub = nullptr;
+    data_.reset();
     data_.pointer.function = reinterpret_cast<void *>(fn);
     return *this;
   }
@@ -340,12 +427,11 @@ class WIZTK_EXPORT Delegate<ReturnType(ParamTypes...)> {
    * @return
    */
   ReturnType operator()(ParamTypes... Args) const {
-    if (data_.object) {
-      _ASSERT(nullptr != data_.method_stub);
-      return (*data_.method_stub)(data_.object, data_.pointer.method, Args...);
+    if (data_.method_stub) {
+      return (*data_.method_stub)(data_, Args...);
     }
 
-    _ASSERT(nullptr == data_.method_stub);
+    _ASSERT(nullptr == data_.object);
     return reinterpret_cast<TFunction >(data_.pointer.function)(Args...);
   }
 
@@ -357,21 +443,21 @@ class WIZTK_EXPORT Delegate<ReturnType(ParamTypes...)> {
    * @note For method, the delegate does not check if the object is deleted.
    */
   ReturnType Invoke(ParamTypes... Args) const {
-    if (data_.object) {
-      _ASSERT(nullptr != data_.method_stub);
-      return (*data_.method_stub)(data_.object, data_.pointer.method, Args...);
+    if (data_.method_stub) {
+      return (*data_.method_stub)(data_, Args...);
     }
 
-    _ASSERT(nullptr == data_.method_stub);
+    _ASSERT(nullptr == data_.object);
     return reinterpret_cast<TFunction >(data_.pointer.function)(Args...);
   }
 
   /**
    * @brief Bool operator
-   * @return True if pointer to a method is set, false otherwise
+   * @return True if pointer to a method/function or a function object is
+   * set, false otherwise
    */
   explicit operator bool() const {
-    return nullptr != data_.pointer.method;
+    return nullptr != data_.method_stub || nullptr != data_.pointer.function;
   }
 
   /**
@@ -440,15 +526,7 @@ class WIZTK_EXPORT Delegate<ReturnType(ParamTypes...)> {
    * @return
    */
   bool EqualStatic(TFunction fn) const {
-#ifdef __DEBUG__
-    if (data_.pointer.function == fn) {
-      assert((nullptr == data_.object) && (nullptr == data_.method_stub));
-      return true;
-    }
-    return false;
-#else
-    return data_.pointer.function == fn;
-#endif  // __DEBUG__
+    return (nullptr == data_.method_stub) && (data_.pointer.function == reinterpret_cast<void *>(fn));
   }
 
   /**
@@ -456,13 +534,12 @@ class WIZTK_EXPORT Delegate<ReturnType(ParamTypes...)> {
    * @return One of DelegateType
    */
   DelegateType type() const {
-    if (nullptr == data_.object) {
-      _ASSERT(nullptr == data_.method_stub);
+    if (nullptr == data_.method_stub) {
+      _ASSERT(nullptr == data_.object);
       return nullptr == data_.pointer.function ? kDelegateTypeUndefined : kDelegateTypeStatic;
     }
 
-    _ASSERT(nullptr != data_.method_stub);
-    return kDelegateTypeMember;
+    return nullptr == data_.object ? kDelegateTypeCallable : kDelegateTypeMember;
   }
 
  private:
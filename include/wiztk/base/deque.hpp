@@ -146,6 +146,20 @@ class DefaultDequeDeleter {
  * When a Deque object is destroyed, it will remove all nodes but not delete
  * them by default. You can assign a deleter with in constructor, or use
  * particular clear(const DeleteType&) method.
+ *
+ * Whole deques can be exchanged by swap() or joined by splice_back() in
+ * constant time, this is the cheap way to drain a shared queue:
+ *
+ * @code
+ * Deque<Task> local;
+ * while (!queue.is_empty()) {
+ *   local.swap(queue);  // Tasks queued while running go to the next pass
+ *   while (Task *task = local.pop_front()) task->Run();
+ * }
+ * @endcode
+ *
+ * There's no cached count as a node can unlink itself without the deque,
+ * count() walks the nodes. Use CountedDeque if the count is needed often.
  */
 template<typename T, typename Deleter = DefaultDequeDeleter>
 class Deque {
@@ -190,14 +204,22 @@ class Deque {
     void push_back(T *element) { BinodeBase::PushBack(current_, element); }
 
     /**
-     * @brief Unlink the bi-node object and invalidate this iterator
+     * @brief Unlink the bi-node object and move this iterator to the next one
      *
-     * @note Once this method is called, this iterator is invalidated and
-     * should not be used, but it can be assigned to another one.
+     * It's safe to remove nodes while iterating:
+     *
+     * @code
+     * Deque<Task>::Iterator it = deque.begin();
+     * while (it != deque.end()) {
+     *   if (it->done()) it.remove();
+     *   else ++it;
+     * }
+     * @endcode
      */
     void remove() {
+      BinodeBase *next = current_->next_;
       BinodeBase::Unlink(current_);
-      current_ = nullptr;
+      current_ = next;
     }
 
     bool operator==(const Iterator &other) const { return current_ == other.current_; }
@@ -315,14 +337,13 @@ class Deque {
     void push_back(T *element) { BinodeBase::PushBack(current_, element); }
 
     /**
-     * @brief Unlink the bi-node object and invalidate this iterator
-     *
-     * @note Once this method is called, this iterator is invalidated and
-     * should not be used, but it can be assigned to another one.
+     * @brief Unlink the bi-node object and move this iterator to the previous
+     * one
      */
     void remove() {
+      BinodeBase *previous = current_->previous_;
       BinodeBase::Unlink(current_);
-      current_ = nullptr;
+      current_ = previous;
     }
 
     bool operator==(const ReverseIterator &other) const { return current_ == other.current_; }
@@ -442,9 +463,39 @@ class Deque {
    */
   void insert(T *node, int index = 0);
 
+  /**
+   * @brief Unlink and return the first node.
+   * @return The first node, or nullptr if this deque is empty.
+   */
+  T *pop_front();
+
+  /**
+   * @brief Unlink and return the last node.
+   * @return The last node, or nullptr if this deque is empty.
+   */
+  T *pop_back();
+
+  /**
+   * @brief Move all nodes of another deque to the end of this one.
+   * @param other
+   *
+   * This takes constant time, the other deque is empty after.
+   */
+  void splice_back(Deque &other);
+
+  /**
+   * @brief Exchange the nodes with another deque.
+   * @param other
+   *
+   * This takes constant time, the deleters are not exchanged.
+   */
+  void swap(Deque &other);
+
   /**
    * @brief Get the count of all nodes contained in this Deque.
    * @return The count number.
+   *
+   * This walks all nodes.
    */
   size_t count() const;
 
@@ -591,6 +642,69 @@ void Deque<T, Deleter>::insert(T *node, int index) {
   }
 }
 
+template<typename T, typename Deleter>
+T *Deque<T, Deleter>::pop_front() {
+  BinodeBase *node = head_.next_;
+  if (&tail_ == node) return nullptr;
+
+  BinodeBase::Unlink(node);
+  return static_cast<T *>(node);
+}
+
+template<typename T, typename Deleter>
+T *Deque<T, Deleter>::pop_back() {
+  BinodeBase *node = tail_.previous_;
+  if (&head_ == node) return nullptr;
+
+  BinodeBase::Unlink(node);
+  return static_cast<T *>(node);
+}
+
+template<typename T, typename Deleter>
+void Deque<T, Deleter>::splice_back(Deque &other) {
+  if (&other == this || other.is_empty()) return;
+
+  BinodeBase *first = other.head_.next_;
+  BinodeBase *last = other.tail_.previous_;
+  other.head_.next_ = &other.tail_;
+  other.tail_.previous_ = &other.head_;
+
+  BinodeBase *previous = tail_.previous_;
+  previous->next_ = first;
+  first->previous_ = previous;
+  last->next_ = &tail_;
+  tail_.previous_ = last;
+}
+
+template<typename T, typename Deleter>
+void Deque<T, Deleter>::swap(Deque &other) {
+  if (&other == this) return;
+
+  BinodeBase *first = head_.next_;
+  BinodeBase *last = tail_.previous_;
+  bool empty = is_empty();
+
+  if (other.is_empty()) {
+    head_.next_ = &tail_;
+    tail_.previous_ = &head_;
+  } else {
+    head_.next_ = other.head_.next_;
+    head_.next_->previous_ = &head_;
+    tail_.previous_ = other.tail_.previous_;
+    tail_.previous_->next_ = &tail_;
+  }
+
+  if (empty) {
+    other.head_.next_ = &other.tail_;
+    other.tail_.previous_ = &other.head_;
+  } else {
+    other.head_.next_ = first;
+    first->previous_ = &other.head_;
+    other.tail_.previous_ = last;
+    last->next_ = &other.tail_;
+  }
+}
+
 template<typename T, typename Deleter>
 size_t Deque<T, Deleter>::count() const {
   size_t size = 0;
@@ -0,0 +1,46 @@
+/*
+ * Copyright 2017 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef WIZTK_BASE_HASH_HPP_
+#define WIZTK_BASE_HASH_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace wiztk {
+namespace base {
+
+/**
+ * @ingroup base
+ * @brief 64-bit FNV-1a hash of the given bytes
+ *
+ * Fast for short keys like names and small blobs, not for hash flooding
+ * resistance.
+ */
+inline uint64_t HashFNV1a(const void *data, size_t length) {
+  const auto *bytes = static_cast<const unsigned char *>(data);
+  uint64_t hash = 14695981039346656037ULL;
+  for (size_t i = 0; i < length; ++i) {
+    hash ^= bytes[i];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+} // namespace base
+} // namespace wiztk
+
+#endif // WIZTK_BASE_HASH_HPP_
@@ -0,0 +1,69 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file allocation-counter.hpp
+ */
+
+#ifndef WIZTK_BASE_MEMORY_ALLOCATION_COUNTER_HPP_
+#define WIZTK_BASE_MEMORY_ALLOCATION_COUNTER_HPP_
+
+#include "wiztk/base/macros.hpp"
+
+#include <cstddef>
+
+namespace wiztk {
+namespace base {
+namespace memory {
+
+/**
+ * @ingroup base_memory
+ * @brief Counts the heap allocations of the current thread
+ *
+ * The counter only works when the library is built with the
+ * COUNT_ALLOCATIONS option, which replaces malloc() and friends with
+ * wrappers of the glibc functions. Take the difference of GetCount() before
+ * and after a piece of code to find out how many times it allocates.
+ *
+ * The option does not work with the address sanitizer, which replaces
+ * malloc() too.
+ */
+class WIZTK_EXPORT AllocationCounter {
+
+ public:
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(AllocationCounter);
+  AllocationCounter() = delete;
+  ~AllocationCounter() = delete;
+
+  /**
+   * @brief If the allocations are counted in this build
+   */
+  static bool IsEnabled();
+
+  /**
+   * @brief The number of allocations in the current thread, always 0 if
+   * not enabled
+   */
+  static size_t GetCount();
+
+};
+
+} // namespace memory
+} // namespace base
+} // namespace wiztk
+
+#endif // WIZTK_BASE_MEMORY_ALLOCATION_COUNTER_HPP_
@@ -0,0 +1,204 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file arena.hpp
+ */
+
+#ifndef WIZTK_BASE_MEMORY_ARENA_HPP_
+#define WIZTK_BASE_MEMORY_ARENA_HPP_
+
+#include "wiztk/base/macros.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace wiztk {
+namespace base {
+namespace memory {
+
+/**
+ * @ingroup base_memory
+ * @brief A bump allocator for short-lived objects
+ *
+ * Memory is cut from large chunks by moving a pointer and is given back all
+ * at once in Reset(), which also destroys the objects created by New() in
+ * reverse order. The chunks are kept for reuse, so an arena reset once per
+ * frame stops calling malloc as soon as it has grown to the size of a frame.
+ *
+ * An arena is not thread safe.
+ */
+class WIZTK_EXPORT Arena {
+
+ public:
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(Arena);
+
+  static const size_t kDefaultChunkSize = 16 * 1024;
+
+  /**
+   * @brief Constructor
+   * @param chunk_size The size of each chunk, an allocation larger than this
+   * gets a chunk of its own
+   */
+  explicit Arena(size_t chunk_size = kDefaultChunkSize);
+
+  ~Arena();
+
+  /**
+   * @brief Allocate raw memory
+   * @param size The size in bytes, must be greater than 0
+   * @param alignment A power of 2
+   * @return The memory which is valid until the next Reset()
+   */
+  void *Allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+    _ASSERT(size > 0);
+    uintptr_t address = (reinterpret_cast<uintptr_t>(position_) + alignment - 1) & ~(alignment - 1);
+    if (address + size <= reinterpret_cast<uintptr_t>(end_)) {
+      position_ = reinterpret_cast<char *>(address + size);
+      return reinterpret_cast<void *>(address);
+    }
+    return AllocateSlow(size, alignment);
+  }
+
+  /**
+   * @brief Create an object in the arena
+   *
+   * The destructor is called in Reset() unless it's trivial, the object must
+   * not be deleted.
+   */
+  template<typename T, typename ... Args>
+  T *New(Args &&... args) {
+    T *object = new(Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    if (!std::is_trivially_destructible<T>::value) AddFinalizer(&Destroy<T>, object);
+    return object;
+  }
+
+  /**
+   * @brief Create an array of value-initialized elements in the arena
+   */
+  template<typename T>
+  T *NewArray(size_t count) {
+    static_assert(std::is_trivially_destructible<T>::value,
+                  "Elements of an arena array are never destroyed");
+    T *array = static_cast<T *>(Allocate(sizeof(T) * count, alignof(T)));
+    for (size_t i = 0; i < count; ++i) new(array + i) T();
+    return array;
+  }
+
+  /**
+   * @brief Destroy all objects and rewind to the first chunk
+   */
+  void Reset();
+
+  /**
+   * @brief The number of bytes handed out since the last Reset(), including
+   * padding
+   */
+  size_t GetUsedSize() const;
+
+  /**
+   * @brief The total size of the chunks
+   */
+  size_t GetCapacity() const { return capacity_; }
+
+ private:
+
+  struct Chunk;
+
+  struct Finalizer;
+
+  template<typename T>
+  static void Destroy(void *object) {
+    static_cast<T *>(object)->~T();
+  }
+
+  void *AllocateSlow(size_t size, size_t alignment);
+
+  void AddFinalizer(void (*destroy)(void *), void *object);
+
+  size_t chunk_size_ = 0;
+
+  Chunk *first_ = nullptr;
+
+  Chunk *current_ = nullptr;
+
+  char *position_ = nullptr;
+
+  char *end_ = nullptr;
+
+  Finalizer *finalizers_ = nullptr;
+
+  size_t capacity_ = 0;
+
+};
+
+/**
+ * @ingroup base_memory
+ * @brief An allocator for standard containers which takes memory from an
+ * Arena
+ *
+ * Memory is only given back in Arena::Reset(), so a container using this
+ * allocator should be reserved up front, and must not outlive the arena's
+ * next reset.
+ */
+template<typename T>
+class ArenaAllocator {
+
+  template<typename U> friend
+  class ArenaAllocator;
+
+ public:
+
+  typedef T value_type;
+
+  explicit ArenaAllocator(Arena *arena)
+      : arena_(arena) {}
+
+  template<typename U>
+  ArenaAllocator(const ArenaAllocator<U> &other)
+      : arena_(other.arena_) {}
+
+  T *allocate(size_t count) {
+    return static_cast<T *>(arena_->Allocate(sizeof(T) * count, alignof(T)));
+  }
+
+  void deallocate(T *, size_t) {}
+
+  template<typename U>
+  bool operator==(const ArenaAllocator<U> &other) const {
+    return arena_ == other.arena_;
+  }
+
+  template<typename U>
+  bool operator!=(const ArenaAllocator<U> &other) const {
+    return arena_ != other.arena_;
+  }
+
+ private:
+
+  Arena *arena_;
+
+};
+
+} // namespace memory
+} // namespace base
+} // namespace wiztk
+
+#endif // WIZTK_BASE_MEMORY_ARENA_HPP_
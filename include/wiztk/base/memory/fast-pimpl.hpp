@@ -0,0 +1,91 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file fast-pimpl.hpp
+ */
+
+#ifndef WIZTK_BASE_MEMORY_FAST_PIMPL_HPP_
+#define WIZTK_BASE_MEMORY_FAST_PIMPL_HPP_
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+namespace wiztk {
+namespace base {
+namespace memory {
+
+/**
+ * @ingroup base_memory
+ * @brief Holds a private structure in inline storage instead of the heap
+ * @tparam T The private structure, may be incomplete in the public header
+ * @tparam Size The reserved size, at least sizeof(T)
+ * @tparam Alignment The reserved alignment, at least alignof(T)
+ *
+ * Use it in place of std::unique_ptr<Private> for small value types which
+ * are created and copied often. The members are only instantiated where T
+ * is complete, so the constructors, destructor and assignment of the owner
+ * must be defined in the source file, as they are with std::unique_ptr.
+ * The size and alignment are checked there at compile time.
+ */
+template<typename T, size_t Size, size_t Alignment = alignof(std::max_align_t)>
+class FastPimpl {
+
+ public:
+
+  FastPimpl() {
+    new(&storage_) T();
+  }
+
+  FastPimpl(const FastPimpl &other) {
+    new(&storage_) T(*other);
+  }
+
+  ~FastPimpl() {
+    static_assert(sizeof(T) <= Size, "Size is too small for the private structure");
+    static_assert(Alignment % alignof(T) == 0, "Alignment is too small for the private structure");
+    get()->~T();
+  }
+
+  FastPimpl &operator=(const FastPimpl &other) {
+    *get() = *other;
+    return *this;
+  }
+
+  T *get() { return reinterpret_cast<T *>(&storage_); }
+
+  const T *get() const { return reinterpret_cast<const T *>(&storage_); }
+
+  T *operator->() { return get(); }
+
+  const T *operator->() const { return get(); }
+
+  T &operator*() { return *get(); }
+
+  const T &operator*() const { return *get(); }
+
+ private:
+
+  typename std::aligned_storage<Size, Alignment>::type storage_;
+
+};
+
+} // namespace memory
+} // namespace base
+} // namespace wiztk
+
+#endif // WIZTK_BASE_MEMORY_FAST_PIMPL_HPP_
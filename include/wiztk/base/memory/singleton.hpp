@@ -23,6 +23,10 @@
 
 #include "wiztk/base/macros.hpp"
 
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+
 namespace wiztk {
 namespace base {
 namespace memory {
@@ -35,10 +39,14 @@ class Singleton;
  * @ingroup base_memory
  * @brief Default traits for Singleton.
  * @tparam T
+ *
+ * The instance is deleted at exit if it's not released before.
  */
 template<typename T>
 struct DefaultSingletonTraits {
 
+  static const bool kDeleteAtExit = true;
+
   static T *New() {
     return new T();
   }
@@ -49,6 +57,21 @@ struct DefaultSingletonTraits {
 
 };
 
+/**
+ * @ingroup base_memory
+ * @brief Traits for a Singleton which is never deleted at exit.
+ * @tparam T
+ *
+ * Use it for an instance which may still be used by other static
+ * destructors or threads at exit, or which is slow to tear down.
+ */
+template<typename T>
+struct LeakySingletonTraits : public DefaultSingletonTraits<T> {
+
+  static const bool kDeleteAtExit = false;
+
+};
+
 namespace internal {
 
 /**
@@ -57,7 +80,10 @@ namespace internal {
  * @tparam T
  * @tparam Traits
  *
- * @todo Make the methods in this class thread safe.
+ * The methods are thread safe. Getting an existing instance is a single
+ * acquire load, only the creation and release take a lock. A lock is used
+ * rather than std::call_once because the instance can be created again
+ * after it's released.
  */
 template<typename T, typename Traits = DefaultSingletonTraits<T> >
 class SingletonBase {
@@ -65,30 +91,57 @@ class SingletonBase {
   template<typename R, typename RTraits> friend
   class wiztk::base::memory::Singleton;
 
+  static T *Get() {
+    return kInstance.load(std::memory_order_acquire);
+  }
+
   static T *CreateOnce() {
-    // TODO: consider multi-thread
-    if (nullptr == kInstance)
-      kInstance = Traits::New();
+    T *instance = kInstance.load(std::memory_order_acquire);
+    if (nullptr != instance) return instance;
+
+    std::lock_guard<std::mutex> lock(GetMutex());
+
+    instance = kInstance.load(std::memory_order_relaxed);
+    if (nullptr == instance) {
+      instance = Traits::New();
+      kInstance.store(instance, std::memory_order_release);
+
+      if (Traits::kDeleteAtExit && !kAtExitRegistered) {
+        kAtExitRegistered = true;
+        std::atexit(&OnExit);
+      }
+    }
 
-    return kInstance;
+    return instance;
   }
 
   static void Release() {
-    Traits::Delete(kInstance);
-    kInstance = nullptr;
+    std::lock_guard<std::mutex> lock(GetMutex());
+    T *instance = kInstance.exchange(nullptr, std::memory_order_acq_rel);
+    if (nullptr != instance) Traits::Delete(instance);
   }
 
-  static void OnExit(void *) {
-    Traits::Delete(kInstance);
-    kInstance = nullptr;
+  static void OnExit() {
+    Release();
   }
 
-  static T *kInstance;
+  static std::mutex &GetMutex() {
+    // Never destroyed, it may be locked in OnExit():
+    static std::mutex *kMutex = new std::mutex;
+    return *kMutex;
+  }
+
+  static std::atomic<T *> kInstance;
+
+  static bool kAtExitRegistered;
 
 };
 
 template<typename T, typename Traits>
-T *SingletonBase<T, Traits>::kInstance = nullptr;
+std::atomic<T *> SingletonBase<T, Traits>::kInstance(nullptr);
+
+template<typename T, typename Traits>
+bool SingletonBase<T, Traits>::kAtExitRegistered = false;
 
 } // namespace internal
 
@@ -110,7 +163,7 @@ class Singleton {
    * @return
    */
   static inline T *get() {
-    return internal::SingletonBase<T, Traits>::kInstance;
+    return internal::SingletonBase<T, Traits>::Get();
   }
 
   /**
@@ -123,6 +176,8 @@ class Singleton {
 
   /**
    * @brief Release the instance and reset the static pointer.
+   *
+   * Other threads must not be using the instance.
    */
   static inline void release() {
     internal::SingletonBase<T, Traits>::Release();
@@ -21,6 +21,7 @@
 #include "macros.hpp"
 
 #include <string>
+#include <vector>
 
 namespace wiztk {
 namespace base {
@@ -34,6 +35,9 @@ namespace base {
  *
  * Every Object has a parent (and only one parent at the same time) and
  * children. When an object is destroyed, all children will be destroyed too.
+ *
+ * Children are stored in an array and each child keeps its index, so the
+ * access by index is O(1). The previous/next links are kept for traversal.
  */
 class Object : public Trackable {
 
@@ -60,6 +64,11 @@ class Object : public Trackable {
 
   int children_count() const { return children_count_; }
 
+  /**
+   * @brief The index of this object in the children of its parent, or -1
+   */
+  int index() const { return index_; }
+
   Object *GetChildAt(int index) const;
 
   /**
@@ -163,6 +172,26 @@ class Object : public Trackable {
 
  private:
 
+  /**
+   * @brief Insert a child into the array and update links, without callbacks
+   */
+  void InsertChildAt(Object *child, int index);
+
+  /**
+   * @brief Erase a child from the array and update links, without callbacks
+   */
+  void EraseChildAt(int index);
+
+  /**
+   * @brief Move a child in the array and shift the ones between
+   */
+  void MoveChild(int from, int to);
+
+  /**
+   * @brief Update the back-indices and links of children in [begin, end)
+   */
+  void UpdateChildren(int begin, int end);
+
   Object *previous_;
   Object *next_;
 
@@ -172,6 +201,10 @@ class Object : public Trackable {
   Object *parent_;
   int children_count_;
 
+  std::vector<Object *> children_;
+
+  int index_;
+
 };
 
 template<typename T>
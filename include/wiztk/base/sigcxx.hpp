@@ -26,6 +26,7 @@
 #include "wiztk/base/binode.hpp"
 
 #include <cstddef>
+#include <cstdint>
 
 #ifndef __SLOT__
 /**
@@ -49,32 +50,58 @@ namespace internal {
 
 // Foward declarations:
 struct TokenNode;
+class SignalBase;
 
 template<typename ... ParamTypes>
 class SignalTokenNode;
 
 /**
  * @ingroup base_intern
- * @brief A bidirectional node used to save the status of a Slot object.
+ * @brief A per-thread free list of memory blocks for the nodes created in
+ * Signal::Connect()
+ *
+ * Blocks are grouped in size classes of 16 bytes. A freed block is cached in
+ * the free list of the current thread (up to a limit) and reused by the next
+ * node of the same size class, so connecting and disconnecting in a steady
+ * state does not call malloc. A block can be freed in any thread, the cached
+ * blocks are released when the thread exits.
  */
-class WIZTK_NO_EXPORT SlotNode : public Binode<SlotNode> {
-  friend class Slot;
+class WIZTK_EXPORT NodePool {
+
  public:
-  WIZTK_DECLARE_NONCOPYABLE(SlotNode);
-  SlotNode() = default;
-  ~SlotNode() override = default;
-  SlotNode(SlotNode &&) = default;
-  SlotNode &operator=(SlotNode &&) = default;
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(NodePool);
+  NodePool() = delete;
+  ~NodePool() = delete;
+
+  static void *Allocate(size_t size);
+
+  static void Deallocate(void *block, size_t size);
+
+  /**
+   * @brief The number of free blocks cached in the current thread
+   */
+  static size_t GetCachedCount();
+
 };
 
 /**
  * @ingroup base_intern
  * @brief Base class of a bidirectional node used in Trackable or Signal only.
+ *
+ * The nodes allocated on heap are taken from NodePool.
  */
 class WIZTK_NO_EXPORT InterRelatedNodeBase : public Binode<InterRelatedNodeBase> {
   friend class Trackable;
   template<typename ... ParamTypes> friend
   class Signal;
+
+ public:
+
+  static void *operator new(size_t size) { return NodePool::Allocate(size); }
+
+  static void operator delete(void *block, size_t size) { NodePool::Deallocate(block, size); }
+
 };
 
 /**
@@ -104,11 +131,23 @@ struct WIZTK_NO_EXPORT BindingNode : public InterRelatedNodeBase {
  */
 struct WIZTK_NO_EXPORT TokenNode : public InterRelatedNodeBase {
   friend class Slot;
-  TokenNode() = default;
+
+  /**
+   * @brief The concrete type of a token, checked instead of dynamic_cast
+   */
+  enum Kind {
+    kKindDelegate,  /**< A DelegateTokenNode */
+    kKindSignal,    /**< A SignalTokenNode */
+    kKindCustom     /**< A token defined out of sigcxx, e.g. a queued connection */
+  };
+
+  TokenNode() = delete;
+  explicit TokenNode(Kind kind)
+      : kind(kind) {}
   ~TokenNode() override;
   Trackable *trackable = nullptr;
   BindingNode *binding = nullptr;
-  SlotNode slot_mark_head;
+  const Kind kind;
 };
 
 /**
@@ -123,7 +162,10 @@ class WIZTK_NO_EXPORT AbstractInvokableTokenNode : public TokenNode {
 
   WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(AbstractInvokableTokenNode);
 
-  AbstractInvokableTokenNode() = default;
+  AbstractInvokableTokenNode() = delete;
+
+  explicit AbstractInvokableTokenNode(TokenNode::Kind kind)
+      : TokenNode(kind) {}
 
   ~AbstractInvokableTokenNode() override = default;
 
@@ -147,7 +189,7 @@ class WIZTK_NO_EXPORT DelegateTokenNode : public AbstractInvokableTokenNode<Para
   DelegateTokenNode() = delete;
 
   explicit DelegateTokenNode(const DelegateType &d)
-      : AbstractInvokableTokenNode<ParamTypes...>(), delegate_(d) {}
+      : AbstractInvokableTokenNode<ParamTypes...>(TokenNode::kKindDelegate), delegate_(d) {}
 
   ~DelegateTokenNode() final = default;
 
@@ -181,7 +223,7 @@ class WIZTK_NO_EXPORT SignalTokenNode : public AbstractInvokableTokenNode<ParamT
   SignalTokenNode() = delete;
 
   explicit SignalTokenNode(SignalType &signal)
-      : AbstractInvokableTokenNode<ParamTypes...>(), signal_(&signal) {}
+      : AbstractInvokableTokenNode<ParamTypes...>(TokenNode::kKindSignal), signal_(&signal) {}
 
   ~SignalTokenNode() final = default;
 
@@ -537,10 +579,14 @@ class WIZTK_NO_EXPORT InterRelatedDeque {
  * A Signal holds a list of token to support multicast, when it's being
  * emitted, it create a simple Slot object and use it as an iterater and call
  * each delegate (@ref Delegate) to the slot method or another signal.
+ *
+ * The slots being emitted are chained in the signal, so a token removed in a
+ * slot method moves the slots standing on it to the next token.
  */
 class WIZTK_EXPORT Slot {
 
   friend struct internal::TokenNode;
+  friend class internal::SignalBase;
   friend class Trackable;
 
   template<typename ... ParamTypes> friend
@@ -551,27 +597,6 @@ class WIZTK_EXPORT Slot {
   WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(Slot);
   Slot() = delete;
 
-  class Mark : public internal::SlotNode {
-
-   public:
-
-    Mark() = delete;
-
-    explicit Mark(Slot *slot)
-        : slot_(slot) {}
-
-    ~Mark() final = default;
-
-    Slot *slot() const { return slot_; }
-
-   private:
-
-    Slot *slot_ = nullptr;
-
-  };
-
- public:
-
   /**
    * @brief Get the Signal object which is just calling this slot
    */
@@ -593,14 +618,20 @@ class WIZTK_EXPORT Slot {
   typedef internal::InterRelatedDeque<internal::TokenNode> DequeType;
   typedef internal::InterRelatedDeque<internal::TokenNode>::Iterator IteratorType;
 
-  explicit Slot(DequeType *deque)
-      : deque_(deque), iterator_(deque->begin()), mark_(this) {}
+  /**
+   * @brief Chain this slot in the signal, and remove it when destroyed
+   *
+   * Defined out of line: the signal holds the address of this stack object
+   * only during the emission, which the compiler cannot prove when inlined
+   * in Emit(), as a slot method may destroy the signal.
+   */
+  Slot(internal::SignalBase *signal, DequeType *deque);
 
-  ~Slot() = default;
+  ~Slot();
 
   Slot &operator++() {
-    if (ref_count_ > 0) {
-      --ref_count_;
+    if (advanced_) {
+      advanced_ = false;
     } else {
       ++iterator_;
     }
@@ -608,18 +639,33 @@ class WIZTK_EXPORT Slot {
   }
 
   Slot &operator--() {
-    if (ref_count_ > 0) {
-      --ref_count_;
+    if (advanced_) {
+      advanced_ = false;
     } else {
       --iterator_;
     }
     return *this;
   }
 
+  /**
+   * @brief The signal being emitted, or nullptr if it was destroyed in a slot
+   * method
+   */
+  internal::SignalBase *signal_ = nullptr;
+
+  /**
+   * @brief The slot of the outer emission of the same signal
+   */
+  Slot *previous_ = nullptr;
+
   DequeType *deque_ = nullptr;
   IteratorType iterator_;
-  size_t ref_count_ = 0;
-  Mark mark_;
+
+  /**
+   * @brief True if the token under the iterator was removed and the iterator
+   * already points to the next one
+   */
+  bool advanced_ = false;
 
 };
 
@@ -763,12 +809,57 @@ size_t Trackable::CountSignalBindings(void (T::*method)(ParamTypes...)) const {
   return count;
 }
 
+namespace internal {
+
+/**
+ * @ingroup base_intern
+ * @brief The part of Signal independent of the parameter types
+ *
+ * Keeps the slots being emitted and a version number changed with every token
+ * added or removed, which is checked by Signal::Emit() after each call.
+ */
+class WIZTK_EXPORT SignalBase : public Trackable {
+
+  friend struct TokenNode;
+  friend class base::Slot;
+
+  template<typename ... ParamTypes> friend
+  class base::Signal;
+
+ public:
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(SignalBase);
+
+  SignalBase() = default;
+
+  ~SignalBase() override;
+
+ private:
+
+  /**
+   * @brief The innermost slot being emitted
+   */
+  Slot *emitting_ = nullptr;
+
+  uint32_t version_ = 0;
+
+};
+
+} // namespace internal
+
 /**
  * @ingroup base
  * @brief A template class which can emit signal(s)
+ *
+ * Up to kInlineSlots delegates connected to slot methods are copied into an
+ * inline buffer of the signal, Emit() calls them in a flat loop without
+ * touching the token nodes. The buffer is rebuilt lazily after the
+ * connections change, and not used when there're more connections or a
+ * connection of another kind. If a slot method connects or disconnects this
+ * signal, the emission continues in the token list.
  */
 template<typename ... ParamTypes>
-class WIZTK_EXPORT Signal : public Trackable {
+class WIZTK_EXPORT Signal : public internal::SignalBase {
 
   friend class Trackable;
 
@@ -790,6 +881,21 @@ class WIZTK_EXPORT Signal : public Trackable {
 
   void Connect(Signal<ParamTypes...> &other, int index = -1);
 
+  /**
+   * @brief Connect a custom token
+   * @param token A token of kind TokenNode::kKindCustom, it's deleted when
+   *        disconnected
+   * @param trackable The object which stores the binding of the token
+   * @param index
+   *
+   * This is used to extend the connection types, e.g. the queued connection
+   * in async. A custom token is only disconnected by Disconnect(int, int),
+   * DisconnectAll(), or when the trackable or the token itself is destroyed.
+   */
+  void Connect(internal::AbstractInvokableTokenNode<ParamTypes..., SLOT> *token,
+               Trackable *trackable,
+               int index = -1);
+
   /**
    * @brief Disconnect all delegates to a method
    */
@@ -862,26 +968,81 @@ class WIZTK_EXPORT Signal : public Trackable {
 
  private:
 
+  typedef internal::DelegateTokenNode<ParamTypes..., SLOT> DelegateTokenType;
+
+  typedef internal::SignalTokenNode<ParamTypes...> SignalTokenType;
+
+  typedef typename DelegateTokenType::DelegateType DelegateType;
+
+  /**
+   * @brief Max delegates stored in the inline buffer
+   */
+  static const int kInlineSlots = 4;
+
+  struct InlineSlot {
+    DelegateTokenType *token = nullptr;
+    DelegateType delegate;
+  };
+
+  /**
+   * @brief Cast a token of this signal to DelegateTokenType, or return nullptr
+   */
+  static inline DelegateTokenType *ToDelegateToken(internal::TokenNode *token) {
+    return internal::TokenNode::kKindDelegate == token->kind ? static_cast<DelegateTokenType *>(token) : nullptr;
+  }
+
+  /**
+   * @brief Cast a token of this signal to SignalTokenType, or return nullptr
+   */
+  static inline SignalTokenType *ToSignalToken(internal::TokenNode *token) {
+    return internal::TokenNode::kKindSignal == token->kind ? static_cast<SignalTokenType *>(token) : nullptr;
+  }
+
   static inline void PushFrontToken(Signal *signal, internal::TokenNode *token) {
     _ASSERT(nullptr == token->trackable);
     token->trackable = signal;
     signal->tokens_.push_front(token);
+    ++signal->version_;
   }
 
   static inline void PushBackToken(Signal *signal, internal::TokenNode *token) {
     _ASSERT(nullptr == token->trackable);
     token->trackable = signal;
     signal->tokens_.push_back(token);
+    ++signal->version_;
   }
 
   static inline void InsertToken(Signal *signal, internal::TokenNode *token, int index = 0) {
     _ASSERT(nullptr == token->trackable);
     token->trackable = signal;
     signal->tokens_.insert(token, index);
+    ++signal->version_;
   }
 
+  /**
+   * @brief Copy the delegates to the inline buffer if possible
+   */
+  void UpdateInlineSlots();
+
+  /**
+   * @brief Call the tokens from the slot position to the end
+   */
+  void EmitTokens(Slot &slot, ParamTypes ... Args);
+
   internal::InterRelatedDeque<internal::TokenNode> tokens_;
 
+  InlineSlot inline_slots_[kInlineSlots];
+
+  /**
+   * @brief The number of delegates in the inline buffer, -1 if it's not used
+   */
+  int inline_count_ = -1;
+
+  /**
+   * @brief The version of the connections when the inline buffer was updated
+   */
+  uint32_t inline_version_ = 0xFFFFFFFF;
+
 };
 
 // Signal implementation:
@@ -910,10 +1071,22 @@ void Signal<ParamTypes...>::Connect(Signal<ParamTypes...> &other, int index) {
   PushBackBinding(&other, binding);  // always push back binding, don't care about the position in observer
 }
 
+template<typename ... ParamTypes>
+void Signal<ParamTypes...>::Connect(internal::AbstractInvokableTokenNode<ParamTypes..., SLOT> *token,
+                                    Trackable *trackable,
+                                    int index) {
+  _ASSERT(internal::TokenNode::kKindCustom == token->kind);
+  auto *binding = new internal::BindingNode;
+
+  Link(token, binding);
+  InsertToken(this, token, index);
+  PushBackBinding(trackable, binding);
+}
+
 template<typename ... ParamTypes>
 template<typename T>
 void Signal<ParamTypes...>::DisconnectAll(T *obj, void (T::*method)(ParamTypes..., SLOT)) {
-  internal::DelegateTokenNode<ParamTypes..., SLOT> *delegate_token = nullptr;
+  DelegateTokenType *delegate_token = nullptr;
   internal::TokenNode *tmp = nullptr;
 
   auto it = tokens_.rbegin();
@@ -922,7 +1095,7 @@ void Signal<ParamTypes...>::DisconnectAll(T *obj, void (T::*method)(ParamTypes..
     ++it;
 
     if (tmp->binding->trackable == obj) {
-      delegate_token = dynamic_cast<internal::DelegateTokenNode<ParamTypes..., SLOT> * > (tmp);
+      delegate_token = ToDelegateToken(tmp);
       if (delegate_token && (delegate_token->delegate().template Equal<T>(obj, method))) {
         delete tmp;
       }
@@ -932,7 +1105,7 @@ void Signal<ParamTypes...>::DisconnectAll(T *obj, void (T::*method)(ParamTypes..
 
 template<typename ... ParamTypes>
 void Signal<ParamTypes...>::DisconnectAll(Signal<ParamTypes...> &other) {
-  internal::SignalTokenNode<ParamTypes...> *signal_token = nullptr;
+  SignalTokenType *signal_token = nullptr;
   internal::TokenNode *tmp = nullptr;
 
   auto it = tokens_.rbegin();
@@ -941,7 +1114,7 @@ void Signal<ParamTypes...>::DisconnectAll(Signal<ParamTypes...> &other) {
     ++it;
 
     if (tmp->binding->trackable == (&other)) {
-      signal_token = dynamic_cast<internal::SignalTokenNode<ParamTypes...> * > (tmp);
+      signal_token = ToSignalToken(tmp);
       if (signal_token && (signal_token->signal() == (&other))) {
         delete tmp;
       }
@@ -952,7 +1125,7 @@ void Signal<ParamTypes...>::DisconnectAll(Signal<ParamTypes...> &other) {
 template<typename ... ParamTypes>
 template<typename T>
 int Signal<ParamTypes...>::Disconnect(T *obj, void (T::*method)(ParamTypes..., SLOT), int start_pos, int counts) {
-  internal::DelegateTokenNode<ParamTypes..., SLOT> *delegate_token = nullptr;
+  DelegateTokenType *delegate_token = nullptr;
   internal::TokenNode *tmp = nullptr;
   int ret_count = 0;
 
@@ -968,7 +1141,7 @@ int Signal<ParamTypes...>::Disconnect(T *obj, void (T::*method)(ParamTypes..., S
       ++it;
 
       if (tmp->binding->trackable == obj) {
-        delegate_token = dynamic_cast<internal::DelegateTokenNode<ParamTypes..., SLOT> * > (tmp);
+        delegate_token = ToDelegateToken(tmp);
         if (delegate_token && (delegate_token->delegate().template Equal<T>(obj, method))) {
           ret_count++;
           counts--;
@@ -989,7 +1162,7 @@ int Signal<ParamTypes...>::Disconnect(T *obj, void (T::*method)(ParamTypes..., S
       ++it;
 
       if (tmp->binding->trackable == obj) {
-        delegate_token = dynamic_cast<internal::DelegateTokenNode<ParamTypes..., SLOT> * > (tmp);
+        delegate_token = ToDelegateToken(tmp);
         if (delegate_token && (delegate_token->delegate().template Equal<T>(obj, method))) {
           ret_count++;
           counts--;
@@ -1005,7 +1178,7 @@ int Signal<ParamTypes...>::Disconnect(T *obj, void (T::*method)(ParamTypes..., S
 
 template<typename ... ParamTypes>
 int Signal<ParamTypes...>::Disconnect(Signal<ParamTypes...> &other, int start_pos, int counts) {
-  internal::SignalTokenNode<ParamTypes...> *signal_token = nullptr;
+  SignalTokenType *signal_token = nullptr;
   internal::TokenNode *tmp = nullptr;
   int ret_count = 0;
 
@@ -1021,7 +1194,7 @@ int Signal<ParamTypes...>::Disconnect(Signal<ParamTypes...> &other, int start_po
       ++it;
 
       if (tmp->binding->trackable == (&other)) {
-        signal_token = dynamic_cast<internal::SignalTokenNode<ParamTypes...> * > (tmp);
+        signal_token = ToSignalToken(tmp);
         if (signal_token && (signal_token->signal() == (&other))) {
           ret_count++;
           counts--;
@@ -1043,7 +1216,7 @@ int Signal<ParamTypes...>::Disconnect(Signal<ParamTypes...> &other, int start_po
       ++it;
 
       if (tmp->binding->trackable == (&other)) {
-        signal_token = dynamic_cast<internal::SignalTokenNode<ParamTypes...> * > (tmp);
+        signal_token = ToSignalToken(tmp);
         if (signal_token && (signal_token->signal() == (&other))) {
           ret_count++;
           counts--;
@@ -1112,7 +1285,7 @@ bool Signal<ParamTypes...>::IsConnectedTo(T *obj, void (T::*method)(ParamTypes..
   for (auto it = tokens_.begin(); it != tokens_.end();
        ++it) {
     if (it->binding->trackable == obj) {
-      delegate_token = dynamic_cast<internal::DelegateTokenNode<ParamTypes..., SLOT> * > (it.get());
+      delegate_token = ToDelegateToken(it.get());
       if (delegate_token && (delegate_token->delegate().template Equal<T>(obj, method))) {
         return true;
       }
@@ -1128,7 +1301,7 @@ bool Signal<ParamTypes...>::IsConnectedTo(const Signal<ParamTypes...> &other) co
   for (auto it = tokens_.begin(); it != tokens_.end();
        ++it) {
     if (it->binding->trackable == (&other)) {
-      signal_token = dynamic_cast<internal::SignalTokenNode<ParamTypes...> * > (it.get());
+      signal_token = ToSignalToken(it.get());
       if (signal_token && (signal_token->signal() == (&other))) {
         return true;
       }
@@ -1157,15 +1330,13 @@ bool Signal<ParamTypes...>::IsConnectedTo(const Trackable *obj) const {
 template<typename ... ParamTypes>
 template<typename T>
 int Signal<ParamTypes...>::CountConnections(T *obj, void (T::*method)(ParamTypes..., SLOT)) const {
-  typedef internal::DelegateTokenNode<ParamTypes..., SLOT> DelegateTokenType;
-
   int count = 0;
   DelegateTokenType *delegate_token = nullptr;
 
   for (auto it = tokens_.begin(); it != tokens_.end();
        ++it) {
     if (it->binding->trackable == obj) {
-      delegate_token = dynamic_cast<DelegateTokenType * > (it.get());
+      delegate_token = ToDelegateToken(it.get());
       if (delegate_token && (delegate_token->delegate().template Equal<T>(obj, method))) {
         count++;
       }
@@ -1176,15 +1347,13 @@ int Signal<ParamTypes...>::CountConnections(T *obj, void (T::*method)(ParamTypes
 
 template<typename ... ParamTypes>
 int Signal<ParamTypes...>::CountConnections(const Signal<ParamTypes...> &other) const {
-  typedef internal::SignalTokenNode<ParamTypes...> SignalTokenType;
-
   int count = 0;
   SignalTokenType *signal_token = nullptr;
 
   for (auto it = tokens_.begin(); it != tokens_.end();
        ++it) {
     if (it->binding->trackable == (&other)) {
-      signal_token = dynamic_cast<SignalTokenType * > (it.get());
+      signal_token = ToSignalToken(it.get());
       if (signal_token && (signal_token->signal() == (&other))) {
         count++;
       }
@@ -1206,16 +1375,56 @@ int Signal<ParamTypes...>::CountConnections() const {
 
 template<typename ... ParamTypes>
 void Signal<ParamTypes...>::Emit(ParamTypes ... Args) {
-  Slot slot(&tokens_);
+  if (inline_version_ != version_) UpdateInlineSlots();
+
+  Slot slot(this, &tokens_);
+
+  if (inline_count_ >= 0) {
+    const uint32_t version = version_;
+    for (int i = 0; i < inline_count_; ++i) {
+      slot.iterator_ = Slot::IteratorType(inline_slots_[i].token);
+      inline_slots_[i].delegate(Args..., &slot);
+      if (nullptr == slot.signal_) return;
+
+      if (version != version_) {
+        // Connections changed in the slot method, go on with the tokens:
+        ++slot;
+        EmitTokens(slot, Args...);
+        return;
+      }
+    }
+    return;
+  }
+
+  EmitTokens(slot, Args...);
+}
 
+template<typename ... ParamTypes>
+void Signal<ParamTypes...>::EmitTokens(Slot &slot, ParamTypes ... Args) {
   while (slot.iterator_) {
-    slot.iterator_->slot_mark_head.push_back(&slot.mark_);
     static_cast<internal::AbstractInvokableTokenNode<ParamTypes..., SLOT> * > (slot.iterator_.get())->Invoke(Args...,
                                                                                                              &slot);
+    if (nullptr == slot.signal_) return;
     ++slot;
   }
 }
 
+template<typename ... ParamTypes>
+void Signal<ParamTypes...>::UpdateInlineSlots() {
+  inline_count_ = 0;
+  for (auto it = tokens_.begin(); it != tokens_.end(); ++it) {
+    DelegateTokenType *token = ToDelegateToken(it.get());
+    if (nullptr == token || kInlineSlots == inline_count_) {
+      inline_count_ = -1;
+      break;
+    }
+    inline_slots_[inline_count_].token = token;
+    inline_slots_[inline_count_].delegate = token->delegate();
+    ++inline_count_;
+  }
+  inline_version_ = version_;
+}
+
 template<typename ... ParamTypes>
 void Signal<ParamTypes...>::DisconnectAll() {
   internal::InterRelatedNodeBase *tmp = nullptr;
@@ -1261,6 +1470,12 @@ class WIZTK_EXPORT SignalRef {
     signal_->Connect(signal, index);
   }
 
+  void Connect(internal::AbstractInvokableTokenNode<ParamTypes..., SLOT> *token,
+               Trackable *trackable,
+               int index = -1) {
+    signal_->Connect(token, trackable, index);
+  }
+
   template<typename T>
   void DisconnectAll(T *obj, void (T::*method)(ParamTypes..., SLOT)) {
     signal_->DisconnectAll(obj, method);
@@ -23,48 +23,147 @@
 #include <string>
 #include <algorithm>
 #include <memory>
-
-#include <unicode/umachine.h>
+#include <ostream>
 
 namespace wiztk {
 namespace base {
 
-typedef std::basic_string<UChar, std::char_traits<UChar> > BasicString;
-
 /**
  * @ingroup base
- * @brief Unicode string
+ * @brief A Unicode string stored as UTF-8
+ *
+ * The text is kept in a std::string, so a short string lives inside the
+ * object without a heap allocation (up to 15 bytes with libstdc++).
+ *
+ * The input is validated when a string is constructed, and an invalid
+ * sequence is replaced with U+FFFD. The data is therefore always valid
+ * UTF-8 and is passed to Skia and Wayland as is. UTF-16 and UTF-32 are
+ * only computed when ToUTF16() or ToUTF32() is called.
+ *
+ * size() and length() are in bytes, use CountCodePoints() for characters.
  */
-class String : public BasicString {
+class WIZTK_EXPORT String {
 
  public:
 
-  using BasicString::BasicString;
+  typedef std::string::size_type size_type;
+
+  static const size_type npos = std::string::npos;
+
+  String() = default;
 
   /**
-   * @brief Constructor from UTF8 string.
+   * @brief Constructor from a NUL-terminated UTF-8 string.
    * @param str
    */
   String(const char *str);
 
   /**
-   * @brief Constructor from UTF16 string.
+   * @brief Constructor from a UTF-8 string of a given length in bytes.
+   * @param str
+   * @param length
+   */
+  String(const char *str, size_type length);
+
+  /**
+   * @brief Constructor from UTF-8 in a std::string.
+   * @param str
+   */
+  String(const std::string &str);
+
+  /**
+   * @brief Constructor from UTF-8 in a std::string, takes the buffer if valid.
+   * @param str
+   */
+  String(std::string &&str);
+
+  /**
+   * @brief Constructor from a NUL-terminated UTF-16 string.
    * @param str
    */
   String(const char16_t *str);
 
   /**
-   * @brief Constructor from UTF32 string.
+   * @brief Constructor from a NUL-terminated UTF-32 string.
    * @param str
    */
   String(const char32_t *str);
 
-  std::string ToUTF8() const;
+  String(const String &) = default;
+
+  String(String &&) = default;
+
+  ~String() = default;
+
+  String &operator=(const String &) = default;
+
+  String &operator=(String &&) = default;
+
+  String &operator+=(const String &other) {
+    utf8_ += other.utf8_;
+    return *this;
+  }
+
+  const char *data() const { return utf8_.data(); }
+
+  const char *c_str() const { return utf8_.c_str(); }
+
+  size_type size() const { return utf8_.size(); }
+
+  size_type length() const { return utf8_.length(); }
+
+  bool empty() const { return utf8_.empty(); }
+
+  void clear() { utf8_.clear(); }
+
+  /**
+   * @brief The number of Unicode code points
+   */
+  size_type CountCodePoints() const;
+
+  /**
+   * @brief The UTF-8 data, no conversion is needed
+   */
+  const std::string &ToUTF8() const { return utf8_; }
+
+  std::u16string ToUTF16() const;
 
   std::u32string ToUTF32() const;
 
+  /**
+   * @brief Check if the given data is valid UTF-8
+   *
+   * Overlong forms, surrogates and code points beyond U+10FFFF are invalid.
+   * ASCII is checked 16 bytes at a time.
+   */
+  static bool IsValidUTF8(const char *str, size_type length);
+
+ private:
+
+  void Assign(const char *str, size_type length);
+
+  std::string utf8_;
+
 };
 
+inline bool operator==(const String &str1, const String &str2) {
+  return str1.ToUTF8() == str2.ToUTF8();
+}
+
+inline bool operator!=(const String &str1, const String &str2) {
+  return str1.ToUTF8() != str2.ToUTF8();
+}
+
+inline bool operator<(const String &str1, const String &str2) {
+  return str1.ToUTF8() < str2.ToUTF8();
+}
+
+inline String operator+(const String &str1, const String &str2) {
+  String str(str1);
+  str += str2;
+  return str;
+}
+
 /**
  * @ingroup base
  * @brief A string-like object that points to a sized piece of memory.
@@ -0,0 +1,113 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef WIZTK_DEVICE_VIDEO_ABSTRACT_FRAME_SOURCE_HPP_
+#define WIZTK_DEVICE_VIDEO_ABSTRACT_FRAME_SOURCE_HPP_
+
+#include "wiztk/device/video/frame.hpp"
+
+#include "wiztk/base/sigcxx.hpp"
+
+#include <memory>
+
+namespace wiztk {
+
+namespace async {
+class EventLoop;
+}
+
+namespace device {
+namespace video {
+
+/**
+ * @ingroup device_video
+ * @brief The base class of objects which produce video frames
+ *
+ * A frame source watches a file descriptor in an async::EventLoop and emits
+ * frame_ready() in the thread of this event loop when a new frame is
+ * available. Connect to frame_ready() and copy the Frame handle to keep the
+ * pixels, no image data is copied.
+ */
+class WIZTK_EXPORT AbstractFrameSource {
+
+ public:
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(AbstractFrameSource);
+
+  template<typename ... Args> using SignalRef = typename base::SignalRef<Args...>;
+  template<typename ... Args> using Signal = typename base::Signal<Args...>;
+
+  AbstractFrameSource();
+
+  virtual ~AbstractFrameSource();
+
+  /**
+   * @brief Start streaming in the given event loop
+   * @param event_loop The event loop in which frame_ready() is emitted
+   * @return true if success
+   */
+  virtual bool Start(async::EventLoop *event_loop) = 0;
+
+  /**
+   * @brief Stop streaming
+   *
+   * The Frame handles which are still alive remain valid.
+   */
+  virtual void Stop() = 0;
+
+  virtual const Format &GetFormat() const = 0;
+
+  bool IsStreaming() const;
+
+  /**
+   * @brief A signal emitted when a new frame is captured
+   */
+  SignalRef<const Frame &> frame_ready() { return frame_ready_; }
+
+ protected:
+
+  /**
+   * @brief Watch the file descriptor which becomes readable when frames arrive
+   */
+  bool Watch(async::EventLoop *event_loop, int fd);
+
+  /**
+   * @brief Stop watching the file descriptor
+   */
+  void Unwatch();
+
+  /**
+   * @brief Called in the event loop when the watched file descriptor is ready
+   */
+  virtual void OnEvent(uint32_t events) = 0;
+
+  void EmitFrame(const Frame &frame) { frame_ready_.Emit(frame); }
+
+ private:
+
+  class Watcher;
+
+  std::unique_ptr<Watcher> watcher_;
+
+  Signal<const Frame &> frame_ready_;
+
+};
+
+} // namespace video
+} // namespace device
+} // namespace wiztk
+
+#endif // WIZTK_DEVICE_VIDEO_ABSTRACT_FRAME_SOURCE_HPP_
@@ -17,32 +17,119 @@
 #ifndef WIZTK_DEVICE_VIDEO_CAMERA_HPP_
 #define WIZTK_DEVICE_VIDEO_CAMERA_HPP_
 
-#include "wiztk/base/macros.hpp"
+#include "wiztk/device/video/abstract-frame-source.hpp"
 
 namespace wiztk {
 namespace device {
 namespace video {
 
-class WIZTK_EXPORT Camera {
+/**
+ * @ingroup device_video
+ * @brief A V4L2 video capture device
+ *
+ * Typical usage:
+ *
+ * @code
+ * Camera camera;
+ * camera.Open("/dev/video0");
+ * camera.SetFormat(V4L2_PIX_FMT_YUYV, 640, 480);
+ * camera.frame_ready().Connect(this, &MyView::OnFrame);
+ * camera.Start(async::EventLoop::GetCurrent());
+ * @endcode
+ *
+ * The capture buffers are either mapped from the driver (kIOMethodMmap) or
+ * allocated by this object (kIOMethodUserPtr), the frames emitted refer to
+ * these buffers directly and a buffer is queued back to the driver when its
+ * last Frame handle is released.
+ *
+ * @note Restarting while frames of the previous stream are still held may
+ * fail as the driver cannot free the old buffers.
+ */
+class WIZTK_EXPORT Camera : public AbstractFrameSource {
 
  public:
 
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(Camera);
+
+  enum IOMethod {
+    kIOMethodMmap,
+    kIOMethodUserPtr
+  };
+
   Camera();
 
-  ~Camera();
+  ~Camera() override;
 
   static void GetAll();
 
+  /**
+   * @brief Open a video capture device
+   * @param dev_name Device name, e.g. "/dev/video0"
+   * @return true if the device supports video capture and streaming
+   */
+  bool Open(const char *dev_name);
+
+  /**
+   * @brief Stop streaming and close the device
+   */
+  void Close();
+
+  bool IsOpen() const;
+
+  /**
+   * @brief Negotiate the image format with the driver
+   * @param pixel_format A V4L2 fourcc code
+   * @param width
+   * @param height
+   * @return true if success, the driver may adjust the size, check GetFormat()
+   */
+  bool SetFormat(uint32_t pixel_format, int width, int height);
+
+  const Format &GetFormat() const final;
+
+  /**
+   * @brief Set the I/O method used in the next Start()
+   */
+  void SetIOMethod(IOMethod method);
+
+  IOMethod GetIOMethod() const;
+
+  /**
+   * @brief Set the number of buffers requested in the next Start()
+   *
+   * The driver may allocate more or less buffers, at least 2 are needed.
+   */
+  void SetBufferCount(int count);
+
+  /**
+   * @brief Export each mmap buffer as a DMABUF file descriptor in Start()
+   *
+   * See Frame::GetDmaBufFd().
+   */
+  void SetExportDmaBuf(bool export_dmabuf);
+
+  bool Start(async::EventLoop *event_loop) final;
+
+  void Stop() final;
+
+ protected:
+
+  void OnEvent(uint32_t events) final;
+
  private:
 
-  static int OpenDevice(const char* dev_name);
+  struct Private;
+
+  static int OpenDevice(const char *dev_name);
 
   static void ShowInfo(int fd);
 
+  std::unique_ptr<Private> p_;
+
 };
 
-}
-}
-}
+} // namespace video
+} // namespace device
+} // namespace wiztk
 
 #endif // WIZTK_DEVICE_VIDEO_CAMERA_HPP_
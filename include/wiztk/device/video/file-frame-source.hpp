@@ -0,0 +1,105 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef WIZTK_DEVICE_VIDEO_FILE_FRAME_SOURCE_HPP_
+#define WIZTK_DEVICE_VIDEO_FILE_FRAME_SOURCE_HPP_
+
+#include "wiztk/device/video/abstract-frame-source.hpp"
+
+namespace wiztk {
+namespace device {
+namespace video {
+
+/**
+ * @ingroup device_video
+ * @brief A frame source which plays raw frames from a file
+ *
+ * This is a stand-in of Camera for tests and environments without a capture
+ * device. The file is a sequence of frames of Format::size_image bytes each,
+ * it's mapped in memory and the emitted frames point into the mapping.
+ *
+ * Frames are produced by a timer at the given frame rate, like a driver, only
+ * a limited number of frames can be held (see SetBufferCount()), a frame is
+ * dropped when all of them are in use.
+ */
+class WIZTK_EXPORT FileFrameSource : public AbstractFrameSource {
+
+ public:
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(FileFrameSource);
+
+  FileFrameSource();
+
+  ~FileFrameSource() override;
+
+  /**
+   * @brief Open a raw frames file
+   * @param path File path
+   * @param format The format of frames in this file
+   * @return true if the file contains at least one frame
+   */
+  bool Open(const char *path, const Format &format);
+
+  void Close();
+
+  const Format &GetFormat() const final;
+
+  /**
+   * @brief Get the number of frames in the file
+   */
+  int GetFrameCount() const;
+
+  /**
+   * @brief Set frames per second, takes effect in the next Start()
+   */
+  void SetFrameRate(int fps);
+
+  /**
+   * @brief Set the number of frames which can be held at the same time
+   */
+  void SetBufferCount(int count);
+
+  /**
+   * @brief Restart from the first frame at the end of file, true by default
+   */
+  void SetLoop(bool loop);
+
+  /**
+   * @brief The number of frames dropped as no buffer was free
+   */
+  uint32_t GetDroppedCount() const;
+
+  bool Start(async::EventLoop *event_loop) final;
+
+  void Stop() final;
+
+ protected:
+
+  void OnEvent(uint32_t events) final;
+
+ private:
+
+  struct Private;
+
+  std::unique_ptr<Private> p_;
+
+};
+
+} // namespace video
+} // namespace device
+} // namespace wiztk
+
+#endif // WIZTK_DEVICE_VIDEO_FILE_FRAME_SOURCE_HPP_
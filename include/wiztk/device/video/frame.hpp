@@ -0,0 +1,156 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef WIZTK_DEVICE_VIDEO_FRAME_HPP_
+#define WIZTK_DEVICE_VIDEO_FRAME_HPP_
+
+#include "wiztk/base/macros.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace wiztk {
+namespace device {
+namespace video {
+
+namespace internal {
+class BufferRing;
+}
+
+/**
+ * @ingroup device_video
+ * @brief Describes the image format of frames
+ *
+ * The pixel format is a V4L2 fourcc code, for the YUV formats (YUYV, NV12,
+ * YU12) it has the same value as the corresponding wiztk::PixelFormat.
+ */
+struct WIZTK_EXPORT Format {
+
+  uint32_t pixel_format = 0;
+
+  int width = 0;
+
+  int height = 0;
+
+  int bytes_per_line = 0;
+
+  size_t size_image = 0;
+
+  /**
+   * @brief Make a format with the stride and image size of the pixel format
+   * @param pixel_format The fourcc code
+   * @param width
+   * @param height
+   * @param bytes_per_line The stride reported by a driver, or 0
+   * @param size_image The image size reported by a driver, or 0
+   *
+   * For the packed 16-bit formats (YUYV, UYVY) the stride is at least
+   * width * 2 and the image size at least stride * height. For the planar
+   * 4:2:0 formats (NV12, YU12) the stride is at least width and the image
+   * size at least stride * height * 3 / 2. The values of other formats (e.g.
+   * MJPEG) are kept as given.
+   */
+  static Format Make(uint32_t pixel_format, int width, int height,
+                     int bytes_per_line = 0, size_t size_image = 0);
+
+};
+
+/**
+ * @ingroup device_video
+ * @brief A reference counted handle to a captured frame
+ *
+ * A Frame refers to a buffer in the capture ring without copying the pixels.
+ * The buffer is given back to the ring (re-queued to the driver) when the last
+ * handle to it is released, so hold a Frame only as long as the pixels are
+ * needed, otherwise the ring runs out of buffers and frames are dropped.
+ *
+ * Frame handles can be copied, moved and released in any thread.
+ */
+class WIZTK_EXPORT Frame {
+
+  friend class internal::BufferRing;
+
+ public:
+
+  Frame() = default;
+
+  Frame(const Frame &other);
+
+  Frame(Frame &&other) noexcept;
+
+  ~Frame();
+
+  Frame &operator=(const Frame &other);
+
+  Frame &operator=(Frame &&other) noexcept;
+
+  /**
+   * @brief Release this handle
+   */
+  void Reset();
+
+  /**
+   * @brief The address of the pixels
+   */
+  const void *GetData() const;
+
+  /**
+   * @brief The bytes used by this frame
+   */
+  size_t GetSize() const;
+
+  const Format &GetFormat() const;
+
+  /**
+   * @brief The index of the buffer in the ring
+   */
+  int GetIndex() const { return index_; }
+
+  uint32_t GetSequence() const;
+
+  /**
+   * @brief The capture time in microseconds (CLOCK_MONOTONIC)
+   */
+  int64_t GetTimestamp() const;
+
+  /**
+   * @brief The exported DMABUF file descriptor, or -1
+   */
+  int GetDmaBufFd() const;
+
+  /**
+   * @brief The number of handles refer to the same buffer
+   */
+  int GetUseCount() const;
+
+  explicit operator bool() const { return nullptr != ring_; }
+
+ private:
+
+  Frame(internal::BufferRing *ring, int index)
+      : ring_(ring), index_(index) {}
+
+  internal::BufferRing *ring_ = nullptr;
+
+  int index_ = -1;
+
+};
+
+} // namespace video
+} // namespace device
+} // namespace wiztk
+
+#endif // WIZTK_DEVICE_VIDEO_FRAME_HPP_
@@ -35,6 +35,7 @@ namespace graphics {
 
 // Forward declarations:
 class Image;
+class Picture;
 class Paint;
 class Path;
 class Matrix;
@@ -56,6 +57,7 @@ class SurfaceProps;
 class Canvas {
 
   friend class Surface;
+  friend class PictureRecorder;
 
  public:
 
@@ -140,6 +142,14 @@ class Canvas {
 
   void DrawPaint(const Paint &paint);
 
+  /**
+   * @brief Draw a recorded picture
+   * @param picture The picture to be replayed
+   * @param matrix An optional matrix applied to the picture
+   * @param paint An optional paint, if not null the picture is drawn in a layer with its alpha, color filter etc.
+   */
+  void DrawPicture(const Picture &picture, const Matrix *matrix = nullptr, const Paint *paint = nullptr);
+
   void Translate(float dx, float dy);
 
   void Scale(float sx, float sy);
@@ -203,6 +213,8 @@ class Canvas {
 
   explicit Canvas(Surface *surface);
 
+  explicit Canvas(Private *p);
+
   void DrawAlignedText(const void *text,
                        size_t byte_length,
                        float x,
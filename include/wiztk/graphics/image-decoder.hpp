@@ -0,0 +1,179 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef WIZTK_GRAPHICS_IMAGE_DECODER_HPP_
+#define WIZTK_GRAPHICS_IMAGE_DECODER_HPP_
+
+#include "wiztk/graphics/image.hpp"
+
+#include "wiztk/base/sigcxx.hpp"
+
+#include <string>
+
+namespace wiztk {
+
+namespace async {
+class EventLoop;
+}
+
+namespace graphics {
+
+/**
+ * @ingroup graphics
+ * @brief Decodes image files (PNG, JPEG, WebP, etc.) in worker threads
+ *
+ * Load() queues a file to be decoded by a small pool of threads and returns
+ * immediately. The result is emitted by decoded() in the thread of the
+ * async::EventLoop given in constructor, so the slots can update views
+ * directly.
+ *
+ * A target size can be given to decode thumbnails: the image is scaled down
+ * to fit in it and keeps the aspect ratio. The codec samples the source while
+ * decoding (e.g. JPEG DCT scaling) so a large file is never decoded in full
+ * resolution only to be thrown away.
+ *
+ * Decoded images are kept in a LRU cache keyed by the path and the target
+ * size, a cached image is delivered without decoding again.
+ *
+ * An ImageDecoder must be used in the thread of its event loop.
+ */
+class WIZTK_EXPORT ImageDecoder {
+
+ public:
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(ImageDecoder);
+
+  template<typename ... Args> using SignalRef = typename base::SignalRef<Args...>;
+  template<typename ... Args> using Signal = typename base::Signal<Args...>;
+
+  /**
+   * @brief The result of a Load()
+   */
+  struct Result {
+
+    std::string path;
+
+    /**
+     * @brief The target width given in Load()
+     */
+    int width = 0;
+
+    /**
+     * @brief The target height given in Load()
+     */
+    int height = 0;
+
+    /**
+     * @brief The decoded image, invalid if the file cannot be decoded
+     */
+    Image image;
+
+  };
+
+  /**
+   * @brief The default budget of the cache in bytes
+   */
+  static const size_t kDefaultCacheCapacity = 64 * 1024 * 1024;
+
+  /**
+   * @brief Decode an image file in the current thread
+   * @param path The file path
+   * @param width The maximal width, 0 for no limit
+   * @param height The maximal height, 0 for no limit
+   * @return The decoded image, invalid if failed
+   */
+  static Image Decode(const std::string &path, int width = 0, int height = 0);
+
+  /**
+   * @brief Constructor
+   * @param event_loop The event loop in which decoded() is emitted, nullptr to
+   *        use the one of the current thread
+   * @param thread_count The number of worker threads, 0 to choose one by the
+   *        number of CPUs
+   */
+  explicit ImageDecoder(async::EventLoop *event_loop = nullptr, int thread_count = 0);
+
+  /**
+   * @brief Destructor
+   *
+   * Queued files are discarded and the worker threads are joined.
+   */
+  ~ImageDecoder();
+
+  /**
+   * @brief Decode an image file asynchronously
+   * @param path The file path
+   * @param width The maximal width, 0 for no limit
+   * @param height The maximal height, 0 for no limit
+   *
+   * A request equals to one which is still in progress is ignored, the result
+   * is emitted once.
+   */
+  void Load(const std::string &path, int width = 0, int height = 0);
+
+  /**
+   * @brief Remove a request which is not being decoded yet
+   * @return true if the request was removed, no result will be emitted
+   */
+  bool Cancel(const std::string &path, int width = 0, int height = 0);
+
+  /**
+   * @brief Find a decoded image in the cache
+   * @return The cached image, or an invalid image
+   */
+  Image Find(const std::string &path, int width = 0, int height = 0) const;
+
+  /**
+   * @brief Set the budget of the cache in bytes, least recently used images are
+   * evicted when it's exceeded
+   */
+  void SetCacheCapacity(size_t bytes);
+
+  size_t GetCacheCapacity() const;
+
+  /**
+   * @brief The bytes of pixels of all cached images
+   */
+  size_t GetCacheSize() const;
+
+  void ClearCache();
+
+  /**
+   * @brief A signal emitted in the event loop when a Load() finishes
+   */
+  SignalRef<const Result &> decoded() { return decoded_; }
+
+ private:
+
+  struct Private;
+
+  class WakeupEvent;
+
+  /**
+   * @brief Called in the event loop to emit the finished results
+   */
+  void DispatchResults();
+
+  std::unique_ptr<Private> p_;
+
+  Signal<const Result &> decoded_;
+
+};
+
+} // namespace graphics
+} // namespace wiztk
+
+#endif // WIZTK_GRAPHICS_IMAGE_DECODER_HPP_
@@ -25,9 +25,12 @@ namespace wiztk {
 namespace graphics {
 
 class Pixmap;
+class ImageDecoder;
 
 class Image {
 
+  friend class ImageDecoder;
+
  public:
 
   struct Private;
@@ -51,6 +54,12 @@ class Image {
 
   virtual ~Image();
 
+  bool IsValid() const;
+
+  int GetWidth() const;
+
+  int GetHeight() const;
+
  private:
 
   std::unique_ptr<Private> p_;
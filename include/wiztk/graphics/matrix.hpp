@@ -17,7 +17,7 @@
 #ifndef WIZTK_GRAPHICS_MATRIX_HPP_
 #define WIZTK_GRAPHICS_MATRIX_HPP_
 
-#include <memory>
+#include "wiztk/base/memory/fast-pimpl.hpp"
 
 namespace wiztk {
 namespace graphics {
@@ -42,7 +42,8 @@ class Matrix {
 
  private:
 
-  std::unique_ptr<Private> p_;
+  // Large enough for a SkMatrix:
+  base::memory::FastPimpl<Private, 48> p_;
 
 };
 
@@ -18,12 +18,12 @@
 #define WIZTK_GRAPHIC_PAINT_HPP_
 
 #include "wiztk/base/color.hpp"
+#include "wiztk/base/memory/fast-pimpl.hpp"
 
 #include "wiztk/graphics/font.hpp"
 #include "wiztk/graphics/text-alignment.hpp"
 
 #include <cstdint>
-#include <memory>
 
 namespace wiztk {
 namespace graphics {
@@ -134,7 +134,8 @@ class WIZTK_EXPORT Paint {
   
  private:
 
-  std::unique_ptr<Private> p_;
+  // Large enough for a SkPaint:
+  base::memory::FastPimpl<Private, 128> p_;
 };
 
 bool operator==(const Paint &paint1, const Paint &paint2);
@@ -18,8 +18,7 @@
 #define WIZTK_GRAPHIC_PATH_HPP_
 
 #include "wiztk/base/rect.hpp"
-
-#include <memory>
+#include "wiztk/base/memory/fast-pimpl.hpp"
 
 namespace wiztk {
 namespace graphics {
@@ -133,7 +132,8 @@ class Path {
 
  private:
 
-  std::unique_ptr<Private> p_;
+  // Large enough for a SkPath:
+  base::memory::FastPimpl<Private, 32> p_;
 
 };
 
@@ -0,0 +1,84 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef WIZTK_GRAPHICS_PICTURE_RECORDER_HPP_
+#define WIZTK_GRAPHICS_PICTURE_RECORDER_HPP_
+
+#include "wiztk/graphics/picture.hpp"
+
+namespace wiztk {
+namespace graphics {
+
+/**
+ * @ingroup graphics
+ * @brief Records drawing commands into a Picture
+ *
+ * Example:
+ *
+ * @code
+ * PictureRecorder recorder;
+ * Canvas *canvas = recorder.BeginRecording(RectF::FromXYWH(0.f, 0.f, 200.f, 100.f));
+ * canvas->DrawRect(..., paint);
+ * Picture picture = recorder.FinishRecording();
+ *
+ * // later, in any thread:
+ * target->DrawPicture(picture);
+ * @endcode
+ */
+class WIZTK_EXPORT PictureRecorder {
+
+ public:
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(PictureRecorder);
+
+  using RectF = base::RectF;
+
+  struct Private;
+
+  PictureRecorder();
+
+  ~PictureRecorder();
+
+  /**
+   * @brief Start recording
+   * @param cull_rect The bounds of the content
+   * @param use_bbh Build a bounding box hierarchy (R-tree), which lets a
+   *        playback clipped to a small region skip the commands outside it
+   * @return The recording canvas, owned by this recorder and valid until
+   *         FinishRecording()
+   */
+  Canvas *BeginRecording(const RectF &cull_rect, bool use_bbh = false);
+
+  /**
+   * @brief Get the recording canvas, nullptr if not recording
+   */
+  Canvas *GetRecordingCanvas() const;
+
+  /**
+   * @brief Stop recording and return the picture
+   */
+  Picture FinishRecording();
+
+ private:
+
+  std::unique_ptr<Private> p_;
+
+};
+
+} // namespace graphics
+} // namespace wiztk
+
+#endif // WIZTK_GRAPHICS_PICTURE_RECORDER_HPP_
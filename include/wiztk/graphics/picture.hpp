@@ -0,0 +1,116 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef WIZTK_GRAPHICS_PICTURE_HPP_
+#define WIZTK_GRAPHICS_PICTURE_HPP_
+
+#include "wiztk/base/macros.hpp"
+#include "wiztk/base/rect.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace wiztk {
+namespace graphics {
+
+// Forward declarations
+class Canvas;
+
+/**
+ * @ingroup graphics
+ * @brief An immutable list of recorded drawing commands
+ *
+ * A Picture is created by PictureRecorder and can be replayed onto any Canvas
+ * with Canvas::DrawPicture() or Playback(). It's reference counted internally,
+ * copying a Picture is cheap and a Picture can be shared between threads, e.g.
+ * record in the main thread and rasterize in a worker thread.
+ *
+ * @see PictureRecorder
+ */
+class WIZTK_EXPORT Picture {
+
+  friend class PictureRecorder;
+
+ public:
+
+  using RectF = base::RectF;
+
+  struct Private;
+
+  /**
+   * @brief Recreate a picture from the bytes returned by Serialize()
+   * @return A picture, check IsValid() for errors
+   */
+  static Picture MakeFromData(const void *data, size_t size);
+
+  /**
+   * @brief Create an empty and invalid picture
+   */
+  Picture();
+
+  Picture(const Picture &other);
+
+  Picture(Picture &&other) noexcept;
+
+  ~Picture();
+
+  Picture &operator=(const Picture &other);
+
+  Picture &operator=(Picture &&other) noexcept;
+
+  bool IsValid() const;
+
+  /**
+   * @brief Replay the drawing commands onto the canvas
+   */
+  void Playback(Canvas *canvas) const;
+
+  /**
+   * @brief The bounds given when recording, drawing outside may be culled
+   */
+  RectF GetCullRect() const;
+
+  /**
+   * @brief The approximate number of drawing operations
+   */
+  int GetApproximateOpCount() const;
+
+  /**
+   * @brief The approximate bytes used by the commands and the data they refer to
+   */
+  size_t GetApproximateBytesUsed() const;
+
+  /**
+   * @brief A non-zero value unique among all pictures
+   */
+  uint32_t GetUniqueID() const;
+
+  /**
+   * @brief Serialize to bytes, for storage or golden file tests
+   */
+  std::vector<uint8_t> Serialize() const;
+
+ private:
+
+  std::unique_ptr<Private> p_;
+
+};
+
+} // namespace graphics
+} // namespace wiztk
+
+#endif // WIZTK_GRAPHICS_PICTURE_HPP_
@@ -0,0 +1,205 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef WIZTK_GRAPHICS_YUV_CONVERTER_HPP_
+#define WIZTK_GRAPHICS_YUV_CONVERTER_HPP_
+
+#include "wiztk/base/macros.hpp"
+#include "wiztk/base/types.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace wiztk {
+namespace graphics {
+
+/**
+ * @ingroup graphics
+ * @brief A YUV frame in memory, usually from a camera or a video decoder
+ *
+ * Supported formats:
+ *   - kPixelFormatYUYV: one packed plane, Y0 U0 Y1 V0 (4:2:2)
+ *   - kPixelFormatNV12: Y plane + interleaved UV plane (4:2:0)
+ *   - kPixelFormatYUV420: I420, Y plane + U plane + V plane (4:2:0)
+ *
+ * This struct does not own the pixel memory.
+ */
+struct WIZTK_EXPORT YUVFrame {
+
+  PixelFormat format = kPixelFormatInvalid;
+
+  int width = 0;
+
+  int height = 0;
+
+  /**
+   * @brief Plane addresses, unused planes are nullptr
+   */
+  const uint8_t *planes[3] = {nullptr, nullptr, nullptr};
+
+  /**
+   * @brief Bytes per row of each plane
+   */
+  int strides[3] = {0, 0, 0};
+
+  /**
+   * @brief Describe a tightly packed frame in a single continuous buffer
+   * @param format One of kPixelFormatYUYV, kPixelFormatNV12 or kPixelFormatYUV420
+   * @param width
+   * @param height
+   * @param data
+   * @return
+   */
+  static YUVFrame Make(PixelFormat format, int width, int height, const void *data);
+
+  /**
+   * @brief Returns the bytes of a tightly packed frame
+   */
+  static size_t GetByteSize(PixelFormat format, int width, int height);
+
+};
+
+/**
+ * @ingroup graphics
+ * @brief Convert YUV frames to 32-bit ARGB8888/XRGB8888 SHM pixels
+ *
+ * The output is little-endian 0xAARRGGBB, i.e. the byte order B, G, R, A,
+ * exactly what the WL_SHM_FORMAT_ARGB8888 and WL_SHM_FORMAT_XRGB8888 buffers
+ * expect. Alpha is always 0xFF, so the ARGB8888 output is also premultiplied.
+ *
+ * The input is limited range (16-235), the conversion uses 6-bit fixed point
+ * coefficients and the scalar, SSE2 and AVX2 paths generate identical results.
+ *
+ * Example:
+ *
+ * @code
+ * YUVConverter converter(YUVConverter::kBT709);
+ * converter.SetThreadCount(4);
+ * converter.Convert(YUVFrame::Make(kPixelFormatNV12, w, h, data),
+ *                   buffer.GetData(), buffer.GetStride());
+ * @endcode
+ */
+class WIZTK_EXPORT YUVConverter {
+
+ public:
+
+  /**
+   * @brief YUV to RGB matrix
+   */
+  enum Matrix {
+    kBT601,  ///< SDTV, most webcams
+    kBT709   ///< HDTV
+  };
+
+  /**
+   * @brief Kernel implementations
+   */
+  enum Path {
+    kPathAuto,    ///< The fastest path the running CPU supports
+    kPathScalar,
+    kPathSSE2,
+    kPathAVX2
+  };
+
+  /**
+   * @brief Max number of threads used in Convert()
+   */
+  static const int kMaxThreads = 16;
+
+  /**
+   * @brief Returns true if the given path can run on this CPU
+   */
+  static bool IsSupported(Path path);
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(YUVConverter);
+
+  explicit YUVConverter(Matrix matrix = kBT601, Path path = kPathAuto);
+
+  ~YUVConverter();
+
+  void SetMatrix(Matrix matrix) { matrix_ = matrix; }
+
+  Matrix GetMatrix() const { return matrix_; }
+
+  /**
+   * @brief Select the kernel path
+   *
+   * Falls back to the best supported path if the given one is not supported.
+   */
+  void SetPath(Path path);
+
+  /**
+   * @brief Returns the resolved kernel path, never kPathAuto
+   */
+  Path GetPath() const { return path_; }
+
+  /**
+   * @brief Set the number of threads to split rows across
+   *
+   * The calling thread always works on the first slice, 1 (the default)
+   * converts in the calling thread only. The other (count - 1) threads are
+   * started here and kept until the count changes or the converter is
+   * destroyed, so Convert() does not create threads for each frame.
+   */
+  void SetThreadCount(int count);
+
+  int GetThreadCount() const { return thread_count_; }
+
+  /**
+   * @brief Convert a frame
+   * @param src The source frame
+   * @param dst The address of the destination pixels
+   * @param dst_stride Bytes per row of the destination
+   * @param dst_format kPixelFormatARGB8888 or kPixelFormatXRGB8888
+   * @return false if the source or destination format is not supported
+   */
+  bool Convert(const YUVFrame &src,
+               void *dst,
+               int dst_stride,
+               PixelFormat dst_format = kPixelFormatARGB8888) const;
+
+  /**
+   * @brief Convert the rows [row_begin, row_end) of a frame
+   *
+   * For 4:2:0 formats row_begin should be even. This can be used to
+   * schedule rows on a custom thread pool.
+   */
+  bool ConvertRows(const YUVFrame &src,
+                   void *dst,
+                   int dst_stride,
+                   int row_begin,
+                   int row_end,
+                   PixelFormat dst_format = kPixelFormatARGB8888) const;
+
+ private:
+
+  class WorkerPool;
+
+  Matrix matrix_;
+
+  Path path_;
+
+  int thread_count_;
+
+  std::unique_ptr<WorkerPool> pool_;
+
+};
+
+} // namespace graphics
+} // namespace wiztk
+
+#endif // WIZTK_GRAPHICS_YUV_CONVERTER_HPP_
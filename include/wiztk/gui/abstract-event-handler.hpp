@@ -18,7 +18,7 @@
 #define WIZTK_GUI_ABSTRACT_EVENT_HANDLER_HPP_
 
 #include "wiztk/base/sigcxx.hpp"
-#include "wiztk/base/string.hpp"
+#include "wiztk/base/atom.hpp"
 
 #include <memory>
 
@@ -27,6 +27,7 @@ namespace gui {
 
 class MouseEvent;
 class KeyEvent;
+class TouchEvent;
 
 class Surface;
 class AbstractView;
@@ -58,24 +59,25 @@ class WIZTK_EXPORT AbstractEventHandler : public base::Trackable {
 
   friend class AbstractView;
   friend class AbstractShellView;
+  friend class HoverPath;
 
  public:
 
-  using String = base::String;
+  using Atom = base::Atom;
   template<typename ... Args> using SignalRef = typename base::SignalRef<Args...>;
   template<typename ... Args> using Signal = typename base::Signal<Args...>;
 
   WIZTK_DECLARE_NONCOPYABLE(AbstractEventHandler);
 
   /**
-   * @brief Nested class represents an mouse event node.
-   */
-  class MouseTask : public base::Binode<MouseTask> {
+    * @brief Nested class represents an mouse motion event node.
+    */
+  class MouseMotionTask : public base::Binode<MouseMotionTask> {
 
    public:
 
-    WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(MouseTask);
-    MouseTask() = delete;
+    WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(MouseMotionTask);
+    MouseMotionTask() = delete;
 
     /**
      * @brief Constructor
@@ -83,17 +85,17 @@ class WIZTK_EXPORT AbstractEventHandler : public base::Trackable {
      *
      * @note The parameter cannot be nullptr.
      */
-    explicit MouseTask(AbstractEventHandler *event_handler)
+    explicit MouseMotionTask(AbstractEventHandler *event_handler)
         : event_handler_(event_handler) {}
 
     /**
      * @brief Destructor
      */
-    ~MouseTask() override = default;
+    ~MouseMotionTask() override = default;
 
     inline AbstractEventHandler *event_handler() const { return event_handler_; }
 
-    static MouseTask *Get(const AbstractEventHandler *event_hander);
+    static MouseMotionTask *Get(const AbstractEventHandler *event_handler);
 
    private:
 
@@ -102,14 +104,17 @@ class WIZTK_EXPORT AbstractEventHandler : public base::Trackable {
   };
 
   /**
-    * @brief Nested class represents an mouse motion event node.
-    */
-  class MouseMotionTask : public base::Binode<MouseMotionTask> {
+   * @brief Nested class represents a keyboard focus node.
+   *
+   * The node of a shell view is followed by the node of the view which has the
+   * keyboard focus in it.
+   */
+  class KeyboardTask : public base::Binode<KeyboardTask> {
 
    public:
 
-    WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(MouseMotionTask);
-    MouseMotionTask() = delete;
+    WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(KeyboardTask);
+    KeyboardTask() = delete;
 
     /**
      * @brief Constructor
@@ -117,17 +122,17 @@ class WIZTK_EXPORT AbstractEventHandler : public base::Trackable {
      *
      * @note The parameter cannot be nullptr.
      */
-    explicit MouseMotionTask(AbstractEventHandler *event_handler)
+    explicit KeyboardTask(AbstractEventHandler *event_handler)
         : event_handler_(event_handler) {}
 
     /**
      * @brief Destructor
      */
-    ~MouseMotionTask() override = default;
+    ~KeyboardTask() override = default;
 
     inline AbstractEventHandler *event_handler() const { return event_handler_; }
 
-    static MouseMotionTask *Get(const AbstractEventHandler *event_handler);
+    static KeyboardTask *Get(const AbstractEventHandler *event_handler);
 
    private:
 
@@ -145,9 +150,12 @@ class WIZTK_EXPORT AbstractEventHandler : public base::Trackable {
    */
   ~AbstractEventHandler() override;
 
-  const String &GetName() const;
+  /**
+   * @brief The name of this object, compared by pointer
+   */
+  const Atom &GetName() const;
 
-  void SetName(const String &name);
+  void SetName(const Atom &name);
 
  protected:
 
@@ -177,6 +185,23 @@ class WIZTK_EXPORT AbstractEventHandler : public base::Trackable {
    */
   virtual void OnMouseUp(MouseEvent *event) = 0;
 
+  /**
+   * @brief Virtual callback when scrolling on this object
+   *
+   * The axis events in one pointer frame are delivered in one call. Accept the
+   * event to stop passing it to the outer objects. Does nothing by default.
+   */
+  virtual void OnMouseAxis(MouseEvent *event);
+
+  /**
+   * @brief Virtual callback when touch points change on this object
+   *
+   * Called once per touch frame with all points and the recognized gestures.
+   * Accept the event to stop passing it to the outer objects. Does nothing by
+   * default.
+   */
+  virtual void OnTouch(TouchEvent *event);
+
   /**
    * @brief Virtual callback when a keyboard key is prssed down on this object
    */
@@ -25,6 +25,20 @@ namespace gui {
 /**
  * @ingroup gui
  * @brief The base abstract layout class
+ *
+ * A layout arranges its children in 2 passes:
+ *
+ *   - Measure: OnMeasure() returns the size this layout wants from the sizes
+ *     of its children (see MeasureView()). The result is cached until this
+ *     layout is marked dirty.
+ *   - Arrange: OnLayout() places every child in the content area by
+ *     ArrangeView(), which commits the geometry of each child once.
+ *
+ * Adding or removing views, changing the size constraints or the layout policy
+ * of a child only marks this layout dirty by RequestLayout(). The dirty flag
+ * propagates up to the outermost layout which posts a LayoutMessage to the
+ * event loop, so any number of changes in one frame result in one layout pass
+ * before rendering.
  */
 WIZTK_EXPORT class AbstractLayout : public AbstractView {
 
@@ -34,18 +48,42 @@ WIZTK_EXPORT class AbstractLayout : public AbstractView {
 
   WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(AbstractLayout);
 
+  class LayoutMessage;
+
   AbstractLayout(const Padding &padding = Padding(5));
 
+  /**
+   * @brief Append a view
+   */
   void AddView(AbstractView *view);
 
+  /**
+   * @brief Insert a view at the given index
+   */
   void AddView(int index, AbstractView *view);
 
-  void AddView(int row, int column, AbstractView *view);
-
   void RemoveView(AbstractView *view);
 
+  /**
+   * @brief Mark this layout dirty and schedule a layout pass
+   *
+   * The layout pass runs once in the next iteration of the event loop, or
+   * immediately if there's no event loop in this thread.
+   */
+  void RequestLayout();
+
+  /**
+   * @brief Run the measure and arrange passes now if this layout is dirty
+   */
   void Layout();
 
+  bool IsLayoutDirty() const { return need_measure_ || need_arrange_; }
+
+  /**
+   * @brief Measure this layout if dirty and return the cached size
+   */
+  const Size &Measure();
+
  protected:
 
   virtual ~AbstractLayout();
@@ -82,15 +120,85 @@ WIZTK_EXPORT class AbstractLayout : public AbstractView {
 
   virtual void OnViewRemoved(AbstractView *view) = 0;
 
+  /**
+   * @brief The measure pass
+   * @return The size including padding
+   *
+   * By default this returns the preferred size.
+   */
+  virtual Size OnMeasure();
+
+  /**
+   * @brief The arrange pass
+   * @param left, top, right, bottom The content area (inside padding)
+   *        relative to this layout
+   */
   virtual void OnLayout(int left, int top, int right, int bottom) = 0;
 
+  /**
+   * @brief Get the size a child wants by its layout policy
+   *
+   * Returns the cached measured size for a nested layout.
+   */
+  static Size MeasureView(const AbstractView *view);
+
+  /**
+   * @brief Arrange the children again in the next layout pass without
+   * measuring, e.g. when the content scrolls
+   *
+   * Unlike RequestLayout() this does not mark the outer layouts dirty.
+   */
+  void RequestArrange();
+
+  /**
+   * @brief Commit the geometry of a child, relative to this layout
+   *
+   * A nested layout is arranged in the same pass.
+   */
+  void ArrangeView(AbstractView *view, int left, int top, int width, int height);
+
  private:
 
-  struct Private;
+  /**
+   * @brief Run OnLayout() in the current geometry
+   */
+  void Arrange();
+
+  /**
+   * @brief Post the layout message or layout immediately without event loop
+   */
+  void ScheduleLayout();
+
+  bool need_measure_ = true;
+
+  bool need_arrange_ = true;
+
+  Size measured_size_;
+
+  std::unique_ptr<LayoutMessage> layout_message_;
 
-  bool is_geometry_saved_;
+};
+
+/**
+ * @brief Nested class represents a pending layout pass in main loop.
+ */
+class AbstractLayout::LayoutMessage : public async::Message {
+
+ public:
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(LayoutMessage);
+  LayoutMessage() = delete;
+
+  explicit LayoutMessage(AbstractLayout *layout)
+      : layout_(layout) {}
+
+  ~LayoutMessage() final = default;
+
+  void Exec() final;
+
+ private:
 
-//  std::unique_ptr<Private> p_;
+  AbstractLayout *layout_ = nullptr;
 
 };
 
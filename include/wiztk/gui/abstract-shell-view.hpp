@@ -31,6 +31,7 @@ namespace wiztk {
 namespace gui {
 
 class Context;
+class Animator;
 
 /**
  * @ingroup gui
@@ -190,6 +191,24 @@ WIZTK_EXPORT class AbstractShellView : public AbstractEventHandler {
 
   AbstractShellView *GetParent() const;
 
+  /**
+   * @brief Set the view which receives the key events of this shell view
+   * @param view A view in this shell view, or nullptr to clear the focus
+   *
+   * The focus is cleared automatically when the view is destroyed.
+   */
+  void SetKeyboardFocus(AbstractView *view);
+
+  /**
+   * @brief Get the view which has the keyboard focus, or nullptr
+   */
+  AbstractView *GetKeyboardFocus() const;
+
+  /**
+   * @brief Get the animator driven by the frame callbacks of this shell view
+   */
+  Animator *GetAnimator() const;
+
   static const Margin kResizingMargin;
 
  protected:
@@ -281,14 +300,48 @@ WIZTK_EXPORT class AbstractShellView : public AbstractEventHandler {
 
   Surface *GetShellSurface() const;
 
+  /**
+   * @brief Update the hover path of the pointer from the given top view
+   *
+   * Only the views which the pointer entered or left since the last motion
+   * receive events.
+   *
+   * @see HoverPath
+   */
   void DispatchMouseEnterEvent(AbstractView *view, MouseEvent *event);
 
+  /**
+   * @brief Send leave events to all views hovered in this shell view
+   */
   void DispatchMouseLeaveEvent();
 
   void DispatchMouseDownEvent(MouseEvent *event);
 
   void DispatchMouseUpEvent(MouseEvent *event);
 
+  /**
+   * @brief Dispatch scrolling from the innermost view under the cursor to the
+   * outermost one, until a view accepts or rejects it
+   */
+  void DispatchMouseAxisEvent(MouseEvent *event);
+
+  /**
+   * @brief Dispatch a touch event to the deepest view under the origin of the
+   * touch gesture and then its parents, until a view accepts or rejects it
+   * @param view The top view which contains the origin
+   */
+  void DispatchTouchEvent(AbstractView *view, TouchEvent *event);
+
+  /**
+   * @brief Dispatch a key down event to the view which has the keyboard focus
+   */
+  void DispatchKeyDownEvent(KeyEvent *event);
+
+  /**
+   * @brief Dispatch a key up event to the view which has the keyboard focus
+   */
+  void DispatchKeyUpEvent(KeyEvent *event);
+
   void DropShadow(const Context &context);
 
   static void DispatchUpdate(AbstractView *view);
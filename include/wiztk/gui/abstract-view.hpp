@@ -23,6 +23,7 @@
 #include "wiztk/base/size.hpp"
 #include "wiztk/base/rect.hpp"
 #include "wiztk/base/thickness.hpp"
+#include "wiztk/base/delegate.hpp"
 #include <wiztk/base/deque.hpp>
 
 #include "wiztk/async/message.hpp"
@@ -30,7 +31,6 @@
 #include "wiztk/gui/anchor-group.hpp"
 
 #include <memory>
-#include <functional>
 
 namespace wiztk {
 namespace gui {
@@ -77,6 +77,8 @@ WIZTK_EXPORT class AbstractView : public AbstractEventHandler {
 
   friend class AbstractShellView;
   friend class AbstractLayout;
+  friend class HoverPath;
+  friend class Animator;
 
  public:
 
@@ -93,6 +95,7 @@ WIZTK_EXPORT class AbstractView : public AbstractEventHandler {
   // Internal nested classes:
   class Iterator;
   class ConstIterator;
+  class HitTestIndex;
 
   /**
    * @brief Bitwise enums represents geometry dirty flag in private data.
@@ -109,7 +112,7 @@ WIZTK_EXPORT class AbstractView : public AbstractEventHandler {
   /**
    * @brief A typedef of a function object used when destroying a view object.
    */
-  typedef std::function<void(AbstractView *obj)> DeleterType;
+  typedef base::Delegate<void(AbstractView *obj)> DeleterType;
 
  public:
 
@@ -389,6 +392,8 @@ WIZTK_EXPORT class AbstractView : public AbstractEventHandler {
    *     - If kAlignRight: put this view at the right side of target view
    *     - If kAlignBottom: put this view at the bottom side of target view
    * @param distance
+   *   The offset added to the edge of the target, e.g. a right or bottom
+   *   anchor to the parent needs a negative distance to stay inside it
    *
    * @note This method does not check if there's already anchors connect these 2
    * views.
@@ -413,6 +418,35 @@ WIZTK_EXPORT class AbstractView : public AbstractEventHandler {
    */
   virtual bool Contain(int x, int y) const;
 
+  /**
+   * @brief Returns the index of this view in the children of its parent
+   * @return The index, or -1 if this view has no parent
+   */
+  int GetIndex() const;
+
+  /**
+   * @brief Returns the first child which contains the given position
+   * @param x
+   * @param y
+   * @return A child view or nullptr
+   */
+  AbstractView *HitTest(int x, int y) const;
+
+  /**
+   * @brief Enable or disable the spatial index for hit testing children
+   *
+   * HitTest() scans all children by default. For a view which has thousands
+   * of children, enable this to look up a uniform grid over the child
+   * geometries instead. The grid is rebuilt on the next hit test after the
+   * children or their geometries change.
+   *
+   * @note The index assumes a child contains a position only inside its
+   * geometry.
+   */
+  void SetHitTestIndexEnabled(bool enabled);
+
+  bool IsHitTestIndexEnabled() const;
+
   /**
    * @brief Destroy and delete this object
    *
@@ -557,18 +591,6 @@ WIZTK_EXPORT class AbstractView : public AbstractEventHandler {
    */
   virtual void DispatchUpdate();
 
-  /**
-   * @brief Dispatch mouse enter event down to the target view
-   * @param event
-   * @return
-   *   - A sub view object
-   *   - nullptr if no sub view need to handle the mouse enter event
-   *
-   * By default this method check all sub views and return the one contains the
-   * cursor position. Sub class can override this.
-   */
-  virtual AbstractView *DispatchMouseEnterEvent(MouseEvent *event);
-
   /**
    * @brief Schedule change the geometry of this view
    * @param[in] validate
@@ -581,6 +603,11 @@ WIZTK_EXPORT class AbstractView : public AbstractEventHandler {
 
   void UntrackMouseMotion();
 
+  /**
+   * @brief Returns the child at the given index in O(1)
+   * @param index The index, a negative value counts from the back
+   * @return A child view or nullptr if the index is out of range
+   */
   AbstractView *GetChildAt(int index) const;
 
   /**
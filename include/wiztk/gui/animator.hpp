@@ -0,0 +1,183 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef WIZTK_GUI_ANIMATOR_HPP_
+#define WIZTK_GUI_ANIMATOR_HPP_
+
+#include "wiztk/base/macros.hpp"
+#include "wiztk/base/delegate.hpp"
+#include "wiztk/base/color.hpp"
+#include "wiztk/base/rect.hpp"
+
+#include <cstdint>
+#include <memory>
+
+namespace wiztk {
+namespace gui {
+
+class AbstractView;
+
+/**
+ * @ingroup gui
+ * @brief Animates float, color and rect values of views on the frame clock
+ *
+ * Each shell view has an Animator driven by the timestamp of the compositor
+ * frame callback, see AbstractShellView::GetAnimator(). An animation writes
+ * the interpolated value to a member of a view in Step(), then the view is
+ * updated once no matter how many of its values changed. Views without
+ * running animations are not touched.
+ *
+ * The value is computed from the frame time rather than added per frame,
+ * so the speed of an animation does not depend on the frame rate. The first
+ * Step() after an animation is added sets its start time.
+ *
+ * The animations of each value type are kept in a contiguous array and
+ * stepped in one pass. An animation is removed when it finishes, is
+ * stopped, or the view is destroyed.
+ */
+class WIZTK_EXPORT Animator {
+
+ public:
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(Animator);
+
+  template<typename R, typename ... P> using DelegateRef = typename base::DelegateRef<R, P...>;
+  template<typename R, typename ... P> using Delegate = typename base::Delegate<R, P...>;
+
+  using ColorF = base::ColorF;
+  using RectF = base::RectF;
+
+  /**
+   * @brief Easing curves
+   */
+  enum Easing {
+    kEasingLinear,
+    kEasingInQuad,
+    kEasingOutQuad,
+    kEasingInOutQuad,
+    kEasingInCubic,
+    kEasingOutCubic,
+    kEasingInOutCubic
+  };
+
+  /**
+   * @brief Repeat an animation until it's stopped
+   */
+  static const int kRepeatForever = -1;
+
+  /**
+   * @brief Identifies a running animation
+   *
+   * A handle turns invalid when the animation finishes or is stopped, it's
+   * safe to use an invalid handle.
+   */
+  struct Handle {
+
+    uint32_t slot = 0;
+
+    uint32_t serial = 0;
+
+    explicit operator bool() const { return 0 != serial; }
+
+  };
+
+  Animator();
+
+  ~Animator();
+
+  /**
+   * @brief Animate a float value
+   * @param view The view which owns the value, and is updated when it changes
+   * @param value The address of the value, it's set to 'from' at once
+   * @param from The start value
+   * @param to The end value
+   * @param duration The duration of one cycle in milliseconds
+   * @param easing The easing curve
+   * @param repeat The number of extra cycles, or kRepeatForever
+   */
+  Handle Animate(AbstractView *view, float *value, float from, float to,
+                 uint32_t duration, Easing easing = kEasingLinear, int repeat = 0);
+
+  /**
+   * @brief Animate a color value, see the float version
+   */
+  Handle Animate(AbstractView *view, ColorF *value, const ColorF &from, const ColorF &to,
+                 uint32_t duration, Easing easing = kEasingLinear, int repeat = 0);
+
+  /**
+   * @brief Animate a rect value, see the float version
+   */
+  Handle Animate(AbstractView *view, RectF *value, const RectF &from, const RectF &to,
+                 uint32_t duration, Easing easing = kEasingLinear, int repeat = 0);
+
+  /**
+   * @brief Stop an animation and keep the current value
+   */
+  void Stop(Handle &handle);
+
+  /**
+   * @brief Stop all animations of a view
+   */
+  void Stop(const AbstractView *view);
+
+  bool IsRunning(const Handle &handle) const;
+
+  /**
+   * @brief The number of running animations
+   */
+  int GetCount() const;
+
+  /**
+   * @brief Advance all animations to the given frame time
+   * @param time The timestamp of the frame in milliseconds
+   */
+  void Step(uint32_t time);
+
+  /**
+   * @brief A delegate called when the animator needs a frame callback
+   *
+   * It's called when the first animation is added, and after each Step()
+   * while there're animations running.
+   */
+  DelegateRef<void()> frame_request() { return frame_request_; }
+
+  /**
+   * @brief Map the linear progress in [0, 1] with the easing curve
+   */
+  static float Ease(Easing easing, float progress);
+
+  /**
+   * @brief Stop the animations of a view in all animators, e.g. when the view
+   * is destroyed or moved to another shell view
+   */
+  static void Forget(const AbstractView *view);
+
+ private:
+
+  struct Private;
+
+  void RequestFrame();
+
+  std::unique_ptr<Private> p_;
+
+  Delegate<void()> frame_request_;
+
+};
+
+} // namespace gui
+} // namespace wiztk
+
+#endif // WIZTK_GUI_ANIMATOR_HPP_
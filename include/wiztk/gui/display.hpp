@@ -19,6 +19,7 @@
 
 #include "wiztk/base/types.hpp"
 #include "wiztk/base/sigcxx.hpp"
+#include "wiztk/base/atom.hpp"
 
 #include <set>
 #include <memory>
@@ -131,7 +132,7 @@ class WIZTK_EXPORT Display {
   */
 struct Display::Global {
   uint32_t id;
-  std::string interface;
+  base::Atom interface;
   uint32_t version;
 };
 
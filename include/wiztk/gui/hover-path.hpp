@@ -0,0 +1,123 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef WIZTK_GUI_HOVER_PATH_HPP_
+#define WIZTK_GUI_HOVER_PATH_HPP_
+
+#include "wiztk/base/macros.hpp"
+
+#include <vector>
+
+namespace wiztk {
+namespace gui {
+
+class AbstractView;
+class AbstractShellView;
+class MouseEvent;
+
+/**
+ * @ingroup gui
+ * @brief The views under the pointer of a seat, from the root to the leaf
+ *
+ * Each seat keeps one HoverPath in its MouseEvent. Update() hit tests from
+ * the root view down to the deepest view containing the pointer, compares
+ * the result with the path of the last frame and only sends OnMouseLeave()
+ * to the views no longer hovered (deepest first) and OnMouseEnter() to the
+ * new ones. The views are kept in a flat array reused across frames, so
+ * moving the pointer does not allocate once the deepest path was seen, and
+ * no list is relinked.
+ *
+ * A view which ignores the enter event stays in the path but does not
+ * receive mouse events, a view which rejects it stops the path.
+ *
+ * A destroyed view is removed from all paths together with its descendants,
+ * without any callback.
+ */
+class WIZTK_EXPORT HoverPath {
+
+ public:
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(HoverPath);
+
+  struct Entry {
+
+    AbstractView *view;
+
+    /** False if the view ignored the enter event */
+    bool accepted;
+
+  };
+
+  HoverPath();
+
+  ~HoverPath();
+
+  /**
+   * @brief Update the path to the views under the given window position
+   * @param root The top view, the path is cleared if it's nullptr or does not
+   * contain the position
+   * @param x The x coordinate in window
+   * @param y The y coordinate in window
+   * @param event The mouse event sent to OnMouseEnter()
+   */
+  void Update(AbstractView *root, int x, int y, MouseEvent *event);
+
+  /**
+   * @brief Send OnMouseLeave() to all accepted views and clear the path
+   */
+  void Clear();
+
+  /**
+   * @brief The number of views in the path, including the ignored ones
+   */
+  int GetDepth() const { return static_cast<int>(entries_.size()); }
+
+  const Entry &GetEntry(int index) const { return entries_[index]; }
+
+  /**
+   * @brief The deepest view which accepted the enter event, or nullptr
+   */
+  AbstractView *GetLeaf() const;
+
+  bool IsEmpty() const { return entries_.empty(); }
+
+  /**
+   * @brief Clear every path rooted in the given shell view
+   */
+  static void Clear(const AbstractShellView *shell_view);
+
+  /**
+   * @brief Remove a view and its descendants from all paths, used when the
+   * view is destroyed
+   */
+  static void Forget(const AbstractView *view);
+
+ private:
+
+  /**
+   * @brief Pop the entries after the given depth, send OnMouseLeave() if
+   * callback is true
+   */
+  void Truncate(size_t depth, bool callback);
+
+  std::vector<Entry> entries_;
+
+};
+
+} // namespace gui
+} // namespace wiztk
+
+#endif // WIZTK_GUI_HOVER_PATH_HPP_
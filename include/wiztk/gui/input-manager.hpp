@@ -24,6 +24,8 @@
 namespace wiztk {
 namespace gui {
 
+class Surface;
+
 /**
  * @ingroup gui
  * @brief Singleton input manager controlled by Display.
@@ -45,6 +47,7 @@ namespace gui {
 class WIZTK_EXPORT InputManager {
 
   friend class Display;
+  friend class Surface;
 
  public:
 
@@ -64,6 +67,11 @@ class WIZTK_EXPORT InputManager {
 
   void Clear();
 
+  /**
+   * @brief Tell all inputs the given surface is being destroyed
+   */
+  void ResetSurface(const Surface *surface);
+
   InputPrivateDeque deque_;
 
 };
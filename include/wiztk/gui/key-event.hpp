@@ -53,6 +53,9 @@ class KeyEvent : public InputEvent {
         mods_latched_(0),
         mods_locked_(0),
         group_(0),
+        keysym_(0),
+        text_{0},
+        repeat_(false),
         surface_(nullptr) {
   }
 
@@ -76,6 +79,47 @@ class KeyEvent : public InputEvent {
     return mods_depressed_;
   }
 
+  uint32_t mods_latched() const {
+    return mods_latched_;
+  }
+
+  uint32_t mods_locked() const {
+    return mods_locked_;
+  }
+
+  uint32_t group() const {
+    return group_;
+  }
+
+  /**
+   * @brief The XKB keysym of the key with the current modifiers, 0 if there's
+   * no keymap
+   */
+  uint32_t keysym() const {
+    return keysym_;
+  }
+
+  /**
+   * @brief The UTF-8 text the key produces, an empty string if none
+   */
+  const char *text() const {
+    return text_;
+  }
+
+  /**
+   * @brief Returns true if this is a repeated key down event
+   */
+  bool is_repeat() const {
+    return repeat_;
+  }
+
+  /**
+   * @brief The surface which has the keyboard focus
+   */
+  Surface *surface() const {
+    return surface_;
+  }
+
  private:
 
   ~KeyEvent() {}
@@ -90,6 +134,10 @@ class KeyEvent : public InputEvent {
   uint32_t mods_locked_;
   uint32_t group_;
 
+  uint32_t keysym_;
+  char text_[16];
+  bool repeat_;
+
   Surface *surface_;
 };
 
@@ -0,0 +1,98 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef WIZTK_GUI_KEY_REPEATER_HPP_
+#define WIZTK_GUI_KEY_REPEATER_HPP_
+
+#include "timer.hpp"
+
+#include "../base/macros.hpp"
+#include "../base/sigcxx.hpp"
+
+#include <cstdint>
+
+namespace wiztk {
+namespace gui {
+
+/**
+ * @ingroup gui
+ * @brief Repeats the held key with the rate and delay from the compositor
+ *
+ * The first repeat comes after the delay, then one every 1/rate second. Only
+ * the last started key repeats. The timer runs in the event loop of the
+ * thread which calls Start(), sub classes deliver the repeats in OnRepeat().
+ */
+class WIZTK_EXPORT KeyRepeater : public base::Trackable {
+
+ public:
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(KeyRepeater);
+
+  KeyRepeater();
+
+  ~KeyRepeater() override = default;
+
+  /**
+   * @brief Set the repeat info
+   * @param rate Characters per second, 0 disables repeating
+   * @param delay Delay in milliseconds before repeating
+   */
+  void SetInfo(int32_t rate, int32_t delay);
+
+  /**
+   * @brief Start repeating the key pressed at the given time
+   */
+  void Start(uint32_t key, uint32_t time);
+
+  void Stop();
+
+  bool IsActive() const { return timer_.IsArmed(); }
+
+  /**
+   * @brief The key being repeated, 0 if not active
+   */
+  uint32_t GetKey() const { return key_; }
+
+ protected:
+
+  /**
+   * @brief Deliver a repeat
+   * @param key The repeated key
+   * @param time The time of this repeat in milliseconds, counted from the
+   * time of the press with the delay and interval
+   */
+  virtual void OnRepeat(uint32_t key, uint32_t time) = 0;
+
+ private:
+
+  void OnTimeout(__SLOT__);
+
+  Timer timer_;
+
+  uint32_t key_ = 0;
+
+  uint32_t time_ = 0;
+
+  // The defaults used by most compositors:
+  int32_t rate_ = 25;
+  int32_t delay_ = 600;
+
+};
+
+} // namespace gui
+} // namespace wiztk
+
+#endif // WIZTK_GUI_KEY_REPEATER_HPP_
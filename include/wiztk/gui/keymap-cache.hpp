@@ -0,0 +1,106 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef WIZTK_GUI_KEYMAP_CACHE_HPP_
+#define WIZTK_GUI_KEYMAP_CACHE_HPP_
+
+#include "../base/macros.hpp"
+
+#include <xkbcommon/xkbcommon.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace wiztk {
+namespace gui {
+
+/**
+ * @ingroup gui
+ * @brief Compiled keymaps shared by all seats
+ *
+ * Compositors send the same keymap text to every seat and again when a seat
+ * reconnects, the entries are looked up by the hash of the text and compared
+ * before use. The least recently used entry is dropped when the cache is full.
+ *
+ * The cache holds a reference of each keymap, a keymap dropped from the cache
+ * stays valid until the last reference elsewhere is released.
+ */
+class WIZTK_EXPORT KeymapCache {
+
+ public:
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(KeymapCache);
+
+  static const size_t kMaxEntries = 4;
+
+  KeymapCache() = default;
+
+  ~KeymapCache();
+
+  /**
+   * @brief Returns a new reference of the compiled keymap, or nullptr
+   */
+  struct xkb_keymap *Find(uint64_t hash,
+                          const char *string,
+                          size_t length,
+                          enum xkb_keymap_format format,
+                          enum xkb_keymap_compile_flags flags);
+
+  /**
+   * @brief Add a compiled keymap as the most recently used one
+   *
+   * The cache takes a new reference, the caller keeps its own.
+   */
+  void Add(uint64_t hash,
+           const char *string,
+           size_t length,
+           enum xkb_keymap_format format,
+           enum xkb_keymap_compile_flags flags,
+           struct xkb_keymap *xkb_keymap);
+
+  size_t GetCount() const { return entries_.size(); }
+
+  /**
+   * @brief The hash of a keymap text
+   */
+  static uint64_t Hash(const char *string, size_t length);
+
+  /**
+   * @brief The cache shared by all seats
+   */
+  static KeymapCache &Get();
+
+ private:
+
+  struct Entry {
+    uint64_t hash;
+    enum xkb_keymap_format format;
+    enum xkb_keymap_compile_flags flags;
+    std::string text;
+    struct xkb_keymap *xkb_keymap;
+  };
+
+  /** From the most to the least recently used */
+  std::vector<Entry> entries_;
+
+};
+
+} // namespace gui
+} // namespace wiztk
+
+#endif // WIZTK_GUI_KEYMAP_CACHE_HPP_
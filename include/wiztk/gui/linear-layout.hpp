@@ -26,6 +26,11 @@ namespace gui {
 /**
  * @ingroup gui
  * @brief Layout to arrange children in a single row or column.
+ *
+ * Children get the size measured by their layout policy along the orientation.
+ * The remaining space is shared by the children with kLayoutExpandable or
+ * kLayoutMaximal policy, and when there's not enough space the children
+ * (except kLayoutFixed) shrink towards their minimal sizes.
  */
 WIZTK_EXPORT class LinearLayout final : public AbstractLayout {
 
@@ -37,6 +42,17 @@ WIZTK_EXPORT class LinearLayout final : public AbstractLayout {
                const Padding &padding = Padding(5),
                int space = 5);
 
+  void SetOrientation(Orientation orientation);
+
+  Orientation GetOrientation() const { return orientation_; }
+
+  /**
+   * @brief Set the space between children
+   */
+  void SetSpace(int space);
+
+  int GetSpace() const { return space_; }
+
  protected:
 
   virtual ~LinearLayout();
@@ -45,6 +61,8 @@ WIZTK_EXPORT class LinearLayout final : public AbstractLayout {
 
   virtual void OnViewRemoved(AbstractView *view);
 
+  virtual Size OnMeasure() final;
+
   virtual void OnLayout(int left, int top, int right, int bottom) final;
 
  private:
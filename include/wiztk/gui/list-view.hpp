@@ -0,0 +1,183 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef WIZTK_GUI_LIST_VIEW_HPP_
+#define WIZTK_GUI_LIST_VIEW_HPP_
+
+#include "abstract-layout.hpp"
+
+namespace wiztk {
+namespace gui {
+
+/**
+ * @ingroup gui
+ * @brief A vertical list which keeps only the visible rows alive
+ *
+ * A ListView gets the number of items, the item heights and the row views from
+ * an Adapter. Only the rows in the viewport plus a few overscan rows on each
+ * side are children of this view. When a row scrolls out it is removed and
+ * kept in a pool by its item type, then bound to another item by the adapter
+ * when one scrolls in, so the number of views and the cost of one frame do
+ * not depend on the number of items.
+ *
+ * Scrolling only marks this view to be arranged in the next layout pass, see
+ * AbstractLayout::RequestArrange().
+ */
+class WIZTK_EXPORT ListView : public AbstractLayout {
+
+ public:
+
+  class Adapter;
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(ListView);
+
+  /**
+   * @brief Constructor
+   * @param adapter The adapter which is not owned by this view, can be nullptr
+   */
+  explicit ListView(Adapter *adapter = nullptr);
+
+  /**
+   * @brief Set the adapter, all row views of the last adapter are destroyed
+   */
+  void SetAdapter(Adapter *adapter);
+
+  Adapter *GetAdapter() const;
+
+  /**
+   * @brief Call this when the items in the adapter changed
+   *
+   * All live rows are recycled and bound again in the next layout pass.
+   */
+  void NotifyDataChanged();
+
+  /**
+   * @brief Set the number of rows kept alive out of each side of the viewport
+   */
+  void SetOverscan(int count);
+
+  int GetOverscan() const;
+
+  /**
+   * @brief Scroll to the given offset in pixels from the top of the content
+   *
+   * The offset is clamped to the content in the next layout pass.
+   */
+  void ScrollTo(int offset);
+
+  void ScrollBy(int delta);
+
+  int GetScrollOffset() const;
+
+  /**
+   * @brief The total height of all items
+   */
+  int GetContentHeight() const;
+
+  /**
+   * @brief Returns the row view bound to the given item, or nullptr if the
+   * item is not alive
+   */
+  AbstractView *GetItemView(int index) const;
+
+  /**
+   * @brief The number of live rows
+   */
+  int GetLiveCount() const;
+
+  /**
+   * @brief The number of row views kept in the recycle pool
+   */
+  int GetRecycledCount() const;
+
+ protected:
+
+  ~ListView() override;
+
+  void OnViewAdded(AbstractView *view) final;
+
+  void OnViewRemoved(AbstractView *view) final;
+
+  void OnLayout(int left, int top, int right, int bottom) final;
+
+  void OnDraw(const Context &context) override;
+
+  /**
+   * @brief Scroll with the vertical axis, the event is passed to the outer
+   * views when the list is already at the top or bottom
+   */
+  void OnMouseAxis(MouseEvent *event) override;
+
+ private:
+
+  struct Private;
+
+  // Rows are managed by this view only:
+  using AbstractLayout::AddView;
+  using AbstractLayout::RemoveView;
+
+  std::unique_ptr<Private> p_;
+
+};
+
+/**
+ * @ingroup gui
+ * @brief The interface provides items to a ListView
+ */
+class WIZTK_EXPORT ListView::Adapter {
+
+ public:
+
+  Adapter() = default;
+
+  virtual ~Adapter() = default;
+
+  virtual int GetItemCount() const = 0;
+
+  /**
+   * @brief The height of the item at the given index
+   */
+  virtual int GetItemHeight(int index) const = 0;
+
+  /**
+   * @brief Returns true if all items have the height of the first one
+   *
+   * A ListView does not need to keep the offsets of items in this case and
+   * uses constant memory for any number of items.
+   */
+  virtual bool HasFixedItemHeight() const { return false; }
+
+  /**
+   * @brief Row views are recycled by type
+   */
+  virtual int GetItemType(int /*index*/) const { return 0; }
+
+  /**
+   * @brief Create a new row view for the given type
+   */
+  virtual AbstractView *CreateItemView(int type) = 0;
+
+  /**
+   * @brief Show the item at the given index in a new or recycled row view
+   */
+  virtual void BindItemView(AbstractView *view, int index) = 0;
+
+};
+
+} // namespace gui
+} // namespace wiztk
+
+#endif // WIZTK_GUI_LIST_VIEW_HPP_
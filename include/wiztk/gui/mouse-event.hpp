@@ -30,6 +30,7 @@ namespace wiztk {
 namespace gui {
 
 class Surface;
+class HoverPath;
 
 enum MouseButton {
   kMouseButtonLeft = BTN_LEFT,
@@ -42,9 +43,27 @@ enum MouseButtonState {
   kMouseButtonPressed = WL_POINTER_BUTTON_STATE_PRESSED /* 1 */
 };
 
+enum MouseAxis {
+  kMouseAxisVertical = WL_POINTER_AXIS_VERTICAL_SCROLL, /* 0 */
+  kMouseAxisHorizontal = WL_POINTER_AXIS_HORIZONTAL_SCROLL /* 1 */
+};
+
+enum MouseAxisSource {
+  kMouseAxisSourceWheel = WL_POINTER_AXIS_SOURCE_WHEEL,  /* 0 */
+  kMouseAxisSourceFinger = WL_POINTER_AXIS_SOURCE_FINGER, /* 1 */
+  kMouseAxisSourceContinuous = WL_POINTER_AXIS_SOURCE_CONTINUOUS, /* 2 */
+  kMouseAxisSourceWheelTilt = WL_POINTER_AXIS_SOURCE_WHEEL_TILT, /* 3 */
+
+  /**
+   * @brief Generated by the client after a finger scroll stops
+   */
+  kMouseAxisSourceKinetic = 0x100
+};
+
 WIZTK_EXPORT class MouseEvent : public InputEvent {
 
   friend class Input;
+  friend class AbstractShellView;
 
   MouseEvent() = delete;
   MouseEvent(const MouseEvent &orig) = delete;
@@ -66,8 +85,36 @@ WIZTK_EXPORT class MouseEvent : public InputEvent {
 
   uint32_t GetState() const;
 
+  /**
+   * @brief The last axis changed in this event
+   */
   uint32_t GetAxis() const;
 
+  /**
+   * @brief The scroll distance on the given axis in surface coordinates
+   *
+   * This is the sum of all axis events coalesced into this event.
+   */
+  double GetAxisValue(MouseAxis axis) const;
+
+  /**
+   * @brief The number of wheel steps on the given axis, 0 if the source is not
+   * a wheel
+   */
+  int GetAxisDiscrete(MouseAxis axis) const;
+
+  MouseAxisSource GetAxisSource() const;
+
+  /**
+   * @brief Returns true if the scroll on the given axis stopped in this event
+   */
+  bool IsAxisStopped(MouseAxis axis) const;
+
+  /**
+   * @brief The views hovered by this pointer, from the root to the leaf
+   */
+  const HoverPath &GetHoverPath() const;
+
  private:
 
   struct Private;
@@ -0,0 +1,238 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef WIZTK_GUI_POINTER_DISPATCHER_HPP_
+#define WIZTK_GUI_POINTER_DISPATCHER_HPP_
+
+#include "mouse-event.hpp"
+
+#include "../base/point.hpp"
+#include "../base/sigcxx.hpp"
+
+#include <cstdint>
+#include <memory>
+
+namespace wiztk {
+namespace gui {
+
+class Surface;
+
+/**
+ * @ingroup gui
+ * @brief Pointer events received since the last wl_pointer.frame
+ */
+struct WIZTK_EXPORT PointerFrame {
+
+  enum Mask {
+    kEnter = 0x1 << 0,
+    kLeave = 0x1 << 1,
+    kMotion = 0x1 << 2,
+    kButton = 0x1 << 3,
+    kAxis = 0x1 << 4,
+    kAxisSource = 0x1 << 5,
+    kAxisStop = 0x1 << 6,
+    kAxisDiscrete = 0x1 << 7
+  };
+
+  static const int kMaxButtons = 8;
+
+  struct Button {
+    uint32_t serial;
+    uint32_t time;
+    uint32_t button;
+    uint32_t state;
+  };
+
+  uint32_t mask = 0;
+
+  Surface *enter_surface = nullptr;
+  uint32_t enter_serial = 0;
+
+  Surface *leave_surface = nullptr;
+  uint32_t leave_serial = 0;
+
+  uint32_t time = 0;
+  base::Point2D surface_xy;
+
+  Button buttons[kMaxButtons];
+  int button_count = 0;
+
+  uint32_t axis = 0;
+  uint32_t axis_time = 0;
+  double axis_value[2] = {0.0, 0.0};
+  int axis_discrete[2] = {0, 0};
+  MouseAxisSource axis_source = kMouseAxisSourceWheel;
+  bool axis_stop[2] = {false, false};
+
+};
+
+/**
+ * @ingroup gui
+ * @brief The scrolling of one or more pointer frames delivered at once
+ */
+struct WIZTK_EXPORT PointerAxis {
+
+  /**
+   * @brief The last axis changed
+   */
+  uint32_t axis = 0;
+
+  MouseAxisSource source = kMouseAxisSourceWheel;
+
+  /** Indexed by MouseAxis */
+  double value[2] = {0.0, 0.0};
+  int discrete[2] = {0, 0};
+  bool stop[2] = {false, false};
+
+};
+
+/**
+ * @ingroup gui
+ * @brief Continues a finger scroll with exponentially decaying velocity
+ *
+ * Track() samples the velocity from the frames of finger scrolling, Start()
+ * checks if the finger lifted fast enough, then each Step() returns the
+ * distance scrolled in the elapsed time until the velocity drops under
+ * kMinVelocity. It does not read any clock.
+ */
+class WIZTK_EXPORT KineticScroll {
+
+ public:
+
+  /**
+   * @brief The time constant of the exponential decay in milliseconds
+   */
+  static const double kTimeConstant;
+
+  /**
+   * @brief Velocities under this (pixels per millisecond) stop scrolling
+   */
+  static const double kMinVelocity;
+
+  KineticScroll() = default;
+
+  ~KineticScroll() = default;
+
+  /**
+   * @brief Sample the velocity from a frame of finger scrolling
+   * @param time The time of the frame in milliseconds
+   * @param value The distance scrolled in this frame on each axis
+   */
+  void Track(uint32_t time, const double value[2]);
+
+  /**
+   * @brief The finger lifted at the given time
+   * @return true if the last samples are fast enough to keep scrolling
+   */
+  bool Start(uint32_t time);
+
+  /**
+   * @brief Decay the velocity over the elapsed time
+   * @param elapsed Milliseconds since the last step or Start()
+   * @param value Output, the distance scrolled on each axis
+   * @return true if the scroll stops after this step
+   */
+  bool Step(double elapsed, double value[2]);
+
+  void Reset();
+
+  /**
+   * @brief Pixels per millisecond on the given axis
+   */
+  double GetVelocity(MouseAxis axis) const { return velocity_[axis]; }
+
+ private:
+
+  double velocity_[2] = {0.0, 0.0};
+
+  uint32_t last_time_ = 0;
+
+};
+
+/**
+ * @ingroup gui
+ * @brief Dispatches pointer frames in order and coalesces motion and
+ * scrolling
+ *
+ * Motion and scrolling are deferred to a message posted to the current event
+ * loop, so all frames read in one loop iteration cause at most one motion and
+ * one axis dispatch, and a high-rate mouse doesn't cause more hit tests than
+ * frames are rendered. Enter, leave, buttons and axis stops deliver the
+ * deferred events first to keep the order. A finger scroll is continued with
+ * KineticScroll on a Timer after it stops.
+ *
+ * This class knows nothing about Wayland, sub classes deliver the events in
+ * the virtual methods.
+ */
+class WIZTK_EXPORT PointerDispatcher : public base::Trackable {
+
+ public:
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(PointerDispatcher);
+
+  PointerDispatcher();
+
+  ~PointerDispatcher() override;
+
+  /**
+   * @brief Dispatch the events of a frame, or defer the motion and scrolling
+   */
+  void Commit(const PointerFrame &frame);
+
+  /**
+   * @brief Dispatch the deferred motion and scrolling now
+   */
+  void Flush();
+
+  void StopKineticScroll();
+
+  bool IsKineticScrolling() const;
+
+ protected:
+
+  virtual void OnLeave(uint32_t serial, Surface *surface) = 0;
+
+  virtual void OnEnter(uint32_t serial, Surface *surface, const base::Point2D &surface_xy) = 0;
+
+  /**
+   * @brief The last motion of the coalesced frames
+   */
+  virtual void OnMotion(uint32_t time, const base::Point2D &surface_xy) = 0;
+
+  virtual void OnButton(const PointerFrame::Button &button) = 0;
+
+  /**
+   * @brief The sum of the scrolling of the coalesced frames, or a step of
+   * kinetic scrolling
+   */
+  virtual void OnAxis(const PointerAxis &axis) = 0;
+
+ private:
+
+  struct Private;
+
+  void Schedule();
+
+  void OnKineticTimeout(__SLOT__);
+
+  std::unique_ptr<Private> p_;
+
+};
+
+} // namespace gui
+} // namespace wiztk
+
+#endif // WIZTK_GUI_POINTER_DISPATCHER_HPP_
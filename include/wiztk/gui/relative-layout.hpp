@@ -22,6 +22,14 @@
 namespace wiztk {
 namespace gui {
 
+/**
+ * @ingroup gui
+ * @brief A layout places children by their anchors
+ *
+ * In each layout pass the anchors of all visible children are compiled into
+ * edge equations on the horizontal and vertical axes, solved in one pass and
+ * the geometry of each child is committed once.
+ */
 WIZTK_EXPORT class RelativeLayout final : public AbstractLayout {
 
  public:
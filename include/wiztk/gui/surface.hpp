@@ -21,6 +21,7 @@
 #include "wiztk/base/thickness.hpp"
 #include "wiztk/base/point.hpp"
 #include "wiztk/base/deque.hpp"
+#include "wiztk/base/memory/arena.hpp"
 
 #include "wiztk/gui/abstract-view.hpp"
 #include "wiztk/gui/queued-task.hpp"
@@ -123,6 +124,23 @@ class WIZTK_EXPORT Surface : public base::Trackable {
 
   static int CountShellSurfaces() { return kShellSurfaceCount; }
 
+  /**
+   * @brief The arena for transient objects used to render a frame
+   *
+   * The main loop resets the arena after all surfaces are rendered and
+   * committed, objects created in it must not be kept out of the rendering
+   * code.
+   */
+  static base::memory::Arena *GetFrameArena() { return &kFrameArena; }
+
+  /**
+   * @brief The number of heap allocations in rendering and committing the
+   * last frame
+   *
+   * Always 0 unless built with the COUNT_ALLOCATIONS option.
+   */
+  static size_t GetFrameAllocationCount() { return kFrameAllocationCount; }
+
   ~Surface() override;
 
   /**
@@ -303,6 +321,10 @@ class WIZTK_EXPORT Surface : public base::Trackable {
 
   static base::Deque<CommitTask> kCommitTaskDeque;
 
+  static base::memory::Arena kFrameArena;
+
+  static size_t kFrameAllocationCount;
+
   std::unique_ptr<Private> p_;
 
 };
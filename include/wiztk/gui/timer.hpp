@@ -26,6 +26,9 @@ namespace gui {
 
 /**
  * @brief A timer emit signal in main thread
+ *
+ * The timer fd is watched by the event loop of the thread which calls Start(),
+ * the timeout signal is emitted in that loop.
  */
 class Timer {
 
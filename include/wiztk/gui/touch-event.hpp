@@ -19,10 +19,142 @@
 
 #include "input-event.hpp"
 
+#include "../base/point.hpp"
+
+#include <cstdint>
+
 namespace wiztk {
 namespace gui {
 
-class TouchEvent : public InputEvent {
+class Surface;
+
+enum TouchState {
+  kTouchDown,
+  kTouchMotion,
+  kTouchUp,
+
+  /**
+   * @brief The point did not change in this frame
+   */
+  kTouchStationary
+};
+
+/**
+ * @ingroup gui
+ * @brief A touch point in a frame
+ */
+struct WIZTK_EXPORT TouchPoint {
+
+  int32_t id = 0;
+
+  TouchState state = kTouchDown;
+
+  uint32_t time = 0;
+
+  /**
+   * @brief The position in surface coordinates
+   */
+  base::Point2D surface_xy;
+
+  /**
+   * @brief The position in the last frame, the same as surface_xy if the
+   * point went down in this frame
+   */
+  base::Point2D last_surface_xy;
+
+};
+
+/**
+ * @ingroup gui
+ * @brief Recognizes pan and pinch from the touch points of each frame
+ *
+ * Only the points which exist in both the last and this frame are measured,
+ * so adding or lifting a finger does not make the centroid or the spread
+ * jump. Each update is O(points) and does not allocate.
+ *
+ * A pan starts when the centroid moves further than the slop, a pinch when
+ * there're at least 2 points and their mean distance to the centroid changes
+ * more than the slop. Both end when all points are up.
+ */
+class WIZTK_EXPORT TouchGesture {
+
+ public:
+
+  /**
+   * @brief The distance in pixels to move before a gesture is recognized
+   */
+  static const double kSlop;
+
+  TouchGesture() = default;
+
+  ~TouchGesture() = default;
+
+  void Update(const TouchPoint *points, int count);
+
+  void Reset();
+
+  bool IsPanning() const { return panning_; }
+
+  bool IsPinching() const { return pinching_; }
+
+  /**
+   * @brief The centroid of the points down in surface coordinates
+   */
+  const base::Point2D &GetCentroid() const { return centroid_; }
+
+  /**
+   * @brief The movement of the centroid in this frame
+   */
+  const base::Point2D &GetPanDelta() const { return pan_delta_; }
+
+  /**
+   * @brief The movement of the centroid since the first point went down
+   */
+  const base::Point2D &GetPan() const { return pan_; }
+
+  /**
+   * @brief The change of the scale in this frame, 1.0 if not pinching
+   */
+  double GetScaleDelta() const { return scale_delta_; }
+
+  /**
+   * @brief The scale since the pinch was recognized
+   */
+  double GetScale() const { return scale_; }
+
+ private:
+
+  bool panning_ = false;
+
+  bool pinching_ = false;
+
+  base::Point2D centroid_;
+
+  base::Point2D pan_delta_;
+
+  base::Point2D pan_;
+
+  double scale_delta_ = 1.0;
+
+  double scale_ = 1.0;
+
+  /**
+   * @brief The accumulated relative change of the spread before a pinch is
+   * recognized
+   */
+  double spread_change_ = 0.0;
+
+};
+
+/**
+ * @ingroup gui
+ * @brief Touch event delivered once per wl_touch.frame
+ *
+ * A TouchEvent contains all points touching the surface, the points changed
+ * in this frame have the state kTouchDown, kTouchMotion or kTouchUp. The up
+ * points are removed after the frame.
+ */
+class WIZTK_EXPORT TouchEvent : public InputEvent {
 
   friend class Input;
 
@@ -32,14 +164,73 @@ class TouchEvent : public InputEvent {
 
  public:
 
+  /**
+   * @brief The max number of points tracked at the same time
+   */
+  static const int kMaxPoints = 10;
+
   inline TouchEvent(Input *input)
       : InputEvent(input) {
   }
 
+  Surface *GetSurface() const { return surface_; }
+
+  uint32_t GetSerial() const { return serial_; }
+
+  int GetPointCount() const { return count_; }
+
+  const TouchPoint &GetPoint(int index) const { return points_[index]; }
+
+  /**
+   * @brief Find a point by the touch id, returns nullptr if not found
+   */
+  const TouchPoint *FindPoint(int32_t id) const;
+
+  /**
+   * @brief The position where the first point of this gesture went down in
+   * surface coordinates
+   *
+   * Touch events are dispatched to the views under this position, so a
+   * gesture keeps going to the same view.
+   */
+  const base::Point2D &GetOriginXY() const { return origin_xy_; }
+
+  base::Point2D GetWindowOriginXY() const;
+
+  /**
+   * @brief Returns true if the compositor cancelled the touch sequence, the
+   * event contains all points which were down and no point is left after it
+   */
+  bool IsCancelled() const { return cancelled_; }
+
+  const TouchGesture &GetGesture() const { return gesture_; }
+
  private:
 
   ~TouchEvent() {}
 
+  int FindIndex(int32_t id) const;
+
+  /**
+   * @brief Remove the up points and reset the others to stationary after a
+   * frame is dispatched
+   */
+  void Advance();
+
+  Surface *surface_ = nullptr;
+
+  uint32_t serial_ = 0;
+
+  TouchPoint points_[kMaxPoints];
+
+  int count_ = 0;
+
+  base::Point2D origin_xy_;
+
+  bool cancelled_ = false;
+
+  TouchGesture gesture_;
+
 };
 
 } // namespace gui
@@ -14,63 +14,153 @@
  * limitations under the License.
  */
 
-#ifndef WIZTK_VIDEO_VIEW_HPP
-#define WIZTK_VIDEO_VIEW_HPP
+#ifndef WIZTK_GUI_VIDEO_VIEW_HPP_
+#define WIZTK_GUI_VIDEO_VIEW_HPP_
 
-#include "abstract-view.hpp"
+#include "wiztk/gui/abstract-view.hpp"
+
+#include <memory>
 
 namespace wiztk {
-namespace gui {
 
-class Surface;
+// Forward declarations
+namespace graphics {
+struct YUVFrame;
+}
+
+namespace device {
+namespace video {
+class Frame;
+}
+}
+
+namespace gui {
 
 /**
  * @ingroup gui
- * @brief A view with own surface to display video stream
+ * @brief A view displays video frames on its own sub surface
  *
- * @note This class is currently used for test only
+ * VideoView creates a desynchronized sub surface when it's drawn the first
+ * time, frames pushed to this view are converted directly into the shared
+ * memory buffers of this sub surface and committed without redrawing the
+ * window.
+ *
+ * The PushFrame() methods can be called in any thread, e.g. in the thread of a
+ * camera or decoder. A frame is converted in the calling thread, the buffer is
+ * attached and committed in the main loop. When frames come faster than the
+ * compositor releases buffers, the latest frame wins and the older ones are
+ * dropped.
+ *
+ * The size of the sub surface follows the size of frames, the first frames
+ * may be dropped while the buffers are (re)allocated in the main loop.
  */
-class VideoView final : public AbstractView {
+class WIZTK_EXPORT VideoView : public AbstractView {
 
  public:
 
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(VideoView);
+
+  /**
+   * @brief The number of shared memory buffers
+   */
+  static const int kBufferCount = 3;
+
+  /**
+   * @brief Frame statistics
+   *
+   * The latency is measured from the timestamp of a frame (CLOCK_MONOTONIC,
+   * in microseconds) to the frame callback of the commit showing it.
+   */
+  struct Statistics {
+
+    uint32_t pushed = 0;
+
+    uint32_t presented = 0;
+
+    uint32_t dropped = 0;
+
+    int64_t last_latency = 0;
+
+    int64_t average_latency = 0;
+
+    int64_t max_latency = 0;
+
+  };
+
   VideoView();
 
   VideoView(int width, int height);
 
-  virtual ~VideoView();
+  /**
+   * @brief Push a YUV frame, can be called in any thread
+   * @param frame A YUV frame in the formats supported by graphics::YUVConverter
+   * @param timestamp The capture time in microseconds (CLOCK_MONOTONIC), 0 for now
+   * @return false if the frame is dropped
+   */
+  bool PushFrame(const graphics::YUVFrame &frame, int64_t timestamp = 0);
+
+  /**
+   * @brief Push a frame from a device::video::AbstractFrameSource, can be called in any thread
+   */
+  bool PushFrame(const device::video::Frame &frame);
+
+  /**
+   * @brief Push a frame of 32-bit ARGB pixels, can be called in any thread
+   */
+  bool PushFrame(const void *pixels, int width, int height, int stride, int64_t timestamp = 0);
+
+  /**
+   * @brief A slot method which can be connected to AbstractFrameSource::frame_ready()
+   */
+  void OnFrameReady(const device::video::Frame &frame, __SLOT__);
+
+  /**
+   * @brief Get the statistics, call this in the main thread
+   */
+  Statistics GetStatistics() const;
+
+  /**
+   * @brief A signal emitted in the main thread when a frame is presented
+   *
+   * The argument is the latency of this frame in microseconds.
+   */
+  SignalRef<int64_t> presented() { return presented_; }
 
  protected:
 
-  virtual void OnRequestUpdateFrom(AbstractView *view);
+  ~VideoView() override;
 
-  virtual Surface *GetSurface(const AbstractView *view) const;
+  void OnConfigureGeometry(const RectF &old_geometry, const RectF &new_geometry) override;
 
-  virtual void OnSizeChanged(int width, int height);
+  void OnSaveGeometry(const RectF &old_geometry, const RectF &new_geometry) override;
 
-  virtual void OnMouseEnter(MouseEvent *event);
+  void OnMouseEnter(MouseEvent *event) override;
 
-  virtual void OnMouseLeave(MouseEvent *event);
+  void OnMouseLeave() override;
 
-  virtual void OnMouseMove(MouseEvent *event);
+  void OnMouseMove(MouseEvent *event) override;
 
-  virtual void OnMouseDown(MouseEvent *event);
+  void OnMouseDown(MouseEvent *event) override;
 
-  virtual void OnMouseUp(MouseEvent *event) override;
+  void OnMouseUp(MouseEvent *event) override;
 
-  virtual void OnKeyDown(KeyEvent *event) override;
+  void OnKeyDown(KeyEvent *event) override;
 
-  virtual void OnKeyUp(KeyEvent *event) override;
+  void OnKeyUp(KeyEvent *event) override;
 
-  virtual void OnDraw(const Context *context);
+  void OnDraw(const Context &context) override;
 
  private:
 
-  Surface *surface_;
+  struct Private;
+
+  std::unique_ptr<Private> p_;
+
+  Signal<int64_t> presented_;
 
 };
 
 } // namespace gui
 } // namespace wiztk
 
-#endif //WIZTK_VIDEO_VIEW_HPP
+#endif // WIZTK_GUI_VIDEO_VIEW_HPP_
@@ -101,6 +101,10 @@ class WIZTK_EXPORT Window : public AbstractShellView {
 
   void OnMouseUp(MouseEvent *event) override;
 
+  void OnMouseAxis(MouseEvent *event) override;
+
+  void OnTouch(TouchEvent *event) override;
+
   void OnKeyDown(KeyEvent *event) override;
 
   void OnFocus(bool) override;
@@ -23,11 +23,11 @@
 
 #include "wiztk/base/macros.hpp"
 #include "wiztk/base/abstract-runnable.hpp"
+#include "wiztk/base/delegate.hpp"
 
 #include <pthread.h>
 
 #include <memory>
-#include <functional>
 
 namespace wiztk {
 namespace system {
@@ -87,7 +87,7 @@ class WIZTK_EXPORT Thread {
   /**
    * @brief A function object to delete Delegate object in destructor.
    */
-  typedef std::function<void(Delegate *)> DelegateDeleter;
+  typedef base::Delegate<void(Delegate *)> DelegateDeleter;
 
   /**
    * @brief A default function object which will delete delegate in destructor.
@@ -16,6 +16,7 @@
 
 #include "event-loop/private.hpp"
 #include "event-loop/quit-event.hpp"
+#include "event-loop/inbox.hpp"
 
 #include "wiztk/async/message.hpp"
 #include "wiztk/async/message-queue.hpp"
@@ -35,9 +36,15 @@ EventLoop::FactoryType EventLoop::kDefaultFactory = []() -> EventLoop * {
 EventLoop::EventLoop() {
   epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
   _ASSERT(-1 != epoll_fd_);
+
+  inbox_.reset(new Inbox);
+  WatchFileDescriptor(inbox_->event_fd(), inbox_.get(), EPOLLIN);
 }
 
 EventLoop::~EventLoop() {
+  UnwatchFileDescriptor(inbox_->event_fd());
+  inbox_.reset();
+
   if (-1 != epoll_fd_)
     close(epoll_fd_);
 }
@@ -69,7 +76,7 @@ void EventLoop::Run() {
       for (int i = 0; i < count; ++i) {
         auto *event = static_cast<AbstractEvent *>(events[i].data.ptr);
         if (nullptr != event)
-          event->Run(events->events);
+          event->Run(events[i].events);
       }
     }
 
@@ -105,6 +112,8 @@ Scheduler EventLoop::GetScheduler() {
 }
 
 void EventLoop::DispatchMessage() {
+  inbox_->MoveTo(&message_queue_);
+
   Message *msg = message_queue_.PopFront();
   while (nullptr != msg) {
     msg->Exec();
@@ -0,0 +1,61 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "inbox.hpp"
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace wiztk {
+namespace async {
+
+EventLoop::Inbox::Inbox() {
+  event_fd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  _ASSERT(-1 != event_fd_);
+}
+
+EventLoop::Inbox::~Inbox() {
+  close(event_fd_);
+}
+
+void EventLoop::Inbox::Post(Message *message) {
+  bool wake_up = false;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_.PushBack(message);
+    wake_up = !pending_.exchange(true);
+  }
+
+  if (wake_up) eventfd_write(event_fd_, 1);
+}
+
+void EventLoop::Inbox::MoveTo(MessageQueue *queue) {
+  if (!pending_.load()) return;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  queue->SpliceBack(&queue_);
+  pending_.store(false);
+}
+
+void EventLoop::Inbox::Run(uint32_t events) {
+  // The messages are moved in EventLoop::DispatchMessage():
+  eventfd_t value = 0;
+  eventfd_read(event_fd_, &value);
+}
+
+} // namespace async
+} // namespace wiztk
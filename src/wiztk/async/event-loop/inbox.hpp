@@ -0,0 +1,80 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef WIZTK_ASYNC_INTERNAL_INBOX_HPP_
+#define WIZTK_ASYNC_INTERNAL_INBOX_HPP_
+
+#include "wiztk/async/event-loop.hpp"
+
+#include <atomic>
+#include <mutex>
+
+namespace wiztk {
+namespace async {
+
+/**
+ * @brief Messages posted to an EventLoop from other threads.
+ *
+ * The messages are kept in a queue guarded by a mutex, and moved to the queue
+ * of the loop before it dispatches messages. An eventfd is written when the
+ * first message arrives to wake up the loop in epoll_wait().
+ */
+class EventLoop::Inbox : public AbstractEvent {
+
+ public:
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(Inbox);
+
+  Inbox();
+
+  ~Inbox() final;
+
+  /**
+   * @brief Queue a message, called in any thread
+   */
+  void Post(Message *message);
+
+  /**
+   * @brief Move all messages to the end of the given queue, called in the
+   * thread of the loop
+   */
+  void MoveTo(MessageQueue *queue);
+
+  int event_fd() const { return event_fd_; }
+
+ protected:
+
+  void Run(uint32_t events) final;
+
+ private:
+
+  std::mutex mutex_;
+
+  MessageQueue queue_;
+
+  /**
+   * @brief True if there're messages in queue_, checked without lock
+   */
+  std::atomic<bool> pending_{false};
+
+  int event_fd_ = -1;
+
+};
+
+}
+}
+
+#endif // WIZTK_ASYNC_INTERNAL_INBOX_HPP_
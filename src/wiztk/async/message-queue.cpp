@@ -32,19 +32,17 @@ void MessageQueue::PushBack(Message *message) {
 }
 
 Message *MessageQueue::PopFront() {
-  if (traits_.is_empty()) return nullptr;
-
-  auto it = traits_.begin();
-  it->unlink();
-  return it->message();
+  internal::MessageTraits *traits = traits_.pop_front();
+  return nullptr == traits ? nullptr : traits->message();
 }
 
 Message *MessageQueue::PopBack() {
-  if (traits_.is_empty()) return nullptr;
+  internal::MessageTraits *traits = traits_.pop_back();
+  return nullptr == traits ? nullptr : traits->message();
+}
 
-  auto it = traits_.rbegin();
-  it->unlink();
-  return it->message();
+void MessageQueue::SpliceBack(MessageQueue *other) {
+  traits_.splice_back(other->traits_);
 }
 
 }
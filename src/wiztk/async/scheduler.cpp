@@ -16,7 +16,7 @@
 
 #include "wiztk/async/scheduler.hpp"
 
-#include "wiztk/async/event-loop.hpp"
+#include "event-loop/inbox.hpp"
 
 namespace wiztk {
 namespace async {
@@ -36,7 +36,12 @@ Scheduler::Scheduler(EventLoop *event_loop)
 Scheduler::~Scheduler() = default;
 
 void Scheduler::PostMessage(Message *message) {
-  event_loop_->message_queue_.PushBack(message);
+  if (EventLoop::GetCurrent() == event_loop_) {
+    event_loop_->message_queue_.PushBack(message);
+    return;
+  }
+
+  event_loop_->inbox_->Post(message);
 }
 
 void Scheduler::PostMessageAfter(Message *a, Message *b) {
@@ -0,0 +1,180 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "wiztk/base/atom.hpp"
+
+#include "wiztk/base/hash.hpp"
+#include "wiztk/base/memory/arena.hpp"
+
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+namespace wiztk {
+namespace base {
+
+/**
+ * @brief An interned string, followed by the text
+ */
+struct Atom::Entry {
+
+  size_t hash;
+
+  size_t length;
+
+  const char *data() const { return reinterpret_cast<const char *>(this + 1); }
+
+};
+
+/**
+ * @brief The global table of atoms
+ *
+ * An open addressing hash table of entries allocated in an arena, entries
+ * are never removed.
+ */
+class Atom::Table {
+
+ public:
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(Table);
+
+  static Table *Get() {
+    // Never deleted, atoms may be used in static destructors:
+    static Table *kTable = new Table;
+    return kTable;
+  }
+
+  Table()
+      : slots_(kInitialSize, nullptr) {}
+
+  ~Table() = default;
+
+  const Entry *Find(const char *str, size_t length, size_t hash) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return slots_[Probe(str, length, hash)];
+  }
+
+  const Entry *Intern(const char *str, size_t length, size_t hash) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    size_t slot = Probe(str, length, hash);
+    if (nullptr != slots_[slot]) return slots_[slot];
+
+    auto *entry = static_cast<Entry *>(arena_.Allocate(sizeof(Entry) + length + 1, alignof(Entry)));
+    entry->hash = hash;
+    entry->length = length;
+    char *data = reinterpret_cast<char *>(entry + 1);
+    memcpy(data, str, length);
+    data[length] = '\0';
+
+    slots_[slot] = entry;
+    ++count_;
+    if (count_ * 2 > slots_.size()) Grow();
+
+    return entry;
+  }
+
+  size_t GetCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return count_;
+  }
+
+ private:
+
+  static const size_t kInitialSize = 256;
+
+  /**
+   * @brief Find the slot of the string, or the empty slot to insert it
+   */
+  size_t Probe(const char *str, size_t length, size_t hash) const {
+    size_t mask = slots_.size() - 1;
+    size_t slot = hash & mask;
+
+    while (nullptr != slots_[slot]) {
+      const Entry *entry = slots_[slot];
+      if (entry->hash == hash && entry->length == length && 0 == memcmp(entry->data(), str, length))
+        break;
+      slot = (slot + 1) & mask;
+    }
+
+    return slot;
+  }
+
+  void Grow() {
+    std::vector<const Entry *> slots(slots_.size() * 2, nullptr);
+    size_t mask = slots.size() - 1;
+
+    for (const Entry *entry : slots_) {
+      if (nullptr == entry) continue;
+      size_t slot = entry->hash & mask;
+      while (nullptr != slots[slot]) slot = (slot + 1) & mask;
+      slots[slot] = entry;
+    }
+
+    slots_.swap(slots);
+  }
+
+  mutable std::mutex mutex_;
+
+  std::vector<const Entry *> slots_;
+
+  size_t count_ = 0;
+
+  memory::Arena arena_;
+
+};
+
+static inline size_t Hash(const char *str, size_t length) {
+  return static_cast<size_t>(HashFNV1a(str, length));
+}
+
+Atom::Atom(const char *str)
+    : Atom(nullptr == str ? "" : str, nullptr == str ? 0 : strlen(str)) {}
+
+Atom::Atom(const char *str, size_t length) {
+  entry_ = Table::Get()->Intern(str, length, Hash(str, length));
+}
+
+Atom Atom::Find(const char *str, size_t length) {
+  return Atom(Table::Get()->Find(str, length, Hash(str, length)));
+}
+
+Atom Atom::Find(const char *str) {
+  return nullptr == str ? Find("", 0) : Find(str, strlen(str));
+}
+
+const char *Atom::c_str() const {
+  return nullptr == entry_ ? "" : entry_->data();
+}
+
+size_t Atom::size() const {
+  return nullptr == entry_ ? 0 : entry_->length;
+}
+
+size_t Atom::GetHash() const {
+  return nullptr == entry_ ? 0 : entry_->hash;
+}
+
+size_t Atom::CountAll() {
+  return Table::Get()->GetCount();
+}
+
+std::ostream &operator<<(std::ostream &out, const Atom &atom) {
+  return out << atom.c_str();
+}
+
+} // namespace base
+} // namespace wiztk
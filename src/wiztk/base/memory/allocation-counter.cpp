@@ -0,0 +1,101 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "wiztk/base/memory/allocation-counter.hpp"
+
+#ifdef __COUNT_ALLOCATIONS__
+
+#include <cerrno>
+#include <cstdlib>
+
+namespace {
+
+// The initial-exec model keeps the access from calling malloc() itself:
+__thread size_t kAllocationCount __attribute__((tls_model("initial-exec"))) = 0;
+
+}
+
+extern "C" {
+
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+void *__libc_memalign(size_t alignment, size_t size);
+
+void *malloc(size_t size) {
+  ++kAllocationCount;
+  return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size) {
+  ++kAllocationCount;
+  return __libc_calloc(count, size);
+}
+
+void *realloc(void *ptr, size_t size) {
+  ++kAllocationCount;
+  return __libc_realloc(ptr, size);
+}
+
+void *memalign(size_t alignment, size_t size) {
+  ++kAllocationCount;
+  return __libc_memalign(alignment, size);
+}
+
+void *aligned_alloc(size_t alignment, size_t size) {
+  ++kAllocationCount;
+  return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void **ptr, size_t alignment, size_t size) {
+  if (0 == alignment || 0 != (alignment & (alignment - 1)) || 0 != alignment % sizeof(void *))
+    return EINVAL;
+
+  ++kAllocationCount;
+  void *memory = __libc_memalign(alignment, size);
+  if (nullptr == memory) return ENOMEM;
+
+  *ptr = memory;
+  return 0;
+}
+
+} // extern "C"
+
+#endif // __COUNT_ALLOCATIONS__
+
+namespace wiztk {
+namespace base {
+namespace memory {
+
+bool AllocationCounter::IsEnabled() {
+#ifdef __COUNT_ALLOCATIONS__
+  return true;
+#else
+  return false;
+#endif
+}
+
+size_t AllocationCounter::GetCount() {
+#ifdef __COUNT_ALLOCATIONS__
+  return kAllocationCount;
+#else
+  return 0;
+#endif
+}
+
+} // namespace memory
+} // namespace base
+} // namespace wiztk
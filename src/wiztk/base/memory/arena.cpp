@@ -0,0 +1,132 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "wiztk/base/memory/arena.hpp"
+
+#include <cstdlib>
+
+namespace wiztk {
+namespace base {
+namespace memory {
+
+/**
+ * @brief The header of a chunk, followed by 'size' bytes of memory
+ */
+struct Arena::Chunk {
+
+  Chunk *next;
+
+  size_t size;
+
+  char *begin() { return reinterpret_cast<char *>(this + 1); }
+
+  char *end() { return begin() + size; }
+
+};
+
+/**
+ * @brief A destructor to be called in Reset(), allocated in the arena itself
+ */
+struct Arena::Finalizer {
+
+  void (*destroy)(void *);
+
+  void *object;
+
+  Finalizer *next;
+
+};
+
+Arena::Arena(size_t chunk_size)
+    : chunk_size_(chunk_size) {
+  _ASSERT(chunk_size_ > 0);
+}
+
+Arena::~Arena() {
+  Reset();
+
+  Chunk *chunk = first_;
+  while (nullptr != chunk) {
+    Chunk *next = chunk->next;
+    free(chunk);
+    chunk = next;
+  }
+}
+
+void Arena::Reset() {
+  // Finalizers are prepended, so objects are destroyed in reverse order:
+  while (nullptr != finalizers_) {
+    Finalizer *finalizer = finalizers_;
+    finalizers_ = finalizer->next;
+    finalizer->destroy(finalizer->object);
+  }
+
+  current_ = first_;
+  if (nullptr != current_) {
+    position_ = current_->begin();
+    end_ = current_->end();
+  }
+}
+
+size_t Arena::GetUsedSize() const {
+  if (nullptr == current_) return 0;
+
+  size_t size = 0;
+  for (Chunk *chunk = first_; chunk != current_; chunk = chunk->next) {
+    size += chunk->size;
+  }
+  return size + (position_ - current_->begin());
+}
+
+void *Arena::AllocateSlow(size_t size, size_t alignment) {
+  // Move on to the next chunk left from the last frame if it's large enough,
+  // otherwise insert a new one after the current chunk:
+  Chunk *chunk = nullptr == current_ ? first_ : current_->next;
+
+  if (nullptr == chunk || chunk->size < size + alignment) {
+    size_t chunk_size = size + alignment > chunk_size_ ? size + alignment : chunk_size_;
+    chunk = static_cast<Chunk *>(malloc(sizeof(Chunk) + chunk_size));
+    if (nullptr == chunk) throw std::bad_alloc();
+    chunk->size = chunk_size;
+    capacity_ += chunk_size;
+
+    if (nullptr == current_) {
+      chunk->next = first_;
+      first_ = chunk;
+    } else {
+      chunk->next = current_->next;
+      current_->next = chunk;
+    }
+  }
+
+  current_ = chunk;
+  position_ = current_->begin();
+  end_ = current_->end();
+
+  return Allocate(size, alignment);
+}
+
+void Arena::AddFinalizer(void (*destroy)(void *), void *object) {
+  Finalizer *finalizer = static_cast<Finalizer *>(Allocate(sizeof(Finalizer), alignof(Finalizer)));
+  finalizer->destroy = destroy;
+  finalizer->object = object;
+  finalizer->next = finalizers_;
+  finalizers_ = finalizer;
+}
+
+} // namespace memory
+} // namespace base
+} // namespace wiztk
@@ -16,6 +16,8 @@
 
 #include <wiztk/base/object.hpp>
 
+#include <algorithm>
+
 namespace wiztk {
 namespace base {
 
@@ -26,7 +28,8 @@ Object::Object()
       first_child_(nullptr),
       last_child_(nullptr),
       parent_(nullptr),
-      children_count_(0) {
+      children_count_(0),
+      index_(-1) {
 }
 
 Object::~Object() {
@@ -47,25 +50,9 @@ Object::~Object() {
 Object *Object::GetChildAt(int index) const {
   if (index < 0) index = children_count_ + index;
 
-  Object *object = nullptr;
-  int mid = (children_count_ + 1) / 2;
+  if (index < 0 || index >= children_count_) return nullptr;
 
-  if (index >= 0 && index < mid) {
-    object = first_child_;
-    while (index > 0) {
-      object = object->next_;
-      index--;
-    }
-  } else if (index >= mid && index < children_count_) {
-    object = last_child_;
-    int max = children_count_ - 1;
-    while (index < max) {
-      object = object->previous_;
-      index++;
-    }
-  }
-
-  return object;
+  return children_[index];
 }
 
 void Object::PushFrontChild(Object *child) {
@@ -81,20 +68,7 @@ void Object::PushFrontChild(Object *child) {
   _ASSERT(child->next_ == nullptr);
   _ASSERT(child->parent_ == nullptr);
 
-  if (first_child_) {
-    first_child_->previous_ = child;
-    child->next_ = first_child_;
-  } else {
-    _ASSERT(last_child_ == nullptr);
-    _ASSERT(children_count_ == 0);
-    // child->next_ = nullptr;
-    last_child_ = child;
-  }
-  first_child_ = child;
-
-  // child->previous_ = nullptr;
-  child->parent_ = this;
-  children_count_++;
+  InsertChildAt(child, 0);
 
   child->OnAddedToParent();
 }
@@ -112,55 +86,15 @@ void Object::InsertChild(Object *child, int index) {
   _ASSERT(child->next_ == nullptr);
   _ASSERT(child->parent_ == nullptr);
 
-  if (first_child_ == nullptr) {
-    _ASSERT(last_child_ == nullptr);
-    _ASSERT(children_count_ == 0);
-    // child->next_ = nullptr;
-    // child->previous_ = nullptr;
-    last_child_ = child;
-    first_child_ = child;
+  // A negative index counts from the back and inserts after that position:
+  if (index >= 0) {
+    if (index > children_count_) index = children_count_;
   } else {
-    if (index >= 0) {
-      Object *p = first_child_;
-      while (p && (index > 0)) {
-        p = p->next_;
-        index--;
-      }
-      if (p) {  // insert before p
-        child->previous_ = p->previous_;
-        child->next_ = p;
-        if (p->previous_) p->previous_->next_ = child;
-        else first_child_ = child;
-        p->previous_ = child;
-      } else {  // push back
-        last_child_->next_ = child;
-        child->previous_ = last_child_;
-        last_child_ = child;
-        // child->next_ = nullptr;
-      }
-    } else {
-      Object *p = last_child_;
-      while (p && (index < -1)) {
-        p = p->previous_;
-        index++;
-      }
-      if (p) {  // insert after p
-        child->next_ = p->next_;
-        child->previous_ = p;
-        if (p->next_) p->next_->previous_ = child;
-        else last_child_ = child;
-        p->next_ = child;
-      } else {  // push front
-        first_child_->previous_ = child;
-        child->next_ = first_child_;
-        first_child_ = child;
-        // child->previous_ = nullptr;
-      }
-    }
+    index = children_count_ + index + 1;
+    if (index < 0) index = 0;
   }
 
-  child->parent_ = this;
-  children_count_++;
+  InsertChildAt(child, index);
 
   child->OnAddedToParent();
 }
@@ -178,20 +112,7 @@ void Object::PushBackChild(Object *child) {
   _ASSERT(child->next_ == nullptr);
   _ASSERT(child->parent_ == nullptr);
 
-  if (last_child_) {
-    last_child_->next_ = child;
-    child->previous_ = last_child_;
-  } else {
-    _ASSERT(first_child_ == nullptr);
-    _ASSERT(children_count_ == 0);
-    // child->previous_ = nullptr;
-    first_child_ = child;
-  }
-  last_child_ = child;
-
-  // child->next_ = nullptr;
-  child->parent_ = this;
-  children_count_++;
+  InsertChildAt(child, children_count_);
 
   child->OnAddedToParent();
 }
@@ -200,27 +121,9 @@ Object *Object::RemoveChild(Object *child) {
   if (child->parent_ != this) return nullptr;
 
   _ASSERT(children_count_ > 0);
+  _ASSERT(children_[child->index_] == child);
 
-  if (child->previous_) {
-    child->previous_->next_ = child->next_;
-  } else {
-    _ASSERT(first_child_ == child);
-    first_child_ = child->next_;
-  }
-
-  if (child->next_) {
-    child->next_->previous_ = child->previous_;
-  } else {
-    _ASSERT(last_child_ == child);
-    last_child_ = child->previous_;
-  }
-
-  children_count_--;
-  _ASSERT(children_count_ >= 0);
-
-  child->previous_ = nullptr;
-  child->next_ = nullptr;
-  child->parent_ = nullptr;
+  EraseChildAt(child->index_);
 
   child->OnRemovedFromParent(this);
 
@@ -228,21 +131,14 @@ Object *Object::RemoveChild(Object *child) {
 }
 
 void Object::ClearChildren() {
-  Object *ptr = first_child_;
-  Object *next_ptr = nullptr;
-
-  while (ptr) {
-    next_ptr = ptr->next_;
-    // ptr->previous_ = nullptr;
-    // ptr->next_ = nullptr;
-    // ptr->parent_ = nullptr;
-    delete ptr;
-    ptr = next_ptr;
+  // Delete from the back so that each removal does not move other children:
+  while (children_count_ > 0) {
+    delete last_child_;
   }
 
-  children_count_ = 0;
-  first_child_ = nullptr;
-  last_child_ = nullptr;
+  _ASSERT(children_.empty());
+  _ASSERT(first_child_ == nullptr);
+  _ASSERT(last_child_ == nullptr);
 }
 
 void Object::OnAddedToParent() {
@@ -259,66 +155,13 @@ bool Object::SwapIndex(Object *object1, Object *object2) {
   if (object1->parent_ != object2->parent_) return false;
   if (object1->parent_ == nullptr) return false;
 
-  Object *tmp1 = nullptr;
-  Object *tmp2 = nullptr;
+  Object *parent = object1->parent_;
+  int index1 = object1->index_;
+  int index2 = object2->index_;
 
-  if (object1->next_ == object2) {    // view1 is just the previous sibling of view2
-
-    _ASSERT(object2->previous_ == object1);
-    tmp1 = object1->previous_;
-    tmp2 = object2->next_;
-    object2->previous_ = tmp1;
-    object1->previous_ = object2;
-    object2->next_ = object1;
-    object1->next_ = tmp2;
-
-    if (tmp1 != nullptr) tmp1->next_ = object2;
-    else object1->parent_->first_child_ = object2;
-
-    if (tmp2 != nullptr) tmp2->previous_ = object1;
-    else object2->parent_->last_child_ = object2;
-
-  } else if (object1->previous_ == object2) {
-    _ASSERT(object2->next_ == object1);
-
-    tmp1 = object2->previous_;
-    tmp2 = object1->next_;
-    object1->previous_ = tmp1;
-    object2->previous_ = object1;
-    object1->next_ = object2;
-    object2->next_ = tmp2;
-
-    if (tmp1 != nullptr) tmp1->next_ = object1;
-    else object2->parent_->first_child_ = object1;
-
-    if (tmp2 != nullptr) tmp2->previous_ = object2;
-    else object1->parent_->last_child_ = object2;
-
-  } else {
-
-    tmp1 = object1->previous_;
-    tmp2 = object2->previous_;
-    object1->previous_ = tmp2;
-    object2->previous_ = tmp1;
-
-    if (tmp1 != nullptr) tmp1->next_ = object2;
-    else object1->parent_->first_child_ = object2;
-
-    if (tmp2 != nullptr) tmp2->next_ = object1;
-    else object2->parent_->first_child_ = object1;
-
-    tmp1 = object1->next_;
-    tmp2 = object2->next_;
-    object1->next_ = tmp2;
-    object2->next_ = tmp1;
-
-    if (tmp1 != nullptr) tmp1->previous_ = object2;
-    else object1->parent_->last_child_ = object2;
-
-    if (tmp2 != nullptr) tmp2->previous_ = object1;
-    else object2->parent_->last_child_ = object1;
-
-  }
+  std::swap(parent->children_[index1], parent->children_[index2]);
+  parent->UpdateChildren(index1, index1 + 1);
+  parent->UpdateChildren(index2, index2 + 1);
 
   return true;
 }
@@ -326,67 +169,25 @@ bool Object::SwapIndex(Object *object1, Object *object2) {
 bool Object::InsertSiblingBefore(Object *src, Object *dst) {
   if (src == nullptr || dst == nullptr) return false;
   if (src == dst) return false;
+  if (src->parent_ == nullptr) return false;
 
-  if (dst->parent_ != nullptr) {
-
-    if (dst->parent_ == src->parent_) {
-
-      if (src->previous_ == dst) {    // already is the previous one of src
-        return true;
-      }
-
-      if (dst->previous_) {
-        dst->previous_->next_ = dst->next_;
-      } else {
-        _ASSERT(dst->parent_->first_child_ == dst);
-        dst->parent_->first_child_ = dst->next_;
-      }
-
-      if (dst->next_) {
-        dst->next_->previous_ = dst->previous_;
-      } else {
-        _ASSERT(dst->parent_->last_child_ == dst);
-        dst->parent_->last_child_ = dst->previous_;
-      }
+  Object *parent = src->parent_;
 
-      Object *tmp = src->previous_;
-
-      src->previous_ = dst;
-      dst->next_ = src;
-      dst->previous_ = tmp;
-
-      if (tmp) {
-        tmp->next_ = dst;
-      } else {
-        _ASSERT(src->parent_->first_child_ == src);
-        dst->parent_->first_child_ = dst;
-      }
-
-      return true;
-
-    } else {
-      dst->parent_->RemoveChild(dst);
+  if (dst->parent_ == parent) {
+    if (src->previous_ != dst) {  // not already the previous one of src
+      int from = dst->index_;
+      parent->MoveChild(from, from < src->index_ ? src->index_ - 1 : src->index_);
     }
-
+    return true;
   }
+
+  if (dst->parent_ != nullptr) dst->parent_->RemoveChild(dst);
+
   _ASSERT(dst->parent_ == nullptr);
   _ASSERT(dst->next_ == nullptr);
   _ASSERT(dst->previous_ == nullptr);
 
-  Object *tmp = src->previous_;
-
-  src->previous_ = dst;
-  dst->next_ = src;
-  dst->previous_ = tmp;
-  if (tmp) {
-    tmp->next_ = dst;
-  } else {
-    _ASSERT(src->parent_->first_child_ == src);
-    src->parent_->first_child_ = dst;
-  }
-
-  dst->parent_ = src->parent_;
-  src->parent_->children_count_++;
+  parent->InsertChildAt(dst, src->index_);
 
   return true;
 }
@@ -394,199 +195,102 @@ bool Object::InsertSiblingBefore(Object *src, Object *dst) {
 bool Object::InsertSiblingAfter(Object *src, Object *dst) {
   if (src == nullptr || dst == nullptr) return false;
   if (src == dst) return false;
+  if (src->parent_ == nullptr) return false;
 
-  if (dst->parent_ != nullptr) {
-
-    if (dst->previous_ == src->parent_) {
-
-      if (src->next_ == dst) {    // alrady is the next one of src
-        return true;
-      }
-
-      if (dst->previous_) {
-        dst->previous_->next_ = dst->next_;
-      } else {
-        _ASSERT(dst->parent_->first_child_ == dst);
-        dst->parent_->first_child_ = dst->next_;
-      }
-
-      if (dst->next_) {
-        dst->next_->previous_ = dst->previous_;
-      } else {
-        _ASSERT(dst->parent_->last_child_ == dst);
-        dst->parent_->last_child_ = dst->previous_;
-      }
-
-      Object *tmp = src->next_;
-
-      src->next_ = dst;
-      dst->previous_ = src;
-      dst->next_ = tmp;
-
-      if (tmp) {
-        tmp->previous_ = dst;
-      } else {
-        _ASSERT(src->parent_->last_child_ == src);
-        dst->parent_->last_child_ = dst;
-      }
-
-      return true;
+  Object *parent = src->parent_;
 
-    } else {
-      dst->parent_->RemoveChild(dst);
+  if (dst->parent_ == parent) {
+    if (src->next_ != dst) {  // not already the next one of src
+      int from = dst->index_;
+      parent->MoveChild(from, from < src->index_ ? src->index_ : src->index_ + 1);
     }
-
+    return true;
   }
 
+  if (dst->parent_ != nullptr) dst->parent_->RemoveChild(dst);
+
   _ASSERT(dst->parent_ == nullptr);
   _ASSERT(dst->next_ == nullptr);
   _ASSERT(dst->previous_ == nullptr);
 
-  Object *tmp = src->next_;
-
-  src->next_ = dst;
-  dst->previous_ = src;
-  dst->next_ = tmp;
-  if (tmp) {
-    tmp->previous_ = dst;
-  } else {
-    _ASSERT(src->parent_->last_child_ == src);
-    src->parent_->last_child_ = dst;
-  }
-
-  dst->parent_ = src->parent_;
-  src->parent_->children_count_++;
+  parent->InsertChildAt(dst, src->index_ + 1);
 
   return true;
 }
 
 void Object::MoveToFirst(Object *object) {
   if (object->parent_) {
-
-    if (object->parent_->first_child_ == object) {
-      _ASSERT(object->previous_ == 0);
-      return;    // already at first
-    }
-
-    object->previous_->next_ = object->next_;
-    if (object->next_) {
-      object->next_->previous_ = object->previous_;
-    } else {
-      _ASSERT(object->parent_->last_child_ == object);
-      object->parent_->last_child_ = object->previous_;
-    }
-
-    object->previous_ = 0;
-    object->next_ = object->parent_->first_child_;
-    object->parent_->first_child_->previous_ = object;
-    object->parent_->first_child_ = object;
+    object->parent_->MoveChild(object->index_, 0);
   }
 }
 
 void Object::MoveToLast(Object *object) {
   if (object->parent_) {
+    object->parent_->MoveChild(object->index_, object->parent_->children_count_ - 1);
+  }
+}
 
-    if (object->parent_->last_child_ == object) {
-      _ASSERT(object->next_ == 0);
-      return;    // already at last
-    }
+void Object::MoveForward(Object *object) {
+  if (object->parent_ && object->next_) {
+    object->parent_->MoveChild(object->index_, object->index_ + 1);
+  }
+}
 
-    object->next_->previous_ = object->previous_;
+void Object::MoveBackward(Object *object) {
+  if (object->parent_ && object->previous_) {
+    object->parent_->MoveChild(object->index_, object->index_ - 1);
+  }
+}
 
-    if (object->previous_) {
-      object->previous_->next_ = object->next_;
-    } else {
-      _ASSERT(object->parent_->first_child_ == object);
-      object->parent_->first_child_ = object->next_;
-    }
+void Object::InsertChildAt(Object *child, int index) {
+  _ASSERT(index >= 0 && index <= children_count_);
 
-    object->next_ = 0;
-    object->previous_ = object->parent_->last_child_;
-    object->parent_->last_child_->next_ = object;
-    object->parent_->last_child_ = object;
-  }
+  children_.insert(children_.begin() + index, child);
+  child->parent_ = this;
+  UpdateChildren(index, static_cast<int>(children_.size()));
 }
 
-void Object::MoveForward(Object *object) {
-  if (object->parent_) {
+void Object::EraseChildAt(int index) {
+  Object *child = children_[index];
 
-    if (object->next_) {
-
-      Object *tmp = object->next_;
-
-      tmp->previous_ = object->previous_;
-      if (object->previous_) {
-        object->previous_->next_ = tmp;
-      } else {
-        _ASSERT(object->parent_->first_child_ == object);
-        object->parent_->first_child_ = tmp;
-      }
-
-      object->previous_ = tmp;
-      object->next_ = tmp->next_;
-      if (tmp->next_) {
-        tmp->next_->previous_ = object;
-      }
-      tmp->next_ = object;
-
-      if (object->next_ == 0) {
-        _ASSERT(object->parent_->last_child_ == tmp);
-        object->parent_->last_child_ = object;
-      }
-
-      if (object->previous_) {
-        _ASSERT(object->previous_->next_ == object);
-      }
-      if (object->next_) {
-        _ASSERT(object->next_->previous_ == object);
-      }
+  children_.erase(children_.begin() + index);
+  child->previous_ = nullptr;
+  child->next_ = nullptr;
+  child->parent_ = nullptr;
+  child->index_ = -1;
+  UpdateChildren(index, static_cast<int>(children_.size()));
+}
 
-    } else {
-      _ASSERT(object->parent_->last_child_ == object);
-    }
+void Object::MoveChild(int from, int to) {
+  if (from == to) return;
 
+  auto begin = children_.begin();
+  if (from < to) {
+    std::rotate(begin + from, begin + from + 1, begin + to + 1);
+    UpdateChildren(from, to + 1);
+  } else {
+    std::rotate(begin + to, begin + from, begin + from + 1);
+    UpdateChildren(to, from + 1);
   }
 }
 
-void Object::MoveBackward(Object *object) {
-  if (object->parent_) {
-
-    if (object->previous_) {
-
-      Object *tmp = object->previous_;
-
-      tmp->next_ = object->next_;
-      if (object->next_) {
-        object->next_->previous_ = tmp;
-      } else {
-        _ASSERT(object->parent_->last_child_ == object);
-        object->parent_->last_child_ = tmp;
-      }
-
-      object->next_ = tmp;
-      object->previous_ = tmp->previous_;
-      if (tmp->previous_) {
-        tmp->previous_->next_ = object;
-      }
-      tmp->previous_ = object;
-
-      if (object->previous_ == 0) {
-        _ASSERT(object->parent_->first_child_ == tmp);
-        object->parent_->first_child_ = object;
-      }
-
-      if (object->previous_) {
-        _ASSERT(object->previous_->next_ == object);
-      }
-      if (object->next_) {
-        _ASSERT(object->next_->previous_ == object);
-      }
+void Object::UpdateChildren(int begin, int end) {
+  int count = static_cast<int>(children_.size());
 
-    } else {
-      _ASSERT(object->parent_->first_child_ == object);
-    }
+  // The neighbours of the range have their links changed too:
+  begin = std::max(begin - 1, 0);
+  end = std::min(end + 1, count);
 
+  for (int i = begin; i < end; ++i) {
+    Object *child = children_[i];
+    child->index_ = i;
+    child->previous_ = i > 0 ? children_[i - 1] : nullptr;
+    child->next_ = i < count - 1 ? children_[i + 1] : nullptr;
   }
+
+  children_count_ = count;
+  first_child_ = children_.empty() ? nullptr : children_.front();
+  last_child_ = children_.empty() ? nullptr : children_.back();
 }
 
 } // namespace base
@@ -16,11 +16,105 @@
 
 #include "wiztk/base/sigcxx.hpp"
 
+#include <new>
+
 namespace wiztk {
 namespace base {
 
 namespace internal {
 
+namespace {
+
+/**
+ * @brief The free lists of NodePool in a thread
+ */
+struct FreeLists {
+
+  /** Size classes of 16 bytes, larger blocks are not cached */
+  static const size_t kGranularity = 16;
+  static const size_t kClasses = 16;
+
+  /** Max free blocks cached for each size class */
+  static const size_t kMaxCached = 1024;
+
+  struct Block {
+    Block *next;
+  };
+
+  FreeLists() = default;
+
+  ~FreeLists();
+
+  static inline size_t GetClass(size_t size) {
+    return (size - 1) / kGranularity;
+  }
+
+  Block *heads[kClasses] = {nullptr};
+
+  size_t counts[kClasses] = {0};
+
+};
+
+thread_local FreeLists kFreeLists;
+
+/**
+ * Set when kFreeLists of this thread is destroyed. Nodes of static signals
+ * and trackables, or of thread_local ones destroyed after kFreeLists, are
+ * freed after that and go to the heap directly. Trivially destructible, so
+ * it's still valid then.
+ */
+thread_local bool kFreeListsDestroyed = false;
+
+FreeLists::~FreeLists() {
+  Block *block = nullptr;
+  for (size_t i = 0; i < kClasses; ++i) {
+    while (nullptr != heads[i]) {
+      block = heads[i];
+      heads[i] = block->next;
+      ::operator delete(block);
+    }
+    counts[i] = 0;
+  }
+
+  kFreeListsDestroyed = true;
+}
+
+} // namespace
+
+void *NodePool::Allocate(size_t size) {
+  size_t index = FreeLists::GetClass(size);
+  if (index >= FreeLists::kClasses || kFreeListsDestroyed) return ::operator new(size);
+
+  FreeLists::Block *block = kFreeLists.heads[index];
+  if (nullptr == block) return ::operator new((index + 1) * FreeLists::kGranularity);
+
+  kFreeLists.heads[index] = block->next;
+  --kFreeLists.counts[index];
+  return block;
+}
+
+void NodePool::Deallocate(void *block, size_t size) {
+  size_t index = FreeLists::GetClass(size);
+  if (index >= FreeLists::kClasses || kFreeListsDestroyed
+      || kFreeLists.counts[index] >= FreeLists::kMaxCached) {
+    ::operator delete(block);
+    return;
+  }
+
+  auto *node = static_cast<FreeLists::Block *>(block);
+  node->next = kFreeLists.heads[index];
+  kFreeLists.heads[index] = node;
+  ++kFreeLists.counts[index];
+}
+
+size_t NodePool::GetCachedCount() {
+  if (kFreeListsDestroyed) return 0;
+
+  size_t count = 0;
+  for (size_t i = 0; i < FreeLists::kClasses; ++i) count += kFreeLists.counts[i];
+  return count;
+}
+
 BindingNode::~BindingNode() {
   if (nullptr != token) {
     _ASSERT(token->binding == this);
@@ -30,13 +124,17 @@ BindingNode::~BindingNode() {
 }
 
 TokenNode::~TokenNode() {
-  _ASSERT(nullptr == slot_mark_head.previous());
-  Slot::Mark *mark = nullptr;
-  while (nullptr != slot_mark_head.next()) {
-    mark = static_cast<Slot::Mark *>(slot_mark_head.next());  // always a Slot::Mark pointer
-    ++mark->slot()->iterator_;
-    ++mark->slot()->ref_count_;
-    mark->unlink();
+  if (nullptr != trackable) {
+    auto *signal = static_cast<SignalBase *>(trackable);  // always a Signal
+    ++signal->version_;
+
+    // Move the slots being emitted on this token to the next one:
+    for (Slot *slot = signal->emitting_; nullptr != slot; slot = slot->previous_) {
+      if (slot->iterator_.get() == this) {
+        ++slot->iterator_;
+        slot->advanced_ = true;
+      }
+    }
   }
 
   if (nullptr != binding) {
@@ -46,8 +144,30 @@ TokenNode::~TokenNode() {
   }
 }
 
+SignalBase::~SignalBase() {
+  // Tell the emissions in progress this signal is destroyed:
+  Slot *slot = emitting_;
+  while (nullptr != slot) {
+    slot->signal_ = nullptr;
+    slot = slot->previous_;
+  }
+  emitting_ = nullptr;
+}
+
 }  // namespace internal
 
+Slot::Slot(internal::SignalBase *signal, DequeType *deque)
+    : signal_(signal), previous_(signal->emitting_), deque_(deque), iterator_(deque->begin()) {
+  signal->emitting_ = this;
+}
+
+Slot::~Slot() {
+  if (nullptr != signal_) {
+    _ASSERT(signal_->emitting_ == this);
+    signal_->emitting_ = previous_;
+  }
+}
+
 Trackable::Trackable(const Trackable &)
     : Trackable() {}
 
@@ -16,44 +16,261 @@
 
 #include "wiztk/base/string.hpp"
 
-#include <unicode/utf.h>
-#include <unicode/unistr.h>
-#include <unicode/ustream.h>
-#include <unicode/stringpiece.h>
+#include <cstdint>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 namespace wiztk {
 namespace base {
 
+namespace {
+
+const char32_t kReplacementCharacter = 0xFFFD;
+
+/**
+ * @brief Decode one multi-byte UTF-8 sequence
+ * @param str Points to a lead byte >= 0x80
+ * @param end The end of the data
+ * @param code_point Output
+ * @return The length of the sequence if valid, or the negative length of the
+ * invalid prefix to be replaced with one U+FFFD
+ */
+int DecodeSequence(const unsigned char *str, const unsigned char *end, char32_t *code_point) {
+  unsigned char lead = str[0];
+  int length = 0;
+  unsigned char lower = 0x80, upper = 0xBF;  // The range of the 2nd byte
+
+  if (lead >= 0xC2 && lead <= 0xDF) {
+    length = 2;
+    *code_point = lead & 0x1F;
+  } else if (lead >= 0xE0 && lead <= 0xEF) {
+    length = 3;
+    *code_point = lead & 0x0F;
+    if (0xE0 == lead) lower = 0xA0;       // Overlong
+    else if (0xED == lead) upper = 0x9F;  // Surrogates
+  } else if (lead >= 0xF0 && lead <= 0xF4) {
+    length = 4;
+    *code_point = lead & 0x07;
+    if (0xF0 == lead) lower = 0x90;       // Overlong
+    else if (0xF4 == lead) upper = 0x8F;  // Beyond U+10FFFF
+  } else {
+    return -1;
+  }
+
+  for (int i = 1; i < length; ++i) {
+    if (str + i >= end || str[i] < lower || str[i] > upper) return -i;
+    *code_point = (*code_point << 6) | (str[i] & 0x3F);
+    lower = 0x80;
+    upper = 0xBF;
+  }
+
+  return length;
+}
+
+/**
+ * @brief Skip the ASCII bytes from str
+ */
+inline const unsigned char *SkipASCII(const unsigned char *str, const unsigned char *end) {
+#ifdef __SSE2__
+  while (end - str >= 16) {
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(str));
+    if (0 != _mm_movemask_epi8(chunk)) break;
+    str += 16;
+  }
+#else
+  while (end - str >= 8) {
+    uint64_t chunk;
+    memcpy(&chunk, str, 8);
+    if (0 != (chunk & 0x8080808080808080ULL)) break;
+    str += 8;
+  }
+#endif
+
+  while (str < end && *str < 0x80) ++str;
+  return str;
+}
+
+void AppendUTF8(char32_t code_point, std::string *out) {
+  if (code_point < 0x80) {
+    out->push_back(static_cast<char>(code_point));
+  } else if (code_point < 0x800) {
+    out->push_back(static_cast<char>(0xC0 | (code_point >> 6)));
+    out->push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+  } else if (code_point < 0x10000) {
+    out->push_back(static_cast<char>(0xE0 | (code_point >> 12)));
+    out->push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+    out->push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+  } else {
+    out->push_back(static_cast<char>(0xF0 | (code_point >> 18)));
+    out->push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3F)));
+    out->push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+    out->push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+  }
+}
+
+inline bool IsSurrogate(char32_t code_point) {
+  return code_point >= 0xD800 && code_point <= 0xDFFF;
+}
+
+} // namespace
+
 String::String(const char *str) {
-  // TODO: temporary workaround, optimize this by ICU later:
-  icu::UnicodeString unicode = icu::UnicodeString::fromUTF8(icu::StringPiece(str));
-  assign(unicode.getBuffer());
+  if (nullptr != str) Assign(str, strlen(str));
+}
+
+String::String(const char *str, size_type length) {
+  Assign(str, length);
+}
+
+String::String(const std::string &str) {
+  Assign(str.data(), str.size());
+}
+
+String::String(std::string &&str) {
+  if (IsValidUTF8(str.data(), str.size()))
+    utf8_ = std::move(str);
+  else
+    Assign(str.data(), str.size());
 }
 
 String::String(const char16_t *str) {
-  assign(reinterpret_cast<const UChar *>(str));
+  if (nullptr == str) return;
+
+  size_type length = std::char_traits<char16_t>::length(str);
+  utf8_.reserve(length);
+
+  for (size_type i = 0; i < length; ++i) {
+    char32_t code_point = str[i];
+    if (code_point >= 0xD800 && code_point <= 0xDBFF &&
+        i + 1 < length && str[i + 1] >= 0xDC00 && str[i + 1] <= 0xDFFF) {
+      code_point = 0x10000 + ((code_point - 0xD800) << 10) + (str[i + 1] - 0xDC00);
+      ++i;
+    } else if (IsSurrogate(code_point)) {
+      code_point = kReplacementCharacter;  // Unpaired
+    }
+    AppendUTF8(code_point, &utf8_);
+  }
 }
 
 String::String(const char32_t *str) {
-  // TODO: temporary workaround, optimize this by ICU later.
-  icu::UnicodeString unicode =
-      icu::UnicodeString::fromUTF32(reinterpret_cast<const UChar32 *>(str),
-                                    static_cast<uint32_t>(std::char_traits<char32_t>::length(str)));
-  assign(unicode.getBuffer());
+  if (nullptr == str) return;
+
+  size_type length = std::char_traits<char32_t>::length(str);
+  utf8_.reserve(length);
+
+  for (size_type i = 0; i < length; ++i) {
+    char32_t code_point = str[i];
+    if (code_point > 0x10FFFF || IsSurrogate(code_point)) code_point = kReplacementCharacter;
+    AppendUTF8(code_point, &utf8_);
+  }
 }
 
-std::ostream &operator<<(std::ostream &out, const String &str) {
-  // TODO: This create and copy the string array from String16 to icu::UnicodeString, find a better way for performance.
-  return out << icu::UnicodeString(str.data());
+String::size_type String::CountCodePoints() const {
+  // Every byte but the continuation bytes starts a code point:
+  size_type count = 0;
+  for (char c : utf8_) {
+    if ((static_cast<unsigned char>(c) & 0xC0) != 0x80) ++count;
+  }
+  return count;
 }
 
-std::string String::ToUTF8() const {
-  std::string utf8;
-  icu::UnicodeString unicode = data();
+std::u16string String::ToUTF16() const {
+  // Never more code units than bytes:
+  std::u16string utf16(utf8_.size(), 0);
+  char16_t *out = &utf16[0];
+
+  const unsigned char *str = reinterpret_cast<const unsigned char *>(utf8_.data());
+  const unsigned char *end = str + utf8_.size();
+  char32_t code_point = 0;
 
-  unicode.toUTF8String(utf8);
+  while (str < end) {
+    for (const unsigned char *ascii_end = SkipASCII(str, end); str < ascii_end; ++str) *out++ = *str;
+    if (str == end) break;
+
+    str += DecodeSequence(str, end, &code_point);
+    if (code_point < 0x10000) {
+      *out++ = static_cast<char16_t>(code_point);
+    } else {
+      code_point -= 0x10000;
+      *out++ = static_cast<char16_t>(0xD800 + (code_point >> 10));
+      *out++ = static_cast<char16_t>(0xDC00 + (code_point & 0x3FF));
+    }
+  }
+
+  utf16.resize(static_cast<size_type>(out - utf16.data()));
+  return utf16;
+}
+
+std::u32string String::ToUTF32() const {
+  std::u32string utf32(utf8_.size(), 0);
+  char32_t *out = &utf32[0];
+
+  const unsigned char *str = reinterpret_cast<const unsigned char *>(utf8_.data());
+  const unsigned char *end = str + utf8_.size();
+
+  while (str < end) {
+    for (const unsigned char *ascii_end = SkipASCII(str, end); str < ascii_end; ++str) *out++ = *str;
+    if (str == end) break;
+
+    str += DecodeSequence(str, end, out++);
+  }
+
+  utf32.resize(static_cast<size_type>(out - utf32.data()));
+  return utf32;
+}
 
-  return utf8;
+bool String::IsValidUTF8(const char *str, size_type length) {
+  const unsigned char *p = reinterpret_cast<const unsigned char *>(str);
+  const unsigned char *end = p + length;
+  char32_t code_point = 0;
+
+  while (p < end) {
+    p = SkipASCII(p, end);
+    if (p == end) break;
+
+    int n = DecodeSequence(p, end, &code_point);
+    if (n < 0) return false;
+    p += n;
+  }
+
+  return true;
+}
+
+void String::Assign(const char *str, size_type length) {
+  if (IsValidUTF8(str, length)) {
+    utf8_.assign(str, length);
+    return;
+  }
+
+  // Copy the valid parts and replace the others:
+  utf8_.clear();
+  utf8_.reserve(length + 2);
+
+  const unsigned char *p = reinterpret_cast<const unsigned char *>(str);
+  const unsigned char *end = p + length;
+  char32_t code_point = 0;
+
+  while (p < end) {
+    const unsigned char *ascii_end = SkipASCII(p, end);
+    utf8_.append(reinterpret_cast<const char *>(p), ascii_end - p);
+    p = ascii_end;
+    if (p == end) break;
+
+    int n = DecodeSequence(p, end, &code_point);
+    if (n > 0) {
+      utf8_.append(reinterpret_cast<const char *>(p), static_cast<size_type>(n));
+      p += n;
+    } else {
+      AppendUTF8(kReplacementCharacter, &utf8_);
+      p -= n;
+    }
+  }
+}
+
+std::ostream &operator<<(std::ostream &out, const String &str) {
+  return out << str.ToUTF8();
 }
 
 } // namespace base
@@ -0,0 +1,91 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "wiztk/device/video/abstract-frame-source.hpp"
+
+#include "wiztk/async/event-loop.hpp"
+
+namespace wiztk {
+namespace device {
+namespace video {
+
+/**
+ * @brief An epoll event forwards to AbstractFrameSource::OnEvent()
+ */
+class AbstractFrameSource::Watcher : public async::AbstractEvent {
+
+ public:
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(Watcher);
+  Watcher() = delete;
+
+  Watcher(AbstractFrameSource *source, async::EventLoop *event_loop, int fd)
+      : source_(source), event_loop_(event_loop), fd_(fd) {}
+
+  ~Watcher() final = default;
+
+  void Run(uint32_t events) final {
+    source_->OnEvent(events);
+  }
+
+  async::EventLoop *event_loop() const { return event_loop_; }
+
+  int fd() const { return fd_; }
+
+ private:
+
+  AbstractFrameSource *source_ = nullptr;
+
+  async::EventLoop *event_loop_ = nullptr;
+
+  int fd_ = -1;
+
+};
+
+AbstractFrameSource::AbstractFrameSource() = default;
+
+AbstractFrameSource::~AbstractFrameSource() {
+  Unwatch();
+}
+
+bool AbstractFrameSource::IsStreaming() const {
+  return nullptr != watcher_;
+}
+
+bool AbstractFrameSource::Watch(async::EventLoop *event_loop, int fd) {
+  _ASSERT(nullptr == watcher_);
+
+  if (nullptr == event_loop || fd < 0) return false;
+
+  watcher_.reset(new Watcher(this, event_loop, fd));
+  if (!event_loop->WatchFileDescriptor(fd, watcher_.get(), EPOLLIN | EPOLLERR)) {
+    watcher_.reset();
+    return false;
+  }
+
+  return true;
+}
+
+void AbstractFrameSource::Unwatch() {
+  if (nullptr == watcher_) return;
+
+  watcher_->event_loop()->UnwatchFileDescriptor(watcher_->fd());
+  watcher_.reset();
+}
+
+} // namespace video
+} // namespace device
+} // namespace wiztk
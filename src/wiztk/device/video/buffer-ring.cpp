@@ -0,0 +1,56 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "buffer-ring.hpp"
+
+namespace wiztk {
+namespace device {
+namespace video {
+namespace internal {
+
+BufferRing::BufferRing(const Format &format, int count)
+    : format_(format), count_(count), slots_(new Slot[count]) {}
+
+void BufferRing::Unreference() {
+  if (1 == ref_count_.fetch_sub(1, std::memory_order_acq_rel))
+    delete this;
+}
+
+Frame BufferRing::Acquire(int index) {
+  _ASSERT(index >= 0 && index < count_);
+  _ASSERT(0 == slots_[index].use_count);
+
+  slots_[index].use_count.store(1, std::memory_order_release);
+  ref_count_.fetch_add(1, std::memory_order_relaxed);
+  return Frame(this, index);
+}
+
+void BufferRing::Retain(int index) {
+  slots_[index].use_count.fetch_add(1, std::memory_order_relaxed);
+  ref_count_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void BufferRing::Release(int index) {
+  if (1 == slots_[index].use_count.fetch_sub(1, std::memory_order_acq_rel))
+    OnRequeue(index);
+
+  Unreference();
+}
+
+} // namespace internal
+} // namespace video
+} // namespace device
+} // namespace wiztk
@@ -0,0 +1,122 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef WIZTK_DEVICE_VIDEO_BUFFER_RING_HPP_
+#define WIZTK_DEVICE_VIDEO_BUFFER_RING_HPP_
+
+#include "wiztk/device/video/frame.hpp"
+
+#include <atomic>
+#include <memory>
+
+namespace wiztk {
+namespace device {
+namespace video {
+namespace internal {
+
+/**
+ * @brief A ring of capture buffers shared by a frame source and Frame handles
+ *
+ * The frame source holds one reference to the ring, each Frame handle holds
+ * another, so the buffers stay valid while frames are alive even if the
+ * source is stopped or destroyed.
+ */
+class BufferRing {
+
+ public:
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(BufferRing);
+
+  struct Slot {
+
+    void *start = nullptr;
+
+    size_t length = 0;
+
+    size_t bytes_used = 0;
+
+    uint32_t sequence = 0;
+
+    int64_t timestamp = 0;
+
+    int dmabuf_fd = -1;
+
+    std::atomic<int> use_count = {0};
+
+  };
+
+  BufferRing(const Format &format, int count);
+
+  /**
+   * @brief Drop the reference held by the owner
+   */
+  void Unreference();
+
+  /**
+   * @brief Create the first handle of a dequeued buffer
+   */
+  Frame Acquire(int index);
+
+  /**
+   * @brief Add a handle to the buffer
+   */
+  void Retain(int index);
+
+  /**
+   * @brief Drop a handle, re-queue the buffer when it's the last one
+   */
+  void Release(int index);
+
+  /**
+   * @brief Returns true if there's no handle to the buffer
+   */
+  bool IsFree(int index) const { return 0 == slots_[index].use_count.load(std::memory_order_acquire); }
+
+  Slot &slot(int index) const { return slots_[index]; }
+
+  int count() const { return count_; }
+
+  const Format &format() const { return format_; }
+
+ protected:
+
+  virtual ~BufferRing() = default;
+
+  /**
+   * @brief Called when all handles to a buffer are released
+   *
+   * This can be called in any thread which releases the last Frame.
+   */
+  virtual void OnRequeue(int index) = 0;
+
+ private:
+
+  std::atomic<int> ref_count_ = {1};
+
+  Format format_;
+
+  int count_ = 0;
+
+  std::unique_ptr<Slot[]> slots_;
+
+};
+
+} // namespace internal
+} // namespace video
+} // namespace device
+} // namespace wiztk
+
+#endif // WIZTK_DEVICE_VIDEO_BUFFER_RING_HPP_
@@ -16,10 +16,18 @@
 
 #include "wiztk/device/video/camera.hpp"
 
+#include "buffer-ring.hpp"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <string>
 
 #include <fcntl.h>
 #include <unistd.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 
 #include <linux/videodev2.h>
@@ -29,6 +37,201 @@ namespace wiztk {
 namespace device {
 namespace video {
 
+static int xioctl(int fd, unsigned long request, void *arg) {
+  int ret;
+  do {
+    ret = ioctl(fd, request, arg);
+  } while (-1 == ret && EINTR == errno);
+  return ret;
+}
+
+/**
+ * @brief The buffer ring of a V4L2 capture stream
+ *
+ * It keeps a duplicated file descriptor of the device so that buffers can be
+ * re-queued or unmapped after the Camera is closed.
+ */
+class V4L2BufferRing : public internal::BufferRing {
+
+ public:
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(V4L2BufferRing);
+
+  V4L2BufferRing(int fd, const Format &format, int count, Camera::IOMethod io_method)
+      : BufferRing(format, count), fd_(dup(fd)), io_method_(io_method) {}
+
+  /**
+   * @brief Queue a buffer to the driver
+   */
+  bool Enqueue(int index) {
+    struct v4l2_buffer buf = {0};
+
+    buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buf.index = static_cast<uint32_t>(index);
+
+    if (Camera::kIOMethodUserPtr == io_method_) {
+      buf.memory = V4L2_MEMORY_USERPTR;
+      buf.m.userptr = reinterpret_cast<unsigned long>(slot(index).start);
+      buf.length = static_cast<uint32_t>(slot(index).length);
+    } else {
+      buf.memory = V4L2_MEMORY_MMAP;
+    }
+
+    return -1 != xioctl(fd_, VIDIOC_QBUF, &buf);
+  }
+
+  int fd() const { return fd_; }
+
+  Camera::IOMethod io_method() const { return io_method_; }
+
+  std::atomic<bool> streaming = {false};
+
+ protected:
+
+  ~V4L2BufferRing() final {
+    for (int i = 0; i < count(); ++i) {
+      Slot &s = slot(i);
+      if (-1 != s.dmabuf_fd) close(s.dmabuf_fd);
+      if (nullptr == s.start) continue;
+
+      if (Camera::kIOMethodUserPtr == io_method_)
+        free(s.start);
+      else
+        munmap(s.start, s.length);
+    }
+
+    if (-1 != fd_) close(fd_);
+  }
+
+  void OnRequeue(int index) final {
+    if (streaming.load(std::memory_order_acquire))
+      Enqueue(index);
+  }
+
+ private:
+
+  int fd_ = -1;
+
+  Camera::IOMethod io_method_ = Camera::kIOMethodMmap;
+
+};
+
+// -------
+
+/**
+ * @brief The private structure used in Camera
+ */
+struct Camera::Private {
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(Private);
+
+  Private() = default;
+  ~Private() = default;
+
+  /**
+   * @brief Request and prepare the buffers, create a new ring
+   */
+  bool CreateRing();
+
+  /**
+   * @brief Drop the reference to the ring
+   */
+  void DestroyRing();
+
+  int fd = -1;
+
+  Format format;
+
+  IOMethod io_method = kIOMethodMmap;
+
+  int buffer_count = 4;
+
+  bool export_dmabuf = false;
+
+  V4L2BufferRing *ring = nullptr;
+
+};
+
+bool Camera::Private::CreateRing() {
+  struct v4l2_requestbuffers req = {0};
+
+  req.count = static_cast<uint32_t>(buffer_count);
+  req.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+  req.memory = kIOMethodUserPtr == io_method ? V4L2_MEMORY_USERPTR : V4L2_MEMORY_MMAP;
+
+  if (-1 == xioctl(fd, VIDIOC_REQBUFS, &req)) {
+    fprintf(stderr, "Camera: VIDIOC_REQBUFS failed: %s\n", strerror(errno));
+    return false;
+  }
+
+  if (req.count < 2) {
+    fprintf(stderr, "Camera: insufficient buffer memory\n");
+    return false;
+  }
+
+  ring = new V4L2BufferRing(fd, format, static_cast<int>(req.count), io_method);
+
+  for (int i = 0; i < ring->count(); ++i) {
+    internal::BufferRing::Slot &slot = ring->slot(i);
+
+    if (kIOMethodUserPtr == io_method) {
+      slot.length = format.size_image;
+      if (0 != posix_memalign(&slot.start, static_cast<size_t>(getpagesize()), slot.length)) {
+        slot.start = nullptr;
+        DestroyRing();
+        return false;
+      }
+      continue;
+    }
+
+    struct v4l2_buffer buf = {0};
+    buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buf.memory = V4L2_MEMORY_MMAP;
+    buf.index = static_cast<uint32_t>(i);
+
+    if (-1 == xioctl(fd, VIDIOC_QUERYBUF, &buf)) {
+      DestroyRing();
+      return false;
+    }
+
+    void *start = mmap(nullptr, buf.length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, buf.m.offset);
+    if (MAP_FAILED == start) {
+      DestroyRing();
+      return false;
+    }
+    slot.start = start;
+    slot.length = buf.length;
+
+    if (export_dmabuf) {
+      struct v4l2_exportbuffer expbuf = {0};
+      expbuf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+      expbuf.index = static_cast<uint32_t>(i);
+      expbuf.flags = O_RDONLY | O_CLOEXEC;
+      if (-1 != xioctl(fd, VIDIOC_EXPBUF, &expbuf))
+        slot.dmabuf_fd = expbuf.fd;
+    }
+  }
+
+  return true;
+}
+
+void Camera::Private::DestroyRing() {
+  if (nullptr == ring) return;
+
+  ring->streaming.store(false, std::memory_order_release);
+  ring->Unreference();
+  ring = nullptr;
+}
+
+// -------
+
+Camera::Camera()
+    : p_(new Private) {}
+
+Camera::~Camera() {
+  Close();
+}
+
 void Camera::GetAll() {
   int fd = -1;
 
@@ -46,6 +249,177 @@ void Camera::GetAll() {
   }
 }
 
+bool Camera::Open(const char *dev_name) {
+  Close();
+
+  int fd = OpenDevice(dev_name);
+  if (-1 == fd) return false;
+
+  struct v4l2_capability cap = {0};
+  if (-1 == xioctl(fd, VIDIOC_QUERYCAP, &cap) ||
+      !(cap.capabilities & V4L2_CAP_VIDEO_CAPTURE) ||
+      !(cap.capabilities & V4L2_CAP_STREAMING)) {
+    close(fd);
+    return false;
+  }
+
+  p_->fd = fd;
+
+  // Query the current format:
+  struct v4l2_format fmt = {0};
+  fmt.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+  if (-1 != xioctl(fd, VIDIOC_G_FMT, &fmt)) {
+    p_->format.pixel_format = fmt.fmt.pix.pixelformat;
+    p_->format.width = fmt.fmt.pix.width;
+    p_->format.height = fmt.fmt.pix.height;
+    p_->format.bytes_per_line = fmt.fmt.pix.bytesperline;
+    p_->format.size_image = fmt.fmt.pix.sizeimage;
+  }
+
+  return true;
+}
+
+void Camera::Close() {
+  Stop();
+
+  if (-1 != p_->fd) {
+    close(p_->fd);
+    p_->fd = -1;
+  }
+
+  p_->format = Format();
+}
+
+bool Camera::IsOpen() const {
+  return -1 != p_->fd;
+}
+
+bool Camera::SetFormat(uint32_t pixel_format, int width, int height) {
+  if (-1 == p_->fd || IsStreaming()) return false;
+
+  struct v4l2_format fmt = {0};
+  fmt.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+  fmt.fmt.pix.width = static_cast<uint32_t>(width);
+  fmt.fmt.pix.height = static_cast<uint32_t>(height);
+  fmt.fmt.pix.pixelformat = pixel_format;
+  fmt.fmt.pix.field = V4L2_FIELD_NONE;
+
+  if (-1 == xioctl(p_->fd, VIDIOC_S_FMT, &fmt)) return false;
+
+  // The driver may change the pixel format:
+  if (fmt.fmt.pix.pixelformat != pixel_format) return false;
+
+  // Buggy driver paranoia, see the capture example in V4L2 documentation,
+  // the minimum stride and size depend on the pixel format:
+  p_->format = Format::Make(fmt.fmt.pix.pixelformat,
+                            static_cast<int>(fmt.fmt.pix.width),
+                            static_cast<int>(fmt.fmt.pix.height),
+                            static_cast<int>(fmt.fmt.pix.bytesperline),
+                            fmt.fmt.pix.sizeimage);
+
+  return true;
+}
+
+const Format &Camera::GetFormat() const {
+  return p_->format;
+}
+
+void Camera::SetIOMethod(IOMethod method) {
+  p_->io_method = method;
+}
+
+Camera::IOMethod Camera::GetIOMethod() const {
+  return p_->io_method;
+}
+
+void Camera::SetBufferCount(int count) {
+  p_->buffer_count = count < 2 ? 2 : count;
+}
+
+void Camera::SetExportDmaBuf(bool export_dmabuf) {
+  p_->export_dmabuf = export_dmabuf;
+}
+
+bool Camera::Start(async::EventLoop *event_loop) {
+  if (-1 == p_->fd || IsStreaming() || 0 == p_->format.size_image) return false;
+
+  if (!p_->CreateRing()) return false;
+
+  for (int i = 0; i < p_->ring->count(); ++i) {
+    if (!p_->ring->Enqueue(i)) {
+      p_->DestroyRing();
+      return false;
+    }
+  }
+
+  enum v4l2_buf_type type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+  if (-1 == xioctl(p_->fd, VIDIOC_STREAMON, &type)) {
+    p_->DestroyRing();
+    return false;
+  }
+
+  p_->ring->streaming.store(true, std::memory_order_release);
+
+  if (!Watch(event_loop, p_->fd)) {
+    xioctl(p_->fd, VIDIOC_STREAMOFF, &type);
+    p_->DestroyRing();
+    return false;
+  }
+
+  return true;
+}
+
+void Camera::Stop() {
+  if (!IsStreaming()) return;
+
+  Unwatch();
+
+  // Stop re-queuing before STREAMOFF which returns all buffers to user space:
+  p_->ring->streaming.store(false, std::memory_order_release);
+
+  enum v4l2_buf_type type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+  xioctl(p_->fd, VIDIOC_STREAMOFF, &type);
+
+  p_->DestroyRing();
+}
+
+void Camera::OnEvent(uint32_t /* events */) {
+  struct v4l2_buffer buf;
+
+  // Drain all ready buffers, the device is opened in non-blocking mode:
+  while (nullptr != p_->ring) {
+    memset(&buf, 0, sizeof(buf));
+    buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buf.memory = kIOMethodUserPtr == p_->io_method ? V4L2_MEMORY_USERPTR : V4L2_MEMORY_MMAP;
+
+    if (-1 == xioctl(p_->fd, VIDIOC_DQBUF, &buf)) {
+      if (EAGAIN != errno)
+        fprintf(stderr, "Camera: VIDIOC_DQBUF failed: %s\n", strerror(errno));
+      break;
+    }
+
+    int index = static_cast<int>(buf.index);
+    if (kIOMethodUserPtr == p_->io_method) {
+      // Find the buffer by address, see the capture example in V4L2 documentation:
+      for (index = 0; index < p_->ring->count(); ++index) {
+        if (buf.m.userptr == reinterpret_cast<unsigned long>(p_->ring->slot(index).start)) break;
+      }
+    }
+
+    if (index < 0 || index >= p_->ring->count()) continue;
+
+    internal::BufferRing::Slot &slot = p_->ring->slot(index);
+    slot.bytes_used = buf.bytesused;
+    slot.sequence = buf.sequence;
+    slot.timestamp = static_cast<int64_t>(buf.timestamp.tv_sec) * 1000000 + buf.timestamp.tv_usec;
+
+    // The buffer is re-queued when the last handle is released, this may be in
+    // a slot connected to frame_ready(), or later in any thread:
+    Frame frame = p_->ring->Acquire(index);
+    EmitFrame(frame);
+  }
+}
+
 int Camera::OpenDevice(const char *dev_name) {
   int fd = -1;
   struct stat st = {0};
@@ -60,7 +434,7 @@ int Camera::OpenDevice(const char *dev_name) {
     return fd;
   }
 
-  fd = open(dev_name, O_RDWR | O_NONBLOCK, 0);
+  fd = open(dev_name, O_RDWR | O_NONBLOCK | O_CLOEXEC, 0);
 
   return fd;
 }
@@ -0,0 +1,263 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "wiztk/device/video/file-frame-source.hpp"
+
+#include "buffer-ring.hpp"
+
+#include <ctime>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/timerfd.h>
+
+namespace wiztk {
+namespace device {
+namespace video {
+
+/**
+ * @brief A buffer ring whose slots point into a mapped file
+ */
+class FileBufferRing : public internal::BufferRing {
+
+ public:
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(FileBufferRing);
+
+  FileBufferRing(const Format &format, int count, void *data, size_t size)
+      : BufferRing(format, count), data_(data), size_(size) {}
+
+  const uint8_t *data() const { return static_cast<const uint8_t *>(data_); }
+
+ protected:
+
+  ~FileBufferRing() final {
+    munmap(data_, size_);
+  }
+
+  void OnRequeue(int /* index */) final {
+    // Nothing to do, the slot is free when the use count drops to 0.
+  }
+
+ private:
+
+  void *data_ = nullptr;
+
+  size_t size_ = 0;
+
+};
+
+// -------
+
+/**
+ * @brief The private structure used in FileFrameSource
+ */
+struct FileFrameSource::Private {
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(Private);
+
+  Private() = default;
+  ~Private() = default;
+
+  int fd = -1;
+
+  int timer_fd = -1;
+
+  Format format;
+
+  int frame_count = 0;
+
+  int frame_rate = 30;
+
+  int buffer_count = 4;
+
+  bool loop = true;
+
+  FileBufferRing *ring = nullptr;
+
+  int next_frame = 0;
+
+  int next_slot = 0;
+
+  uint32_t sequence = 0;
+
+  uint32_t dropped = 0;
+
+};
+
+FileFrameSource::FileFrameSource()
+    : p_(new Private) {}
+
+FileFrameSource::~FileFrameSource() {
+  Close();
+}
+
+bool FileFrameSource::Open(const char *path, const Format &format) {
+  Close();
+
+  if (0 == format.size_image) return false;
+
+  int fd = open(path, O_RDONLY | O_CLOEXEC);
+  if (-1 == fd) return false;
+
+  struct stat st = {0};
+  if (-1 == fstat(fd, &st) || static_cast<size_t>(st.st_size) < format.size_image) {
+    close(fd);
+    return false;
+  }
+
+  p_->fd = fd;
+  p_->format = format;
+  p_->frame_count = static_cast<int>(static_cast<size_t>(st.st_size) / format.size_image);
+
+  return true;
+}
+
+void FileFrameSource::Close() {
+  Stop();
+
+  if (-1 != p_->fd) {
+    close(p_->fd);
+    p_->fd = -1;
+  }
+
+  p_->format = Format();
+  p_->frame_count = 0;
+}
+
+const Format &FileFrameSource::GetFormat() const {
+  return p_->format;
+}
+
+int FileFrameSource::GetFrameCount() const {
+  return p_->frame_count;
+}
+
+void FileFrameSource::SetFrameRate(int fps) {
+  p_->frame_rate = fps < 1 ? 1 : fps;
+}
+
+void FileFrameSource::SetBufferCount(int count) {
+  p_->buffer_count = count < 1 ? 1 : count;
+}
+
+void FileFrameSource::SetLoop(bool loop) {
+  p_->loop = loop;
+}
+
+uint32_t FileFrameSource::GetDroppedCount() const {
+  return p_->dropped;
+}
+
+bool FileFrameSource::Start(async::EventLoop *event_loop) {
+  if (-1 == p_->fd || IsStreaming()) return false;
+
+  size_t size = p_->format.size_image * p_->frame_count;
+  void *data = mmap(nullptr, size, PROT_READ, MAP_SHARED, p_->fd, 0);
+  if (MAP_FAILED == data) return false;
+
+  p_->timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+  if (-1 == p_->timer_fd) {
+    munmap(data, size);
+    return false;
+  }
+
+  p_->ring = new FileBufferRing(p_->format, p_->buffer_count, data, size);
+  p_->next_frame = 0;
+  p_->next_slot = 0;
+  p_->sequence = 0;
+  p_->dropped = 0;
+
+  struct itimerspec spec = {{0, 0}, {0, 0}};
+  long interval = 1000000000L / p_->frame_rate;
+  spec.it_interval.tv_sec = interval / 1000000000L;
+  spec.it_interval.tv_nsec = interval % 1000000000L;
+  spec.it_value = spec.it_interval;
+
+  if (-1 == timerfd_settime(p_->timer_fd, 0, &spec, nullptr) || !Watch(event_loop, p_->timer_fd)) {
+    Stop();
+    return false;
+  }
+
+  return true;
+}
+
+void FileFrameSource::Stop() {
+  Unwatch();
+
+  if (-1 != p_->timer_fd) {
+    close(p_->timer_fd);
+    p_->timer_fd = -1;
+  }
+
+  if (nullptr != p_->ring) {
+    p_->ring->Unreference();
+    p_->ring = nullptr;
+  }
+}
+
+void FileFrameSource::OnEvent(uint32_t /* events */) {
+  uint64_t expirations = 0;
+  if (sizeof(expirations) != read(p_->timer_fd, &expirations, sizeof(expirations)))
+    return;
+
+  // Deliver one frame per wakeup, the missed ticks are counted as dropped:
+  p_->sequence += static_cast<uint32_t>(expirations);
+  p_->dropped += static_cast<uint32_t>(expirations - 1);
+
+  if (p_->next_frame >= p_->frame_count) {
+    if (!p_->loop) return;
+    p_->next_frame = 0;
+  }
+
+  int count = p_->ring->count();
+  int index = -1;
+  for (int i = 0; i < count; ++i) {
+    int n = (p_->next_slot + i) % count;
+    if (p_->ring->IsFree(n)) {
+      index = n;
+      break;
+    }
+  }
+
+  if (-1 == index) {
+    ++p_->dropped;
+    ++p_->next_frame;
+    return;
+  }
+
+  struct timespec now = {0, 0};
+  clock_gettime(CLOCK_MONOTONIC, &now);
+
+  internal::BufferRing::Slot &slot = p_->ring->slot(index);
+  slot.start = const_cast<uint8_t *>(p_->ring->data() + p_->format.size_image * p_->next_frame);
+  slot.length = p_->format.size_image;
+  slot.bytes_used = p_->format.size_image;
+  slot.sequence = p_->sequence - 1;
+  slot.timestamp = static_cast<int64_t>(now.tv_sec) * 1000000 + now.tv_nsec / 1000;
+
+  p_->next_slot = (index + 1) % count;
+  ++p_->next_frame;
+
+  Frame frame = p_->ring->Acquire(index);
+  EmitFrame(frame);
+}
+
+} // namespace video
+} // namespace device
+} // namespace wiztk
@@ -0,0 +1,142 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "wiztk/device/video/frame.hpp"
+
+#include "buffer-ring.hpp"
+
+#include <linux/videodev2.h>
+
+namespace wiztk {
+namespace device {
+namespace video {
+
+Format Format::Make(uint32_t pixel_format, int width, int height, int bytes_per_line, size_t size_image) {
+  Format format;
+  format.pixel_format = pixel_format;
+  format.width = width;
+  format.height = height;
+  format.bytes_per_line = bytes_per_line;
+  format.size_image = size_image;
+
+  int min_stride = 0;
+  size_t min_size = 0;
+
+  switch (pixel_format) {
+    case V4L2_PIX_FMT_YUYV:
+    case V4L2_PIX_FMT_UYVY: {
+      min_stride = width * 2;
+      if (format.bytes_per_line < min_stride) format.bytes_per_line = min_stride;
+      min_size = static_cast<size_t>(format.bytes_per_line) * height;
+      break;
+    }
+    case V4L2_PIX_FMT_NV12:
+    case V4L2_PIX_FMT_YUV420: {
+      // Both chroma planes of YU12 have half the stride and half the rows:
+      min_stride = width;
+      if (format.bytes_per_line < min_stride) format.bytes_per_line = min_stride;
+      min_size = static_cast<size_t>(format.bytes_per_line) * height
+          + static_cast<size_t>(format.bytes_per_line) * ((height + 1) / 2);
+      break;
+    }
+    default: {
+      return format;
+    }
+  }
+
+  if (format.size_image < min_size) format.size_image = min_size;
+
+  return format;
+}
+
+Frame::Frame(const Frame &other)
+    : ring_(other.ring_), index_(other.index_) {
+  if (nullptr != ring_) ring_->Retain(index_);
+}
+
+Frame::Frame(Frame &&other) noexcept
+    : ring_(other.ring_), index_(other.index_) {
+  other.ring_ = nullptr;
+  other.index_ = -1;
+}
+
+Frame::~Frame() {
+  Reset();
+}
+
+Frame &Frame::operator=(const Frame &other) {
+  if (this != &other) {
+    if (nullptr != other.ring_) other.ring_->Retain(other.index_);
+    Reset();
+    ring_ = other.ring_;
+    index_ = other.index_;
+  }
+  return *this;
+}
+
+Frame &Frame::operator=(Frame &&other) noexcept {
+  if (this != &other) {
+    Reset();
+    ring_ = other.ring_;
+    index_ = other.index_;
+    other.ring_ = nullptr;
+    other.index_ = -1;
+  }
+  return *this;
+}
+
+void Frame::Reset() {
+  if (nullptr == ring_) return;
+
+  internal::BufferRing *ring = ring_;
+  int index = index_;
+  ring_ = nullptr;
+  index_ = -1;
+  ring->Release(index);
+}
+
+const void *Frame::GetData() const {
+  return nullptr == ring_ ? nullptr : ring_->slot(index_).start;
+}
+
+size_t Frame::GetSize() const {
+  return nullptr == ring_ ? 0 : ring_->slot(index_).bytes_used;
+}
+
+const Format &Frame::GetFormat() const {
+  static const Format kEmpty;
+  return nullptr == ring_ ? kEmpty : ring_->format();
+}
+
+uint32_t Frame::GetSequence() const {
+  return nullptr == ring_ ? 0 : ring_->slot(index_).sequence;
+}
+
+int64_t Frame::GetTimestamp() const {
+  return nullptr == ring_ ? 0 : ring_->slot(index_).timestamp;
+}
+
+int Frame::GetDmaBufFd() const {
+  return nullptr == ring_ ? -1 : ring_->slot(index_).dmabuf_fd;
+}
+
+int Frame::GetUseCount() const {
+  return nullptr == ring_ ? 0 : ring_->slot(index_).use_count.load(std::memory_order_relaxed);
+}
+
+} // namespace video
+} // namespace device
+} // namespace wiztk
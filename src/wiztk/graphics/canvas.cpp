@@ -22,12 +22,10 @@
 #include "image-info/private.hpp"
 #include "bitmap/private.hpp"
 #include "image/private.hpp"
+#include "picture/private.hpp"
 #include "surface/private.hpp"
 #include "surface-props/private.hpp"
 
-#include <unicode/utf.h>
-#include <unicode/unistr.h>
-
 namespace wiztk {
 namespace graphics {
 
@@ -97,6 +95,9 @@ Canvas::Canvas(Surface *surface) {
   p_ = std::make_unique<Private>(surface);
 }
 
+Canvas::Canvas(Private *p)
+    : p_(p) {}
+
 Canvas::~Canvas() = default;
 
 Canvas &Canvas::operator=(Canvas &&other) noexcept {
@@ -168,12 +169,7 @@ void Canvas::DrawText(const std::string &text, float x, float y, const Paint &pa
 
 void Canvas::DrawText(const String &text, float x, float y, const Paint &paint,
                       TextAlignment::Vertical vert) {
-  // TODO: This create and copy the string array from String16 to icu::UnicodeString, find a better way for performance.
-  std::string utf8;
-  icu::UnicodeString utf16(text.data(), static_cast<uint32_t>(text.length()));
-  utf16.toUTF8String(utf8);
-
-  DrawAlignedText(utf8.data(), utf8.length(), x, y, paint, vert);
+  DrawAlignedText(text.data(), text.size(), x, y, paint, vert);
 }
 
 void Canvas::DrawImageRect(const Image &img, const RectF &src, const RectF &dst) {
@@ -183,6 +179,12 @@ void Canvas::DrawImageRect(const Image &img, const RectF &src, const RectF &dst)
                                nullptr);
 }
 
+void Canvas::DrawPicture(const Picture &picture, const Matrix *matrix, const Paint *paint) {
+  p_->sk_canvas->drawPicture(Picture::Private::Get(picture).sk_picture_sp.get(),
+                             nullptr == matrix ? nullptr : &Matrix::Private::Get(*matrix).sk_matrix,
+                             nullptr == paint ? nullptr : &Paint::Private::Get(*paint).sk_paint);
+}
+
 void Canvas::DrawPaint(const Paint &paint) {
   p_->sk_canvas->drawPaint(Paint::Private::Get(paint).sk_paint);
 }
@@ -327,10 +329,7 @@ void Canvas::DrawAlignedText(const void *text,
 Canvas::LockGuard::~LockGuard() {
   if (node_.is_linked()) {
     base::Deque<LockGuardNode>::ReverseIterator it = canvas_->p_->lock_guard_deque.rbegin();
-    while (it.get() != &node_) {
-      it.remove();
-      it = canvas_->p_->lock_guard_deque.rbegin();
-    }
+    while (it.get() != &node_) it.remove();
     canvas_->p_->sk_canvas->restoreToCount(node_.depth);
   }
 }
@@ -384,10 +383,7 @@ void Canvas::LockGuard::Unlock() {
   if (!node_.is_linked()) return;
 
   base::Deque<LockGuardNode>::ReverseIterator it = canvas_->p_->lock_guard_deque.rbegin();
-  while (it.get() != &node_) {
-    it.remove();
-    it = canvas_->p_->lock_guard_deque.rbegin();
-  }
+  while (it.get() != &node_) it.remove();
   canvas_->p_->sk_canvas->restoreToCount(node_.depth);
   node_.unlink();
 }
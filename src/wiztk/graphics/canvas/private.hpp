@@ -59,8 +59,16 @@ struct Canvas::Private {
     sk_canvas = Surface::Private::Get(*surface).sk_surface_sp->getCanvas();
   }
 
+  /**
+   * @brief Wrap a SkCanvas owned by others, e.g. the recording canvas of a SkPictureRecorder
+   */
+  explicit Private(SkCanvas *canvas)
+      : sk_canvas(canvas), is_borrowed(true) {
+    _ASSERT(nullptr != sk_canvas);
+  }
+
   ~Private() {
-    if (nullptr == surface) delete sk_canvas;
+    if (nullptr == surface && !is_borrowed) delete sk_canvas;
   }
 
   SkCanvas *sk_canvas = nullptr;
@@ -71,6 +79,11 @@ struct Canvas::Private {
    */
   Surface *surface = nullptr;
 
+  /**
+   * If true, the sk_canvas is owned by others and is not deleted with this canvas.
+   */
+  bool is_borrowed = false;
+
   Point2F origin;
 
   size_t lock_count = 0;
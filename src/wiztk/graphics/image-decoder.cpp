@@ -0,0 +1,428 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "wiztk/graphics/image-decoder.hpp"
+
+#include "image/private.hpp"
+
+#include "wiztk/async/event-loop.hpp"
+
+#include "SkAndroidCodec.h"
+#include "SkBitmap.h"
+#include "SkData.h"
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace wiztk {
+namespace graphics {
+
+namespace {
+
+/**
+ * @brief The key of a request and of the cache
+ */
+struct Key {
+
+  Key() = default;
+
+  Key(const std::string &path, int width, int height)
+      : path(path), width(std::max(width, 0)), height(std::max(height, 0)) {}
+
+  bool operator==(const Key &other) const {
+    return width == other.width && height == other.height && path == other.path;
+  }
+
+  std::string path;
+
+  int width = 0;
+
+  int height = 0;
+
+};
+
+struct KeyHash {
+
+  size_t operator()(const Key &key) const {
+    size_t hash = std::hash<std::string>()(key.path);
+    hash ^= std::hash<int>()(key.width) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    hash ^= std::hash<int>()(key.height) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    return hash;
+  }
+
+};
+
+/**
+ * @brief Get the size to fit the source in width x height, never scales up
+ */
+SkISize GetTargetSize(const SkISize &source, int width, int height) {
+  if (source.isEmpty() || (width <= 0 && height <= 0)) return source;
+
+  double scale_x = width > 0 ? static_cast<double>(width) / source.width() : 1.0;
+  double scale_y = height > 0 ? static_cast<double>(height) / source.height() : 1.0;
+  double scale = std::min(std::min(scale_x, scale_y), 1.0);
+
+  return SkISize::Make(std::max(1, static_cast<int>(std::lround(source.width() * scale))),
+                       std::max(1, static_cast<int>(std::lround(source.height() * scale))));
+}
+
+/**
+ * @brief Decode into a sk_sp<SkImage>, can be called in any thread
+ */
+sk_sp<SkImage> DecodeFile(const std::string &path, int width, int height) {
+  sk_sp<SkData> data = SkData::MakeFromFileName(path.c_str());
+  if (!data) return nullptr;
+
+  std::unique_ptr<SkAndroidCodec> codec = SkAndroidCodec::MakeFromData(std::move(data));
+  if (!codec) return nullptr;
+
+  SkISize target = GetTargetSize(codec->getInfo().dimensions(), width, height);
+
+  // Let the codec skip the pixels not needed, the sampled size is equal to or
+  // a little larger than the target:
+  SkISize sampled = target;
+  SkAndroidCodec::AndroidOptions options;
+  options.fSampleSize = codec->computeSampleSize(&sampled);
+
+  SkImageInfo info = SkImageInfo::MakeN32(sampled.width(),
+                                          sampled.height(),
+                                          codec->computeOutputAlphaType(false));
+  SkBitmap bitmap;
+  if (!bitmap.tryAllocPixels(info)) return nullptr;
+
+  switch (codec->getAndroidPixels(info, bitmap.getPixels(), bitmap.rowBytes(), &options)) {
+    case SkCodec::kSuccess:
+    case SkCodec::kIncompleteInput:
+    case SkCodec::kErrorInInput: break;
+    default: return nullptr;
+  }
+
+  if (sampled != target) {
+    SkBitmap scaled;
+    if (!scaled.tryAllocPixels(info.makeWH(target.width(), target.height()))) return nullptr;
+    if (!bitmap.pixmap().scalePixels(scaled.pixmap(), kMedium_SkFilterQuality)) return nullptr;
+    bitmap.swap(scaled);
+  }
+
+  bitmap.setImmutable();
+  return SkImage::MakeFromBitmap(bitmap);
+}
+
+size_t GetByteSize(const Image &image) {
+  return static_cast<size_t>(image.GetWidth()) * image.GetHeight() * 4;
+}
+
+} // namespace
+
+/**
+ * @brief An epoll event on the eventfd written by the worker threads
+ */
+class ImageDecoder::WakeupEvent : public async::AbstractEvent {
+
+ public:
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(WakeupEvent);
+  WakeupEvent() = delete;
+
+  explicit WakeupEvent(ImageDecoder *decoder)
+      : decoder_(decoder) {}
+
+  ~WakeupEvent() final = default;
+
+  void Run(uint32_t events) final {
+    decoder_->DispatchResults();
+  }
+
+ private:
+
+  ImageDecoder *decoder_ = nullptr;
+
+};
+
+/**
+ * @brief The private structure used in ImageDecoder
+ */
+struct ImageDecoder::Private {
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(Private);
+
+  struct CacheEntry {
+
+    Key key;
+
+    Image image;
+
+  };
+
+  using CacheList = std::list<CacheEntry>;
+
+  Private() = default;
+
+  ~Private() = default;
+
+  /**
+   * @brief The loop of worker threads
+   */
+  void Work();
+
+  /**
+   * @brief Push a result and wake up the event loop, must be locked
+   */
+  void PostResult(Result &&result);
+
+  void InsertCache(const Key &key, const Image &image);
+
+  void Evict();
+
+  std::mutex mutex;
+
+  std::condition_variable condition;
+
+  /**
+   * @brief Requests not started yet, guarded by mutex
+   */
+  std::deque<Key> jobs;
+
+  /**
+   * @brief Requests queued or being decoded, guarded by mutex
+   */
+  std::unordered_set<Key, KeyHash> pending;
+
+  /**
+   * @brief Results to be emitted, guarded by mutex
+   */
+  std::deque<Result> results;
+
+  bool quit = false;
+
+  std::vector<std::thread> threads;
+
+  async::EventLoop *event_loop = nullptr;
+
+  int event_fd = -1;
+
+  std::unique_ptr<WakeupEvent> wakeup_event;
+
+  // The cache is used in the event loop thread only:
+
+  CacheList cache_list;
+
+  std::unordered_map<Key, CacheList::iterator, KeyHash> cache_index;
+
+  size_t cache_size = 0;
+
+  size_t cache_capacity = kDefaultCacheCapacity;
+
+};
+
+void ImageDecoder::Private::Work() {
+  std::unique_lock<std::mutex> lock(mutex);
+
+  while (true) {
+    condition.wait(lock, [this] { return quit || !jobs.empty(); });
+    if (quit) break;
+
+    Key key = std::move(jobs.front());
+    jobs.pop_front();
+    lock.unlock();
+
+    Result result;
+    result.path = key.path;
+    result.width = key.width;
+    result.height = key.height;
+    result.image = ImageDecoder::Decode(key.path, key.width, key.height);
+
+    lock.lock();
+    PostResult(std::move(result));
+  }
+}
+
+void ImageDecoder::Private::PostResult(Result &&result) {
+  bool empty = results.empty();
+  results.push_back(std::move(result));
+
+  // One write is enough until the results are taken:
+  if (empty) eventfd_write(event_fd, 1);
+}
+
+void ImageDecoder::Private::InsertCache(const Key &key, const Image &image) {
+  auto it = cache_index.find(key);
+  if (it != cache_index.end()) {
+    cache_list.splice(cache_list.begin(), cache_list, it->second);
+    return;
+  }
+
+  size_t bytes = GetByteSize(image);
+  if (bytes > cache_capacity) return;
+
+  cache_list.push_front(CacheEntry{key, image});
+  cache_index[key] = cache_list.begin();
+  cache_size += bytes;
+
+  Evict();
+}
+
+void ImageDecoder::Private::Evict() {
+  while (cache_size > cache_capacity && !cache_list.empty()) {
+    CacheEntry &entry = cache_list.back();
+    cache_size -= GetByteSize(entry.image);
+    cache_index.erase(entry.key);
+    cache_list.pop_back();
+  }
+}
+
+// -------
+
+Image ImageDecoder::Decode(const std::string &path, int width, int height) {
+  Image image;
+  image.p_->sk_image_sp = DecodeFile(path, width, height);
+  return image;
+}
+
+ImageDecoder::ImageDecoder(async::EventLoop *event_loop, int thread_count) {
+  p_ = std::make_unique<Private>();
+
+  p_->event_loop = nullptr == event_loop ? async::EventLoop::GetCurrent() : event_loop;
+  _ASSERT(nullptr != p_->event_loop);
+
+  p_->event_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  if (p_->event_fd < 0) throw std::runtime_error("Error! Cannot create eventfd for ImageDecoder!");
+
+  p_->wakeup_event.reset(new WakeupEvent(this));
+  p_->event_loop->WatchFileDescriptor(p_->event_fd, p_->wakeup_event.get(), EPOLLIN | EPOLLERR);
+
+  if (thread_count <= 0) {
+    // Leave a CPU to the event loop:
+    int cpus = static_cast<int>(std::thread::hardware_concurrency());
+    thread_count = std::min(std::max(cpus - 1, 1), 4);
+  }
+
+  for (int i = 0; i < thread_count; ++i) {
+    p_->threads.emplace_back(&Private::Work, p_.get());
+  }
+}
+
+ImageDecoder::~ImageDecoder() {
+  {
+    std::lock_guard<std::mutex> lock(p_->mutex);
+    p_->quit = true;
+  }
+  p_->condition.notify_all();
+
+  for (auto &thread : p_->threads) thread.join();
+
+  p_->event_loop->UnwatchFileDescriptor(p_->event_fd);
+  close(p_->event_fd);
+}
+
+void ImageDecoder::Load(const std::string &path, int width, int height) {
+  Key key(path, width, height);
+
+  auto it = p_->cache_index.find(key);
+  if (it != p_->cache_index.end()) {
+    Result result;
+    result.path = key.path;
+    result.width = key.width;
+    result.height = key.height;
+    result.image = it->second->image;
+
+    std::lock_guard<std::mutex> lock(p_->mutex);
+    p_->PostResult(std::move(result));
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(p_->mutex);
+    if (!p_->pending.insert(key).second) return;
+    p_->jobs.push_back(std::move(key));
+  }
+  p_->condition.notify_one();
+}
+
+bool ImageDecoder::Cancel(const std::string &path, int width, int height) {
+  Key key(path, width, height);
+  std::lock_guard<std::mutex> lock(p_->mutex);
+
+  auto it = std::find(p_->jobs.begin(), p_->jobs.end(), key);
+  if (it == p_->jobs.end()) return false;
+
+  p_->jobs.erase(it);
+  p_->pending.erase(key);
+  return true;
+}
+
+Image ImageDecoder::Find(const std::string &path, int width, int height) const {
+  auto it = p_->cache_index.find(Key(path, width, height));
+  if (it == p_->cache_index.end()) return Image();
+
+  p_->cache_list.splice(p_->cache_list.begin(), p_->cache_list, it->second);
+  return it->second->image;
+}
+
+void ImageDecoder::SetCacheCapacity(size_t bytes) {
+  p_->cache_capacity = bytes;
+  p_->Evict();
+}
+
+size_t ImageDecoder::GetCacheCapacity() const {
+  return p_->cache_capacity;
+}
+
+size_t ImageDecoder::GetCacheSize() const {
+  return p_->cache_size;
+}
+
+void ImageDecoder::ClearCache() {
+  p_->cache_index.clear();
+  p_->cache_list.clear();
+  p_->cache_size = 0;
+}
+
+void ImageDecoder::DispatchResults() {
+  eventfd_t value = 0;
+  eventfd_read(p_->event_fd, &value);
+
+  std::deque<Result> results;
+  {
+    std::lock_guard<std::mutex> lock(p_->mutex);
+    results.swap(p_->results);
+    for (const Result &result : results) {
+      p_->pending.erase(Key(result.path, result.width, result.height));
+    }
+  }
+
+  for (const Result &result : results) {
+    if (result.image.IsValid())
+      p_->InsertCache(Key(result.path, result.width, result.height), result.image);
+    decoded_.Emit(result);
+  }
+}
+
+} // namespace graphics
+} // namespace wiztk
@@ -38,8 +38,9 @@ Image::Image(const Image &other) {
   p_ = std::make_unique<Private>(*other.p_);
 }
 
-Image::Image(Image &&other) noexcept {
-  p_ = std::move(other.p_);
+Image::Image(Image &&other) noexcept
+    : Image() {
+  p_->sk_image_sp = std::move(other.p_->sk_image_sp);
 }
 
 Image::~Image() = default;
@@ -50,9 +51,21 @@ Image &Image::operator=(const Image &other) {
 }
 
 Image &Image::operator=(Image &&other) noexcept {
-  p_ = std::move(other.p_);
+  p_->sk_image_sp = std::move(other.p_->sk_image_sp);
   return *this;
 }
 
+bool Image::IsValid() const {
+  return nullptr != p_->sk_image_sp;
+}
+
+int Image::GetWidth() const {
+  return p_->sk_image_sp ? p_->sk_image_sp->width() : 0;
+}
+
+int Image::GetHeight() const {
+  return p_->sk_image_sp ? p_->sk_image_sp->height() : 0;
+}
+
 } // namespace graphics
 } // namespace wiztk
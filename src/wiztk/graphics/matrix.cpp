@@ -19,20 +19,13 @@
 namespace wiztk {
 namespace graphics {
 
-Matrix::Matrix() {
-  p_ = std::make_unique<Private>();
-}
+Matrix::Matrix() = default;
 
-Matrix::Matrix(const Matrix &other) {
-  p_ = std::make_unique<Private>(*other.p_);
-}
+Matrix::Matrix(const Matrix &other) = default;
 
 Matrix::~Matrix() = default;
 
-Matrix &Matrix::operator=(const Matrix &other) {
-  *p_ = *other.p_;
-  return *this;
-}
+Matrix &Matrix::operator=(const Matrix &other) = default;
 
 } // namespace graphics
 } // namespace wiztk
@@ -22,20 +22,13 @@
 namespace wiztk {
 namespace graphics {
 
-Paint::Paint() {
-  p_ = std::make_unique<Private>();
-}
+Paint::Paint() = default;
 
-Paint::Paint(const Paint &orig) {
-  p_ = std::make_unique<Private>(*orig.p_);
-}
+Paint::Paint(const Paint &orig) = default;
 
 Paint::~Paint() = default;
 
-Paint &Paint::operator=(const Paint &other) {
-  *p_ = *other.p_;
-  return *this;
-}
+Paint &Paint::operator=(const Paint &other) = default;
 
 uint32_t Paint::GetHash() const {
   return p_->sk_paint.getHash();
@@ -161,11 +154,11 @@ float Paint::MeasureText(const void *text, size_t length, RectF *boulds) const {
 }
 
 bool operator==(const Paint &paint1, const Paint &paint2) {
-  return paint1.p_ == paint2.p_;
+  return paint1.p_.get() == paint2.p_.get();
 }
 
 bool operator!=(const Paint &paint1, const Paint &paint2) {
-  return paint1.p_ != paint2.p_;
+  return paint1.p_.get() != paint2.p_.get();
 }
 
 } // namespace graphics
@@ -22,21 +22,13 @@ namespace graphics {
 using base::Point2F;
 using base::RectF;
 
-Path::Path() {
-  p_.reset(new Private);
-}
+Path::Path() = default;
 
-Path::Path(const Path &other) {
-  p_.reset(new Private(*other.p_));
-}
+Path::Path(const Path &other) = default;
 
-Path::~Path() {
-}
+Path::~Path() = default;
 
-Path &Path::operator=(const Path &other) {
-  *p_ = *other.p_;
-  return *this;
-}
+Path &Path::operator=(const Path &other) = default;
 
 bool Path::IsInterpolatable(const Path &compare) const {
   return p_->sk_path.isInterpolatable(compare.p_->sk_path);
@@ -0,0 +1,79 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "wiztk/graphics/picture-recorder.hpp"
+
+#include "picture/private.hpp"
+#include "canvas/private.hpp"
+
+#include "SkBBHFactory.h"
+#include "SkPictureRecorder.h"
+
+namespace wiztk {
+namespace graphics {
+
+/**
+ * @brief The private structure used in PictureRecorder
+ */
+struct PictureRecorder::Private {
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(Private);
+
+  Private() = default;
+
+  ~Private() = default;
+
+  SkPictureRecorder sk_picture_recorder;
+
+  SkRTreeFactory sk_rtree_factory;
+
+  /**
+   * @brief The Canvas wraps the recording SkCanvas, nullptr if not recording
+   */
+  std::unique_ptr<Canvas> canvas;
+
+};
+
+PictureRecorder::PictureRecorder() {
+  p_ = std::make_unique<Private>();
+}
+
+PictureRecorder::~PictureRecorder() = default;
+
+Canvas *PictureRecorder::BeginRecording(const RectF &cull_rect, bool use_bbh) {
+  SkCanvas *sk_canvas =
+      p_->sk_picture_recorder.beginRecording(reinterpret_cast<const SkRect &>(cull_rect),
+                                             use_bbh ? &p_->sk_rtree_factory : nullptr);
+
+  p_->canvas.reset(new Canvas(new Canvas::Private(sk_canvas)));
+  return p_->canvas.get();
+}
+
+Canvas *PictureRecorder::GetRecordingCanvas() const {
+  return p_->canvas.get();
+}
+
+Picture PictureRecorder::FinishRecording() {
+  Picture picture;
+  if (nullptr == p_->canvas) return picture;
+
+  p_->canvas.reset();
+  picture.p_->sk_picture_sp = p_->sk_picture_recorder.finishRecordingAsPicture();
+  return picture;
+}
+
+} // namespace graphics
+} // namespace wiztk
@@ -0,0 +1,101 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "picture/private.hpp"
+
+#include "canvas/private.hpp"
+
+#include "SkData.h"
+
+namespace wiztk {
+namespace graphics {
+
+Picture Picture::MakeFromData(const void *data, size_t size) {
+  Picture picture;
+  if (nullptr != data && size > 0)
+    picture.p_->sk_picture_sp = SkPicture::MakeFromData(data, size);
+  return picture;
+}
+
+Picture::Picture() {
+  p_ = std::make_unique<Private>();
+}
+
+Picture::Picture(const Picture &other) {
+  p_ = std::make_unique<Private>(*other.p_);
+}
+
+Picture::Picture(Picture &&other) noexcept
+    : Picture() {
+  p_->sk_picture_sp = std::move(other.p_->sk_picture_sp);
+}
+
+Picture::~Picture() = default;
+
+Picture &Picture::operator=(const Picture &other) {
+  *p_ = *other.p_;
+  return *this;
+}
+
+Picture &Picture::operator=(Picture &&other) noexcept {
+  p_->sk_picture_sp = std::move(other.p_->sk_picture_sp);
+  return *this;
+}
+
+bool Picture::IsValid() const {
+  return nullptr != p_->sk_picture_sp;
+}
+
+void Picture::Playback(Canvas *canvas) const {
+  if (nullptr == canvas || !p_->sk_picture_sp) return;
+
+  p_->sk_picture_sp->playback(Canvas::Private::Get(*canvas).sk_canvas);
+}
+
+base::RectF Picture::GetCullRect() const {
+  if (!p_->sk_picture_sp) return RectF();
+
+  SkRect rect = p_->sk_picture_sp->cullRect();
+  return RectF::FromLTRB(rect.left(), rect.top(), rect.right(), rect.bottom());
+}
+
+int Picture::GetApproximateOpCount() const {
+  return p_->sk_picture_sp ? p_->sk_picture_sp->approximateOpCount() : 0;
+}
+
+size_t Picture::GetApproximateBytesUsed() const {
+  return p_->sk_picture_sp ? p_->sk_picture_sp->approximateBytesUsed() : 0;
+}
+
+uint32_t Picture::GetUniqueID() const {
+  return p_->sk_picture_sp ? p_->sk_picture_sp->uniqueID() : 0;
+}
+
+std::vector<uint8_t> Picture::Serialize() const {
+  std::vector<uint8_t> bytes;
+  if (!p_->sk_picture_sp) return bytes;
+
+  sk_sp<SkData> data = p_->sk_picture_sp->serialize();
+  if (data) {
+    const auto *begin = static_cast<const uint8_t *>(data->data());
+    bytes.assign(begin, begin + data->size());
+  }
+
+  return bytes;
+}
+
+} // namespace graphics
+} // namespace wiztk
@@ -0,0 +1,54 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef WIZTK_GRAPHICS_PICTURE_PRIVATE_HPP_
+#define WIZTK_GRAPHICS_PICTURE_PRIVATE_HPP_
+
+#include "wiztk/graphics/picture.hpp"
+
+#include "SkPicture.h"
+
+namespace wiztk {
+namespace graphics {
+
+/**
+ * @brief The private structure used in Picture
+ */
+struct Picture::Private {
+
+  static const Private &Get(const Picture &picture) {
+    return *picture.p_;
+  }
+
+  Private() = default;
+
+  Private(const Private &) = default;
+
+  explicit Private(sk_sp<SkPicture> picture)
+      : sk_picture_sp(std::move(picture)) {}
+
+  ~Private() = default;
+
+  Private &operator=(const Private &) = default;
+
+  sk_sp<SkPicture> sk_picture_sp;
+
+};
+
+} // namespace graphics
+} // namespace wiztk
+
+#endif // WIZTK_GRAPHICS_PICTURE_PRIVATE_HPP_
@@ -0,0 +1,374 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "yuv-converter/private.hpp"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace wiztk {
+namespace graphics {
+
+namespace internal {
+
+const YUVCoefficients &YUVCoefficients::Get(YUVConverter::Matrix matrix) {
+  // Limited range, 6-bit fixed point:
+  static const YUVCoefficients kBT601 = {75, 102, 25, 52, 129};
+  static const YUVCoefficients kBT709 = {75, 115, 14, 34, 135};
+
+  return matrix == YUVConverter::kBT709 ? kBT709 : kBT601;
+}
+
+const YUVRowKernels &YUVRowKernels::Get(YUVConverter::Path path) {
+  switch (path) {
+#ifdef WIZTK_YUV_CONVERTER_X86
+    case YUVConverter::kPathSSE2: return kSSE2RowKernels;
+    case YUVConverter::kPathAVX2: return kAVX2RowKernels;
+#endif
+    default: break;
+  }
+  return kScalarRowKernels;
+}
+
+} // namespace internal
+
+using internal::YUVCoefficients;
+using internal::YUVRowKernels;
+
+/**
+ * @brief Worker threads which convert all slices of a frame but the first
+ *
+ * The worker of index i converts the slice (i + 1) of each job. Run() calls
+ * from different threads are serialized.
+ */
+class YUVConverter::WorkerPool {
+
+ public:
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(WorkerPool);
+
+  explicit WorkerPool(int count);
+
+  ~WorkerPool();
+
+  /**
+   * @brief Convert a frame with the calling thread and all workers
+   * @return false if any slice failed
+   */
+  bool Run(const YUVConverter *converter,
+           const YUVFrame &src,
+           void *dst,
+           int dst_stride,
+           int rows_per_slice,
+           PixelFormat dst_format);
+
+ private:
+
+  struct Job {
+
+    const YUVConverter *converter;
+
+    const YUVFrame *src;
+
+    void *dst;
+
+    int dst_stride;
+
+    int rows_per_slice;
+
+    PixelFormat dst_format;
+
+  };
+
+  void Work(int index);
+
+  void Stop();
+
+  std::mutex run_mutex_;
+
+  std::mutex mutex_;
+
+  std::condition_variable start_condition_;
+
+  std::condition_variable done_condition_;
+
+  std::vector<std::thread> threads_;
+
+  // The members below are guarded by mutex_:
+
+  Job job_ = {};
+
+  unsigned int generation_ = 0;
+
+  size_t pending_ = 0;
+
+  bool result_ = true;
+
+  bool quit_ = false;
+
+};
+
+YUVConverter::WorkerPool::WorkerPool(int count) {
+  threads_.reserve(static_cast<size_t>(count));
+
+  // Join the threads already started if one fails to start:
+  try {
+    for (int i = 0; i < count; ++i) threads_.emplace_back(&WorkerPool::Work, this, i);
+  } catch (...) {
+    Stop();
+    throw;
+  }
+}
+
+YUVConverter::WorkerPool::~WorkerPool() {
+  Stop();
+}
+
+bool YUVConverter::WorkerPool::Run(const YUVConverter *converter,
+                                   const YUVFrame &src,
+                                   void *dst,
+                                   int dst_stride,
+                                   int rows_per_slice,
+                                   PixelFormat dst_format) {
+  std::lock_guard<std::mutex> run_lock(run_mutex_);
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    job_ = {converter, &src, dst, dst_stride, rows_per_slice, dst_format};
+    pending_ = threads_.size();
+    result_ = true;
+    ++generation_;
+  }
+  start_condition_.notify_all();
+
+  bool ret = converter->ConvertRows(src, dst, dst_stride, 0, rows_per_slice, dst_format);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_condition_.wait(lock, [this] { return 0 == pending_; });
+
+  return ret && result_;
+}
+
+void YUVConverter::WorkerPool::Work(int index) {
+  unsigned int generation = 0;
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  while (true) {
+    start_condition_.wait(lock, [this, generation] { return quit_ || generation != generation_; });
+    if (quit_) break;
+
+    generation = generation_;
+    Job job = job_;
+    int begin = (index + 1) * job.rows_per_slice;
+
+    lock.unlock();
+    bool ret = job.converter->ConvertRows(*job.src, job.dst, job.dst_stride,
+                                          begin, begin + job.rows_per_slice, job.dst_format);
+    lock.lock();
+
+    result_ = result_ && ret;
+    if (0 == --pending_) done_condition_.notify_one();
+  }
+}
+
+void YUVConverter::WorkerPool::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    quit_ = true;
+  }
+  start_condition_.notify_all();
+
+  for (std::thread &thread : threads_) {
+    if (thread.joinable()) thread.join();
+  }
+}
+
+// -------
+
+YUVFrame YUVFrame::Make(PixelFormat format, int width, int height, const void *data) {
+  YUVFrame frame;
+  const auto *bytes = static_cast<const uint8_t *>(data);
+  int chroma_width = (width + 1) / 2;
+  int chroma_height = (height + 1) / 2;
+
+  frame.format = format;
+  frame.width = width;
+  frame.height = height;
+
+  switch (format) {
+    case kPixelFormatYUYV: {
+      frame.planes[0] = bytes;
+      frame.strides[0] = chroma_width * 4;
+      break;
+    }
+    case kPixelFormatNV12: {
+      frame.planes[0] = bytes;
+      frame.strides[0] = width;
+      frame.planes[1] = bytes + width * height;
+      frame.strides[1] = chroma_width * 2;
+      break;
+    }
+    case kPixelFormatYUV420: {
+      frame.planes[0] = bytes;
+      frame.strides[0] = width;
+      frame.planes[1] = bytes + width * height;
+      frame.strides[1] = chroma_width;
+      frame.planes[2] = frame.planes[1] + chroma_width * chroma_height;
+      frame.strides[2] = chroma_width;
+      break;
+    }
+    default: {
+      frame.format = kPixelFormatInvalid;
+      break;
+    }
+  }
+
+  return frame;
+}
+
+size_t YUVFrame::GetByteSize(PixelFormat format, int width, int height) {
+  size_t chroma_width = static_cast<size_t>((width + 1) / 2);
+  size_t chroma_height = static_cast<size_t>((height + 1) / 2);
+
+  switch (format) {
+    case kPixelFormatYUYV: return chroma_width * 4 * height;
+    case kPixelFormatNV12: return static_cast<size_t>(width) * height + chroma_width * 2 * chroma_height;
+    case kPixelFormatYUV420: return static_cast<size_t>(width) * height + chroma_width * 2 * chroma_height;
+    default: break;
+  }
+
+  return 0;
+}
+
+// -------
+
+bool YUVConverter::IsSupported(Path path) {
+  switch (path) {
+    case kPathAuto:
+    case kPathScalar: return true;
+#ifdef WIZTK_YUV_CONVERTER_X86
+    case kPathSSE2: return __builtin_cpu_supports("sse2") != 0;
+    case kPathAVX2: return __builtin_cpu_supports("avx2") != 0;
+#endif
+    default: break;
+  }
+  return false;
+}
+
+YUVConverter::YUVConverter(Matrix matrix, Path path)
+    : matrix_(matrix), path_(kPathScalar), thread_count_(1) {
+  SetPath(path);
+}
+
+YUVConverter::~YUVConverter() = default;
+
+void YUVConverter::SetPath(Path path) {
+  if (kPathAuto == path || !IsSupported(path)) {
+    if (IsSupported(kPathAVX2)) path_ = kPathAVX2;
+    else if (IsSupported(kPathSSE2)) path_ = kPathSSE2;
+    else path_ = kPathScalar;
+    return;
+  }
+
+  path_ = path;
+}
+
+void YUVConverter::SetThreadCount(int count) {
+  count = count < 1 ? 1 : (count > kMaxThreads ? kMaxThreads : count);
+  if (count == thread_count_) return;
+
+  // Start the new workers before releasing the old ones, so a failure leaves
+  // the converter unchanged:
+  std::unique_ptr<WorkerPool> pool;
+  if (count > 1) pool.reset(new WorkerPool(count - 1));
+
+  pool_ = std::move(pool);
+  thread_count_ = count;
+}
+
+bool YUVConverter::Convert(const YUVFrame &src, void *dst, int dst_stride, PixelFormat dst_format) const {
+  if (nullptr == pool_)
+    return ConvertRows(src, dst, dst_stride, 0, src.height, dst_format);
+
+  // Split at even rows so that 4:2:0 chroma rows are never shared by slices,
+  // workers whose slice starts past the last row have nothing to convert:
+  int pairs = (src.height + 1) / 2;
+  int rows_per_slice = (pairs + thread_count_ - 1) / thread_count_ * 2;
+
+  return pool_->Run(this, src, dst, dst_stride, rows_per_slice, dst_format);
+}
+
+bool YUVConverter::ConvertRows(const YUVFrame &src,
+                               void *dst,
+                               int dst_stride,
+                               int row_begin,
+                               int row_end,
+                               PixelFormat dst_format) const {
+  if (kPixelFormatARGB8888 != dst_format && kPixelFormatXRGB8888 != dst_format)
+    return false;
+
+  if (nullptr == dst || nullptr == src.planes[0]) return false;
+
+  if (row_begin < 0) row_begin = 0;
+  if (row_end > src.height) row_end = src.height;
+
+  const YUVCoefficients &coeffs = YUVCoefficients::Get(matrix_);
+  const YUVRowKernels &kernels = YUVRowKernels::Get(path_);
+  auto *dst_row = static_cast<uint8_t *>(dst) + static_cast<ptrdiff_t>(row_begin) * dst_stride;
+
+  switch (src.format) {
+    case kPixelFormatYUYV: {
+      for (int row = row_begin; row < row_end; ++row) {
+        kernels.yuyv(src.planes[0] + row * src.strides[0], nullptr, nullptr,
+                     dst_row, src.width, coeffs);
+        dst_row += dst_stride;
+      }
+      break;
+    }
+    case kPixelFormatNV12: {
+      if (nullptr == src.planes[1]) return false;
+      for (int row = row_begin; row < row_end; ++row) {
+        kernels.nv12(src.planes[0] + row * src.strides[0],
+                     src.planes[1] + (row / 2) * src.strides[1],
+                     nullptr,
+                     dst_row, src.width, coeffs);
+        dst_row += dst_stride;
+      }
+      break;
+    }
+    case kPixelFormatYUV420: {
+      if (nullptr == src.planes[1] || nullptr == src.planes[2]) return false;
+      for (int row = row_begin; row < row_end; ++row) {
+        kernels.i420(src.planes[0] + row * src.strides[0],
+                     src.planes[1] + (row / 2) * src.strides[1],
+                     src.planes[2] + (row / 2) * src.strides[2],
+                     dst_row, src.width, coeffs);
+        dst_row += dst_stride;
+      }
+      break;
+    }
+    default: {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+} // namespace graphics
+} // namespace wiztk
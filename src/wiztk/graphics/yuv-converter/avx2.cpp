@@ -0,0 +1,139 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "private.hpp"
+
+#ifdef WIZTK_YUV_CONVERTER_X86
+
+#include <immintrin.h>
+
+#define WIZTK_TARGET_AVX2 __attribute__((target("avx2")))
+
+namespace wiztk {
+namespace graphics {
+namespace internal {
+
+// Note: only lane-wise operations and the order-preserving cvtepu* are used
+// below, so there's no need to fix up the 128-bit lane order of AVX2
+// unpack/pack instructions.
+
+/**
+ * @brief Split 16-bit chroma pairs (U0 V0 U1 V1 ...) into duplicated U and V
+ */
+WIZTK_TARGET_AVX2
+static inline void SplitChroma(__m256i uv, __m256i *u, __m256i *v) {
+  __m256i u32 = _mm256_and_si256(uv, _mm256_set1_epi32(0xFFFF));
+  __m256i v32 = _mm256_srli_epi32(uv, 16);
+  *u = _mm256_or_si256(u32, _mm256_slli_epi32(u32, 16));
+  *v = _mm256_or_si256(v32, _mm256_slli_epi32(v32, 16));
+}
+
+/**
+ * @brief Convert and store 16 pixels from 16-bit Y, U, V lanes
+ */
+WIZTK_TARGET_AVX2
+static inline void Store16(__m256i y, __m256i u, __m256i v, uint8_t *dst, const YUVCoefficients &c) {
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i max = _mm256_set1_epi16(255);
+
+  y = _mm256_mullo_epi16(_mm256_sub_epi16(y, _mm256_set1_epi16(16)), _mm256_set1_epi16(c.y));
+  y = _mm256_add_epi16(y, _mm256_set1_epi16(32));
+  u = _mm256_sub_epi16(u, _mm256_set1_epi16(128));
+  v = _mm256_sub_epi16(v, _mm256_set1_epi16(128));
+
+  __m256i b = _mm256_adds_epi16(y, _mm256_mullo_epi16(u, _mm256_set1_epi16(c.bu)));
+  __m256i g = _mm256_subs_epi16(_mm256_subs_epi16(y, _mm256_mullo_epi16(u, _mm256_set1_epi16(c.gu))),
+                                _mm256_mullo_epi16(v, _mm256_set1_epi16(c.gv)));
+  __m256i r = _mm256_adds_epi16(y, _mm256_mullo_epi16(v, _mm256_set1_epi16(c.rv)));
+
+  b = _mm256_min_epi16(_mm256_max_epi16(_mm256_srai_epi16(b, 6), zero), max);
+  g = _mm256_min_epi16(_mm256_max_epi16(_mm256_srai_epi16(g, 6), zero), max);
+  r = _mm256_min_epi16(_mm256_max_epi16(_mm256_srai_epi16(r, 6), zero), max);
+
+  __m256i bg = _mm256_or_si256(b, _mm256_slli_epi16(g, 8));
+  __m256i ra = _mm256_or_si256(r, _mm256_set1_epi16(static_cast<int16_t>(0xFF00)));
+
+  __m256i lo = _mm256_or_si256(_mm256_cvtepu16_epi32(_mm256_castsi256_si128(bg)),
+                               _mm256_slli_epi32(_mm256_cvtepu16_epi32(_mm256_castsi256_si128(ra)), 16));
+  __m256i hi = _mm256_or_si256(_mm256_cvtepu16_epi32(_mm256_extracti128_si256(bg, 1)),
+                               _mm256_slli_epi32(_mm256_cvtepu16_epi32(_mm256_extracti128_si256(ra, 1)), 16));
+  _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst), lo);
+  _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + 32), hi);
+}
+
+WIZTK_TARGET_AVX2
+static void RowYUYV(const uint8_t *src0, const uint8_t *src1, const uint8_t *src2,
+                    uint8_t *dst, int width, const YUVCoefficients &coeffs) {
+  const __m256i mask = _mm256_set1_epi16(0x00FF);
+  __m256i u, v;
+  int x = 0;
+
+  for (; x + 16 <= width; x += 16) {
+    __m256i packed = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src0 + x * 2));
+    SplitChroma(_mm256_srli_epi16(packed, 8), &u, &v);
+    Store16(_mm256_and_si256(packed, mask), u, v, dst + x * 4, coeffs);
+  }
+
+  if (x < width)
+    kSSE2RowKernels.yuyv(src0 + x * 2, src1, src2, dst + x * 4, width - x, coeffs);
+}
+
+WIZTK_TARGET_AVX2
+static void RowNV12(const uint8_t *src0, const uint8_t *src1, const uint8_t *src2,
+                    uint8_t *dst, int width, const YUVCoefficients &coeffs) {
+  __m256i u, v;
+  int x = 0;
+
+  for (; x + 16 <= width; x += 16) {
+    __m256i y = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src0 + x)));
+    __m256i uv = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src1 + x)));
+    SplitChroma(uv, &u, &v);
+    Store16(y, u, v, dst + x * 4, coeffs);
+  }
+
+  if (x < width)
+    kSSE2RowKernels.nv12(src0 + x, src1 + x, src2, dst + x * 4, width - x, coeffs);
+}
+
+WIZTK_TARGET_AVX2
+static void RowI420(const uint8_t *src0, const uint8_t *src1, const uint8_t *src2,
+                    uint8_t *dst, int width, const YUVCoefficients &coeffs) {
+  int x = 0;
+
+  for (; x + 16 <= width; x += 16) {
+    __m128i u8 = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(src1 + x / 2));
+    __m128i v8 = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(src2 + x / 2));
+    __m256i y = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src0 + x)));
+    __m256i u = _mm256_cvtepu8_epi16(_mm_unpacklo_epi8(u8, u8));
+    __m256i v = _mm256_cvtepu8_epi16(_mm_unpacklo_epi8(v8, v8));
+    Store16(y, u, v, dst + x * 4, coeffs);
+  }
+
+  if (x < width)
+    kSSE2RowKernels.i420(src0 + x, src1 + x / 2, src2 + x / 2, dst + x * 4, width - x, coeffs);
+}
+
+const YUVRowKernels kAVX2RowKernels = {
+    RowYUYV,
+    RowNV12,
+    RowI420
+};
+
+} // namespace internal
+} // namespace graphics
+} // namespace wiztk
+
+#endif // WIZTK_YUV_CONVERTER_X86
@@ -0,0 +1,90 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef WIZTK_GRAPHICS_YUV_CONVERTER_PRIVATE_HPP_
+#define WIZTK_GRAPHICS_YUV_CONVERTER_PRIVATE_HPP_
+
+#include "wiztk/graphics/yuv-converter.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define WIZTK_YUV_CONVERTER_X86
+#endif
+
+namespace wiztk {
+namespace graphics {
+namespace internal {
+
+/**
+ * @brief YUV to RGB coefficients in 6-bit fixed point (x64)
+ *
+ * R = (Y - 16) * y + (V - 128) * rv
+ * G = (Y - 16) * y - (U - 128) * gu - (V - 128) * gv
+ * B = (Y - 16) * y + (U - 128) * bu
+ *
+ * All intermediate values fit in signed 16-bit except for the blue channel
+ * which may saturate, but saturated values are clamped to 255 anyway.
+ */
+struct YUVCoefficients {
+
+  static const YUVCoefficients &Get(YUVConverter::Matrix matrix);
+
+  int16_t y;
+  int16_t rv;
+  int16_t gu;
+  int16_t gv;
+  int16_t bu;
+
+};
+
+/**
+ * @brief Convert one row into BGRA bytes (little-endian ARGB8888)
+ *
+ * - YUYV: src0 is the packed row, src1 and src2 are not used.
+ * - NV12: src0 is the Y row, src1 is the UV row, src2 is not used.
+ * - I420: src0 is the Y row, src1 the U row, src2 the V row.
+ */
+typedef void (*YUVRowFunc)(const uint8_t *src0,
+                           const uint8_t *src1,
+                           const uint8_t *src2,
+                           uint8_t *dst,
+                           int width,
+                           const YUVCoefficients &coeffs);
+
+/**
+ * @brief A table of row kernels for one path
+ */
+struct YUVRowKernels {
+
+  static const YUVRowKernels &Get(YUVConverter::Path path);
+
+  YUVRowFunc yuyv;
+  YUVRowFunc nv12;
+  YUVRowFunc i420;
+
+};
+
+extern const YUVRowKernels kScalarRowKernels;
+
+#ifdef WIZTK_YUV_CONVERTER_X86
+extern const YUVRowKernels kSSE2RowKernels;
+extern const YUVRowKernels kAVX2RowKernels;
+#endif
+
+} // namespace internal
+} // namespace graphics
+} // namespace wiztk
+
+#endif // WIZTK_GRAPHICS_YUV_CONVERTER_PRIVATE_HPP_
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "private.hpp"
+
+namespace wiztk {
+namespace graphics {
+namespace internal {
+
+static inline uint8_t Clamp(int value) {
+  return static_cast<uint8_t>(value < 0 ? 0 : (value > 255 ? 255 : value));
+}
+
+static inline void StorePixel(int y, int u, int v, uint8_t *dst, const YUVCoefficients &c) {
+  int yy = (y - 16) * c.y + 32;
+  u -= 128;
+  v -= 128;
+
+  dst[0] = Clamp((yy + u * c.bu) >> 6);
+  dst[1] = Clamp((yy - u * c.gu - v * c.gv) >> 6);
+  dst[2] = Clamp((yy + v * c.rv) >> 6);
+  dst[3] = 0xFF;
+}
+
+static void RowYUYV(const uint8_t *src0, const uint8_t *, const uint8_t *,
+                    uint8_t *dst, int width, const YUVCoefficients &coeffs) {
+  int x = 0;
+  for (; x + 1 < width; x += 2) {
+    StorePixel(src0[0], src0[1], src0[3], dst, coeffs);
+    StorePixel(src0[2], src0[1], src0[3], dst + 4, coeffs);
+    src0 += 4;
+    dst += 8;
+  }
+  if (x < width) StorePixel(src0[0], src0[1], src0[3], dst, coeffs);
+}
+
+static void RowNV12(const uint8_t *src0, const uint8_t *src1, const uint8_t *,
+                    uint8_t *dst, int width, const YUVCoefficients &coeffs) {
+  for (int x = 0; x < width; ++x) {
+    const uint8_t *uv = src1 + (x & ~1);
+    StorePixel(src0[x], uv[0], uv[1], dst, coeffs);
+    dst += 4;
+  }
+}
+
+static void RowI420(const uint8_t *src0, const uint8_t *src1, const uint8_t *src2,
+                    uint8_t *dst, int width, const YUVCoefficients &coeffs) {
+  for (int x = 0; x < width; ++x) {
+    StorePixel(src0[x], src1[x >> 1], src2[x >> 1], dst, coeffs);
+    dst += 4;
+  }
+}
+
+const YUVRowKernels kScalarRowKernels = {
+    RowYUYV,
+    RowNV12,
+    RowI420
+};
+
+} // namespace internal
+} // namespace graphics
+} // namespace wiztk
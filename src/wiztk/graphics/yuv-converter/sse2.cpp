@@ -0,0 +1,134 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "private.hpp"
+
+#ifdef WIZTK_YUV_CONVERTER_X86
+
+#include <emmintrin.h>
+
+#include <cstring>
+
+#define WIZTK_TARGET_SSE2 __attribute__((target("sse2")))
+
+namespace wiztk {
+namespace graphics {
+namespace internal {
+
+/**
+ * @brief Split 16-bit chroma pairs (U0 V0 U1 V1 ...) into duplicated U and V
+ */
+WIZTK_TARGET_SSE2
+static inline void SplitChroma(__m128i uv, __m128i *u, __m128i *v) {
+  __m128i u32 = _mm_and_si128(uv, _mm_set1_epi32(0xFFFF));
+  __m128i v32 = _mm_srli_epi32(uv, 16);
+  *u = _mm_or_si128(u32, _mm_slli_epi32(u32, 16));
+  *v = _mm_or_si128(v32, _mm_slli_epi32(v32, 16));
+}
+
+/**
+ * @brief Convert and store 8 pixels from 16-bit Y, U, V lanes
+ */
+WIZTK_TARGET_SSE2
+static inline void Store8(__m128i y, __m128i u, __m128i v, uint8_t *dst, const YUVCoefficients &c) {
+  y = _mm_mullo_epi16(_mm_sub_epi16(y, _mm_set1_epi16(16)), _mm_set1_epi16(c.y));
+  y = _mm_add_epi16(y, _mm_set1_epi16(32));
+  u = _mm_sub_epi16(u, _mm_set1_epi16(128));
+  v = _mm_sub_epi16(v, _mm_set1_epi16(128));
+
+  __m128i b = _mm_adds_epi16(y, _mm_mullo_epi16(u, _mm_set1_epi16(c.bu)));
+  __m128i g = _mm_subs_epi16(_mm_subs_epi16(y, _mm_mullo_epi16(u, _mm_set1_epi16(c.gu))),
+                             _mm_mullo_epi16(v, _mm_set1_epi16(c.gv)));
+  __m128i r = _mm_adds_epi16(y, _mm_mullo_epi16(v, _mm_set1_epi16(c.rv)));
+
+  b = _mm_packus_epi16(_mm_srai_epi16(b, 6), _mm_setzero_si128());
+  g = _mm_packus_epi16(_mm_srai_epi16(g, 6), _mm_setzero_si128());
+  r = _mm_packus_epi16(_mm_srai_epi16(r, 6), _mm_setzero_si128());
+
+  __m128i bg = _mm_unpacklo_epi8(b, g);
+  __m128i ra = _mm_unpacklo_epi8(r, _mm_set1_epi8(-1));
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_unpacklo_epi16(bg, ra));
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 16), _mm_unpackhi_epi16(bg, ra));
+}
+
+WIZTK_TARGET_SSE2
+static void RowYUYV(const uint8_t *src0, const uint8_t *src1, const uint8_t *src2,
+                    uint8_t *dst, int width, const YUVCoefficients &coeffs) {
+  const __m128i mask = _mm_set1_epi16(0x00FF);
+  __m128i u, v;
+  int x = 0;
+
+  for (; x + 8 <= width; x += 8) {
+    __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src0 + x * 2));
+    SplitChroma(_mm_srli_epi16(packed, 8), &u, &v);
+    Store8(_mm_and_si128(packed, mask), u, v, dst + x * 4, coeffs);
+  }
+
+  if (x < width)
+    kScalarRowKernels.yuyv(src0 + x * 2, src1, src2, dst + x * 4, width - x, coeffs);
+}
+
+WIZTK_TARGET_SSE2
+static void RowNV12(const uint8_t *src0, const uint8_t *src1, const uint8_t *src2,
+                    uint8_t *dst, int width, const YUVCoefficients &coeffs) {
+  const __m128i zero = _mm_setzero_si128();
+  __m128i u, v;
+  int x = 0;
+
+  for (; x + 8 <= width; x += 8) {
+    __m128i y = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(src0 + x)), zero);
+    __m128i uv = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(src1 + x)), zero);
+    SplitChroma(uv, &u, &v);
+    Store8(y, u, v, dst + x * 4, coeffs);
+  }
+
+  if (x < width)
+    kScalarRowKernels.nv12(src0 + x, src1 + x, src2, dst + x * 4, width - x, coeffs);
+}
+
+WIZTK_TARGET_SSE2
+static void RowI420(const uint8_t *src0, const uint8_t *src1, const uint8_t *src2,
+                    uint8_t *dst, int width, const YUVCoefficients &coeffs) {
+  const __m128i zero = _mm_setzero_si128();
+  int x = 0;
+  int32_t u4, v4;
+
+  for (; x + 8 <= width; x += 8) {
+    memcpy(&u4, src1 + x / 2, 4);
+    memcpy(&v4, src2 + x / 2, 4);
+    __m128i y = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(src0 + x)), zero);
+    __m128i u = _mm_cvtsi32_si128(u4);
+    __m128i v = _mm_cvtsi32_si128(v4);
+    u = _mm_unpacklo_epi8(_mm_unpacklo_epi8(u, u), zero);
+    v = _mm_unpacklo_epi8(_mm_unpacklo_epi8(v, v), zero);
+    Store8(y, u, v, dst + x * 4, coeffs);
+  }
+
+  if (x < width)
+    kScalarRowKernels.i420(src0 + x, src1 + x / 2, src2 + x / 2, dst + x * 4, width - x, coeffs);
+}
+
+const YUVRowKernels kSSE2RowKernels = {
+    RowYUYV,
+    RowNV12,
+    RowI420
+};
+
+} // namespace internal
+} // namespace graphics
+} // namespace wiztk
+
+#endif // WIZTK_YUV_CONVERTER_X86
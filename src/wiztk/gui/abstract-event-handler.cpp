@@ -19,18 +19,18 @@
 namespace wiztk {
 namespace gui {
 
-using base::String;
-
-AbstractEventHandler::MouseTask *
-AbstractEventHandler::MouseTask::Get(const AbstractEventHandler *event_hander) {
-  return &event_hander->__PROPERTY__(mouse_event_node);
-}
+using base::Atom;
 
 AbstractEventHandler::MouseMotionTask *
 AbstractEventHandler::MouseMotionTask::Get(const AbstractEventHandler *event_handler) {
   return &event_handler->__PROPERTY__(mouse_motion_event_node);
 }
 
+AbstractEventHandler::KeyboardTask *
+AbstractEventHandler::KeyboardTask::Get(const AbstractEventHandler *event_handler) {
+  return &event_handler->__PROPERTY__(keyboard_event_node);
+}
+
 // --------------------
 
 AbstractEventHandler::AbstractEventHandler() {
@@ -39,14 +39,21 @@ AbstractEventHandler::AbstractEventHandler() {
 
 AbstractEventHandler::~AbstractEventHandler() = default;
 
-const String &AbstractEventHandler::GetName() const {
+const Atom &AbstractEventHandler::GetName() const {
   return __PROPERTY__(name);
 }
 
-void AbstractEventHandler::SetName(const String &name) {
+void AbstractEventHandler::SetName(const Atom &name) {
   __PROPERTY__(name) = name;
 }
 
+void AbstractEventHandler::OnMouseAxis(MouseEvent *event) {
+  // override in sub class
+}
+
+void AbstractEventHandler::OnTouch(TouchEvent *event) {
+  // override in sub class
+}
+
 } // namespace gui
 } // namespace wiztk
-
@@ -33,25 +33,25 @@ struct AbstractEventHandler::Private : public base::Property<AbstractEventHandle
 
   explicit Private(AbstractEventHandler *event_handler)
       : base::Property<AbstractEventHandler>(event_handler),
-        mouse_event_node(event_handler),
         mouse_motion_event_node(event_handler),
+        keyboard_event_node(event_handler),
         name() {}
 
   ~Private() final = default;
 
   /**
-   * @brief An event task to handle mouse enter/leave/button events
+   * @brief An event task to handle mouse move event
    */
-  MouseTask mouse_event_node;
+  MouseMotionTask mouse_motion_event_node;
 
   /**
-   * @brief An event task to handle mouse move event
+   * @brief An event task to handle keyboard focus
    */
-  MouseMotionTask mouse_motion_event_node;
+  KeyboardTask keyboard_event_node;
 
   // TODO: there will be more tasks added later
 
-  base::String name;
+  base::Atom name;
 
 };
 
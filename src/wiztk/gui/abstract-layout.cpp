@@ -24,6 +24,11 @@
 
 #include "abstract-view/iterators.hpp"
 
+#include "wiztk/async/event-loop.hpp"
+#include "wiztk/async/scheduler.hpp"
+
+#include "wiztk/base/clamp.hpp"
+
 //#ifdef DEBUG
 #include <cstdlib>
 #include <wiztk/gui/timer.hpp>
@@ -40,14 +45,19 @@ using base::ColorF;
 using graphics::Paint;
 using graphics::Canvas;
 
-AbstractLayout::AbstractLayout(const Padding &padding)
-    : is_geometry_saved_(false) {
+AbstractLayout::AbstractLayout(const Padding &padding) {
   p_->padding = padding;
+  p_->is_layout = true;
+  layout_message_ = std::make_unique<LayoutMessage>(this);
 }
 
 AbstractLayout::~AbstractLayout() = default;
 
 void AbstractLayout::AddView(AbstractView *view) {
+  AddView(-1, view);
+}
+
+void AbstractLayout::AddView(int index, AbstractView *view) {
   _ASSERT(view->p_->parent == view->p_->layout);
 
   if (view->p_->layout == this) return;
@@ -57,8 +67,10 @@ void AbstractLayout::AddView(AbstractView *view) {
   _ASSERT(nullptr == view->p_->layout);
   _ASSERT(nullptr == view->p_->parent);
 
-  InsertChild(view);
-  Layout();
+  if (index < 0 || index >= p_->children_count) PushBackChild(view);
+  else InsertChild(view, index);
+
+  RequestLayout();
 }
 
 void AbstractLayout::RemoveView(AbstractView *view) {
@@ -67,23 +79,141 @@ void AbstractLayout::RemoveView(AbstractView *view) {
   if (view->p_->layout != this) return;
 
   RemoveChild(view);
-  Layout();
+  RequestLayout();
+}
+
+void AbstractLayout::RequestLayout() {
+  need_measure_ = true;
+  need_arrange_ = true;
+
+  // The measured size of this layout may change, the outer layout lays out
+  // this one in its pass:
+  if (nullptr != p_->layout) {
+    p_->layout->RequestLayout();
+    return;
+  }
+
+  ScheduleLayout();
 }
 
 void AbstractLayout::Layout() {
-  OnLayout(0, 0, 0, 0);
+  if (need_measure_) Measure();
+  if (need_arrange_) Arrange();
+}
+
+const AbstractView::Size &AbstractLayout::Measure() {
+  if (need_measure_) {
+    measured_size_ = OnMeasure();
+    measured_size_.width = base::Clamp(measured_size_.width, p_->minimal_size.width, p_->maximal_size.width);
+    measured_size_.height = base::Clamp(measured_size_.height, p_->minimal_size.height, p_->maximal_size.height);
+    need_measure_ = false;
+  }
+
+  return measured_size_;
 }
 
 void AbstractLayout::OnConfigureGeometry(const RectF &old_geometry, const RectF &new_geometry) {
-  if (!RequestSaveGeometry(new_geometry)) return;
+  if (p_->geometry == new_geometry) return;
+
+  RequestSaveGeometry(new_geometry);
+
+  // Arrange in the next layout pass, so that several changes in one frame
+  // (e.g. MoveTo() and Resize()) run OnLayout() once:
+  need_arrange_ = true;
 
-  OnLayout(0, 0, 0, 0);
+  if (nullptr != p_->layout) {
+    p_->layout->RequestLayout();
+    return;
+  }
+
+  ScheduleLayout();
 }
 
 void AbstractLayout::OnSaveGeometry(const RectF &old_geometry, const RectF &new_geometry) {
   // Do nothing in layout
 }
 
+AbstractView::Size AbstractLayout::OnMeasure() {
+  return Size(p_->preferred_size.width, p_->preferred_size.height);
+}
+
+AbstractView::Size AbstractLayout::MeasureView(const AbstractView *view) {
+  const Private *p = view->p_.get();
+
+  if (p->is_layout)
+    return const_cast<AbstractLayout *>(static_cast<const AbstractLayout *>(view))->Measure();
+
+  Size size;
+
+  switch (p->x_layout_policy) {
+    case kLayoutMinimal: size.width = p->minimal_size.width;
+      break;
+    case kLayoutFixed: size.width = static_cast<int>(p->geometry.width());
+      break;
+    default: size.width = p->preferred_size.width;
+      break;
+  }
+
+  switch (p->y_layout_policy) {
+    case kLayoutMinimal: size.height = p->minimal_size.height;
+      break;
+    case kLayoutFixed: size.height = static_cast<int>(p->geometry.height());
+      break;
+    default: size.height = p->preferred_size.height;
+      break;
+  }
+
+  return size;
+}
+
+void AbstractLayout::ArrangeView(AbstractView *view, int left, int top, int width, int height) {
+  _ASSERT(view->p_->parent == this);
+
+  RectF geometry = RectF::FromXYWH(p_->geometry.left + left, p_->geometry.top + top, width, height);
+
+  if (!view->p_->is_layout) {
+    if (view->p_->geometry != geometry)
+      view->OnConfigureGeometry(view->p_->last_geometry, geometry);
+    return;
+  }
+
+  // Arrange the nested layout in this pass instead of scheduling another one:
+  auto *layout = static_cast<AbstractLayout *>(view);
+  if (layout->p_->geometry != geometry) {
+    layout->RequestSaveGeometry(geometry);
+    layout->need_arrange_ = true;
+  }
+  layout->Layout();
+}
+
+void AbstractLayout::RequestArrange() {
+  need_arrange_ = true;
+  ScheduleLayout();
+}
+
+void AbstractLayout::Arrange() {
+  need_arrange_ = false;
+  layout_message_->Unlink();
+
+  const Padding &padding = p_->padding;
+  OnLayout(padding.left,
+           padding.top,
+           static_cast<int>(p_->geometry.width()) - padding.right,
+           static_cast<int>(p_->geometry.height()) - padding.bottom);
+}
+
+void AbstractLayout::ScheduleLayout() {
+  if (layout_message_->IsQueued()) return;
+
+  async::EventLoop *event_loop = async::EventLoop::GetCurrent();
+  if (nullptr == event_loop) {
+    Layout();
+    return;
+  }
+
+  event_loop->GetScheduler().PostMessage(layout_message_.get());
+}
+
 void AbstractLayout::OnRequestUpdateFrom(AbstractView *view) {
   if (view == this) return; // This layout does not need to update
 
@@ -141,5 +271,12 @@ void AbstractLayout::OnDraw(const Context &context) {
   //#endif
 }
 
+// -------------------
+
+void AbstractLayout::LayoutMessage::Exec() {
+  // A nested layout which needs measuring is laid out by the outer one:
+  if (nullptr == layout_->p_->layout || !layout_->need_measure_) layout_->Layout();
+}
+
 } // namespace gui
 } // namespace wiztk
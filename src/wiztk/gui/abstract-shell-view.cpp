@@ -16,6 +16,7 @@
 
 #include "abstract-shell-view/private.hpp"
 #include "abstract-view/private.hpp"
+#include "mouse-event/private.hpp"
 
 #include "wiztk/base/bit.hpp"
 #include "wiztk/base/rect.hpp"
@@ -25,6 +26,7 @@
 #include "wiztk/gui/application.hpp"
 #include "wiztk/gui/mouse-event.hpp"
 #include "wiztk/gui/key-event.hpp"
+#include "wiztk/gui/touch-event.hpp"
 #include "wiztk/gui/region.hpp"
 #include "wiztk/gui/context.hpp"
 #include "wiztk/gui/theme.hpp"
@@ -197,6 +199,34 @@ AbstractShellView *AbstractShellView::GetParent() const {
   return __PROPERTY__(parent);
 }
 
+void AbstractShellView::SetKeyboardFocus(AbstractView *view) {
+  KeyboardTask *head = KeyboardTask::Get(this);
+
+  if (nullptr != head->next()) head->next()->unlink();
+  if (nullptr == view) return;
+
+  _ASSERT(view->GetShellView() == this);
+  head->push_back(KeyboardTask::Get(view));
+}
+
+Animator *AbstractShellView::GetAnimator() const {
+  return &p_->animator;
+}
+
+AbstractView *AbstractShellView::GetKeyboardFocus() const {
+  KeyboardTask *task = KeyboardTask::Get(this)->next();
+  if (nullptr == task) return nullptr;
+
+  auto *view = static_cast<AbstractView *>(task->event_handler());
+  if (view->GetShellView() != this) {
+    // The view was removed from this shell view:
+    task->unlink();
+    return nullptr;
+  }
+
+  return view;
+}
+
 void AbstractShellView::AttachView(AbstractView *view) {
   if (view->__PROPERTY__(shell_view) == this) {
     _ASSERT(nullptr == view->__PROPERTY__(parent));
@@ -253,11 +283,11 @@ void AbstractShellView::OnMouseUp(MouseEvent *event) {
 }
 
 void AbstractShellView::OnKeyDown(KeyEvent *event) {
-  // override in sub class
+  DispatchKeyDownEvent(event);
 }
 
 void AbstractShellView::OnKeyUp(KeyEvent *event) {
-  // override in sub class
+  DispatchKeyUpEvent(event);
 }
 
 void AbstractShellView::OnRequestSaveGeometry(AbstractView *view) {
@@ -356,75 +386,76 @@ void AbstractShellView::Draw(AbstractView *view, const Context &context) {
 
 void AbstractShellView::DispatchMouseEnterEvent(AbstractView *view, MouseEvent *event) {
   Point cursor = event->GetWindowXY();
-  MouseTask *mouse_task = MouseTask::Get(this);
-
-  if (nullptr == mouse_task->next()) {
-    _ASSERT(mouse_task->event_handler() == this);
-    _ASSERT(nullptr == mouse_task->previous());
-    if (view->Contain(cursor.x, cursor.y)) {
-      view->OnMouseEnter(event);
-      if (event->IsAccepted()) {
-        mouse_task->push_back(MouseTask::Get(view));
-        mouse_task = mouse_task->next();
-        __PROPERTY__(DispatchMouseEnterEvent)(view, event, mouse_task);
-      } else if (event->IsIgnored()) {
-        __PROPERTY__(DispatchMouseEnterEvent)(view, event, mouse_task);
-      }
-    }
-  } else {
-    while (mouse_task->next()) mouse_task = mouse_task->next(); // move to tail
-    AbstractView *last = nullptr;
-    MouseTask *tail = nullptr;
-    while (mouse_task->previous()) {
-      tail = mouse_task;
-      last = static_cast<AbstractView *>(tail->event_handler());
-      if (last->Contain(cursor.x, cursor.y)) {
-        break;
-      }
-      mouse_task = mouse_task->previous();
-      tail->unlink();
-      last->OnMouseLeave();
-      if (nullptr == mouse_task->previous()) break;
-    }
-
-    __PROPERTY__(DispatchMouseEnterEvent)(last, event, mouse_task);
-  }
+  event->p_->hover_path.Update(view, cursor.x, cursor.y, event);
 }
 
 void AbstractShellView::DispatchMouseLeaveEvent() {
-  MouseTask *it = MouseTask::Get(this)->next();
-
-  MouseTask *tmp = nullptr;
-  while (it) {
-    tmp = it;
-    it = it->next();
-    tmp->unlink();
-    tmp->event_handler()->OnMouseLeave();
-  }
+  HoverPath::Clear(this);
 }
 
 void AbstractShellView::DispatchMouseDownEvent(MouseEvent *event) {
   _ASSERT(event->GetState() == kMouseButtonPressed);
 
-  MouseTask *it = MouseTask::Get(this)->next();
-  while (it) {
-    it->event_handler()->OnMouseDown(event);
+  const HoverPath &path = event->p_->hover_path;
+  // Callbacks may shorten the path, so check the depth in each step:
+  for (int i = 0; i < path.GetDepth(); ++i) {
+    if (!path.GetEntry(i).accepted) continue;
+    static_cast<AbstractEventHandler *>(path.GetEntry(i).view)->OnMouseDown(event);
     if (event->IsRejected()) break;
-    it = it->next();
   }
 }
 
 void AbstractShellView::DispatchMouseUpEvent(MouseEvent *event) {
   _ASSERT(event->GetState() == kMouseButtonReleased);
 
-  MouseTask *it = MouseTask::Get(this)->next();
-  while (it) {
-    it->event_handler()->OnMouseUp(event);
+  const HoverPath &path = event->p_->hover_path;
+  for (int i = 0; i < path.GetDepth(); ++i) {
+    if (!path.GetEntry(i).accepted) continue;
+    static_cast<AbstractEventHandler *>(path.GetEntry(i).view)->OnMouseUp(event);
     if (event->IsRejected()) break;
-    it = it->next();
   }
 }
 
+void AbstractShellView::DispatchMouseAxisEvent(MouseEvent *event) {
+  const HoverPath &path = event->p_->hover_path;
+  for (int i = path.GetDepth() - 1; i >= 0; --i) {
+    if (i >= path.GetDepth()) continue;
+    if (!path.GetEntry(i).accepted) continue;
+    event->Ignore();
+    static_cast<AbstractEventHandler *>(path.GetEntry(i).view)->OnMouseAxis(event);
+    if (event->IsAccepted() || event->IsRejected()) break;
+  }
+}
+
+void AbstractShellView::DispatchTouchEvent(AbstractView *view, TouchEvent *event) {
+  Point origin = event->GetWindowOriginXY();
+
+  if (nullptr == view || !view->Contain(origin.x, origin.y)) return;
+
+  AbstractView *child = view->HitTest(origin.x, origin.y);
+  while (nullptr != child) {
+    view = child;
+    child = view->HitTest(origin.x, origin.y);
+  }
+
+  while (nullptr != view) {
+    event->Ignore();
+    static_cast<AbstractEventHandler *>(view)->OnTouch(event);
+    if (event->IsAccepted() || event->IsRejected()) break;
+    view = view->GetParent();
+  }
+}
+
+void AbstractShellView::DispatchKeyDownEvent(KeyEvent *event) {
+  AbstractView *view = GetKeyboardFocus();
+  if (nullptr != view) KeyboardTask::Get(view)->event_handler()->OnKeyDown(event);
+}
+
+void AbstractShellView::DispatchKeyUpEvent(KeyEvent *event) {
+  AbstractView *view = GetKeyboardFocus();
+  if (nullptr != view) KeyboardTask::Get(view)->event_handler()->OnKeyUp(event);
+}
+
 void AbstractShellView::DropShadow(const Context &context) {
   using namespace base;
   using namespace graphics;
@@ -72,25 +72,13 @@ void AbstractShellView::Private::OnXdgToplevelClose() {
   proprietor()->Close();
 }
 
-void AbstractShellView::Private::DispatchMouseEnterEvent(AbstractView *parent,
-                                                         MouseEvent *event,
-                                                         MouseTask *tail) {
-  AbstractView *sub = parent->DispatchMouseEnterEvent(event);
-  while (nullptr != sub) {
-    _ASSERT(sub != parent);
-    sub->OnMouseEnter(event);
-    if (event->IsAccepted()) {
-      tail->push_back(MouseTask::Get(sub));
-      tail = static_cast<MouseTask *>(tail->next());
-      parent = sub;
-      sub = parent->DispatchMouseEnterEvent(event);
-    } else if (event->IsIgnored()) {
-      parent = sub;
-      sub = parent->DispatchMouseEnterEvent(event);
-    } else {
-      break;
-    }
-  }
+void AbstractShellView::Private::OnAnimationFrameRequest() {
+  // Takes effect in the next commit of the shell surface:
+  animation_frame.Setup(shell_surface);
+}
+
+void AbstractShellView::Private::OnAnimationFrame(uint32_t time) {
+  animator.Step(time);
 }
 
 }
@@ -18,6 +18,8 @@
 #define WIZTK_GUI_ABSTRACT_SHELL_VIEW_PRIVATE_HPP_
 
 #include "wiztk/gui/abstract-shell-view.hpp"
+#include "wiztk/gui/animator.hpp"
+#include "wiztk/gui/callback.hpp"
 
 #include "wiztk/base/property.hpp"
 #include "xdg-shell-unstable-v6-client-protocol.h"
@@ -47,7 +49,10 @@ struct AbstractShellView::Private : public base::Property<AbstractShellView> {
    */
   explicit Private(AbstractShellView *shell_view)
       : base::Property<AbstractShellView>(shell_view),
-        geometry_task(shell_view) {}
+        geometry_task(shell_view) {
+    animator.frame_request().Bind(this, &Private::OnAnimationFrameRequest);
+    animation_frame.done().Bind(this, &Private::OnAnimationFrame);
+  }
 
   /**
    * @brief Destructor
@@ -109,9 +114,16 @@ struct AbstractShellView::Private : public base::Property<AbstractShellView> {
 
   void OnXdgToplevelClose();
 
-  void DispatchMouseEnterEvent(AbstractView *parent,
-                               MouseEvent *event,
-                               MouseTask *tail);
+  void OnAnimationFrameRequest();
+
+  void OnAnimationFrame(uint32_t time);
+
+  Animator animator;
+
+  /**
+   * @brief The frame callback to step the animator
+   */
+  Callback animation_frame;
 
 };
 
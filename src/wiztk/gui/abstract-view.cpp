@@ -27,8 +27,12 @@
 
 #include "wiztk/gui/abstract-shell-view.hpp"
 #include "wiztk/gui/abstract-layout.hpp"
+#include "wiztk/gui/hover-path.hpp"
+#include "wiztk/gui/animator.hpp"
 #include "wiztk/gui/mouse-event.hpp"
 
+#include <algorithm>
+
 namespace wiztk {
 namespace gui {
 
@@ -62,6 +66,9 @@ AbstractView::AbstractView(int width, int height, const DeleterType &deleter)
 }
 
 AbstractView::~AbstractView() {
+  if (p_->hover_count > 0) HoverPath::Forget(this);
+  if (p_->animation_count > 0) Animator::Forget(this);
+
   _ASSERT(nullptr == p_->parent);
   _ASSERT(nullptr == p_->shell_view);
   _ASSERT(nullptr == p_->previous);
@@ -81,9 +88,7 @@ void AbstractView::SetMinimalWidth(int width) {
 
   p_->minimal_size.width = width;
 
-  if (p_->layout) {
-    // TODO: relayout
-  }
+  if (nullptr != p_->layout) p_->layout->RequestLayout();
 }
 
 void AbstractView::SetMinimalHeight(int height) {
@@ -93,9 +98,7 @@ void AbstractView::SetMinimalHeight(int height) {
 
   p_->minimal_size.height = height;
 
-  if (p_->layout) {
-    // TODO: relayout
-  }
+  if (nullptr != p_->layout) p_->layout->RequestLayout();
 }
 
 int AbstractView::GetMinimalWidth() const {
@@ -111,9 +114,7 @@ void AbstractView::SetPreferredWidth(int width) {
 
   p_->preferred_size.width = width;
 
-  if (nullptr != p_->layout) {
-    // TODO: relayout
-  }
+  if (nullptr != p_->layout) p_->layout->RequestLayout();
 }
 
 void AbstractView::SetPreferredHeight(int height) {
@@ -121,9 +122,7 @@ void AbstractView::SetPreferredHeight(int height) {
 
   p_->preferred_size.height = height;
 
-  if (nullptr != p_->layout) {
-    // TODO: relayout
-  }
+  if (nullptr != p_->layout) p_->layout->RequestLayout();
 }
 
 int AbstractView::GetPreferredWidth() const {
@@ -141,9 +140,7 @@ void AbstractView::SetMaximalWidth(int width) {
 
   p_->maximal_size.width = width;
 
-  if (nullptr != p_->layout) {
-    // TODO: relayout
-  }
+  if (nullptr != p_->layout) p_->layout->RequestLayout();
 }
 
 void AbstractView::SetMaximalHeight(int height) {
@@ -153,9 +150,7 @@ void AbstractView::SetMaximalHeight(int height) {
 
   p_->maximal_size.height = height;
 
-  if (nullptr != p_->layout) {
-    // TODO: relayout
-  }
+  if (nullptr != p_->layout) p_->layout->RequestLayout();
 }
 
 int AbstractView::GetMaximalWidth() const {
@@ -169,9 +164,7 @@ int AbstractView::GetMaximalHeight() const {
 void AbstractView::SetLayoutPolicyOnX(LayoutPolicy policy) {
   p_->x_layout_policy = policy;
 
-  if (nullptr != p_->layout) {
-    // TODO: relayout
-  }
+  if (nullptr != p_->layout) p_->layout->RequestLayout();
 }
 
 LayoutPolicy AbstractView::GetLayoutPolicyOnX() const {
@@ -181,9 +174,7 @@ LayoutPolicy AbstractView::GetLayoutPolicyOnX() const {
 void AbstractView::SetLayoutPolicyOnY(LayoutPolicy policy) {
   p_->y_layout_policy = policy;
 
-  if (nullptr != p_->layout) {
-    // TODO: relayout
-  }
+  if (nullptr != p_->layout) p_->layout->RequestLayout();
 }
 
 LayoutPolicy AbstractView::GetLayoutPolicyOnY() const {
@@ -396,7 +387,11 @@ void AbstractView::AddAnchorTo(AbstractView *target, int align, int distance) {
     }
   } else {
     _DEBUG("%s\n", "Error! Cannot add anchor to the view which have no relationship!");
+    return;
   }
+
+  if (nullptr != p_->layout) p_->layout->RequestLayout();
+  else if (nullptr != target->p_->layout) target->p_->layout->RequestLayout();
 }
 
 const AnchorGroup &AbstractView::GetAnchorGroup(int align) const {
@@ -423,6 +418,38 @@ bool AbstractView::Contain(int x, int y) const {
   return p_->geometry.Contain(x, y);
 }
 
+AbstractView *AbstractView::HitTest(int x, int y) const {
+  HitTestIndex *index = p_->hit_test_index.get();
+
+  if (nullptr == index) {
+    for (AbstractView *child : p_->children) {
+      if (child->Contain(x, y)) return child;
+    }
+    return nullptr;
+  }
+
+  if (index->IsDirty()) {
+    index->Clear();
+    for (AbstractView *child : p_->children) {
+      index->Add(child, child->p_->geometry);
+    }
+    index->Build();
+  }
+
+  return index->Find(x, y);
+}
+
+void AbstractView::SetHitTestIndexEnabled(bool enabled) {
+  if (enabled == IsHitTestIndexEnabled()) return;
+
+  if (enabled) p_->hit_test_index.reset(new HitTestIndex);
+  else p_->hit_test_index.reset();
+}
+
+bool AbstractView::IsHitTestIndexEnabled() const {
+  return nullptr != p_->hit_test_index;
+}
+
 void AbstractView::Destroy() {
   destroyed_.Emit(this);
 
@@ -559,22 +586,10 @@ void AbstractView::OnDestroy() {
   // override in sub class
 }
 
-AbstractView *AbstractView::DispatchMouseEnterEvent(MouseEvent *event) {
-  Iterator it(this);
-  AbstractView *view = nullptr;
-  Point2I cursor_xy(event->GetWindowXY());
-
-  for (it = it.first_child(); it; ++it) {
-    if (it.view()->Contain(cursor_xy.x, cursor_xy.y)) {
-      view = it.view();
-      break;
-    }
-  }
-
-  return view;
-}
-
 bool AbstractView::RequestSaveGeometry(const RectF &geometry) {
+  if (nullptr != p_->parent && p_->geometry != geometry)
+    p_->parent->p_->InvalidateHitTestIndex();
+
   p_->geometry = geometry;
 
   if (p_->last_geometry == p_->geometry) {
@@ -621,25 +636,13 @@ void AbstractView::UntrackMouseMotion() {
 AbstractView *AbstractView::GetChildAt(int index) const {
   if (index < 0) index = p_->children_count + index;
 
-  AbstractView *object = nullptr;
-  int mid = (p_->children_count + 1) / 2;
+  if (index < 0 || index >= p_->children_count) return nullptr;
 
-  if (index >= 0 && index < mid) {
-    object = p_->first_child;
-    while (index > 0) {
-      object = object->p_->next;
-      index--;
-    }
-  } else if (index >= mid && index < p_->children_count) {
-    object = p_->last_child;
-    int max = p_->children_count - 1;
-    while (index < max) {
-      object = object->p_->previous;
-      index++;
-    }
-  }
+  return p_->children[index];
+}
 
-  return object;
+int AbstractView::GetIndex() const {
+  return p_->index;
 }
 
 void AbstractView::PushFrontChild(AbstractView *child) {
@@ -660,20 +663,7 @@ void AbstractView::PushFrontChild(AbstractView *child) {
   _ASSERT(nullptr == child->p_->next);
   _ASSERT(nullptr == child->p_->parent);
 
-  if (p_->first_child) {
-    p_->first_child->p_->previous = child;
-    child->p_->next = p_->first_child;
-  } else {
-    _ASSERT(nullptr == p_->last_child);
-    _ASSERT(0 == p_->children_count);
-    // child->data_->next_ = nullptr;
-    p_->last_child = child;
-  }
-  p_->first_child = child;
-
-  // child->data_->previous_ = nullptr;
-  child->p_->parent = this;
-  p_->children_count++;
+  p_->InsertChildAt(child, 0);
 
   OnChildAdded(child);
   if (child->p_->parent == this)
@@ -698,55 +688,15 @@ void AbstractView::InsertChild(AbstractView *child, int index) {
   _ASSERT(nullptr == child->p_->next);
   _ASSERT(nullptr == child->p_->parent);
 
-  if (nullptr == p_->first_child) {
-    _ASSERT(nullptr == p_->last_child);
-    _ASSERT(0 == p_->children_count);
-    // child->data_->next_ = nullptr;
-    // child->data_->previous_ = nullptr;
-    p_->last_child = child;
-    p_->first_child = child;
+  // A negative index counts from the back and inserts after that position:
+  if (index >= 0) {
+    if (index > p_->children_count) index = p_->children_count;
   } else {
-    if (index >= 0) {
-      AbstractView *p = p_->first_child;
-      while (p && (index > 0)) {
-        p = p->p_->next;
-        index--;
-      }
-      if (p) {  // insert before p
-        child->p_->previous = p->p_->previous;
-        child->p_->next = p;
-        if (p->p_->previous) p->p_->previous->p_->next = child;
-        else p_->first_child = child;
-        p->p_->previous = child;
-      } else {  // push back
-        p_->last_child->p_->next = child;
-        child->p_->previous = p_->last_child;
-        p_->last_child = child;
-        // child->data_->next_ = nullptr;
-      }
-    } else {
-      AbstractView *p = p_->last_child;
-      while (p && (index < -1)) {
-        p = p->p_->previous;
-        index++;
-      }
-      if (p) {  // insert after p
-        child->p_->next = p->p_->next;
-        child->p_->previous = p;
-        if (p->p_->next) p->p_->next->p_->previous = child;
-        else p_->last_child = child;
-        p->p_->next = child;
-      } else {  // push front
-        p_->first_child->p_->previous = child;
-        child->p_->next = p_->first_child;
-        p_->first_child = child;
-        // child->data_->previous_ = nullptr;
-      }
-    }
+    index = p_->children_count + index + 1;
+    if (index < 0) index = 0;
   }
 
-  child->p_->parent = this;
-  p_->children_count++;
+  p_->InsertChildAt(child, index);
 
   OnChildAdded(child);
   if (child->p_->parent == this)
@@ -771,20 +721,7 @@ void AbstractView::PushBackChild(AbstractView *child) {
   _ASSERT(child->p_->next == nullptr);
   _ASSERT(child->p_->parent == nullptr);
 
-  if (p_->last_child) {
-    p_->last_child->p_->next = child;
-    child->p_->previous = p_->last_child;
-  } else {
-    _ASSERT(p_->first_child == nullptr);
-    _ASSERT(p_->children_count == 0);
-    // child->data_->previous_ = nullptr;
-    p_->first_child = child;
-  }
-  p_->last_child = child;
-
-  // child->data_->next_ = nullptr;
-  child->p_->parent = this;
-  p_->children_count++;
+  p_->InsertChildAt(child, p_->children_count);
 
   OnChildAdded(child);
   if (child->p_->parent == this)
@@ -795,27 +732,9 @@ AbstractView *AbstractView::RemoveChild(AbstractView *child) {
   if (child->p_->parent != this) return nullptr;
 
   _ASSERT(p_->children_count > 0);
+  _ASSERT(p_->children[child->p_->index] == child);
 
-  if (child->p_->previous) {
-    child->p_->previous->p_->next = child->p_->next;
-  } else {
-    _ASSERT(p_->first_child == child);
-    p_->first_child = child->p_->next;
-  }
-
-  if (child->p_->next) {
-    child->p_->next->p_->previous = child->p_->previous;
-  } else {
-    _ASSERT(p_->last_child == child);
-    p_->last_child = child->p_->previous;
-  }
-
-  p_->children_count--;
-  _ASSERT(p_->children_count >= 0);
-
-  child->p_->previous = nullptr;
-  child->p_->next = nullptr;
-  child->p_->parent = nullptr;
+  p_->EraseChildAt(child->p_->index);
 
   OnChildRemoved(child);
   if (child->p_->parent != this)
@@ -825,21 +744,13 @@ AbstractView *AbstractView::RemoveChild(AbstractView *child) {
 }
 
 void AbstractView::ClearChildren() {
-  AbstractView *ptr = p_->first_child;
-  AbstractView *next = nullptr;
-
-  while (ptr) {
-    next = ptr->p_->next;
-    // ptr->previous_ = nullptr;
-    // ptr->next_ = nullptr;
-    // ptr->parent_ = nullptr;
-    ptr->Destroy();
-    ptr = next;
+  // Destroy from the back so that each removal does not move other children:
+  while (nullptr != p_->last_child) {
+    p_->last_child->Destroy();
   }
 
-  p_->children_count = 0;
-  p_->first_child = nullptr;
-  p_->last_child = nullptr;
+  _ASSERT(0 == p_->children_count);
+  _ASSERT(nullptr == p_->first_child);
 }
 
 bool AbstractView::SwapIndex(AbstractView *view1, AbstractView *view2) {
@@ -848,66 +759,13 @@ bool AbstractView::SwapIndex(AbstractView *view1, AbstractView *view2) {
   if (view1->p_->parent != view2->p_->parent) return false;
   if (view1->p_->parent == nullptr) return false;
 
-  AbstractView *tmp1 = nullptr;
-  AbstractView *tmp2 = nullptr;
-
-  if (view1->p_->next == view2) {    // view1 is just the previous sibling of view2
-
-    _ASSERT(view2->p_->previous == view1);
-    tmp1 = view1->p_->previous;
-    tmp2 = view2->p_->next;
-    view2->p_->previous = tmp1;
-    view1->p_->previous = view2;
-    view2->p_->next = view1;
-    view1->p_->next = tmp2;
-
-    if (tmp1 != nullptr) tmp1->p_->next = view2;
-    else view1->p_->parent->p_->first_child = view2;
-
-    if (tmp2 != nullptr) tmp2->p_->previous = view1;
-    else view2->p_->parent->p_->last_child = view2;
-
-  } else if (view1->p_->previous == view2) {
-    _ASSERT(view2->p_->next == view1);
-
-    tmp1 = view2->p_->previous;
-    tmp2 = view1->p_->next;
-    view1->p_->previous = tmp1;
-    view2->p_->previous = view1;
-    view1->p_->next = view2;
-    view2->p_->next = tmp2;
-
-    if (tmp1 != nullptr) tmp1->p_->next = view1;
-    else view2->p_->parent->p_->first_child = view1;
-
-    if (tmp2 != nullptr) tmp2->p_->previous = view2;
-    else view1->p_->parent->p_->last_child = view2;
-
-  } else {
-
-    tmp1 = view1->p_->previous;
-    tmp2 = view2->p_->previous;
-    view1->p_->previous = tmp2;
-    view2->p_->previous = tmp1;
-
-    if (tmp1 != nullptr) tmp1->p_->next = view2;
-    else view1->p_->parent->p_->first_child = view2;
-
-    if (tmp2 != nullptr) tmp2->p_->next = view1;
-    else view2->p_->parent->p_->first_child = view1;
-
-    tmp1 = view1->p_->next;
-    tmp2 = view2->p_->next;
-    view1->p_->next = tmp2;
-    view2->p_->next = tmp1;
-
-    if (tmp1 != nullptr) tmp1->p_->previous = view2;
-    else view1->p_->parent->p_->last_child = view2;
-
-    if (tmp2 != nullptr) tmp2->p_->previous = view1;
-    else view2->p_->parent->p_->last_child = view1;
+  Private *parent = view1->p_->parent->p_.get();
+  int index1 = view1->p_->index;
+  int index2 = view2->p_->index;
 
-  }
+  std::swap(parent->children[index1], parent->children[index2]);
+  parent->UpdateChildren(index1, index1 + 1);
+  parent->UpdateChildren(index2, index2 + 1);
 
   return true;
 }
@@ -915,67 +773,25 @@ bool AbstractView::SwapIndex(AbstractView *view1, AbstractView *view2) {
 bool AbstractView::InsertSiblingBefore(AbstractView *src, AbstractView *dst) {
   if (src == nullptr || dst == nullptr) return false;
   if (src == dst) return false;
+  if (src->p_->parent == nullptr) return false;
 
-  if (dst->p_->parent != nullptr) {
-
-    if (dst->p_->parent == src->p_->parent) {
-
-      if (src->p_->previous == dst) {    // already is the previous one of src
-        return true;
-      }
-
-      if (dst->p_->previous) {
-        dst->p_->previous->p_->next = dst->p_->next;
-      } else {
-        _ASSERT(dst->p_->parent->p_->first_child == dst);
-        dst->p_->parent->p_->first_child = dst->p_->next;
-      }
+  Private *parent = src->p_->parent->p_.get();
 
-      if (dst->p_->next) {
-        dst->p_->next->p_->previous = dst->p_->previous;
-      } else {
-        _ASSERT(dst->p_->parent->p_->last_child == dst);
-        dst->p_->parent->p_->last_child = dst->p_->previous;
-      }
-
-      AbstractView *tmp = src->p_->previous;
-
-      src->p_->previous = dst;
-      dst->p_->next = src;
-      dst->p_->previous = tmp;
-
-      if (tmp) {
-        tmp->p_->next = dst;
-      } else {
-        _ASSERT(src->p_->parent->p_->first_child == src);
-        dst->p_->parent->p_->first_child = dst;
-      }
-
-      return true;
-
-    } else {
-      dst->p_->parent->RemoveChild(dst);
+  if (dst->p_->parent == src->p_->parent) {
+    if (src->p_->previous != dst) {  // not already the previous one of src
+      int from = dst->p_->index;
+      parent->MoveChild(from, from < src->p_->index ? src->p_->index - 1 : src->p_->index);
     }
-
+    return true;
   }
+
+  if (dst->p_->parent != nullptr) dst->p_->parent->RemoveChild(dst);
+
   _ASSERT(dst->p_->parent == nullptr);
   _ASSERT(dst->p_->next == nullptr);
   _ASSERT(dst->p_->previous == nullptr);
 
-  AbstractView *tmp = src->p_->previous;
-
-  src->p_->previous = dst;
-  dst->p_->next = src;
-  dst->p_->previous = tmp;
-  if (tmp) {
-    tmp->p_->next = dst;
-  } else {
-    _ASSERT(src->p_->parent->p_->first_child == src);
-    src->p_->parent->p_->first_child = dst;
-  }
-
-  dst->p_->parent = src->p_->parent;
-  src->p_->parent->p_->children_count++;
+  parent->InsertChildAt(dst, src->p_->index);
 
   return true;
 }
@@ -983,199 +799,106 @@ bool AbstractView::InsertSiblingBefore(AbstractView *src, AbstractView *dst) {
 bool AbstractView::InsertSiblingAfter(AbstractView *src, AbstractView *dst) {
   if (src == nullptr || dst == nullptr) return false;
   if (src == dst) return false;
+  if (src->p_->parent == nullptr) return false;
 
-  if (dst->p_->parent != nullptr) {
-
-    if (dst->p_->previous == src->p_->parent) {
+  Private *parent = src->p_->parent->p_.get();
 
-      if (src->p_->next == dst) {    // alrady is the next one of src
-        return true;
-      }
-
-      if (dst->p_->previous) {
-        dst->p_->previous->p_->next = dst->p_->next;
-      } else {
-        _ASSERT(dst->p_->parent->p_->first_child == dst);
-        dst->p_->parent->p_->first_child = dst->p_->next;
-      }
-
-      if (dst->p_->next) {
-        dst->p_->next->p_->previous = dst->p_->previous;
-      } else {
-        _ASSERT(dst->p_->parent->p_->last_child == dst);
-        dst->p_->parent->p_->last_child = dst->p_->previous;
-      }
-
-      AbstractView *tmp = src->p_->next;
-
-      src->p_->next = dst;
-      dst->p_->previous = src;
-      dst->p_->next = tmp;
-
-      if (tmp) {
-        tmp->p_->previous = dst;
-      } else {
-        _ASSERT(src->p_->parent->p_->last_child == src);
-        dst->p_->parent->p_->last_child = dst;
-      }
-
-      return true;
-
-    } else {
-      dst->p_->parent->RemoveChild(dst);
+  if (dst->p_->parent == src->p_->parent) {
+    if (src->p_->next != dst) {  // not already the next one of src
+      int from = dst->p_->index;
+      parent->MoveChild(from, from < src->p_->index ? src->p_->index : src->p_->index + 1);
     }
-
+    return true;
   }
 
+  if (dst->p_->parent != nullptr) dst->p_->parent->RemoveChild(dst);
+
   _ASSERT(dst->p_->parent == nullptr);
   _ASSERT(dst->p_->next == nullptr);
   _ASSERT(dst->p_->previous == nullptr);
 
-  AbstractView *tmp = src->p_->next;
-
-  src->p_->next = dst;
-  dst->p_->previous = src;
-  dst->p_->next = tmp;
-  if (tmp) {
-    tmp->p_->previous = dst;
-  } else {
-    _ASSERT(src->p_->parent->p_->last_child == src);
-    src->p_->parent->p_->last_child = dst;
-  }
-
-  dst->p_->parent = src->p_->parent;
-  src->p_->parent->p_->children_count++;
+  parent->InsertChildAt(dst, src->p_->index + 1);
 
   return true;
 }
 
 void AbstractView::MoveToFirst(AbstractView *view) {
   if (view->p_->parent) {
-
-    if (view->p_->parent->p_->first_child == view) {
-      _ASSERT(view->p_->previous == 0);
-      return;    // already at first
-    }
-
-    view->p_->previous->p_->next = view->p_->next;
-    if (view->p_->next) {
-      view->p_->next->p_->previous = view->p_->previous;
-    } else {
-      _ASSERT(view->p_->parent->p_->last_child == view);
-      view->p_->parent->p_->last_child = view->p_->previous;
-    }
-
-    view->p_->previous = 0;
-    view->p_->next = view->p_->parent->p_->first_child;
-    view->p_->parent->p_->first_child->p_->previous = view;
-    view->p_->parent->p_->first_child = view;
+    view->p_->parent->p_->MoveChild(view->p_->index, 0);
   }
 }
 
 void AbstractView::MoveToLast(AbstractView *view) {
   if (view->p_->parent) {
-
-    if (view->p_->parent->p_->last_child == view) {
-      _ASSERT(view->p_->next == 0);
-      return;    // already at last
-    }
-
-    view->p_->next->p_->previous = view->p_->previous;
-
-    if (view->p_->previous) {
-      view->p_->previous->p_->next = view->p_->next;
-    } else {
-      _ASSERT(view->p_->parent->p_->first_child == view);
-      view->p_->parent->p_->first_child = view->p_->next;
-    }
-
-    view->p_->next = 0;
-    view->p_->previous = view->p_->parent->p_->last_child;
-    view->p_->parent->p_->last_child->p_->next = view;
-    view->p_->parent->p_->last_child = view;
+    view->p_->parent->p_->MoveChild(view->p_->index, view->p_->parent->p_->children_count - 1);
   }
 }
 
 void AbstractView::MoveForward(AbstractView *view) {
-  if (view->p_->parent) {
+  if (view->p_->parent && view->p_->next) {
+    view->p_->parent->p_->MoveChild(view->p_->index, view->p_->index + 1);
+  }
+}
 
-    if (view->p_->next) {
+void AbstractView::MoveBackward(AbstractView *view) {
+  if (view->p_->parent && view->p_->previous) {
+    view->p_->parent->p_->MoveChild(view->p_->index, view->p_->index - 1);
+  }
+}
 
-      AbstractView *tmp = view->p_->next;
+// -------------------
 
-      tmp->p_->previous = view->p_->previous;
-      if (view->p_->previous) {
-        view->p_->previous->p_->next = tmp;
-      } else {
-        _ASSERT(view->p_->parent->p_->first_child == view);
-        view->p_->parent->p_->first_child = tmp;
-      }
+void AbstractView::Private::InsertChildAt(AbstractView *child, int index) {
+  _ASSERT(index >= 0 && index <= children_count);
 
-      view->p_->previous = tmp;
-      view->p_->next = tmp->p_->next;
-      if (tmp->p_->next) {
-        tmp->p_->next->p_->previous = view;
-      }
-      tmp->p_->next = view;
+  children.insert(children.begin() + index, child);
+  child->p_->parent = proprietor;
+  UpdateChildren(index, static_cast<int>(children.size()));
+}
 
-      if (view->p_->next == 0) {
-        _ASSERT(view->p_->parent->p_->last_child == tmp);
-        view->p_->parent->p_->last_child = view;
-      }
+void AbstractView::Private::EraseChildAt(int index) {
+  AbstractView *child = children[index];
 
-      if (view->p_->previous) {
-        _ASSERT(view->p_->previous->p_->next == view);
-      }
-      if (view->p_->next) {
-        _ASSERT(view->p_->next->p_->previous == view);
-      }
+  children.erase(children.begin() + index);
+  child->p_->previous = nullptr;
+  child->p_->next = nullptr;
+  child->p_->parent = nullptr;
+  child->p_->index = -1;
+  UpdateChildren(index, static_cast<int>(children.size()));
+}
 
-    } else {
-      _ASSERT(view->p_->parent->p_->last_child == view);
-    }
+void AbstractView::Private::MoveChild(int from, int to) {
+  if (from == to) return;
 
+  auto begin = children.begin();
+  if (from < to) {
+    std::rotate(begin + from, begin + from + 1, begin + to + 1);
+    UpdateChildren(from, to + 1);
+  } else {
+    std::rotate(begin + to, begin + from, begin + from + 1);
+    UpdateChildren(to, from + 1);
   }
 }
 
-void AbstractView::MoveBackward(AbstractView *view) {
-  if (view->p_->parent) {
-
-    if (view->p_->previous) {
-
-      AbstractView *tmp = view->p_->previous;
+void AbstractView::Private::UpdateChildren(int begin, int end) {
+  int count = static_cast<int>(children.size());
 
-      tmp->p_->next = view->p_->next;
-      if (view->p_->next) {
-        view->p_->next->p_->previous = tmp;
-      } else {
-        _ASSERT(view->p_->parent->p_->last_child == view);
-        view->p_->parent->p_->last_child = tmp;
-      }
-
-      view->p_->next = tmp;
-      view->p_->previous = tmp->p_->previous;
-      if (tmp->p_->previous) {
-        tmp->p_->previous->p_->next = view;
-      }
-      tmp->p_->previous = view;
-
-      if (view->p_->previous == 0) {
-        _ASSERT(view->p_->parent->p_->first_child == tmp);
-        view->p_->parent->p_->first_child = view;
-      }
+  // The neighbours of the range have their links changed too:
+  begin = std::max(begin - 1, 0);
+  end = std::min(end + 1, count);
 
-      if (view->p_->previous) {
-        _ASSERT(view->p_->previous->p_->next == view);
-      }
-      if (view->p_->next) {
-        _ASSERT(view->p_->next->p_->previous == view);
-      }
+  for (int i = begin; i < end; ++i) {
+    AbstractView *child = children[i];
+    child->p_->index = i;
+    child->p_->previous = i > 0 ? children[i - 1] : nullptr;
+    child->p_->next = i < count - 1 ? children[i + 1] : nullptr;
+  }
 
-    } else {
-      _ASSERT(view->p_->parent->p_->first_child == view);
-    }
+  children_count = count;
+  first_child = children.empty() ? nullptr : children.front();
+  last_child = children.empty() ? nullptr : children.back();
 
-  }
+  InvalidateHitTestIndex();
 }
 
 // -------------------
@@ -0,0 +1,131 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hit-test-index.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace wiztk {
+namespace gui {
+
+const int AbstractView::HitTestIndex::kMaxCellsPerView;
+const int AbstractView::HitTestIndex::kMaxGridSize;
+
+void AbstractView::HitTestIndex::Clear() {
+  items_.clear();
+  cells_.clear();
+  large_items_.clear();
+  dirty_ = true;
+}
+
+void AbstractView::HitTestIndex::Add(AbstractView *view, const RectF &geometry) {
+  if (geometry.IsEmpty()) return;
+  items_.push_back({view, geometry});
+}
+
+void AbstractView::HitTestIndex::Build() {
+  dirty_ = false;
+  columns_ = rows_ = 0;
+
+  if (items_.empty()) return;
+
+  bounds_ = items_.front().geometry;
+  for (const Item &item : items_) {
+    bounds_.left = std::min(bounds_.left, item.geometry.left);
+    bounds_.top = std::min(bounds_.top, item.geometry.top);
+    bounds_.right = std::max(bounds_.right, item.geometry.right);
+    bounds_.bottom = std::max(bounds_.bottom, item.geometry.bottom);
+  }
+
+  // About one cell per view, in the aspect ratio of the bounds:
+  float count = static_cast<float>(items_.size());
+  float ratio = bounds_.width() / bounds_.height();
+  columns_ = std::max(1, std::min(kMaxGridSize, static_cast<int>(std::ceil(std::sqrt(count * ratio)))));
+  rows_ = std::max(1, std::min(kMaxGridSize, static_cast<int>(std::ceil(count / columns_))));
+  cell_width_ = bounds_.width() / columns_;
+  cell_height_ = bounds_.height() / rows_;
+
+  // Count, then fill the cells:
+  offsets_.assign(static_cast<size_t>(columns_ * rows_ + 1), 0);
+  for (int pass = 0; pass < 2; ++pass) {
+    std::vector<int> fill;
+    if (1 == pass) {
+      for (size_t i = 1; i < offsets_.size(); ++i) offsets_[i] += offsets_[i - 1];
+      cells_.resize(static_cast<size_t>(offsets_.back()));
+      fill.assign(offsets_.begin(), offsets_.end() - 1);
+    }
+
+    for (size_t i = 0; i < items_.size(); ++i) {
+      const RectF &geometry = items_[i].geometry;
+      int column0 = GetColumn(geometry.left);
+      int column1 = GetColumn(geometry.right);
+      int row0 = GetRow(geometry.top);
+      int row1 = GetRow(geometry.bottom);
+
+      if ((column1 - column0 + 1) * (row1 - row0 + 1) > kMaxCellsPerView) {
+        if (1 == pass) large_items_.push_back(static_cast<int>(i));
+        continue;
+      }
+
+      for (int row = row0; row <= row1; ++row) {
+        for (int column = column0; column <= column1; ++column) {
+          int cell = row * columns_ + column;
+          if (0 == pass) ++offsets_[cell + 1];
+          else cells_[fill[cell]++] = static_cast<int>(i);
+        }
+      }
+    }
+  }
+}
+
+AbstractView *AbstractView::HitTestIndex::Find(int x, int y) const {
+  if (0 == columns_ || !bounds_.Contain(x, y)) return nullptr;
+
+  int found = static_cast<int>(items_.size());
+  int cell = GetRow(y) * columns_ + GetColumn(x);
+
+  // Items are in the order of children in each cell:
+  for (int i = offsets_[cell]; i < offsets_[cell + 1]; ++i) {
+    if (items_[cells_[i]].view->Contain(x, y)) {
+      found = cells_[i];
+      break;
+    }
+  }
+
+  for (int index : large_items_) {
+    if (index > found) break;
+    if (items_[index].view->Contain(x, y)) {
+      found = index;
+      break;
+    }
+  }
+
+  return found < static_cast<int>(items_.size()) ? items_[found].view : nullptr;
+}
+
+int AbstractView::HitTestIndex::GetColumn(float x) const {
+  int column = static_cast<int>((x - bounds_.left) / cell_width_);
+  return std::max(0, std::min(columns_ - 1, column));
+}
+
+int AbstractView::HitTestIndex::GetRow(float y) const {
+  int row = static_cast<int>((y - bounds_.top) / cell_height_);
+  return std::max(0, std::min(rows_ - 1, row));
+}
+
+} // namespace gui
+} // namespace wiztk
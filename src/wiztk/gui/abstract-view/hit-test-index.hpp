@@ -0,0 +1,113 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef WIZTK_GUI_INTERNAL_ABSTRACT_VIEW_HIT_TEST_INDEX_HPP_
+#define WIZTK_GUI_INTERNAL_ABSTRACT_VIEW_HIT_TEST_INDEX_HPP_
+
+#include "wiztk/gui/abstract-view.hpp"
+
+#include <vector>
+
+namespace wiztk {
+namespace gui {
+
+/**
+ * @brief A uniform grid over the geometries of child views
+ *
+ * The index is rebuilt lazily: views are added in the order of children, then
+ * Build() puts each one into the grid cells it covers. A view covering too
+ * many cells is kept in a separate list instead. Find() returns the first
+ * view in the order of children which contains the given position, the same
+ * result as a linear scan.
+ */
+WIZTK_NO_EXPORT class AbstractView::HitTestIndex {
+
+ public:
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(HitTestIndex);
+
+  HitTestIndex() = default;
+
+  ~HitTestIndex() = default;
+
+  /**
+   * @brief Mark this index to be rebuilt before the next query
+   */
+  void Invalidate() { dirty_ = true; }
+
+  bool IsDirty() const { return dirty_; }
+
+  /**
+   * @brief Remove all views to rebuild the index
+   */
+  void Clear();
+
+  void Add(AbstractView *view, const RectF &geometry);
+
+  void Build();
+
+  AbstractView *Find(int x, int y) const;
+
+ private:
+
+  /**
+   * @brief A view covers more cells than this is not put into the grid
+   */
+  static const int kMaxCellsPerView = 16;
+
+  static const int kMaxGridSize = 1024;
+
+  struct Item {
+    AbstractView *view;
+    RectF geometry;
+  };
+
+  int GetColumn(float x) const;
+
+  int GetRow(float y) const;
+
+  bool dirty_ = true;
+
+  std::vector<Item> items_;
+
+  RectF bounds_;
+
+  int columns_ = 0;
+
+  int rows_ = 0;
+
+  float cell_width_ = 1.f;
+
+  float cell_height_ = 1.f;
+
+  /**
+   * @brief The item indices in each cell, in CSR layout
+   */
+  std::vector<int> offsets_;
+
+  std::vector<int> cells_;
+
+  /**
+   * @brief The indices of items not in the grid
+   */
+  std::vector<int> large_items_;
+
+};
+
+} // namespace gui
+} // namespace wiztk
+
+#endif // WIZTK_GUI_INTERNAL_ABSTRACT_VIEW_HIT_TEST_INDEX_HPP_
@@ -24,6 +24,10 @@
 #include "wiztk/gui/anchor.hpp"
 #include "wiztk/gui/anchor-group.hpp"
 
+#include "hit-test-index.hpp"
+
+#include <vector>
+
 namespace wiztk {
 namespace gui {
 
@@ -36,12 +40,14 @@ WIZTK_NO_EXPORT struct AbstractView::Private {
   Private() = delete;
 
   explicit Private(AbstractView *view)
-      : previous(nullptr),
+      : proprietor(view),
+        previous(nullptr),
         next(nullptr),
         first_child(nullptr),
         last_child(nullptr),
         parent(nullptr),
         children_count(0),
+        index(-1),
         shell_view(nullptr),
         visible(true),
         minimal_size(0, 0),
@@ -55,10 +61,40 @@ WIZTK_NO_EXPORT struct AbstractView::Private {
         top_anchor_group(view, graphics::Alignment::kTop),
         right_anchor_group(view, graphics::Alignment::kRight),
         bottom_anchor_group(view, graphics::Alignment::kBottom),
-        layout(nullptr) {}
+        layout(nullptr),
+        is_layout(false),
+        hover_count(0),
+        animation_count(0),
+        animation_stamp(0) {}
 
   ~Private() = default;
 
+  void InvalidateHitTestIndex() {
+    if (hit_test_index) hit_test_index->Invalidate();
+  }
+
+  /**
+   * @brief Insert a child into the array and update links, without callbacks
+   */
+  void InsertChildAt(AbstractView *child, int index);
+
+  /**
+   * @brief Erase a child from the array and update links, without callbacks
+   */
+  void EraseChildAt(int index);
+
+  /**
+   * @brief Move a child in the array and shift the ones between
+   */
+  void MoveChild(int from, int to);
+
+  /**
+   * @brief Update the back-indices and links of children in [begin, end)
+   */
+  void UpdateChildren(int begin, int end);
+
+  AbstractView *proprietor;
+
   AbstractView *previous;
   AbstractView *next;
 
@@ -68,6 +104,16 @@ WIZTK_NO_EXPORT struct AbstractView::Private {
   AbstractView *parent;
   int children_count;
 
+  /**
+   * @brief Children in order, the links above are kept in sync for traversal
+   */
+  std::vector<AbstractView *> children;
+
+  /**
+   * @brief The index of this view in the children of its parent, or -1
+   */
+  int index;
+
   AbstractShellView *shell_view;
 
   bool visible;
@@ -104,7 +150,30 @@ WIZTK_NO_EXPORT struct AbstractView::Private {
 
   AbstractLayout *layout;
 
-  std::string name;
+  /**
+   * @brief If this view is an AbstractLayout
+   */
+  bool is_layout;
+
+  /**
+   * @brief The number of hover paths this view is in
+   */
+  int hover_count;
+
+  /**
+   * @brief The number of running animations of this view
+   */
+  int animation_count;
+
+  /**
+   * @brief The last animator step which updated this view
+   */
+  uint32_t animation_stamp;
+
+  /**
+   * @brief The optional spatial index of children
+   */
+  std::unique_ptr<HitTestIndex> hit_test_index;
 
   DeleterType deleter;
 
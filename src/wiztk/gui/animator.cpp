@@ -0,0 +1,378 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "wiztk/gui/animator.hpp"
+
+#include "abstract-view/private.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace wiztk {
+namespace gui {
+
+using base::ColorF;
+using base::RectF;
+
+namespace {
+
+/**
+ * @brief All animators alive, to forget destroyed views
+ */
+std::vector<Animator *> &GetAnimators() {
+  static std::vector<Animator *> animators;
+  return animators;
+}
+
+/**
+ * @brief A counter shared by all animators to mark the views updated in a
+ * step
+ */
+uint32_t NextFrameStamp() {
+  static uint32_t stamp = 0;
+  if (0 == ++stamp) ++stamp;
+  return stamp;
+}
+
+inline float Lerp(float from, float to, float t) {
+  return from + (to - from) * t;
+}
+
+inline ColorF Lerp(const ColorF &from, const ColorF &to, float t) {
+  return ColorF(Lerp(from.r, to.r, t),
+                Lerp(from.g, to.g, t),
+                Lerp(from.b, to.b, t),
+                Lerp(from.a, to.a, t));
+}
+
+inline RectF Lerp(const RectF &from, const RectF &to, float t) {
+  return RectF(Lerp(from.left, to.left, t),
+               Lerp(from.top, to.top, t),
+               Lerp(from.right, to.right, t),
+               Lerp(from.bottom, to.bottom, t));
+}
+
+} // namespace
+
+struct Animator::Private {
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(Private);
+
+  Private() = default;
+
+  ~Private() = default;
+
+  enum Kind {
+    kKindFloat,
+    kKindColor,
+    kKindRect
+  };
+
+  template<typename T>
+  struct Track {
+
+    AbstractView *view;
+
+    T *value;
+
+    T from;
+
+    T to;
+
+    uint32_t start;
+
+    uint32_t duration;
+
+    Easing easing;
+
+    int repeat;
+
+    uint32_t slot;
+
+    bool started;
+
+  };
+
+  /**
+   * @brief Maps a handle to the track in one of the arrays
+   */
+  struct Slot {
+
+    Kind kind;
+
+    uint32_t index;
+
+    /** 0 if the slot is free */
+    uint32_t serial;
+
+  };
+
+  template<typename T>
+  Handle Add(std::vector<Track<T>> &tracks, Kind kind, AbstractView *view, T *value,
+             const T &from, const T &to, uint32_t duration, Easing easing, int repeat);
+
+  template<typename T>
+  void Remove(std::vector<Track<T>> &tracks, size_t index);
+
+  template<typename T>
+  void RemoveView(std::vector<Track<T>> &tracks, const AbstractView *view);
+
+  template<typename T>
+  void Step(std::vector<Track<T>> &tracks, uint32_t time, uint32_t stamp);
+
+  template<typename T>
+  void Clear(std::vector<Track<T>> &tracks);
+
+  /**
+   * @brief Update the view if it's not updated in this step
+   */
+  static void Invalidate(AbstractView *view, uint32_t stamp) {
+    if (view->p_->animation_stamp == stamp) return;
+    view->p_->animation_stamp = stamp;
+    view->Update();
+  }
+
+  std::vector<Track<float>> floats;
+
+  std::vector<Track<ColorF>> colors;
+
+  std::vector<Track<RectF>> rects;
+
+  std::vector<Slot> slots;
+
+  std::vector<uint32_t> free_slots;
+
+  uint32_t serial = 0;
+
+  bool frame_requested = false;
+
+};
+
+template<typename T>
+Animator::Handle Animator::Private::Add(std::vector<Track<T>> &tracks, Kind kind, AbstractView *view, T *value,
+                                        const T &from, const T &to, uint32_t duration, Easing easing, int repeat) {
+  uint32_t slot;
+  if (free_slots.empty()) {
+    slot = static_cast<uint32_t>(slots.size());
+    slots.push_back(Slot());
+  } else {
+    slot = free_slots.back();
+    free_slots.pop_back();
+  }
+
+  if (0 == ++serial) ++serial;
+  slots[slot] = {kind, static_cast<uint32_t>(tracks.size()), serial};
+  tracks.push_back({view, value, from, to, 0, duration, easing, repeat, slot, false});
+
+  *value = from;
+  ++view->p_->animation_count;
+
+  Handle handle;
+  handle.slot = slot;
+  handle.serial = serial;
+  return handle;
+}
+
+template<typename T>
+void Animator::Private::Remove(std::vector<Track<T>> &tracks, size_t index) {
+  Track<T> &track = tracks[index];
+
+  --track.view->p_->animation_count;
+  slots[track.slot].serial = 0;
+  free_slots.push_back(track.slot);
+
+  if (index + 1 != tracks.size()) {
+    track = tracks.back();
+    slots[track.slot].index = static_cast<uint32_t>(index);
+  }
+  tracks.pop_back();
+}
+
+template<typename T>
+void Animator::Private::RemoveView(std::vector<Track<T>> &tracks, const AbstractView *view) {
+  size_t i = 0;
+  while (i < tracks.size()) {
+    if (tracks[i].view == view) Remove(tracks, i);
+    else ++i;
+  }
+}
+
+template<typename T>
+void Animator::Private::Step(std::vector<Track<T>> &tracks, uint32_t time, uint32_t stamp) {
+  size_t i = 0;
+  while (i < tracks.size()) {
+    Track<T> &track = tracks[i];
+
+    if (!track.started) {
+      track.start = time;
+      track.started = true;
+    }
+
+    // Unsigned arithmetic works when the timestamp wraps around:
+    uint32_t elapsed = time - track.start;
+    bool finished = false;
+
+    if (elapsed >= track.duration) {
+      uint32_t cycles = 0 == track.duration ? 0 : elapsed / track.duration;
+      if (cycles > 0 && (kRepeatForever == track.repeat || static_cast<uint32_t>(track.repeat) >= cycles)) {
+        if (kRepeatForever != track.repeat) track.repeat -= cycles;
+        track.start += cycles * track.duration;
+        elapsed -= cycles * track.duration;
+      } else {
+        finished = true;
+      }
+    }
+
+    float progress = finished ? 1.f : static_cast<float>(elapsed) / track.duration;
+    *track.value = Lerp(track.from, track.to, Ease(track.easing, progress));
+    Invalidate(track.view, stamp);
+
+    if (finished) Remove(tracks, i);
+    else ++i;
+  }
+}
+
+template<typename T>
+void Animator::Private::Clear(std::vector<Track<T>> &tracks) {
+  for (Track<T> &track : tracks) --track.view->p_->animation_count;
+  tracks.clear();
+}
+
+// -------
+
+Animator::Animator() {
+  p_ = std::make_unique<Private>();
+  GetAnimators().push_back(this);
+}
+
+Animator::~Animator() {
+  p_->Clear(p_->floats);
+  p_->Clear(p_->colors);
+  p_->Clear(p_->rects);
+
+  std::vector<Animator *> &animators = GetAnimators();
+  animators.erase(std::find(animators.begin(), animators.end(), this));
+}
+
+Animator::Handle Animator::Animate(AbstractView *view, float *value, float from, float to,
+                                   uint32_t duration, Easing easing, int repeat) {
+  Handle handle = p_->Add(p_->floats, Private::kKindFloat, view, value, from, to, duration, easing, repeat);
+  view->Update();
+  RequestFrame();
+  return handle;
+}
+
+Animator::Handle Animator::Animate(AbstractView *view, ColorF *value, const ColorF &from, const ColorF &to,
+                                   uint32_t duration, Easing easing, int repeat) {
+  Handle handle = p_->Add(p_->colors, Private::kKindColor, view, value, from, to, duration, easing, repeat);
+  view->Update();
+  RequestFrame();
+  return handle;
+}
+
+Animator::Handle Animator::Animate(AbstractView *view, RectF *value, const RectF &from, const RectF &to,
+                                   uint32_t duration, Easing easing, int repeat) {
+  Handle handle = p_->Add(p_->rects, Private::kKindRect, view, value, from, to, duration, easing, repeat);
+  view->Update();
+  RequestFrame();
+  return handle;
+}
+
+void Animator::Stop(Handle &handle) {
+  if (!IsRunning(handle)) {
+    handle = Handle();
+    return;
+  }
+
+  const Private::Slot &slot = p_->slots[handle.slot];
+  switch (slot.kind) {
+    case Private::kKindFloat: p_->Remove(p_->floats, slot.index);
+      break;
+    case Private::kKindColor: p_->Remove(p_->colors, slot.index);
+      break;
+    case Private::kKindRect: p_->Remove(p_->rects, slot.index);
+      break;
+  }
+
+  handle = Handle();
+}
+
+void Animator::Stop(const AbstractView *view) {
+  if (0 == view->p_->animation_count) return;
+
+  p_->RemoveView(p_->floats, view);
+  p_->RemoveView(p_->colors, view);
+  p_->RemoveView(p_->rects, view);
+}
+
+bool Animator::IsRunning(const Handle &handle) const {
+  return 0 != handle.serial && handle.slot < p_->slots.size() && p_->slots[handle.slot].serial == handle.serial;
+}
+
+int Animator::GetCount() const {
+  return static_cast<int>(p_->floats.size() + p_->colors.size() + p_->rects.size());
+}
+
+void Animator::Step(uint32_t time) {
+  p_->frame_requested = false;
+
+  uint32_t stamp = NextFrameStamp();
+  p_->Step(p_->floats, time, stamp);
+  p_->Step(p_->colors, time, stamp);
+  p_->Step(p_->rects, time, stamp);
+
+  if (GetCount() > 0) RequestFrame();
+}
+
+float Animator::Ease(Easing easing, float progress) {
+  float t = progress < 0.f ? 0.f : (progress > 1.f ? 1.f : progress);
+
+  switch (easing) {
+    case kEasingInQuad: return t * t;
+    case kEasingOutQuad: return t * (2.f - t);
+    case kEasingInOutQuad: return t < 0.5f ? 2.f * t * t : -1.f + (4.f - 2.f * t) * t;
+    case kEasingInCubic: return t * t * t;
+    case kEasingOutCubic: {
+      t -= 1.f;
+      return t * t * t + 1.f;
+    }
+    case kEasingInOutCubic: {
+      if (t < 0.5f) return 4.f * t * t * t;
+      t = 2.f * t - 2.f;
+      return 0.5f * t * t * t + 1.f;
+    }
+    default: break;
+  }
+
+  return t;
+}
+
+void Animator::Forget(const AbstractView *view) {
+  for (Animator *animator : GetAnimators()) {
+    animator->Stop(view);
+    if (0 == view->p_->animation_count) break;
+  }
+}
+
+void Animator::RequestFrame() {
+  if (p_->frame_requested) return;
+
+  p_->frame_requested = true;
+  if (frame_request_) frame_request_();
+}
+
+} // namespace gui
+} // namespace wiztk
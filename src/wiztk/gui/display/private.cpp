@@ -26,6 +26,22 @@ namespace gui {
 
 PFNEGLSWAPBUFFERSWITHDAMAGEEXTPROC Display::Private::kSwapBuffersWithDamageAPI = NULL;
 
+const base::Atom Display::Private::kCompositorInterface(wl_compositor_interface.name);
+
+const base::Atom Display::Private::kSubcompositorInterface(wl_subcompositor_interface.name);
+
+const base::Atom Display::Private::kShmInterface(wl_shm_interface.name);
+
+const base::Atom Display::Private::kOutputInterface(wl_output_interface.name);
+
+const base::Atom Display::Private::kXdgShellInterface(zxdg_shell_v6_interface.name);
+
+const base::Atom Display::Private::kShellInterface(wl_shell_interface.name);
+
+const base::Atom Display::Private::kSeatInterface(wl_seat_interface.name);
+
+const base::Atom Display::Private::kDataDeviceManagerInterface(wl_data_device_manager_interface.name);
+
 const struct wl_display_listener Display::Private::kDisplayListener = {
     OnError,
     OnDeleteId
@@ -251,23 +267,25 @@ void Display::Private::OnGlobal(void *data,
 
   auto *global = new Global;
   global->id = id;
-  global->interface = interface;
+  global->interface = base::Atom(interface);
   global->version = version;
   _this->p_->globals.push_back(global);
 
-  if (strcmp(interface, wl_compositor_interface.name) == 0) {
+  const base::Atom &name = global->interface;
+
+  if (name == kCompositorInterface) {
     _this->p_->wl_compositor =
         static_cast<struct wl_compositor *>(wl_registry_bind(_this->p_->wl_registry,
                                                              id,
                                                              &wl_compositor_interface,
                                                              version));
-  } else if (strcmp(interface, wl_subcompositor_interface.name) == 0) {
+  } else if (name == kSubcompositorInterface) {
     _this->p_->wl_subcompositor =
         static_cast<struct wl_subcompositor *>(wl_registry_bind(_this->p_->wl_registry,
                                                                 id,
                                                                 &wl_subcompositor_interface,
                                                                 version));
-  } else if (strcmp(interface, wl_shm_interface.name) == 0) {
+  } else if (name == kShmInterface) {
     _this->p_->wl_shm =
         static_cast<struct wl_shm *>(wl_registry_bind(_this->p_->wl_registry,
                                                       id,
@@ -278,24 +296,24 @@ void Display::Private::OnGlobal(void *data,
     _this->p_->wl_cursor_theme = wl_cursor_theme_load(NULL, 24, _this->p_->wl_shm);
 
     _this->InitializeCursors();
-  } else if (strcmp(interface, wl_output_interface.name) == 0) {
+  } else if (name == kOutputInterface) {
     _this->p_->output_manager.AddOutput(id, version);
-  } else if (strcmp(interface, zxdg_shell_v6_interface.name) == 0) {
+  } else if (name == kXdgShellInterface) {
     _this->p_->xdg_shell =
         static_cast<struct zxdg_shell_v6 *>(wl_registry_bind(_this->p_->wl_registry,
                                                              id,
                                                              &zxdg_shell_v6_interface,
                                                              version));
     zxdg_shell_v6_add_listener(_this->p_->xdg_shell, &Private::kXdgShellListener, _this);
-  } else if (strcmp(interface, wl_shell_interface.name) == 0) {
+  } else if (name == kShellInterface) {
     _this->p_->wl_shell =
         static_cast<struct wl_shell *>(wl_registry_bind(_this->p_->wl_registry,
                                                         id, &wl_shell_interface,
                                                         version));
-  } else if (strcmp(interface, wl_seat_interface.name) == 0) {
+  } else if (name == kSeatInterface) {
     auto *input = new Input(id, version);
     _this->p_->input_manager.AddInput(input);
-  } else if (strcmp(interface, wl_data_device_manager_interface.name) == 0) {
+  } else if (name == kDataDeviceManagerInterface) {
     _this->p_->wl_data_device_manager =
         static_cast<struct wl_data_device_manager *>(wl_registry_bind(_this->p_->wl_registry,
                                                                       id,
@@ -315,7 +333,7 @@ void Display::Private::OnGlobalRemove(void *data,
       continue;
     }
 
-    if ((*it)->interface == "wl_output") {
+    if ((*it)->interface == Private::kOutputInterface) {
       _this->p_->output_manager.RemoveOutput(name);
     }
 
@@ -138,6 +138,24 @@ struct Display::Private {
 
   static PFNEGLSWAPBUFFERSWITHDAMAGEEXTPROC kSwapBuffersWithDamageAPI;
 
+  // The interface names handled in OnGlobal():
+
+  static const base::Atom kCompositorInterface;
+
+  static const base::Atom kSubcompositorInterface;
+
+  static const base::Atom kShmInterface;
+
+  static const base::Atom kOutputInterface;
+
+  static const base::Atom kXdgShellInterface;
+
+  static const base::Atom kShellInterface;
+
+  static const base::Atom kSeatInterface;
+
+  static const base::Atom kDataDeviceManagerInterface;
+
 };
 
 } // namespace gui
@@ -24,6 +24,7 @@
 
 #include "wiztk/gui/key-event.hpp"
 #include "wiztk/gui/mouse-event.hpp"
+#include "wiztk/gui/hover-path.hpp"
 
 #include "wiztk/gui/surface.hpp"
 #include "wiztk/gui/callback.hpp"
@@ -358,7 +359,7 @@ void GLWindow::OnMouseDown(MouseEvent *event) {
 
     int location = p_->GetMouseLocation(event);
 
-    if (location == kClientArea && (nullptr == MouseTask::Get(this)->next())) {
+    if (location == kClientArea && (nullptr == event->GetHoverPath().GetLeaf())) {
       MoveWithMouse(event);
       event->Ignore();
       return;
@@ -0,0 +1,130 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "wiztk/gui/hover-path.hpp"
+
+#include "abstract-view/private.hpp"
+
+#include "wiztk/gui/mouse-event.hpp"
+
+#include <algorithm>
+
+namespace wiztk {
+namespace gui {
+
+namespace {
+
+/**
+ * @brief All paths alive, one per seat, to forget destroyed views
+ */
+std::vector<HoverPath *> &GetPaths() {
+  static std::vector<HoverPath *> paths;
+  return paths;
+}
+
+} // namespace
+
+HoverPath::HoverPath() {
+  GetPaths().push_back(this);
+}
+
+HoverPath::~HoverPath() {
+  Truncate(0, false);
+
+  std::vector<HoverPath *> &paths = GetPaths();
+  paths.erase(std::find(paths.begin(), paths.end(), this));
+}
+
+void HoverPath::Update(AbstractView *root, int x, int y, MouseEvent *event) {
+  AbstractView *view = (nullptr != root && root->Contain(x, y)) ? root : nullptr;
+
+  // Keep the views hovered in the last frame:
+  size_t depth = 0;
+  while (nullptr != view && depth < entries_.size() && entries_[depth].view == view) {
+    view = view->HitTest(x, y);
+    ++depth;
+  }
+
+  if (depth < entries_.size()) {
+    Truncate(depth, true);
+    // Callbacks may change the tree, find the next view again:
+    if (entries_.size() != depth) return;
+    if (0 == depth)
+      view = (nullptr != root && root->Contain(x, y)) ? root : nullptr;
+    else
+      view = entries_.back().view->HitTest(x, y);
+  }
+
+  while (nullptr != view) {
+    entries_.push_back({view, false});
+    ++view->p_->hover_count;
+
+    static_cast<AbstractEventHandler *>(view)->OnMouseEnter(event);
+    if (entries_.size() != depth + 1) return; // destroyed in callback
+
+    if (event->IsAccepted()) {
+      entries_.back().accepted = true;
+    } else if (!event->IsIgnored()) {
+      Truncate(depth, false);
+      return;
+    }
+
+    view = view->HitTest(x, y);
+    ++depth;
+  }
+}
+
+void HoverPath::Clear() {
+  Truncate(0, true);
+}
+
+AbstractView *HoverPath::GetLeaf() const {
+  for (auto it = entries_.rbegin(); it != entries_.rend(); ++it) {
+    if (it->accepted) return it->view;
+  }
+  return nullptr;
+}
+
+void HoverPath::Clear(const AbstractShellView *shell_view) {
+  for (HoverPath *path : GetPaths()) {
+    if (!path->entries_.empty() && path->entries_.front().view->GetShellView() == shell_view)
+      path->Clear();
+  }
+}
+
+void HoverPath::Forget(const AbstractView *view) {
+  for (HoverPath *path : GetPaths()) {
+    for (size_t i = 0; i < path->entries_.size(); ++i) {
+      if (path->entries_[i].view == view) {
+        path->Truncate(i, false);
+        break;
+      }
+    }
+  }
+}
+
+void HoverPath::Truncate(size_t depth, bool callback) {
+  while (entries_.size() > depth) {
+    Entry entry = entries_.back();
+    entries_.pop_back();
+    --entry.view->p_->hover_count;
+    if (callback && entry.accepted)
+      static_cast<AbstractEventHandler *>(entry.view)->OnMouseLeave();
+  }
+}
+
+} // namespace gui
+} // namespace wiztk
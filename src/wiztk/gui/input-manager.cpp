@@ -38,5 +38,11 @@ void InputManager::Clear() {
   });
 }
 
+void InputManager::ResetSurface(const Surface *surface) {
+  for (auto it = deque_.begin(); it; ++it) {
+    it->ResetSurface(surface);
+  }
+}
+
 }
 }
\ No newline at end of file
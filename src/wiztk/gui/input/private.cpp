@@ -101,16 +101,15 @@ void Input::Private::OnPointerEnter(void *data,
                                     wl_fixed_t surface_x,
                                     wl_fixed_t surface_y) {
   auto *_this = static_cast<Input *>(data);
+  PointerFrame &frame = _this->p_->pointer_frame;
 
-  _this->p_->mouse_event->p_->serial = serial;
-  _this->p_->mouse_event->p_->surface_xy.x = wl_fixed_to_double(surface_x);
-  _this->p_->mouse_event->p_->surface_xy.y = wl_fixed_to_double(surface_y);
+  frame.mask |= PointerFrame::kEnter;
+  frame.enter_serial = serial;
+  frame.enter_surface = static_cast<Surface *>(wl_surface_get_user_data(wl_surface));
+  frame.surface_xy.x = wl_fixed_to_double(surface_x);
+  frame.surface_xy.y = wl_fixed_to_double(surface_y);
 
-  _this->p_->mouse_event->p_->surface =
-      static_cast<Surface *>(wl_surface_get_user_data(wl_surface));
-
-  _this->p_->mouse_event->response_ = InputEvent::kUnknown;
-  _this->p_->mouse_event->p_->surface->GetEventHandler()->OnMouseEnter(_this->p_->mouse_event);
+  if (_this->p_->IsPointerFrameless()) _this->p_->CommitPointerFrame();
 }
 
 void Input::Private::OnPointerLeave(void *data,
@@ -118,12 +117,15 @@ void Input::Private::OnPointerLeave(void *data,
                                     uint32_t serial,
                                     struct wl_surface *wl_surface) {
   auto *_this = static_cast<Input *>(data);
+  PointerFrame &frame = _this->p_->pointer_frame;
 
-  _this->p_->mouse_event->p_->serial = serial;
-  _this->p_->mouse_event->p_->surface = static_cast<Surface *>(wl_surface_get_user_data(wl_surface));
+  frame.mask |= PointerFrame::kLeave;
+  frame.leave_serial = serial;
+  // The surface may be destroyed already:
+  frame.leave_surface =
+      nullptr == wl_surface ? nullptr : static_cast<Surface *>(wl_surface_get_user_data(wl_surface));
 
-  _this->p_->mouse_event->response_ = InputEvent::kUnknown;
-  _this->p_->mouse_event->p_->surface->GetEventHandler()->OnMouseLeave();
+  if (_this->p_->IsPointerFrameless()) _this->p_->CommitPointerFrame();
 }
 
 void Input::Private::OnPointerMotion(void *data,
@@ -132,15 +134,14 @@ void Input::Private::OnPointerMotion(void *data,
                                      wl_fixed_t surface_x,
                                      wl_fixed_t surface_y) {
   auto *_this = static_cast<Input *>(data);
+  PointerFrame &frame = _this->p_->pointer_frame;
 
-  _this->p_->mouse_event->p_->time = time;
-  _this->p_->mouse_event->p_->surface_xy.x = wl_fixed_to_double(surface_x);
-  _this->p_->mouse_event->p_->surface_xy.y = wl_fixed_to_double(surface_y);
-
-  if (nullptr == _this->p_->mouse_event->p_->surface) return;
+  frame.mask |= PointerFrame::kMotion;
+  frame.time = time;
+  frame.surface_xy.x = wl_fixed_to_double(surface_x);
+  frame.surface_xy.y = wl_fixed_to_double(surface_y);
 
-  _this->p_->mouse_event->response_ = InputEvent::kUnknown;
-  _this->p_->mouse_event->p_->surface->GetEventHandler()->OnMouseMove(_this->p_->mouse_event);
+  if (_this->p_->IsPointerFrameless()) _this->p_->CommitPointerFrame();
 }
 
 void Input::Private::OnPointerButton(void *data,
@@ -150,22 +151,15 @@ void Input::Private::OnPointerButton(void *data,
                                      uint32_t button,
                                      uint32_t state) {
   auto *_this = static_cast<Input *>(data);
+  PointerFrame &frame = _this->p_->pointer_frame;
 
-  _this->p_->mouse_event->response_ = InputEvent::kUnknown;
-  _this->p_->mouse_event->p_->serial = serial;
-  _this->p_->mouse_event->p_->time = time;
-  _this->p_->mouse_event->p_->button = button;
-  _this->p_->mouse_event->p_->state = state;
-
-  if (nullptr == _this->p_->mouse_event->p_->surface) return;
+  // A frame should not contain many buttons, commit early if it does:
+  if (frame.button_count == PointerFrame::kMaxButtons) _this->p_->CommitPointerFrame();
 
-  _this->p_->mouse_event->response_ = InputEvent::kUnknown;
+  frame.mask |= PointerFrame::kButton;
+  frame.buttons[frame.button_count++] = {serial, time, button, state};
 
-  if (state == WL_POINTER_BUTTON_STATE_PRESSED) {
-    _this->p_->mouse_event->p_->surface->GetEventHandler()->OnMouseDown(_this->p_->mouse_event);
-  } else if (state == WL_POINTER_BUTTON_STATE_RELEASED) {
-    _this->p_->mouse_event->p_->surface->GetEventHandler()->OnMouseUp(_this->p_->mouse_event);
-  }
+  if (_this->p_->IsPointerFrameless()) _this->p_->CommitPointerFrame();
 }
 
 void Input::Private::OnPointerAxis(void *data,
@@ -173,25 +167,142 @@ void Input::Private::OnPointerAxis(void *data,
                                    uint32_t time,
                                    uint32_t axis,
                                    wl_fixed_t value) {
+  auto *_this = static_cast<Input *>(data);
+  PointerFrame &frame = _this->p_->pointer_frame;
+
+  if (axis > WL_POINTER_AXIS_HORIZONTAL_SCROLL) return;
 
+  frame.mask |= PointerFrame::kAxis;
+  frame.axis = axis;
+  frame.axis_time = time;
+  frame.axis_value[axis] += wl_fixed_to_double(value);
+
+  if (_this->p_->IsPointerFrameless()) _this->p_->CommitPointerFrame();
 }
 
 void Input::Private::OnPointerFrame(void *data, struct wl_pointer *wl_pointer) {
-
+  auto *_this = static_cast<Input *>(data);
+  _this->p_->CommitPointerFrame();
 }
 
 void Input::Private::OnPointerAxisSource(void *data, struct wl_pointer *wl_pointer, uint32_t axis_source) {
+  auto *_this = static_cast<Input *>(data);
+  PointerFrame &frame = _this->p_->pointer_frame;
 
+  frame.mask |= PointerFrame::kAxisSource;
+  frame.axis_source = static_cast<MouseAxisSource>(axis_source);
 }
 
 void Input::Private::OnPointerAxisStop(void *data, struct wl_pointer *wl_pointer, uint32_t time, uint32_t axis) {
+  auto *_this = static_cast<Input *>(data);
+  PointerFrame &frame = _this->p_->pointer_frame;
 
+  if (axis > WL_POINTER_AXIS_HORIZONTAL_SCROLL) return;
+
+  frame.mask |= PointerFrame::kAxisStop;
+  frame.axis = axis;
+  frame.axis_time = time;
+  frame.axis_stop[axis] = true;
 }
 
 void Input::Private::OnPointerAxisDiscrete(void *data, struct wl_pointer *wl_pointer, uint32_t axis, int32_t discrete) {
+  auto *_this = static_cast<Input *>(data);
+  PointerFrame &frame = _this->p_->pointer_frame;
+
+  if (axis > WL_POINTER_AXIS_HORIZONTAL_SCROLL) return;
 
+  frame.mask |= PointerFrame::kAxisDiscrete;
+  frame.axis_discrete[axis] += discrete;
 }
 
+void Input::Private::CommitPointerFrame() {
+  if (nullptr != mouse_event && 0 != pointer_frame.mask) mouse_dispatcher.Commit(pointer_frame);
+  pointer_frame = PointerFrame();
+}
+
+// -------
+
+void Input::Private::MouseDispatcher::OnLeave(uint32_t serial, Surface *surface) {
+  MouseEvent *mouse_event = owner_->mouse_event;
+  MouseEvent::Private *event = mouse_event->p_.get();
+
+  event->serial = serial;
+  if (nullptr != event->surface && (nullptr == surface || event->surface == surface)) {
+    mouse_event->response_ = InputEvent::kUnknown;
+    event->surface->GetEventHandler()->OnMouseLeave();
+  }
+  event->surface = nullptr;
+}
+
+void Input::Private::MouseDispatcher::OnEnter(uint32_t serial, Surface *surface, const base::Point2D &surface_xy) {
+  MouseEvent *mouse_event = owner_->mouse_event;
+  MouseEvent::Private *event = mouse_event->p_.get();
+
+  event->serial = serial;
+  event->surface = surface;
+  event->surface_xy = surface_xy;
+  if (nullptr != event->surface) {
+    mouse_event->response_ = InputEvent::kUnknown;
+    event->surface->GetEventHandler()->OnMouseEnter(mouse_event);
+  }
+}
+
+void Input::Private::MouseDispatcher::OnMotion(uint32_t time, const base::Point2D &surface_xy) {
+  MouseEvent *mouse_event = owner_->mouse_event;
+  MouseEvent::Private *event = mouse_event->p_.get();
+
+  event->time = time;
+  event->surface_xy = surface_xy;
+  if (nullptr != event->surface) {
+    mouse_event->response_ = InputEvent::kUnknown;
+    event->surface->GetEventHandler()->OnMouseMove(mouse_event);
+  }
+}
+
+void Input::Private::MouseDispatcher::OnButton(const PointerFrame::Button &button) {
+  MouseEvent *mouse_event = owner_->mouse_event;
+  MouseEvent::Private *event = mouse_event->p_.get();
+
+  event->serial = button.serial;
+  event->time = button.time;
+  event->button = button.button;
+  event->state = button.state;
+  if (nullptr == event->surface) return;
+
+  mouse_event->response_ = InputEvent::kUnknown;
+  if (button.state == WL_POINTER_BUTTON_STATE_PRESSED) {
+    event->surface->GetEventHandler()->OnMouseDown(mouse_event);
+  } else if (button.state == WL_POINTER_BUTTON_STATE_RELEASED) {
+    event->surface->GetEventHandler()->OnMouseUp(mouse_event);
+  }
+}
+
+void Input::Private::MouseDispatcher::OnAxis(const PointerAxis &axis) {
+  MouseEvent *mouse_event = owner_->mouse_event;
+  MouseEvent::Private *event = mouse_event->p_.get();
+
+  event->axis = axis.axis;
+  event->axis_source = axis.source;
+  for (int i = 0; i < 2; ++i) {
+    event->axis_value[i] = axis.value[i];
+    event->axis_discrete[i] = axis.discrete[i];
+    event->axis_stop[i] = axis.stop[i];
+  }
+
+  if (nullptr != event->surface) {
+    mouse_event->response_ = InputEvent::kUnknown;
+    event->surface->GetEventHandler()->OnMouseAxis(mouse_event);
+  }
+
+  for (int i = 0; i < 2; ++i) {
+    event->axis_value[i] = 0.0;
+    event->axis_discrete[i] = 0;
+    event->axis_stop[i] = false;
+  }
+}
+
+// -------
+
 void Input::Private::OnKeyboardKeymap(void *data,
                                       struct wl_keyboard *wl_keyboard,
                                       uint32_t format,
@@ -221,6 +332,8 @@ void Input::Private::OnKeyboardKeymap(void *data,
   munmap(string, size);
   close(fd);
 
+  _this->p_->key_repeater.Stop();
+
   try {
     _this->p_->keyboard_state.Setup(_this->p_->keymap);
   } catch (const std::runtime_error &e) {
@@ -239,13 +352,21 @@ void Input::Private::OnKeyboardEnter(void *data,
   auto *_this = static_cast<Input *>(data);
 
   _this->p_->key_event->serial_ = serial;
-//  keyboard_event_.surface_ = static_cast<Surface*>(wl_surface_get_user_data((wl_surface)));
-  // TODO: use the keys
-//  void *p = nullptr;
-//  int count = 0;
-//  wl_array_for_each(p, keys) {
-//    count++;
-//  }
+  _this->p_->key_event->surface_ =
+      nullptr == wl_surface ? nullptr : static_cast<Surface *>(wl_surface_get_user_data(wl_surface));
+
+  // Keys held across the focus change are not dispatched as key down, but
+  // the last repeatable one keeps repeating until it's released:
+  _this->p_->key_repeater.Stop();
+
+  uint32_t repeated = 0;
+  const auto *pressed = static_cast<const uint32_t *>(keys->data);
+  for (size_t i = 0; i < keys->size / sizeof(uint32_t); ++i) {
+    if (_this->p_->keyboard_state.IsRepeated(pressed[i])) repeated = pressed[i];
+  }
+
+  if (0 != repeated)
+    _this->p_->key_repeater.Start(repeated, _this->p_->key_event->time_);
 }
 
 void Input::Private::OnKeyboardLeave(void *data,
@@ -254,8 +375,9 @@ void Input::Private::OnKeyboardLeave(void *data,
                                      struct wl_surface *wl_surface) {
   auto *_this = static_cast<Input *>(data);
 
+  _this->p_->key_repeater.Stop();
   _this->p_->key_event->serial_ = serial;
-
+  _this->p_->key_event->surface_ = nullptr;
 }
 
 void Input::Private::OnKeyboardKey(void *data,
@@ -267,14 +389,16 @@ void Input::Private::OnKeyboardKey(void *data,
   auto *_this = static_cast<Input *>(data);
 
   _this->p_->key_event->serial_ = serial;
-  _this->p_->key_event->time_ = serial;
-  _this->p_->key_event->key_ = key;
-  _this->p_->key_event->state_ = state;
+  _this->p_->key_event->time_ = time;
 
   if (state == WL_KEYBOARD_KEY_STATE_PRESSED) {
-    // OnKeyDown;
+    _this->p_->DispatchKey(key, state, false);
+    if (_this->p_->keyboard_state.IsRepeated(key))
+      _this->p_->key_repeater.Start(key, time);
   } else if (state == WL_KEYBOARD_KEY_STATE_RELEASED) {
-    // OnKeyUp;
+    if (_this->p_->key_repeater.GetKey() == key)
+      _this->p_->key_repeater.Stop();
+    _this->p_->DispatchKey(key, state, false);
   }
 }
 
@@ -292,10 +416,38 @@ void Input::Private::OnKeyboardModifiers(void *data,
   _this->p_->key_event->mods_latched_ = mods_latched;
   _this->p_->key_event->mods_locked_ = mods_locked;
   _this->p_->key_event->group_ = group;
+
+  _this->p_->keyboard_state.UpdateMask(mods_depressed, mods_latched, mods_locked, group);
 }
 
 void Input::Private::OnKeyboardRepeatInfo(void *data, struct wl_keyboard *wl_keyboard, int32_t rate, int32_t delay) {
+  auto *_this = static_cast<Input *>(data);
+
+  _this->p_->key_repeater.SetInfo(rate, delay);
+}
+
+void Input::Private::DispatchKey(uint32_t key, uint32_t state, bool repeat) {
+  key_event->key_ = key;
+  key_event->state_ = state;
+  key_event->repeat_ = repeat;
+  key_event->keysym_ = keyboard_state.GetOneSym(key);
+  keyboard_state.GetUTF8(key, key_event->text_, sizeof(key_event->text_));
+
+  if (nullptr == key_event->surface_) return;
+
+  key_event->response_ = InputEvent::kUnknown;
+  if (state == WL_KEYBOARD_KEY_STATE_PRESSED) {
+    key_event->surface_->GetEventHandler()->OnKeyDown(key_event);
+  } else if (state == WL_KEYBOARD_KEY_STATE_RELEASED) {
+    key_event->surface_->GetEventHandler()->OnKeyUp(key_event);
+  }
+}
+
+// -------
 
+void Input::Private::SeatKeyRepeater::OnRepeat(uint32_t key, uint32_t time) {
+  owner_->key_event->time_ = time;
+  owner_->DispatchKey(key, WL_KEYBOARD_KEY_STATE_PRESSED, true);
 }
 
 void Input::Private::OnTouchDown(void *data,
@@ -306,11 +458,41 @@ void Input::Private::OnTouchDown(void *data,
                                  int32_t id,
                                  wl_fixed_t x,
                                  wl_fixed_t y) {
+  auto *_this = static_cast<Input *>(data);
+  TouchEvent *event = _this->p_->touch_event;
+
+  base::Point2D xy(wl_fixed_to_double(x), wl_fixed_to_double(y));
+
+  if (0 == event->count_) {
+    event->surface_ = static_cast<Surface *>(wl_surface_get_user_data(surface));
+    event->origin_xy_ = xy;
+  }
+  event->serial_ = serial;
+
+  int index = event->FindIndex(id);
+  if (index < 0) {
+    if (event->count_ == TouchEvent::kMaxPoints) return;
+    index = event->count_++;
+  }
 
+  TouchPoint &point = event->points_[index];
+  point.id = id;
+  point.state = kTouchDown;
+  point.time = time;
+  point.surface_xy = xy;
+  point.last_surface_xy = xy;
 }
 
 void Input::Private::OnTouchUp(void *data, struct wl_touch *wl_touch, uint32_t serial, uint32_t time, int32_t id) {
+  auto *_this = static_cast<Input *>(data);
+  TouchEvent *event = _this->p_->touch_event;
+
+  int index = event->FindIndex(id);
+  if (index < 0) return;
 
+  event->serial_ = serial;
+  event->points_[index].state = kTouchUp;
+  event->points_[index].time = time;
 }
 
 void Input::Private::OnTouchMotion(void *data,
@@ -319,15 +501,71 @@ void Input::Private::OnTouchMotion(void *data,
                                    int32_t id,
                                    wl_fixed_t x,
                                    wl_fixed_t y) {
+  auto *_this = static_cast<Input *>(data);
+  TouchEvent *event = _this->p_->touch_event;
 
+  int index = event->FindIndex(id);
+  if (index < 0) return;
+
+  TouchPoint &point = event->points_[index];
+  if (kTouchDown != point.state) point.state = kTouchMotion;
+  point.time = time;
+  point.surface_xy.x = wl_fixed_to_double(x);
+  point.surface_xy.y = wl_fixed_to_double(y);
 }
 
 void Input::Private::OnTouchFrame(void *data, struct wl_touch *wl_touch) {
+  auto *_this = static_cast<Input *>(data);
+  TouchEvent *event = _this->p_->touch_event;
 
+  bool changed = false;
+  for (int i = 0; i < event->count_ && !changed; ++i) {
+    changed = kTouchStationary != event->points_[i].state;
+  }
+  if (!changed) return;
+
+  event->gesture_.Update(event->points_, event->count_);
+  _this->p_->DispatchTouch();
 }
 
 void Input::Private::OnTouchCancel(void *data, struct wl_touch *wl_touch) {
+  auto *_this = static_cast<Input *>(data);
+  TouchEvent *event = _this->p_->touch_event;
+
+  if (0 == event->count_) return;
 
+  event->cancelled_ = true;
+  for (int i = 0; i < event->count_; ++i) {
+    event->points_[i].state = kTouchUp;
+  }
+  _this->p_->DispatchTouch();
+}
+
+void Input::Private::DispatchTouch() {
+  if (nullptr != touch_event->surface_) {
+    touch_event->response_ = InputEvent::kUnknown;
+    touch_event->surface_->GetEventHandler()->OnTouch(touch_event);
+  }
+
+  touch_event->Advance();
+}
+
+void Input::Private::ResetSurface(const Surface *surface) {
+  // The events exist only for the capabilities of this seat:
+  if (nullptr != touch_event && touch_event->surface_ == surface) touch_event->surface_ = nullptr;
+
+  if (nullptr != key_event && key_event->surface_ == surface) {
+    key_repeater.Stop();
+    key_event->surface_ = nullptr;
+  }
+
+  if (pointer_frame.enter_surface == surface) pointer_frame.enter_surface = nullptr;
+  if (pointer_frame.leave_surface == surface) pointer_frame.leave_surface = nullptr;
+
+  if (nullptr != mouse_event && mouse_event->p_->surface == surface) {
+    mouse_dispatcher.StopKineticScroll();
+    mouse_event->p_->surface = nullptr;
+  }
 }
 
 } // namespace gui
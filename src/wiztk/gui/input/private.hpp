@@ -22,8 +22,10 @@
 #include "wiztk/base/counted-deque.hpp"
 
 #include <wiztk/gui/surface.hpp>
+#include <wiztk/gui/key-repeater.hpp>
 #include <wiztk/gui/key-event.hpp>
 #include <wiztk/gui/touch-event.hpp>
+#include <wiztk/gui/pointer-dispatcher.hpp>
 
 #include "mouse-event/private.hpp"
 #include "keymap.hpp"
@@ -40,8 +42,61 @@ struct WIZTK_NO_EXPORT Input::Private : public base::CountedDequeNodeBase {
   WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(Private);
   Private() = delete;
 
+  /**
+   * @brief Delivers the pointer events to the surfaces with mouse_event
+   */
+  class MouseDispatcher : public PointerDispatcher {
+
+   public:
+
+    explicit MouseDispatcher(Input::Private *owner)
+        : owner_(owner) {}
+
+    ~MouseDispatcher() final = default;
+
+   protected:
+
+    void OnLeave(uint32_t serial, Surface *surface) final;
+
+    void OnEnter(uint32_t serial, Surface *surface, const base::Point2D &surface_xy) final;
+
+    void OnMotion(uint32_t time, const base::Point2D &surface_xy) final;
+
+    void OnButton(const PointerFrame::Button &button) final;
+
+    void OnAxis(const PointerAxis &axis) final;
+
+   private:
+
+    // Private alone names the one of PointerDispatcher here:
+    Input::Private *owner_;
+
+  };
+
+  /**
+   * @brief Dispatches the repeats of the held key, one per seat
+   */
+  class SeatKeyRepeater : public KeyRepeater {
+
+   public:
+
+    explicit SeatKeyRepeater(Input::Private *owner)
+        : owner_(owner) {}
+
+    ~SeatKeyRepeater() final = default;
+
+   protected:
+
+    void OnRepeat(uint32_t key, uint32_t time) final;
+
+   private:
+
+    Input::Private *owner_;
+
+  };
+
   explicit Private(Input *input)
-      : proprietor(input) {}
+      : proprietor(input), mouse_dispatcher(this), key_repeater(this) {}
 
   ~Private() final {
     keyboard_state.Destroy();
@@ -83,6 +138,44 @@ struct WIZTK_NO_EXPORT Input::Private : public base::CountedDequeNodeBase {
   uint32_t id = 0;
   uint32_t version = 0;
 
+  PointerFrame pointer_frame;
+
+  MouseDispatcher mouse_dispatcher;
+
+  /**
+   * @brief Dispatch the events accumulated in pointer_frame
+   */
+  void CommitPointerFrame();
+
+  SeatKeyRepeater key_repeater;
+
+  /**
+   * @brief Fill the keysym and text of the key and dispatch it to the surface
+   * which has the keyboard focus
+   */
+  void DispatchKey(uint32_t key, uint32_t state, bool repeat);
+
+  /**
+   * @brief Dispatch the touch points of a frame to the touched surface
+   */
+  void DispatchTouch();
+
+  /**
+   * @brief Forget the given surface which is being destroyed
+   *
+   * The touch sequence, keyboard focus and pointer state may still refer to
+   * a surface without a leave event, e.g. a popup dismissed while a finger
+   * is down. The remaining events of the sequence are not dispatched.
+   */
+  void ResetSurface(const Surface *surface);
+
+  /**
+   * @brief Returns true if the compositor does not send wl_pointer.frame
+   */
+  bool IsPointerFrameless() const {
+    return wl_pointer_get_version(wl_pointer) < WL_POINTER_FRAME_SINCE_VERSION;
+  }
+
   // seat:
 
   static void OnSeatCapabilities(void *data, struct wl_seat *wl_seat, uint32_t capabilities);
@@ -0,0 +1,60 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "wiztk/gui/key-repeater.hpp"
+
+namespace wiztk {
+namespace gui {
+
+KeyRepeater::KeyRepeater() {
+  timer_.timeout().Connect(this, &KeyRepeater::OnTimeout);
+}
+
+void KeyRepeater::SetInfo(int32_t rate, int32_t delay) {
+  rate_ = rate < 0 ? 0 : rate;
+  delay_ = delay < 0 ? 0 : delay;
+
+  if (0 == rate_) Stop();
+}
+
+void KeyRepeater::Start(uint32_t key, uint32_t time) {
+  if (0 == rate_) return;
+
+  Stop();
+  key_ = key;
+  time_ = time;
+
+  // Repeat the first time after the delay:
+  timer_.SetInterval(static_cast<unsigned int>(delay_ > 0 ? delay_ : 1) * 1000);
+  timer_.Start();
+}
+
+void KeyRepeater::Stop() {
+  timer_.Stop();
+  key_ = 0;
+}
+
+void KeyRepeater::OnTimeout(base::SLOT /* slot */) {
+  unsigned int interval = 1000000 / static_cast<unsigned int>(rate_);
+
+  time_ += timer_.GetInterval() / 1000;
+  if (timer_.GetInterval() != interval) timer_.SetInterval(interval);
+
+  OnRepeat(key_, time_);
+}
+
+} // namespace gui
+} // namespace wiztk
@@ -30,7 +30,6 @@ void KeyboardState::Setup(const Keymap &keymap) {
 
   xkb_state_ = xkb_state_new(keymap.xkb_keymap_);
   if (nullptr == xkb_state_) {
-    xkb_keymap_unref(keymap.xkb_keymap_);
     throw std::runtime_error("FATAL! Cannot create keyboard state!");
   }
 }
@@ -42,5 +41,37 @@ void KeyboardState::Destroy() {
   }
 }
 
+void KeyboardState::UpdateMask(uint32_t mods_depressed,
+                               uint32_t mods_latched,
+                               uint32_t mods_locked,
+                               uint32_t group) {
+  if (nullptr == xkb_state_) return;
+
+  xkb_state_update_mask(xkb_state_, mods_depressed, mods_latched, mods_locked, 0, 0, group);
+}
+
+// Note: XKB key codes are evdev key codes plus 8.
+
+uint32_t KeyboardState::GetOneSym(uint32_t key) const {
+  if (nullptr == xkb_state_) return XKB_KEY_NoSymbol;
+
+  return xkb_state_key_get_one_sym(xkb_state_, key + 8);
+}
+
+void KeyboardState::GetUTF8(uint32_t key, char *buffer, size_t size) const {
+  if (0 == size) return;
+
+  buffer[0] = '\0';
+  if (nullptr == xkb_state_) return;
+
+  xkb_state_key_get_utf8(xkb_state_, key + 8, buffer, size);
+}
+
+bool KeyboardState::IsRepeated(uint32_t key) const {
+  if (nullptr == xkb_state_) return false;
+
+  return 0 != xkb_keymap_key_repeats(xkb_state_get_keymap(xkb_state_), key + 8);
+}
+
 } // namespace gui
 } // namespace wiztk
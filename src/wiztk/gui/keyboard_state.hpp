@@ -37,6 +37,31 @@ class KeyboardState {
 
   void Destroy();
 
+  /**
+   * @brief Update the modifiers from wl_keyboard.modifiers
+   */
+  void UpdateMask(uint32_t mods_depressed, uint32_t mods_latched, uint32_t mods_locked, uint32_t group);
+
+  /**
+   * @brief Get the keysym of an evdev key code, 0 if there's no keymap
+   */
+  uint32_t GetOneSym(uint32_t key) const;
+
+  /**
+   * @brief Write the UTF-8 text of an evdev key code to the buffer
+   *
+   * The text is always null-terminated, and truncated if the buffer is too
+   * small.
+   */
+  void GetUTF8(uint32_t key, char *buffer, size_t size) const;
+
+  /**
+   * @brief Returns true if the key should repeat when held down
+   */
+  bool IsRepeated(uint32_t key) const;
+
+  bool IsValid() const { return nullptr != xkb_state_; }
+
  private:
 
   struct xkb_state *xkb_state_;
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "wiztk/gui/keymap-cache.hpp"
+
+#include "wiztk/base/hash.hpp"
+
+#include <cstring>
+
+namespace wiztk {
+namespace gui {
+
+const size_t KeymapCache::kMaxEntries;
+
+KeymapCache::~KeymapCache() {
+  for (Entry &entry : entries_) xkb_keymap_unref(entry.xkb_keymap);
+}
+
+struct xkb_keymap *KeymapCache::Find(uint64_t hash,
+                                     const char *string,
+                                     size_t length,
+                                     enum xkb_keymap_format format,
+                                     enum xkb_keymap_compile_flags flags) {
+  for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+    if (it->hash != hash || it->format != format || it->flags != flags) continue;
+    if (it->text.size() != length || 0 != memcmp(it->text.data(), string, length)) continue;
+
+    Entry entry = std::move(*it);
+    entries_.erase(it);
+    entries_.insert(entries_.begin(), std::move(entry));
+    return xkb_keymap_ref(entries_.front().xkb_keymap);
+  }
+
+  return nullptr;
+}
+
+void KeymapCache::Add(uint64_t hash,
+                      const char *string,
+                      size_t length,
+                      enum xkb_keymap_format format,
+                      enum xkb_keymap_compile_flags flags,
+                      struct xkb_keymap *xkb_keymap) {
+  if (entries_.size() == kMaxEntries) {
+    xkb_keymap_unref(entries_.back().xkb_keymap);
+    entries_.pop_back();
+  }
+
+  entries_.insert(entries_.begin(),
+                  Entry{hash, format, flags, std::string(string, length), xkb_keymap_ref(xkb_keymap)});
+}
+
+uint64_t KeymapCache::Hash(const char *string, size_t length) {
+  return base::HashFNV1a(string, length);
+}
+
+KeymapCache &KeymapCache::Get() {
+  static KeymapCache kCache;
+  return kCache;
+}
+
+} // namespace gui
+} // namespace wiztk
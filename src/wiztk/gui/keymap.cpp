@@ -19,6 +19,9 @@
 #include "display/private.hpp"
 
 #include "wiztk/gui/application.hpp"
+#include "wiztk/gui/keymap-cache.hpp"
+
+#include <cstring>
 
 namespace wiztk {
 namespace gui {
@@ -31,10 +34,19 @@ Keymap::~Keymap() {
 void Keymap::Setup(const char *string, enum xkb_keymap_format format, enum xkb_keymap_compile_flags flags) {
   Destroy();
 
+  KeymapCache &cache = KeymapCache::Get();
+  size_t length = strlen(string);
+  uint64_t hash = KeymapCache::Hash(string, length);
+
+  xkb_keymap_ = cache.Find(hash, string, length, format, flags);
+  if (nullptr != xkb_keymap_) return;
+
   Display *display = Application::GetInstance()->GetDisplay();
   xkb_keymap_ = xkb_keymap_new_from_string(Display::Private::Get(*display).xkb_context, string, format, flags);
   if (nullptr == xkb_keymap_)
     throw std::runtime_error("FATAL! Cannot create XKB keymap!");
+
+  cache.Add(hash, string, length, format, flags, xkb_keymap_);
 }
 
 void Keymap::Destroy() {
@@ -39,6 +39,10 @@ class Keymap {
 
   /**
    * @brief Setup a XKB keymap from given string
+   *
+   * Compiled keymaps are cached by the content of the string, so the same
+   * keymap sent to other seats or after a reconnection is not compiled again.
+   *
    * @param string
    * @param format
    * @param flags
@@ -18,11 +18,17 @@
 
 #include <wiztk/gui/linear-layout.hpp>
 
+#include "wiztk/base/clamp.hpp"
+
+#include <algorithm>
+
 namespace wiztk {
 namespace gui {
 
+using base::Clamp;
+
 LinearLayout::LinearLayout(Orientation orientation, const Padding &padding, int space)
-    : AbstractLayout(padding) {
+    : AbstractLayout(padding), orientation_(orientation), space_(space) {
 
 }
 
@@ -30,16 +36,134 @@ LinearLayout::~LinearLayout() {
 
 }
 
+void LinearLayout::SetOrientation(Orientation orientation) {
+  if (orientation_ == orientation) return;
+
+  orientation_ = orientation;
+  RequestLayout();
+}
+
+void LinearLayout::SetSpace(int space) {
+  if (space_ == space) return;
+
+  space_ = space;
+  RequestLayout();
+}
+
 void LinearLayout::OnViewAdded(AbstractView *view) {
-  // TODO:
+  // AbstractLayout::AddView() requests a layout pass
 }
 
 void LinearLayout::OnViewRemoved(AbstractView *view) {
-  // TODO:
+  // AbstractLayout::RemoveView() requests a layout pass
+}
+
+AbstractView::Size LinearLayout::OnMeasure() {
+  const bool horizontal = kHorizontal == orientation_;
+  int main = 0;
+  int cross = 0;
+  int count = 0;
+
+  Iterator it(this);
+  for (it = it.first_child(); it; ++it) {
+    if (!it.view()->IsVisible()) continue;
+
+    Size size = MeasureView(it.view());
+    main += horizontal ? size.width : size.height;
+    cross = std::max(cross, horizontal ? size.height : size.width);
+    ++count;
+  }
+
+  if (count > 1) main += space_ * (count - 1);
+
+  const Padding &padding = GetPadding();
+  return horizontal ?
+         Size(main + padding.horizontal(), cross + padding.vertical()) :
+         Size(cross + padding.horizontal(), main + padding.vertical());
 }
 
 void LinearLayout::OnLayout(int left, int top, int right, int bottom) {
+  const bool horizontal = kHorizontal == orientation_;
+  int available = horizontal ? right - left : bottom - top;
+  int cross_available = std::max(horizontal ? bottom - top : right - left, 0);
+
+  // 1st pass: the sum of measured sizes, how much can be shrunk and how many
+  // children can expand:
+  int count = 0;
+  int total = 0;
+  int shrinkable = 0;
+  int expandable = 0;
+
+  AbstractView *first = Iterator(this).first_child();
+  Iterator it;
+  for (it = first; it; ++it) {
+    AbstractView *view = it.view();
+    if (!view->IsVisible()) continue;
+
+    Size size = MeasureView(view);
+    LayoutPolicy policy = horizontal ? view->GetLayoutPolicyOnX() : view->GetLayoutPolicyOnY();
+    int base = horizontal ? size.width : size.height;
+    int minimal = horizontal ? view->GetMinimalWidth() : view->GetMinimalHeight();
+
+    total += base;
+    if (kLayoutFixed != policy && base > minimal) shrinkable += base - minimal;
+    if (kLayoutExpandable == policy || kLayoutMaximal == policy) ++expandable;
+    ++count;
+  }
+
+  if (0 == count) return;
+
+  available -= space_ * (count - 1);
+  int extra = available - total;
+  int deficit = extra < 0 ? std::min(-extra, shrinkable) : 0;
+
+  // 2nd pass: commit the geometry of each child:
+  int position = horizontal ? left : top;
+  int expand_index = 0;
+  int shrunk = 0;   // The sum of (base - minimal) of children shrunk so far
+
+  for (it = first; it; ++it) {
+    AbstractView *view = it.view();
+    if (!view->IsVisible()) continue;
+
+    Size size = MeasureView(view);
+    LayoutPolicy main_policy = horizontal ? view->GetLayoutPolicyOnX() : view->GetLayoutPolicyOnY();
+    LayoutPolicy cross_policy = horizontal ? view->GetLayoutPolicyOnY() : view->GetLayoutPolicyOnX();
+    int minimal = horizontal ? view->GetMinimalWidth() : view->GetMinimalHeight();
+    int maximal = horizontal ? view->GetMaximalWidth() : view->GetMaximalHeight();
+    int length = horizontal ? size.width : size.height;
+
+    if (extra > 0 && expandable > 0) {
+      if (kLayoutExpandable == main_policy || kLayoutMaximal == main_policy) {
+        length += extra / expandable + (expand_index < extra % expandable ? 1 : 0);
+        ++expand_index;
+      }
+    } else if (deficit > 0 && kLayoutFixed != main_policy && length > minimal) {
+      // Shrink in proportion to (base - minimal), the rounding errors are
+      // accumulated so that the sum is exactly the deficit:
+      int before = static_cast<int>(static_cast<int64_t>(deficit) * shrunk / shrinkable);
+      shrunk += length - minimal;
+      int after = static_cast<int>(static_cast<int64_t>(deficit) * shrunk / shrinkable);
+      length -= after - before;
+    }
+    length = Clamp(length, minimal, maximal);
+
+    int cross = horizontal ? size.height : size.width;
+    if (kLayoutExpandable == cross_policy || kLayoutMaximal == cross_policy)
+      cross = cross_available;
+    else if (kLayoutFixed != cross_policy)
+      cross = std::min(cross, cross_available);
+    cross = Clamp(cross,
+                  horizontal ? view->GetMinimalHeight() : view->GetMinimalWidth(),
+                  horizontal ? view->GetMaximalHeight() : view->GetMaximalWidth());
+
+    if (horizontal)
+      ArrangeView(view, position, top, length, cross);
+    else
+      ArrangeView(view, left, position, cross, length);
 
+    position += length + space_;
+  }
 }
 
 } // namespace gui
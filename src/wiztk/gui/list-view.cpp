@@ -0,0 +1,345 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "wiztk/gui/list-view.hpp"
+#include "wiztk/gui/mouse-event.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+namespace wiztk {
+namespace gui {
+
+/**
+ * @brief The private data in ListView
+ */
+struct ListView::Private {
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(Private);
+  Private() = delete;
+
+  explicit Private(Adapter *adapter)
+      : adapter(adapter) {}
+
+  ~Private() = default;
+
+  struct Row {
+    int index;
+    int type;
+    AbstractView *view;
+  };
+
+  /**
+   * @brief Read the item count and heights from the adapter
+   */
+  void Reload();
+
+  int GetOffset(int index) const {
+    return fixed_height > 0 ? index * fixed_height : offsets[index];
+  }
+
+  int GetHeight(int index) const {
+    return fixed_height > 0 ? fixed_height : offsets[index + 1] - offsets[index];
+  }
+
+  /**
+   * @brief Returns the index of the item at the given offset
+   */
+  int GetIndexAt(int offset) const;
+
+  int GetContentHeight() const { return GetOffset(count); }
+
+  Adapter *adapter = nullptr;
+
+  int count = 0;
+
+  /**
+   * @brief The height of all items if the adapter has fixed item height
+   */
+  int fixed_height = 0;
+
+  /**
+   * @brief Prefix sums of item heights, only for variable item heights
+   */
+  std::vector<int> offsets;
+
+  int overscan = 2;
+
+  int scroll_offset = 0;
+
+  /**
+   * @brief The fraction of pixels scrolled by axis events but not applied yet
+   */
+  double scroll_remainder = 0.0;
+
+  int viewport_height = 0;
+
+  /**
+   * @brief Live rows, the indices are contiguous and ascending
+   */
+  std::deque<Row> rows;
+
+  std::unordered_map<int, std::vector<AbstractView *>> pools;
+
+  int recycled_count = 0;
+
+  /**
+   * @brief True when this view removes rows itself
+   */
+  bool recycling = false;
+
+};
+
+void ListView::Private::Reload() {
+  count = nullptr == adapter ? 0 : std::max(adapter->GetItemCount(), 0);
+  fixed_height = 0;
+  offsets.clear();
+
+  if (0 == count) return;
+
+  if (adapter->HasFixedItemHeight()) {
+    fixed_height = std::max(adapter->GetItemHeight(0), 1);
+    return;
+  }
+
+  offsets.resize(static_cast<size_t>(count) + 1);
+  offsets[0] = 0;
+  for (int i = 0; i < count; ++i) {
+    offsets[i + 1] = offsets[i] + std::max(adapter->GetItemHeight(i), 0);
+  }
+}
+
+int ListView::Private::GetIndexAt(int offset) const {
+  if (fixed_height > 0) return std::min(std::max(offset / fixed_height, 0), count - 1);
+
+  auto it = std::upper_bound(offsets.begin(), offsets.end(), offset);
+  int index = static_cast<int>(it - offsets.begin()) - 1;
+  return std::min(std::max(index, 0), count - 1);
+}
+
+// -------
+
+ListView::ListView(Adapter *adapter)
+    : AbstractLayout(Padding(0)) {
+  p_ = std::make_unique<Private>(adapter);
+  p_->Reload();
+}
+
+ListView::~ListView() {
+  for (auto &pair : p_->pools) {
+    for (AbstractView *view : pair.second) view->Destroy();
+  }
+}
+
+void ListView::SetAdapter(Adapter *adapter) {
+  if (p_->adapter == adapter) return;
+
+  // Row views belong to the last adapter:
+  while (!p_->rows.empty()) {
+    AbstractView *view = p_->rows.back().view;
+    p_->rows.pop_back();
+    view->Destroy();
+  }
+  for (auto &pair : p_->pools) {
+    for (AbstractView *view : pair.second) view->Destroy();
+  }
+  p_->pools.clear();
+  p_->recycled_count = 0;
+
+  p_->adapter = adapter;
+  p_->scroll_offset = 0;
+  NotifyDataChanged();
+}
+
+ListView::Adapter *ListView::GetAdapter() const {
+  return p_->adapter;
+}
+
+void ListView::NotifyDataChanged() {
+  p_->recycling = true;
+  while (!p_->rows.empty()) {
+    const Private::Row &row = p_->rows.back();
+    RemoveChild(row.view);
+    p_->pools[row.type].push_back(row.view);
+    ++p_->recycled_count;
+    p_->rows.pop_back();
+  }
+  p_->recycling = false;
+
+  p_->Reload();
+  RequestArrange();
+}
+
+void ListView::SetOverscan(int count) {
+  count = std::max(count, 0);
+  if (p_->overscan == count) return;
+
+  p_->overscan = count;
+  RequestArrange();
+}
+
+int ListView::GetOverscan() const {
+  return p_->overscan;
+}
+
+void ListView::ScrollTo(int offset) {
+  if (p_->scroll_offset == offset) return;
+
+  p_->scroll_offset = offset;
+  RequestArrange();
+}
+
+void ListView::ScrollBy(int delta) {
+  ScrollTo(p_->scroll_offset + delta);
+}
+
+int ListView::GetScrollOffset() const {
+  return p_->scroll_offset;
+}
+
+int ListView::GetContentHeight() const {
+  return p_->GetContentHeight();
+}
+
+AbstractView *ListView::GetItemView(int index) const {
+  if (p_->rows.empty()) return nullptr;
+
+  int i = index - p_->rows.front().index;
+  if (i < 0 || i >= static_cast<int>(p_->rows.size())) return nullptr;
+
+  return p_->rows[i].view;
+}
+
+int ListView::GetLiveCount() const {
+  return static_cast<int>(p_->rows.size());
+}
+
+int ListView::GetRecycledCount() const {
+  return p_->recycled_count;
+}
+
+void ListView::OnViewAdded(AbstractView */*view*/) {
+  // Rows are added in OnLayout()
+}
+
+void ListView::OnViewRemoved(AbstractView *view) {
+  if (p_->recycling) return;
+
+  // A row is destroyed by others, forget it and fill the gap in the next pass:
+  auto it = std::find_if(p_->rows.begin(), p_->rows.end(),
+                         [view](const Private::Row &row) { return row.view == view; });
+  if (it == p_->rows.end()) return;
+
+  p_->rows.erase(it, p_->rows.end());
+  RequestArrange();
+}
+
+void ListView::OnLayout(int left, int top, int right, int bottom) {
+  Private *p = p_.get();
+  int width = std::max(right - left, 0);
+  int height = std::max(bottom - top, 0);
+
+  p->viewport_height = height;
+  p->scroll_offset = std::max(std::min(p->scroll_offset, p->GetContentHeight() - height), 0);
+
+  int first = 0;
+  int last = -1;
+  if (p->count > 0) {
+    first = std::max(p->GetIndexAt(p->scroll_offset) - p->overscan, 0);
+    last = std::min(p->GetIndexAt(p->scroll_offset + std::max(height, 1) - 1) + p->overscan,
+                    p->count - 1);
+  }
+
+  // Recycle the rows out of [first, last]:
+  p->recycling = true;
+  auto recycle = [this, p](const Private::Row &row) {
+    RemoveChild(row.view);
+    p->pools[row.type].push_back(row.view);
+    ++p->recycled_count;
+  };
+  while (!p->rows.empty() && (p->rows.front().index < first || p->rows.front().index > last)) {
+    recycle(p->rows.front());
+    p->rows.pop_front();
+  }
+  while (!p->rows.empty() && (p->rows.back().index > last || p->rows.back().index < first)) {
+    recycle(p->rows.back());
+    p->rows.pop_back();
+  }
+  p->recycling = false;
+
+  // Bind the rows scroll in, reuse the pooled views first:
+  auto obtain = [this, p](int index) {
+    int type = p->adapter->GetItemType(index);
+    AbstractView *view = nullptr;
+    std::vector<AbstractView *> &pool = p->pools[type];
+    if (pool.empty()) {
+      view = p->adapter->CreateItemView(type);
+    } else {
+      view = pool.back();
+      pool.pop_back();
+      --p->recycled_count;
+    }
+    PushBackChild(view);
+    p->adapter->BindItemView(view, index);
+    view->Update();
+    return Private::Row{index, type, view};
+  };
+
+  if (p->rows.empty()) {
+    for (int i = first; i <= last; ++i) p->rows.push_back(obtain(i));
+  } else {
+    for (int i = p->rows.front().index - 1; i >= first; --i) p->rows.push_front(obtain(i));
+    for (int i = p->rows.back().index + 1; i <= last; ++i) p->rows.push_back(obtain(i));
+  }
+
+  // Commit the geometry of each live row once:
+  for (const Private::Row &row : p->rows) {
+    ArrangeView(row.view,
+                left,
+                top + p->GetOffset(row.index) - p->scroll_offset,
+                width,
+                p->GetHeight(row.index));
+  }
+}
+
+void ListView::OnDraw(const Context &/*context*/) {
+  // Rows draw themselves
+}
+
+void ListView::OnMouseAxis(MouseEvent *event) {
+  double delta = event->GetAxisValue(kMouseAxisVertical);
+  if (0.0 == delta) return;
+
+  int max = std::max(p_->GetContentHeight() - p_->viewport_height, 0);
+  int offset = std::max(std::min(p_->scroll_offset, max), 0);
+
+  if ((delta < 0.0 && 0 == offset) || (delta > 0.0 && max == offset)) {
+    p_->scroll_remainder = 0.0;
+    return;
+  }
+
+  delta += p_->scroll_remainder;
+  int pixels = static_cast<int>(delta);
+  p_->scroll_remainder = delta - pixels;
+
+  ScrollTo(std::max(std::min(offset + pixels, max), 0));
+  event->Accept();
+}
+
+} // namespace gui
+} // namespace wiztk
@@ -18,6 +18,7 @@
 #include "display/private.hpp"
 
 #include "wiztk/base/property.hpp"
+#include "wiztk/base/memory/allocation-counter.hpp"
 
 #include "wiztk/gui/surface.hpp"
 
@@ -56,34 +57,41 @@ MainLoop::~MainLoop() = default;
 
 void MainLoop::DispatchMessage() {
   using base::Deque;
+  using base::memory::AllocationCounter;
   using async::EventLoop;
 
   EventLoop::DispatchMessage();
 
+  bool has_frame = !(Surface::kRenderTaskDeque.is_empty() && Surface::kCommitTaskDeque.is_empty());
+  size_t allocation_count = AllocationCounter::GetCount();
+
   QueuedTask *task = nullptr;
-  Deque<Surface::RenderTask>::Iterator render_it;
-  Deque<Surface::CommitTask>::Iterator commit_it;
+  Deque<Surface::RenderTask> render_tasks;
+  Deque<Surface::CommitTask> commit_tasks;
 
   /*
-   * Draw contents on every surface requested
+   * Draw contents on every surface requested, the tasks are swapped out in
+   * one go, and the ones requested while drawing run in the next pass
    */
-  render_it = Surface::kRenderTaskDeque.begin();
-  while (render_it != Surface::kRenderTaskDeque.end()) {
-    task = render_it.get();
-    render_it.remove();
-    task->Run();
-    render_it = Surface::kRenderTaskDeque.begin();
+  while (!Surface::kRenderTaskDeque.is_empty()) {
+    render_tasks.swap(Surface::kRenderTaskDeque);
+    while (nullptr != (task = render_tasks.pop_front())) task->Run();
   }
 
   /*
    * Commit every surface requested
    */
-  commit_it = Surface::kCommitTaskDeque.begin();
-  while (commit_it != Surface::kCommitTaskDeque.end()) {
-    task = commit_it.get();
-    commit_it.remove();
-    task->Run();
-    commit_it = Surface::kCommitTaskDeque.begin();
+  while (!Surface::kCommitTaskDeque.is_empty()) {
+    commit_tasks.swap(Surface::kCommitTaskDeque);
+    while (nullptr != (task = commit_tasks.pop_front())) task->Run();
+  }
+
+  /*
+   * The transient objects of this frame are no longer used
+   */
+  if (has_frame) {
+    Surface::kFrameAllocationCount = AllocationCounter::GetCount() - allocation_count;
+    Surface::kFrameArena.Reset();
   }
 
   wl_display_dispatch_pending(__PROPERTY__(wl_display));
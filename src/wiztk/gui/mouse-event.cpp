@@ -68,5 +68,25 @@ uint32_t MouseEvent::GetAxis() const {
   return p_->axis;
 }
 
+double MouseEvent::GetAxisValue(MouseAxis axis) const {
+  return p_->axis_value[axis];
+}
+
+int MouseEvent::GetAxisDiscrete(MouseAxis axis) const {
+  return p_->axis_discrete[axis];
+}
+
+MouseAxisSource MouseEvent::GetAxisSource() const {
+  return p_->axis_source;
+}
+
+bool MouseEvent::IsAxisStopped(MouseAxis axis) const {
+  return p_->axis_stop[axis];
+}
+
+const HoverPath &MouseEvent::GetHoverPath() const {
+  return p_->hover_path;
+}
+
 } // namespace gui
 } // namespace wiztk
@@ -18,6 +18,7 @@
 #define WIZTK_GUI_MOUSE_EVENT_PRIVATE_HPP_
 
 #include <wiztk/gui/mouse-event.hpp>
+#include <wiztk/gui/hover-path.hpp>
 
 namespace wiztk {
 namespace gui {
@@ -33,7 +34,11 @@ struct MouseEvent::Private {
         time(0),
         button(0),
         state(0),
-        axis(0) {
+        axis(0),
+        axis_value{0.0, 0.0},
+        axis_discrete{0, 0},
+        axis_source(kMouseAxisSourceWheel),
+        axis_stop{false, false} {
   }
 
   ~Private() = default;
@@ -52,6 +57,17 @@ struct MouseEvent::Private {
 
   uint32_t axis;
 
+  /** Indexed by MouseAxis */
+  double axis_value[2];
+  int axis_discrete[2];
+
+  MouseAxisSource axis_source;
+
+  bool axis_stop[2];
+
+  /** The views hovered by this pointer */
+  HoverPath hover_path;
+
 };
 
 } // namespace gui
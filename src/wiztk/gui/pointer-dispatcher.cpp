@@ -0,0 +1,254 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "wiztk/gui/pointer-dispatcher.hpp"
+
+#include "wiztk/gui/timer.hpp"
+
+#include "wiztk/async/event-loop.hpp"
+#include "wiztk/async/message.hpp"
+
+#include <cmath>
+#include <ctime>
+
+namespace wiztk {
+namespace gui {
+
+const double KineticScroll::kTimeConstant = 325.0;
+
+const double KineticScroll::kMinVelocity = 0.02;
+
+void KineticScroll::Track(uint32_t time, const double value[2]) {
+  uint32_t elapsed = time - last_time_;
+
+  if (0 == last_time_ || elapsed > 100) {
+    velocity_[0] = velocity_[1] = 0.0;
+  } else if (elapsed > 0) {
+    // Weight the latest sample most:
+    for (int i = 0; i < 2; ++i)
+      velocity_[i] = 0.8 * value[i] / elapsed + 0.2 * velocity_[i];
+  }
+
+  last_time_ = time;
+}
+
+bool KineticScroll::Start(uint32_t time) {
+  // The finger paused before lifting:
+  if (0 == last_time_ || time - last_time_ > 50) {
+    velocity_[0] = velocity_[1] = 0.0;
+  }
+  last_time_ = 0;
+
+  return std::abs(velocity_[0]) >= kMinVelocity || std::abs(velocity_[1]) >= kMinVelocity;
+}
+
+bool KineticScroll::Step(double elapsed, double value[2]) {
+  // Integrate the exponentially decaying velocity over the elapsed time:
+  double decay = std::exp(-elapsed / kTimeConstant);
+  for (int i = 0; i < 2; ++i) {
+    value[i] = velocity_[i] * kTimeConstant * (1.0 - decay);
+    velocity_[i] *= decay;
+  }
+
+  return std::abs(velocity_[0]) < kMinVelocity && std::abs(velocity_[1]) < kMinVelocity;
+}
+
+void KineticScroll::Reset() {
+  velocity_[0] = velocity_[1] = 0.0;
+  last_time_ = 0;
+}
+
+// -------
+
+/**
+ * @brief Delivers the deferred motion and scrolling in the next message
+ * dispatching of the event loop
+ */
+class PointerFlushMessage : public async::Message {
+
+ public:
+
+  explicit PointerFlushMessage(PointerDispatcher *owner)
+      : owner_(owner) {}
+
+  ~PointerFlushMessage() final = default;
+
+  void Exec() final {
+    owner_->Flush();
+  }
+
+ private:
+
+  PointerDispatcher *owner_;
+
+};
+
+struct PointerDispatcher::Private {
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(Private);
+  Private() = delete;
+
+  explicit Private(PointerDispatcher *owner)
+      : message(owner), timer(16667) {}
+
+  ~Private() = default;
+
+  PointerFlushMessage message;
+
+  bool motion_deferred = false;
+  uint32_t motion_time = 0;
+  base::Point2D motion_xy;
+
+  bool axis_deferred = false;
+  PointerAxis axis;
+
+  KineticScroll kinetic_scroll;
+
+  Timer timer;
+
+  /** The monotonic clock of the last kinetic step in nanoseconds */
+  uint64_t last_clock = 0;
+
+  static uint64_t GetMonotonicClock() {
+    struct timespec now = {0, 0};
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000 + now.tv_nsec;
+  }
+
+};
+
+PointerDispatcher::PointerDispatcher() {
+  p_.reset(new Private(this));
+  p_->timer.timeout().Connect(this, &PointerDispatcher::OnKineticTimeout);
+}
+
+PointerDispatcher::~PointerDispatcher() {
+  p_->message.Unlink();
+}
+
+void PointerDispatcher::Commit(const PointerFrame &frame) {
+  if (frame.mask & PointerFrame::kLeave) {
+    Flush();
+    StopKineticScroll();
+    OnLeave(frame.leave_serial, frame.leave_surface);
+  }
+
+  if (frame.mask & PointerFrame::kEnter) {
+    Flush();
+    OnEnter(frame.enter_serial, frame.enter_surface, frame.surface_xy);
+  } else if (frame.mask & PointerFrame::kMotion) {
+    // Only the last position is delivered:
+    p_->motion_time = frame.time;
+    p_->motion_xy = frame.surface_xy;
+    p_->motion_deferred = true;
+    Schedule();
+  }
+
+  if (frame.mask & PointerFrame::kButton) {
+    // Make sure the views under the cursor are updated before pressing:
+    Flush();
+    StopKineticScroll();
+    for (int i = 0; i < frame.button_count; ++i) OnButton(frame.buttons[i]);
+  }
+
+  if (frame.mask & (PointerFrame::kAxis | PointerFrame::kAxisStop | PointerFrame::kAxisDiscrete)) {
+    MouseAxisSource source =
+        (frame.mask & PointerFrame::kAxisSource) ? frame.axis_source : kMouseAxisSourceWheel;
+
+    StopKineticScroll();
+    if (p_->axis_deferred && p_->axis.source != source) Flush();
+
+    PointerAxis &axis = p_->axis;
+    axis.axis = frame.axis;
+    axis.source = source;
+    for (int i = 0; i < 2; ++i) {
+      axis.value[i] += frame.axis_value[i];
+      axis.discrete[i] += frame.axis_discrete[i];
+      axis.stop[i] = axis.stop[i] || frame.axis_stop[i];
+    }
+    p_->axis_deferred = true;
+
+    if (kMouseAxisSourceFinger == source && (frame.mask & PointerFrame::kAxis))
+      p_->kinetic_scroll.Track(frame.axis_time, frame.axis_value);
+
+    if (frame.mask & PointerFrame::kAxisStop) {
+      // Deliver the stop now so that it's not mixed with later scrolling:
+      Flush();
+      if (kMouseAxisSourceFinger == source && p_->kinetic_scroll.Start(frame.axis_time)) {
+        p_->last_clock = Private::GetMonotonicClock();
+        p_->timer.Start();
+      }
+    } else {
+      Schedule();
+    }
+  }
+}
+
+void PointerDispatcher::Flush() {
+  p_->message.Unlink();
+
+  if (p_->motion_deferred) {
+    p_->motion_deferred = false;
+    OnMotion(p_->motion_time, p_->motion_xy);
+  }
+
+  if (p_->axis_deferred) {
+    p_->axis_deferred = false;
+    PointerAxis axis = p_->axis;
+    p_->axis = PointerAxis();
+    OnAxis(axis);
+  }
+}
+
+void PointerDispatcher::StopKineticScroll() {
+  p_->timer.Stop();
+}
+
+bool PointerDispatcher::IsKineticScrolling() const {
+  return p_->timer.IsArmed();
+}
+
+void PointerDispatcher::Schedule() {
+  if (p_->message.IsQueued()) return;
+
+  async::EventLoop *event_loop = async::EventLoop::GetCurrent();
+  if (nullptr == event_loop) {
+    Flush();
+    return;
+  }
+
+  event_loop->GetScheduler().PostMessage(&p_->message);
+}
+
+void PointerDispatcher::OnKineticTimeout(base::SLOT /* slot */) {
+  uint64_t clock = Private::GetMonotonicClock();
+  double elapsed = (clock - p_->last_clock) / 1000000.0;
+  p_->last_clock = clock;
+
+  PointerAxis axis;
+  axis.source = kMouseAxisSourceKinetic;
+  bool stop = p_->kinetic_scroll.Step(elapsed, axis.value);
+  if (stop) p_->timer.Stop();
+
+  axis.stop[0] = axis.stop[1] = stop;
+  axis.axis = std::abs(axis.value[1]) > std::abs(axis.value[0]) ? kMouseAxisHorizontal : kMouseAxisVertical;
+
+  Flush();
+  OnAxis(axis);
+}
+
+} // namespace gui
+} // namespace wiztk
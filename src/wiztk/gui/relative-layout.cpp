@@ -19,45 +19,227 @@
 #include "wiztk/graphics/alignment.hpp"
 
 #include <wiztk/gui/relative-layout.hpp>
+#include <wiztk/gui/anchor-group.hpp>
+#include <wiztk/gui/anchor.hpp>
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
 
 namespace wiztk {
 namespace gui {
 
 using graphics::Alignment;
 
+namespace {
+
+/**
+ * @brief Solves the edges of views along one axis
+ *
+ * Each view has a near edge (left or top) and a far edge (right or bottom),
+ * the edges of view i are 2 * i and 2 * i + 1. An anchor to the layout fixes
+ * an edge, an anchor between siblings is an equation: near = far + distance.
+ *
+ * Known edges propagate along the equations in a worklist. The size of a view
+ * is used to get the other edge only when no equation can go further, so a
+ * view anchored on both edges stretches. A view without any anchor keeps its
+ * position. Every edge and equation is visited once.
+ */
+class AxisSolver {
+
+ public:
+
+  explicit AxisSolver(size_t count)
+      : values_(count * 2, 0), known_(count * 2, false) {}
+
+  void Fix(int edge, int value) {
+    if (known_[edge]) return;  // The first one wins
+
+    values_[edge] = value;
+    known_[edge] = true;
+    stack_.push_back(edge);
+  }
+
+  void Link(int far_edge, int near_edge, int distance) {
+    equations_.push_back({far_edge, near_edge, distance});
+  }
+
+  void Solve(const std::vector<int> &sizes, const std::vector<int> &positions) {
+    BuildAdjacency();
+    Propagate();
+
+    for (size_t i = 0; i < sizes.size(); ++i) {
+      int near = static_cast<int>(i) * 2;
+      int far = near + 1;
+
+      if (known_[near] && known_[far]) continue;
+
+      if (known_[near]) {
+        Fix(far, values_[near] + sizes[i]);
+      } else if (known_[far]) {
+        Fix(near, values_[far] - sizes[i]);
+      } else {
+        Fix(near, positions[i]);
+        Fix(far, positions[i] + sizes[i]);
+      }
+
+      Propagate();
+    }
+  }
+
+  int Get(int edge) const { return values_[edge]; }
+
+ private:
+
+  struct Equation {
+    int far;
+    int near;
+    int distance;
+  };
+
+  struct Link_ {
+    int edge;
+    int delta;
+  };
+
+  /**
+   * @brief Build the bidirectional links of each edge (CSR layout)
+   */
+  void BuildAdjacency() {
+    offsets_.assign(values_.size() + 1, 0);
+    for (const Equation &e : equations_) {
+      ++offsets_[e.far + 1];
+      ++offsets_[e.near + 1];
+    }
+    for (size_t i = 1; i < offsets_.size(); ++i) offsets_[i] += offsets_[i - 1];
+
+    links_.resize(equations_.size() * 2);
+    std::vector<int> fill(offsets_.begin(), offsets_.end() - 1);
+    for (const Equation &e : equations_) {
+      links_[fill[e.far]++] = {e.near, e.distance};
+      links_[fill[e.near]++] = {e.far, -e.distance};
+    }
+  }
+
+  void Propagate() {
+    while (!stack_.empty()) {
+      int edge = stack_.back();
+      stack_.pop_back();
+
+      for (int i = offsets_[edge]; i < offsets_[edge + 1]; ++i) {
+        Fix(links_[i].edge, values_[edge] + links_[i].delta);
+      }
+    }
+  }
+
+  std::vector<int> values_;
+
+  std::vector<bool> known_;
+
+  std::vector<int> stack_;
+
+  std::vector<Equation> equations_;
+
+  std::vector<int> offsets_;
+
+  std::vector<Link_> links_;
+
+};
+
+} // namespace
+
 RelativeLayout::~RelativeLayout() {
 
 }
 
 void RelativeLayout::OnViewAdded(AbstractView *view) {
-  if (view->IsVisible())
-    Layout();
+  // AbstractLayout::AddView() requests a layout pass
 }
 
 void RelativeLayout::OnViewRemoved(AbstractView *view) {
-  if (view->IsVisible())
-    Layout();
+  // AbstractLayout::RemoveView() requests a layout pass
 }
 
 void RelativeLayout::OnLayout(int left, int top, int right, int bottom) {
-  const AnchorGroup &left_group = GetAnchorGroup(Alignment::kLeft);
-  for (Anchor *anchor = left_group.first(); nullptr != anchor; anchor = anchor->next()) {
-    anchor->contrary()->group()->view()->SetLeft(left + anchor->distance());
-  }
+  std::vector<AbstractView *> views;
+  std::unordered_map<const AbstractView *, int> indices;
+
+  Iterator it(this);
+  for (it = it.first_child(); it; ++it) {
+    if (!it.view()->IsVisible()) continue;
 
-  const AnchorGroup &top_group = GetAnchorGroup(Alignment::kTop);
-  for (Anchor *anchor = top_group.first(); nullptr != anchor; anchor = anchor->next()) {
-    anchor->contrary()->group()->view()->SetTop(top + anchor->distance());
+    indices[it.view()] = static_cast<int>(views.size());
+    views.push_back(it.view());
   }
 
-  const AnchorGroup &right_group = GetAnchorGroup(Alignment::kRight);
-  for (Anchor *anchor = right_group.first(); nullptr != anchor; anchor = anchor->next()) {
-    anchor->contrary()->group()->view()->SetRight(right + anchor->distance());
+  if (views.empty()) return;
+
+  // Compile the anchors into equations:
+  AxisSolver x(views.size());
+  AxisSolver y(views.size());
+  std::vector<int> widths(views.size());
+  std::vector<int> heights(views.size());
+  std::vector<int> lefts(views.size());
+  std::vector<int> tops(views.size());
+
+  for (size_t i = 0; i < views.size(); ++i) {
+    AbstractView *view = views[i];
+    int near = static_cast<int>(i) * 2;
+    int far = near + 1;
+
+    Size size = MeasureView(view);
+    widths[i] = size.width;
+    heights[i] = size.height;
+    lefts[i] = view->GetLeft();
+    tops[i] = view->GetTop();
+
+    for (int align : {Alignment::kLeft, Alignment::kTop, Alignment::kRight, Alignment::kBottom}) {
+      const AnchorGroup &group = view->GetAnchorGroup(align);
+
+      for (Anchor *anchor = group.first(); nullptr != anchor; anchor = anchor->next()) {
+        const AnchorGroup *other = anchor->contrary()->group();
+        int distance = anchor->distance();
+
+        if (other->view() == this) {
+          switch (align) {
+            case Alignment::kLeft: x.Fix(near, left + distance);
+              break;
+            case Alignment::kTop: y.Fix(near, top + distance);
+              break;
+            case Alignment::kRight: x.Fix(far, right + distance);
+              break;
+            case Alignment::kBottom: y.Fix(far, bottom + distance);
+              break;
+            default: break;
+          }
+          continue;
+        }
+
+        // A sibling anchor is in both views, compile it from the far edge only:
+        auto found = indices.find(other->view());
+        if (found == indices.end()) continue;
+
+        int other_near = found->second * 2;
+        if (Alignment::kRight == align && Alignment::kLeft == other->alignment())
+          x.Link(far, other_near, distance);
+        else if (Alignment::kBottom == align && Alignment::kTop == other->alignment())
+          y.Link(far, other_near, distance);
+      }
+    }
   }
 
-  const AnchorGroup &bottom_group = GetAnchorGroup(Alignment::kBottom);
-  for (Anchor *anchor = bottom_group.first(); nullptr != anchor; anchor = anchor->next()) {
-    anchor->contrary()->group()->view()->SetBottom(bottom + anchor->distance());
+  x.Solve(widths, lefts);
+  y.Solve(heights, tops);
+
+  // Commit the geometry of each view once:
+  for (size_t i = 0; i < views.size(); ++i) {
+    int near = static_cast<int>(i) * 2;
+    int far = near + 1;
+    ArrangeView(views[i],
+                x.Get(near),
+                y.Get(near),
+                std::max(x.Get(far) - x.Get(near), 0),
+                std::max(y.Get(far) - y.Get(near), 0));
   }
 }
 
@@ -21,7 +21,8 @@
 
 #include "wiztk/gui/mouse-event.hpp"
 #include "wiztk/gui/key-event.hpp"
-#include "wiztk/gui/callback.hpp"
+#include "wiztk/gui/animator.hpp"
+#include "wiztk/gui/abstract-shell-view.hpp"
 #include "wiztk/gui/context.hpp"
 
 #include "wiztk/graphics/canvas.hpp"
@@ -43,7 +44,14 @@ struct Spinner::Private : public base::Property<Spinner> {
 
   ~Private() final = default;
 
-  Callback frame_callback;
+  /**
+   * @brief The time of a full turn in milliseconds
+   */
+  static const uint32_t kPeriod = 1000;
+
+  Animator *animator = nullptr;
+
+  Animator::Handle rotation;
 
   ColorF fore_color = 0xEF999999;
   ColorF back_color = 0x00000000;
@@ -52,13 +60,15 @@ struct Spinner::Private : public base::Property<Spinner> {
 
   void Draw(const Context &context);
 
-  void OnFrame(uint32_t serial);
+  /**
+   * @brief Rotate with the animator of the shell view if not yet
+   */
+  void StartRotation();
 
 };
 
 void Spinner::Private::Draw(const Context &context) {
-  angle += 5.f;
-  if (angle > 360.f) angle = 0.f;
+  StartRotation();
 
   Canvas *canvas = context.canvas();
   int scale = context.surface()->GetScale();
@@ -84,18 +94,24 @@ void Spinner::Private::Draw(const Context &context) {
                         rect.center_x() + radius,
                         rect.center_y() + radius),
                   angle, 300.f, false, paint);
-
-  frame_callback.Setup(context.surface());
 }
 
-void Spinner::Private::OnFrame(uint32_t serial) {
-  proprietor()->Update();
+void Spinner::Private::StartRotation() {
+  AbstractShellView *shell_view = proprietor()->GetShellView();
+  if (nullptr == shell_view) return;
+
+  if (animator == shell_view->GetAnimator() && animator->IsRunning(rotation)) return;
+
+  // Moved to another shell view, the last animator may be destroyed:
+  if (nullptr != animator) Animator::Forget(proprietor());
+
+  animator = shell_view->GetAnimator();
+  rotation = animator->Animate(proprietor(), &angle, 0.f, 360.f, kPeriod,
+                               Animator::kEasingLinear, Animator::kRepeatForever);
 }
 
 Spinner::Spinner() {
   p_ = std::make_unique<Private>(this);
-
-  p_->frame_callback.done().Bind(p_.get(), &Private::OnFrame);
 }
 
 Spinner::~Spinner() = default;
@@ -450,6 +450,10 @@ int Surface::kShellSurfaceCount = 0;
 base::Deque<Surface::RenderTask> Surface::kRenderTaskDeque;
 base::Deque<Surface::CommitTask> Surface::kCommitTaskDeque;
 
+base::memory::Arena Surface::kFrameArena;
+
+size_t Surface::kFrameAllocationCount = 0;
+
 Surface::Surface(AbstractEventHandler *event_handler, const Margin &margin) {
   _ASSERT(nullptr != event_handler);
   p_ = std::make_unique<Private>(this, event_handler, margin);
@@ -461,6 +465,10 @@ Surface::Surface(AbstractEventHandler *event_handler, const Margin &margin) {
 }
 
 Surface::~Surface() {
+  // No leave event comes for a touch sequence or a focus on this surface:
+  Display *display = Application::GetInstance()->GetDisplay();
+  display->GetInputManager()->ResetSurface(this);
+
   if (nullptr != p_->rendering_api) {
     p_->rendering_api->Release(this);
   }
@@ -524,7 +532,16 @@ void Surface::Commit() {
 }
 
 void Surface::SetCommitMode(CommitMode mode) {
+  if (p_->commit_mode == mode) return;
+
   p_->commit_mode = mode;
+
+  if (nullptr != p_->parent) {
+    if (kDesynchronized == mode)
+      wl_subsurface_set_desync(p_->role.sub->wl_sub_surface_);
+    else
+      wl_subsurface_set_sync(p_->role.sub->wl_sub_surface_);
+  }
 }
 
 void Surface::Damage(int surface_x, int surface_y, int width, int height) {
@@ -31,6 +31,7 @@
 #include "theme-dark.hpp"
 
 #include <iostream>
+#include <strings.h>
 
 namespace wiztk {
 namespace gui {
@@ -103,14 +104,11 @@ void Theme::Load(const char *name) {
   // TODO: load from file
 
   // Otherwise, use the builtin theme
-  std::string upper_name(name);
-  std::transform(upper_name.begin(), upper_name.end(), upper_name.begin(), ::toupper);
-
-  if (upper_name == "LIGHT") {
+  if (0 == strcasecmp(name, "Light")) {
     handle = ThemeLightCreate;
     kTheme = static_cast<Theme *>(handle());
     kTheme->data_.name = name;
-  } else if (upper_name == "DARK") {
+  } else if (0 == strcasecmp(name, "Dark")) {
     handle = ThemeDarkCreate;
     kTheme = static_cast<Theme *>(handle());
   }
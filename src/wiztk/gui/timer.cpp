@@ -16,8 +16,7 @@
 
 #include <wiztk/gui/timer.hpp>
 
-#include <wiztk/gui/abstract-epoll-task.hpp>
-#include <wiztk/gui/application.hpp>
+#include "wiztk/async/event-loop.hpp"
 
 #include <sys/timerfd.h>
 #include <unistd.h>
@@ -28,16 +27,16 @@
 namespace wiztk {
 namespace gui {
 
-class Timer::EpollTask : public AbstractEpollTask {
+class Timer::EpollTask : public async::AbstractEvent {
 
  public:
 
-  EpollTask(Timer *timer)
-      : AbstractEpollTask(), timer_(timer) {}
+  explicit EpollTask(Timer *timer)
+      : timer_(timer) {}
 
-  virtual ~EpollTask() {}
+  ~EpollTask() override = default;
 
-  virtual void Run(uint32_t events) override;
+  void Run(uint32_t events) override;
 
  private:
 
@@ -52,7 +51,7 @@ struct Timer::Private {
   Private &operator=(const Private &) = delete;
 
   Private(Timer *timer)
-      : fd(-1), is_armed(false), interval(0), epoll_task(timer) {}
+      : fd(-1), is_armed(false), interval(0), epoll_task(timer), event_loop(nullptr) {}
 
   ~Private() {}
 
@@ -61,6 +60,11 @@ struct Timer::Private {
   unsigned int interval;  // interval in microseconds
   EpollTask epoll_task;
 
+  /**
+   * @brief The event loop which watches the timer fd while armed
+   */
+  async::EventLoop *event_loop;
+
 };
 
 void Timer::EpollTask::Run(uint32_t events) {
@@ -79,7 +83,7 @@ void Timer::EpollTask::Run(uint32_t events) {
 Timer::Timer(unsigned int interval) {
   p_.reset(new Private(this));
 
-  p_->fd = timerfd_create(CLOCK_REALTIME, 0);
+  p_->fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
   if (p_->fd < 0) {
     fprintf(stderr, "Error! Fail to create timerfd!\n");
   }
@@ -87,13 +91,17 @@ Timer::Timer(unsigned int interval) {
 }
 
 Timer::~Timer() {
+  Stop();
   if (p_->fd >= 0) close(p_->fd);
 }
 
 void Timer::Start() {
   if (p_->is_armed) return;
 
-//  Application::GetInstance()->WatchFileDescriptor(p_->fd, EPOLLIN, &p_->epoll_task);
+  p_->event_loop = async::EventLoop::GetCurrent();
+  if (nullptr == p_->event_loop || p_->fd < 0) return;
+
+  p_->event_loop->WatchFileDescriptor(p_->fd, &p_->epoll_task, EPOLLIN);
   SetTime();
   p_->is_armed = true;
 }
@@ -113,7 +121,8 @@ void Timer::Stop() {
     _DEBUG("%s\n", "Fail to stop timer!");
   }
 
-//  Application::GetInstance()->UnwatchFileDescriptor(p_->fd);
+  p_->event_loop->UnwatchFileDescriptor(p_->fd);
+  p_->event_loop = nullptr;
 
   p_->is_armed = false;
 }
@@ -0,0 +1,156 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "wiztk/gui/touch-event.hpp"
+
+#include "wiztk/gui/surface.hpp"
+
+#include <cmath>
+
+namespace wiztk {
+namespace gui {
+
+using base::Point2D;
+using base::Point2I;
+
+const double TouchGesture::kSlop = 8.0;
+
+void TouchGesture::Update(const TouchPoint *points, int count) {
+  Point2D centroid(0.0, 0.0);
+  Point2D current(0.0, 0.0);
+  Point2D last(0.0, 0.0);
+  int active = 0;
+  int common = 0;
+
+  for (int i = 0; i < count; ++i) {
+    const TouchPoint &point = points[i];
+    if (kTouchUp != point.state) {
+      centroid += point.surface_xy;
+      ++active;
+    }
+    if (kTouchMotion == point.state || kTouchStationary == point.state) {
+      current += point.surface_xy;
+      last += point.last_surface_xy;
+      ++common;
+    }
+  }
+
+  pan_delta_ = Point2D(0.0, 0.0);
+  scale_delta_ = 1.0;
+
+  if (active > 0) {
+    centroid_.x = centroid.x / active;
+    centroid_.y = centroid.y / active;
+  }
+
+  if (pinching_ && active < 2) pinching_ = false;
+
+  if (0 == common) return;
+
+  current.x /= common;
+  current.y /= common;
+  last.x /= common;
+  last.y /= common;
+
+  Point2D delta(current.x - last.x, current.y - last.y);
+  pan_ += delta;
+  if (!panning_ && std::hypot(pan_.x, pan_.y) > kSlop) panning_ = true;
+  if (panning_) pan_delta_ = delta;
+
+  if (common < 2) return;
+
+  double spread = 0.0;
+  double last_spread = 0.0;
+  for (int i = 0; i < count; ++i) {
+    const TouchPoint &point = points[i];
+    if (kTouchMotion != point.state && kTouchStationary != point.state) continue;
+    spread += std::hypot(point.surface_xy.x - current.x, point.surface_xy.y - current.y);
+    last_spread += std::hypot(point.last_surface_xy.x - last.x, point.last_surface_xy.y - last.y);
+  }
+  spread /= common;
+  last_spread /= common;
+
+  if (last_spread < 1.0) return;
+
+  if (!pinching_) {
+    spread_change_ += spread - last_spread;
+    if (std::abs(spread_change_) <= kSlop) return;
+    pinching_ = true;
+    scale_ = 1.0;
+  }
+
+  scale_delta_ = spread / last_spread;
+  scale_ *= scale_delta_;
+}
+
+void TouchGesture::Reset() {
+  panning_ = false;
+  pinching_ = false;
+  centroid_ = Point2D(0.0, 0.0);
+  pan_delta_ = Point2D(0.0, 0.0);
+  pan_ = Point2D(0.0, 0.0);
+  scale_delta_ = 1.0;
+  scale_ = 1.0;
+  spread_change_ = 0.0;
+}
+
+// -------
+
+const TouchPoint *TouchEvent::FindPoint(int32_t id) const {
+  int index = FindIndex(id);
+  return index < 0 ? nullptr : &points_[index];
+}
+
+Point2D TouchEvent::GetWindowOriginXY() const {
+  Point2D xy = origin_xy_;
+
+  if (nullptr != surface_) {
+    Point2I pos = surface_->GetWindowPosition();
+    xy.x += pos.x;
+    xy.y += pos.y;
+  }
+
+  return xy;
+}
+
+int TouchEvent::FindIndex(int32_t id) const {
+  for (int i = 0; i < count_; ++i) {
+    if (points_[i].id == id) return i;
+  }
+  return -1;
+}
+
+void TouchEvent::Advance() {
+  int count = 0;
+
+  if (!cancelled_) {
+    for (int i = 0; i < count_; ++i) {
+      if (kTouchUp == points_[i].state) continue;
+      points_[count] = points_[i];
+      points_[count].state = kTouchStationary;
+      points_[count].last_surface_xy = points_[count].surface_xy;
+      ++count;
+    }
+  }
+
+  count_ = count;
+  cancelled_ = false;
+
+  if (0 == count_) gesture_.Reset();
+}
+
+} // namespace gui
+} // namespace wiztk
@@ -14,71 +14,462 @@
  * limitations under the License.
  */
 
-#include <wiztk/gui/video-view.hpp>
-#include <wiztk/gui/surface.hpp>
+#include "wiztk/gui/video-view.hpp"
 
-#include <wiztk/gui/context.hpp>
-#include <wiztk/graphics/canvas.hpp>
-#include <wiztk/graphics/paint.hpp>
+#include "wiztk/base/property.hpp"
+
+#include "wiztk/async/event-loop.hpp"
+
+#include "wiztk/graphics/canvas.hpp"
+#include "wiztk/graphics/paint.hpp"
+#include "wiztk/graphics/yuv-converter.hpp"
+
+#include "wiztk/device/video/frame.hpp"
+
+#include "wiztk/gui/buffer.hpp"
+#include "wiztk/gui/callback.hpp"
+#include "wiztk/gui/context.hpp"
+#include "wiztk/gui/key-event.hpp"
+#include "wiztk/gui/mouse-event.hpp"
+#include "wiztk/gui/region.hpp"
+#include "wiztk/gui/shared-memory-pool.hpp"
+#include "wiztk/gui/surface.hpp"
+
+#include <cstring>
+#include <ctime>
+#include <mutex>
+
+#include <sys/eventfd.h>
+#include <unistd.h>
 
 namespace wiztk {
 namespace gui {
 
-VideoView::VideoView()
-    : VideoView(320, 240) {
+static int64_t GetMonotonicTime() {
+  struct timespec now = {0, 0};
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return static_cast<int64_t>(now.tv_sec) * 1000000 + now.tv_nsec / 1000;
+}
+
+/**
+ * @brief Describe a captured frame with its real line stride
+ */
+static graphics::YUVFrame MakeYUVFrame(const device::video::Frame &frame) {
+  const device::video::Format &format = frame.GetFormat();
+  auto pixel_format = static_cast<PixelFormat>(format.pixel_format);
+  graphics::YUVFrame yuv = graphics::YUVFrame::Make(pixel_format, format.width, format.height, frame.GetData());
+
+  int stride = format.bytes_per_line;
+  if (kPixelFormatInvalid == yuv.format || stride <= yuv.strides[0]) return yuv;
+
+  const auto *data = static_cast<const uint8_t *>(frame.GetData());
+  switch (pixel_format) {
+    case kPixelFormatYUYV: {
+      yuv.strides[0] = stride;
+      break;
+    }
+    case kPixelFormatNV12: {
+      yuv.strides[0] = yuv.strides[1] = stride;
+      yuv.planes[1] = data + stride * format.height;
+      break;
+    }
+    case kPixelFormatYUV420: {
+      yuv.strides[0] = stride;
+      yuv.strides[1] = yuv.strides[2] = stride / 2;
+      yuv.planes[1] = data + stride * format.height;
+      yuv.planes[2] = yuv.planes[1] + stride / 2 * ((format.height + 1) / 2);
+      break;
+    }
+    default: break;
+  }
+
+  return yuv;
+}
+
+/**
+ * @brief The private structure used in VideoView
+ *
+ * Each buffer goes through the states: free -> writing (in a producer thread)
+ * -> ready -> attached (in the main thread) -> free (released by compositor).
+ * The states, the frame size and the statistics are guarded by the mutex,
+ * pixels are written outside of the lock.
+ */
+struct VideoView::Private : public base::Property<VideoView> {
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(Private);
+
+  enum SlotState {
+    kSlotFree,
+    kSlotWriting,
+    kSlotReady,
+    kSlotAttached
+  };
+
+  /**
+   * @brief A shared memory buffer and its state
+   */
+  struct Slot : public base::Trackable {
+
+    Buffer buffer;
+
+    SlotState state = kSlotFree;
+
+    int64_t timestamp = 0;
+
+    std::mutex *mutex = nullptr;
+
+    void OnRelease(__SLOT__) {
+      std::lock_guard<std::mutex> lock(*mutex);
+      if (kSlotAttached == state) state = kSlotFree;
+    }
+
+  };
+
+  /**
+   * @brief An epoll event to wake up the main loop when a frame is ready
+   */
+  class WakeupEvent : public async::AbstractEvent {
+
+   public:
+
+    explicit WakeupEvent(Private *p)
+        : p_(p) {}
+
+    ~WakeupEvent() final = default;
+
+    void Run(uint32_t events) final {
+      eventfd_t value = 0;
+      eventfd_read(p_->event_fd, &value);
+      p_->OnWakeup();
+    }
+
+   private:
+
+    Private *p_ = nullptr;
+
+  };
+
+  explicit Private(VideoView *owner);
+
+  ~Private() final;
+
+  /**
+   * @brief Get a buffer to write a frame of the given size, can be called in any thread
+   * @return The index of the buffer, or -1 if the frame should be dropped
+   */
+  int Acquire(int width, int height);
+
+  /**
+   * @brief Mark the buffer written and wake up the main loop
+   */
+  void Queue(int index, int64_t timestamp);
+
+  /**
+   * @brief Handle the ready frame or reallocate the buffers in the main loop
+   */
+  void OnWakeup();
+
+  void OnFrameDone(uint32_t time);
+
+  /**
+   * @brief Create the shared memory pool and buffers for the requested size
+   */
+  void Reallocate();
+
+  std::mutex mutex;
+
+  Slot slots[kBufferCount];
+
+  SharedMemoryPool pool;
+
+  int width = 0;
+
+  int height = 0;
+
+  int requested_width = 0;
+
+  int requested_height = 0;
+
+  /**
+   * @brief The index of the latest written buffer, or -1
+   */
+  int ready = -1;
+
+  Statistics statistics;
+
+  int64_t committed_timestamp = 0;
+
+  graphics::YUVConverter converter;
+
+  Surface *sub_surface = nullptr;
+
+  async::EventLoop *event_loop = nullptr;
+
+  int event_fd = -1;
+
+  WakeupEvent wakeup_event;
 
+  Callback callback;
+
+};
+
+VideoView::Private::Private(VideoView *owner)
+    : base::Property<VideoView>(owner), wakeup_event(this) {
+  for (auto &slot : slots) {
+    slot.mutex = &mutex;
+    slot.buffer.release().Connect(&slot, &Slot::OnRelease);
+  }
+
+  event_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+}
+
+VideoView::Private::~Private() {
+  if (nullptr != event_loop) event_loop->UnwatchFileDescriptor(event_fd);
+  if (-1 != event_fd) close(event_fd);
+
+  delete sub_surface;
+
+  for (auto &slot : slots) slot.buffer.Destroy();
+  pool.Destroy();
+}
+
+int VideoView::Private::Acquire(int w, int h) {
+  std::lock_guard<std::mutex> lock(mutex);
+
+  ++statistics.pushed;
+
+  if (w != width || h != height) {
+    // The buffers are reallocated in the main loop:
+    requested_width = w;
+    requested_height = h;
+    eventfd_write(event_fd, 1);
+    ++statistics.dropped;
+    return -1;
+  }
+
+  for (int i = 0; i < kBufferCount; ++i) {
+    if (kSlotFree == slots[i].state) {
+      slots[i].state = kSlotWriting;
+      return i;
+    }
+  }
+
+  // Overwrite the frame which is not attached yet:
+  if (-1 != ready) {
+    int index = ready;
+    ready = -1;
+    slots[index].state = kSlotWriting;
+    ++statistics.dropped;
+    return index;
+  }
+
+  ++statistics.dropped;
+  return -1;
+}
+
+void VideoView::Private::Queue(int index, int64_t timestamp) {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (-1 != ready) {
+      slots[ready].state = kSlotFree;
+      ++statistics.dropped;
+    }
+
+    slots[index].state = kSlotReady;
+    slots[index].timestamp = 0 == timestamp ? GetMonotonicTime() : timestamp;
+    ready = index;
+  }
+
+  eventfd_write(event_fd, 1);
+}
+
+void VideoView::Private::OnWakeup() {
+  int index = -1;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (requested_width != width || requested_height != height) {
+      bool writing = false;
+      for (auto &slot : slots) writing = writing || (kSlotWriting == slot.state);
+      if (!writing) Reallocate();
+      // Otherwise wait for the next frame.
+      return;
+    }
+
+    if (nullptr == sub_surface || -1 == ready) return;
+
+    index = ready;
+    ready = -1;
+    slots[index].state = kSlotAttached;
+    committed_timestamp = slots[index].timestamp;
+  }
+
+  sub_surface->Attach(&slots[index].buffer);
+  sub_surface->DamageBuffer(0, 0, width, height);
+  callback.Setup(sub_surface);
+  sub_surface->Commit();
+}
+
+void VideoView::Private::OnFrameDone(uint32_t /* time */) {
+  int64_t latency = GetMonotonicTime() - committed_timestamp;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    statistics.last_latency = latency;
+    if (latency > statistics.max_latency) statistics.max_latency = latency;
+    statistics.average_latency =
+        (statistics.average_latency * statistics.presented + latency) / (statistics.presented + 1);
+    ++statistics.presented;
+  }
+
+  proprietor()->presented_.Emit(latency);
+}
+
+void VideoView::Private::Reallocate() {
+  ready = -1;
+  for (auto &slot : slots) {
+    slot.buffer.Destroy();
+    slot.state = kSlotFree;
+  }
+  pool.Destroy();
+
+  width = requested_width;
+  height = requested_height;
+  if (width <= 0 || height <= 0) return;
+
+  int stride = width * 4;
+  int size = stride * height;
+  pool.Setup(size * kBufferCount);
+  for (int i = 0; i < kBufferCount; ++i) {
+    slots[i].buffer.Setup(pool, width, height, stride, kPixelFormatXRGB8888, size * i);
+  }
 }
 
+// -------
+
+VideoView::VideoView()
+    : VideoView(320, 240) {}
+
 VideoView::VideoView(int width, int height)
-    : AbstractView(width, height),
-      surface_(nullptr) {
+    : AbstractView(width, height) {
+  p_ = std::make_unique<Private>(this);
+  p_->callback.done().Bind(p_.get(), &VideoView::Private::OnFrameDone);
+}
+
+VideoView::~VideoView() = default;
+
+bool VideoView::PushFrame(const graphics::YUVFrame &frame, int64_t timestamp) {
+  int index = p_->Acquire(frame.width, frame.height);
+  if (-1 == index) return false;
+
+  Buffer &buffer = p_->slots[index].buffer;
+  p_->converter.Convert(frame, const_cast<void *>(buffer.GetData()), buffer.GetStride(), kPixelFormatXRGB8888);
+  p_->Queue(index, timestamp);
+  return true;
+}
+
+bool VideoView::PushFrame(const device::video::Frame &frame) {
+  if (!frame) return false;
 
+  graphics::YUVFrame yuv = MakeYUVFrame(frame);
+  if (kPixelFormatInvalid == yuv.format) return false;
+
+  return PushFrame(yuv, frame.GetTimestamp());
 }
 
-VideoView::~VideoView() {
-  delete surface_;
+bool VideoView::PushFrame(const void *pixels, int width, int height, int stride, int64_t timestamp) {
+  int index = p_->Acquire(width, height);
+  if (-1 == index) return false;
+
+  Buffer &buffer = p_->slots[index].buffer;
+  const auto *src = static_cast<const uint8_t *>(pixels);
+  auto *dst = static_cast<uint8_t *>(const_cast<void *>(buffer.GetData()));
+  for (int row = 0; row < height; ++row) {
+    memcpy(dst, src, static_cast<size_t>(width) * 4);
+    src += stride;
+    dst += buffer.GetStride();
+  }
+
+  p_->Queue(index, timestamp);
+  return true;
 }
 
-void VideoView::OnRequestUpdateFrom(AbstractView *view) {
+void VideoView::OnFrameReady(const device::video::Frame &frame, base::SLOT /* slot */) {
+  PushFrame(frame);
+}
 
+VideoView::Statistics VideoView::GetStatistics() const {
+  std::lock_guard<std::mutex> lock(p_->mutex);
+  return p_->statistics;
 }
 
-Surface *VideoView::GetSurface(const AbstractView *view) const {
-  return surface_;
+void VideoView::OnConfigureGeometry(const RectF &old_geometry, const RectF &new_geometry) {
+  RequestSaveGeometry(new_geometry);
 }
 
-void VideoView::OnSizeChanged(int width, int height) {
+void VideoView::OnSaveGeometry(const RectF &old_geometry, const RectF &new_geometry) {
+  SetBounds(0.f, 0.f, new_geometry.width(), new_geometry.height());
+
+  if (nullptr != p_->sub_surface) {
+    Surface::Sub::Get(p_->sub_surface)->SetWindowPosition(static_cast<int>(new_geometry.x()),
+                                                          static_cast<int>(new_geometry.y()));
+  }
 
+  Update();
 }
 
 void VideoView::OnMouseEnter(MouseEvent *event) {
-
+  event->Ignore();
 }
 
-void VideoView::OnMouseLeave(MouseEvent *event) {
+void VideoView::OnMouseLeave() {
 
 }
 
 void VideoView::OnMouseMove(MouseEvent *event) {
-
+  event->Ignore();
 }
 
 void VideoView::OnMouseDown(MouseEvent *event) {
+  event->Ignore();
+}
 
+void VideoView::OnMouseUp(MouseEvent *event) {
+  event->Ignore();
 }
 
 void VideoView::OnKeyDown(KeyEvent *event) {
+  event->Ignore();
+}
 
+void VideoView::OnKeyUp(KeyEvent *event) {
+  event->Ignore();
 }
 
-void VideoView::OnDraw(const Context *context) {
+void VideoView::OnDraw(const Context &context) {
   using graphics::Canvas;
   using graphics::Paint;
 
-  Canvas *canvas = context->canvas();
+  if (nullptr == p_->sub_surface) {
+    p_->sub_surface = Surface::Sub::Create(context.surface(), this);
+    p_->sub_surface->SetCommitMode(Surface::kDesynchronized);
+
+    Region region;
+    p_->sub_surface->SetInputRegion(region);
+    Surface::Sub::Get(p_->sub_surface)->SetWindowPosition(GetX(), GetY());
+
+    p_->event_loop = async::EventLoop::GetCurrent();
+    p_->event_loop->WatchFileDescriptor(p_->event_fd, &p_->wakeup_event, EPOLLIN);
+  }
+
+  // The background shown around the video:
+  Canvas *canvas = context.canvas();
   Paint paint;
-  paint.SetColor(0xFF29FF29);
-  canvas->DrawRect(GetBounds() * context->surface()->GetScale(), paint);
+  paint.SetColor(0xFF000000);
+  canvas->DrawRect(GetBounds() * context.surface()->GetScale(), paint);
 }
 
 } // namespace gui
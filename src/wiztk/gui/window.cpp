@@ -21,7 +21,9 @@
 #include "wiztk/gui/application.hpp"
 #include "wiztk/gui/display.hpp"
 #include "wiztk/gui/mouse-event.hpp"
+#include "wiztk/gui/hover-path.hpp"
 #include "wiztk/gui/key-event.hpp"
+#include "wiztk/gui/touch-event.hpp"
 #include "wiztk/gui/title-bar.hpp"
 
 #include "wiztk/gui/shared-memory-pool.hpp"
@@ -98,13 +100,16 @@ struct Window::Private : public base::Property<Window> {
 
   void SetContentViewGeometry();
 
-  static std::vector<float> kOutlineRadii;
+  static const float kOutlineRadii[8];
 
-  static void SetRadii(int scale, float offset, std::vector<float> &vec);
+  /**
+   * @brief Scale the outline radii with an offset
+   */
+  static void SetRadii(int scale, float offset, float radii[8]);
 
 };
 
-std::vector<float> Window::Private::kOutlineRadii = {
+const float Window::Private::kOutlineRadii[8] = {
     7.f, 7.f, // top-left
     7.f, 7.f, // top-right
     4.f, 4.f, // bottom-right
@@ -135,19 +140,16 @@ void Window::Private::DrawBody() {
     body_path.AddRect(body_geometry);
     DrawInner(context, body_path);
   } else {
-    std::vector<float> body_radii(kOutlineRadii.size(), 0.f);
-    SetRadii(scale, 0.f, body_radii);
-
-    body_path.AddRoundRect(body_geometry, body_radii.data());
+    float radii[8];
+    SetRadii(scale, 0.f, radii);
+    body_path.AddRoundRect(body_geometry, radii);
     DrawInner(context, body_path);
     DrawShadow(context, body_path);
 
-    std::vector<float> outline_radii(kOutlineRadii.size(), 0.f);
-    SetRadii(scale, -0.5f, outline_radii);
-
     RectF outline_geometry = RectF::FromXYWH(0.5f, 0.5f, pixel_width - 1.f, pixel_height - 1.f);
     Path outline_path;
-    outline_path.AddRoundRect(outline_geometry, outline_radii.data());
+    SetRadii(scale, -0.5f, radii);
+    outline_path.AddRoundRect(outline_geometry, radii);
     DrawOutline(context, outline_path);
   }
 
@@ -213,18 +215,15 @@ void Window::Private::RecursiveDraw(AbstractView *view, const Context &context)
       body_path.AddRect(body_geometry);
       DrawInner(context, body_path);
     } else {
-      std::vector<float> body_radii(kOutlineRadii.size(), 0.f);
-      SetRadii(scale, 0.f, body_radii);
-
-      body_path.AddRoundRect(body_geometry, body_radii.data());
+      float radii[8];
+      SetRadii(scale, 0.f, radii);
+      body_path.AddRoundRect(body_geometry, radii);
       DrawInner(context, body_path);
 
-      std::vector<float> outline_radii(kOutlineRadii.size(), 0.f);
-      SetRadii(scale, -.5f, outline_radii);
-
       RectF outline_geometry = RectF::FromXYWH(0.5f, 0.5f, pixel_width - 1.f, pixel_height - 1.f);
       Path outline_path;
-      outline_path.AddRoundRect(outline_geometry, outline_radii.data());
+      SetRadii(scale, -.5f, radii);
+      outline_path.AddRoundRect(outline_geometry, radii);
       DrawOutline(context, outline_path);
     }
   }
@@ -238,22 +237,11 @@ void Window::Private::SetContentViewGeometry() {
   content_view->Resize(geometry.width(), geometry.height());
 }
 
-void Window::Private::SetRadii(int scale, float offset, std::vector<float> &vec) {
-  // top-left
-  vec[0] = (kOutlineRadii[0] + offset) * scale;
-  vec[1] = (kOutlineRadii[1] + offset) * scale;
-
-  // top-right
-  vec[2] = (kOutlineRadii[2] + offset) * scale;
-  vec[3] = (kOutlineRadii[3] + offset) * scale;
-
-  // bottom-right
-  vec[4] = (kOutlineRadii[4] + offset) * scale;
-  vec[5] = (kOutlineRadii[5] + offset) * scale;
-
-  // bottom-left
-  vec[6] = (kOutlineRadii[6] + offset) * scale;
-  vec[7] = (kOutlineRadii[7] + offset) * scale;
+void Window::Private::SetRadii(int scale, float offset, float radii[8]) {
+  // top-left, top-right, bottom-right, bottom-left:
+  for (int i = 0; i < 8; ++i) {
+    radii[i] = (kOutlineRadii[i] + offset) * scale;
+  }
 }
 
 // --------------
@@ -472,26 +460,25 @@ void Window::OnRenderSurface(Surface *surface) {
     path.AddRect(geometry);
   } else {
     RectF outline_geometry = RectF::FromXYWH(0.5f, 0.5f, pixel_width - 1.f, pixel_height - 1.f);
-    std::vector<float> outline_radii(Private::kOutlineRadii.size(), 0.f);
-    Private::SetRadii(scale, -0.5f, outline_radii);
-    path.AddRoundRect(outline_geometry, outline_radii.data());
+    float radii[8];
+    Private::SetRadii(scale, -0.5f, radii);
+    path.AddRoundRect(outline_geometry, radii);
   }
 
   base::Deque<AbstractView::RenderNode> &deque = surface->GetRenderDeque();
-  base::Deque<AbstractView::RenderNode>::Iterator it = deque.begin();
 
   Canvas::LockGuard guard(&canvas, path, ClipOperation::kClipIntersect, true);
 
   AbstractView *view = nullptr;
-  while (it != deque.end()) {
-    view = it.get()->view();
-    it.remove();
+  AbstractView::RenderNode *node = deque.pop_front();
+  while (nullptr != node) {
+    view = node->view();
     p_->RecursiveDraw(view, context);
     surface->Damage(view->GetX() + margin.l,
                     view->GetY() + margin.t,
                     view->GetWidth(),
                     view->GetHeight());
-    it = deque.begin();
+    node = deque.pop_front();
   }
 
   canvas.Flush();
@@ -634,7 +621,7 @@ void Window::OnMouseDown(MouseEvent *event) {
 
     int location = GetMouseLocation(event);
 
-    if (location == kTitleBar && (nullptr == MouseTask::Get(this)->next())) {
+    if (location == kTitleBar && (nullptr == event->GetHoverPath().GetLeaf())) {
       MoveWithMouse(event);
       event->Ignore();
       return;
@@ -654,7 +641,26 @@ void Window::OnMouseUp(MouseEvent *event) {
   DispatchMouseUpEvent(event);
 }
 
+void Window::OnMouseAxis(MouseEvent *event) {
+  DispatchMouseAxisEvent(event);
+}
+
+void Window::OnTouch(TouchEvent *event) {
+  base::Point2D origin = event->GetWindowOriginXY();
+  auto x = static_cast<int>(origin.x);
+  auto y = static_cast<int>(origin.y);
+
+  if (nullptr != p_->content_view && p_->content_view->Contain(x, y)) {
+    DispatchTouchEvent(p_->content_view, event);
+  } else if (nullptr != p_->title_bar && p_->title_bar->Contain(x, y)) {
+    DispatchTouchEvent(p_->title_bar, event);
+  }
+}
+
 void Window::OnKeyDown(KeyEvent *event) {
+  DispatchKeyDownEvent(event);
+  if (event->IsAccepted() || event->IsRejected()) return;
+
   if (event->key() == kKey_ESC) {
     Application::GetInstance()->Exit();
   }
@@ -0,0 +1,84 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef WIZTK_TEST_COMMON_BOX_HPP_
+#define WIZTK_TEST_COMMON_BOX_HPP_
+
+#include "wiztk/gui/abstract-view.hpp"
+
+namespace wiztk {
+namespace test {
+
+/**
+ * @brief A simple view which saves the geometry immediately and counts how
+ * many times its geometry is configured and an update is requested
+ */
+class Box : public gui::AbstractView {
+
+ public:
+
+  using AbstractView::PushBackChild;
+  using AbstractView::InsertChild;
+  using AbstractView::GetChildAt;
+  using AbstractView::SwapIndex;
+  using AbstractView::MoveToFirst;
+  using AbstractView::MoveForward;
+
+  explicit Box(int width = 10, int height = 10)
+      : AbstractView(width, height) {}
+
+  int configure_count = 0;
+
+  int update_count = 0;
+
+ protected:
+
+  ~Box() override = default;
+
+  void OnMouseEnter(gui::MouseEvent *event) final {}
+
+  void OnMouseLeave() final {}
+
+  void OnMouseMove(gui::MouseEvent *event) final {}
+
+  void OnMouseDown(gui::MouseEvent *event) final {}
+
+  void OnMouseUp(gui::MouseEvent *event) final {}
+
+  void OnKeyDown(gui::KeyEvent *event) final {}
+
+  void OnKeyUp(gui::KeyEvent *event) final {}
+
+  void OnDraw(const gui::Context &context) final {}
+
+  void OnConfigureGeometry(const RectF &old_geometry, const RectF &new_geometry) final {
+    ++configure_count;
+    RequestSaveGeometry(new_geometry);
+  }
+
+  void OnSaveGeometry(const RectF &old_geometry, const RectF &new_geometry) final {}
+
+  void OnRequestUpdateFrom(AbstractView *view) final {
+    ++update_count;
+    AbstractView::OnRequestUpdateFrom(view);
+  }
+
+};
+
+} // namespace test
+} // namespace wiztk
+
+#endif // WIZTK_TEST_COMMON_BOX_HPP_
@@ -0,0 +1,59 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef WIZTK_TEST_COMMON_EVENT_LOOP_HPP_
+#define WIZTK_TEST_COMMON_EVENT_LOOP_HPP_
+
+#include "wiztk/async/event-loop.hpp"
+
+#include <chrono>
+#include <thread>
+
+namespace wiztk {
+namespace test {
+
+/**
+ * @brief The event loop of this thread, created on the first call
+ */
+inline async::EventLoop *GetEventLoop() {
+  async::EventLoop *event_loop = async::EventLoop::GetCurrent();
+  return nullptr == event_loop ? async::EventLoop::Create() : event_loop;
+}
+
+/**
+ * @brief Run one iteration of the event loop, in which the layout pass runs
+ */
+inline void RunOneFrame(async::EventLoop *event_loop) {
+  event_loop->Quit();
+  event_loop->Run();
+}
+
+/**
+ * @brief Run the event loop in this thread for the given milliseconds
+ */
+inline void RunFor(async::EventLoop *event_loop, int msec) {
+  std::thread quit([event_loop, msec]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(msec));
+    event_loop->Quit();
+  });
+  event_loop->Run();
+  quit.join();
+}
+
+} // namespace test
+} // namespace wiztk
+
+#endif // WIZTK_TEST_COMMON_EVENT_LOOP_HPP_
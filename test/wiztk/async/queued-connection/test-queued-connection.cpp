@@ -0,0 +1,307 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "test-queued-connection.hpp"
+
+#include "wiztk/async/queued-connection.hpp"
+#include "wiztk/async/scheduler.hpp"
+#include "wiztk/system/threading/thread.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace wiztk;
+using namespace wiztk::system;
+using namespace wiztk::async;
+
+static EventLoop *GetEventLoop() {
+  EventLoop *event_loop = EventLoop::GetCurrent();
+  return nullptr == event_loop ? EventLoop::Create() : event_loop;
+}
+
+/**
+ * @brief Run the loop until the messages posted so far are dispatched
+ */
+static void Flush(EventLoop *event_loop) {
+  event_loop->Quit();
+  event_loop->Run();
+}
+
+/**
+ * @brief A thread emits a signal a number of times
+ */
+class Emitter : public threading::Thread {
+
+ public:
+
+  explicit Emitter(int count)
+      : count_(count) {}
+
+  ~Emitter() final {
+    delete signal_;
+  }
+
+  base::Signal<int, const std::string &> &signal() { return *signal_; }
+
+  /**
+   * @brief Destroy the signal in the thread after the emissions
+   */
+  bool destroy_signal = false;
+
+ protected:
+
+  void Run() final {
+    std::string text("text");
+    for (int i = 0; i < count_; ++i) signal_->Emit(i, text);
+
+    if (destroy_signal) {
+      delete signal_;
+      signal_ = nullptr;
+    }
+  }
+
+ private:
+
+  int count_;
+
+  base::Signal<int, const std::string &> *signal_ = new base::Signal<int, const std::string &>;
+
+};
+
+/**
+ * @brief Records the values received in the thread of the event loop
+ */
+class Receiver : public base::Trackable {
+
+ public:
+
+  static std::atomic<int> kDestroyed;
+
+  explicit Receiver(EventLoop *event_loop, int quit_count = 0)
+      : event_loop_(event_loop), quit_count_(quit_count) {}
+
+  ~Receiver() final {
+    ++kDestroyed;
+  }
+
+  void OnValue(int value, const std::string &text, __SLOT__) {
+    if (EventLoop::GetCurrent() != event_loop_) wrong_thread = true;
+    if (text != "text") wrong_text = true;
+
+    values.push_back(value);
+    if (static_cast<int>(values.size()) == quit_count_) event_loop_->Quit();
+  }
+
+  void OnUnbind(int value, const std::string &text, __SLOT__) {
+    values.push_back(value);
+    UnbindSignal(slot);
+  }
+
+  std::vector<int> values;
+
+  bool wrong_thread = false;
+
+  bool wrong_text = false;
+
+ private:
+
+  EventLoop *event_loop_;
+
+  int quit_count_;
+
+};
+
+std::atomic<int> Receiver::kDestroyed(0);
+
+/**
+ * @brief A message posted from another thread
+ */
+class QuitMessage : public Message {
+
+ public:
+
+  explicit QuitMessage(EventLoop *event_loop)
+      : event_loop_(event_loop) {}
+
+  ~QuitMessage() final = default;
+
+  void Exec() final {
+    executed = EventLoop::GetCurrent() == event_loop_;
+    event_loop_->Quit();
+  }
+
+  std::atomic<bool> executed{false};
+
+ private:
+
+  EventLoop *event_loop_;
+
+};
+
+class Poster : public threading::Thread {
+
+ public:
+
+  Poster(EventLoop *event_loop, Message *message)
+      : event_loop_(event_loop), message_(message) {}
+
+  ~Poster() final = default;
+
+ protected:
+
+  void Run() final {
+    event_loop_->GetScheduler().PostMessage(message_);
+  }
+
+ private:
+
+  EventLoop *event_loop_;
+
+  Message *message_;
+
+};
+
+/**
+ * @brief Post a message from another thread.
+ */
+TEST_F(TestQueuedConnection, post_1) {
+  EventLoop *event_loop = GetEventLoop();
+  QuitMessage message(event_loop);
+
+  Poster poster(event_loop, &message);
+  poster.Start();
+  event_loop->Run();
+  poster.Join();
+
+  ASSERT_TRUE(message.executed);
+}
+
+/**
+ * @brief Emit in another thread, the slot method is called in order in the
+ * thread of the event loop.
+ */
+TEST_F(TestQueuedConnection, emit_1) {
+  const int kCount = 1000;
+
+  EventLoop *event_loop = GetEventLoop();
+  Receiver receiver(event_loop, kCount);
+  Emitter emitter(kCount);
+
+  ConnectQueued(emitter.signal(), &receiver, &Receiver::OnValue, event_loop);
+  emitter.Start();
+  event_loop->Run();
+  emitter.Join();
+
+  ASSERT_EQ(kCount, static_cast<int>(receiver.values.size()));
+  for (int i = 0; i < kCount; ++i) ASSERT_EQ(i, receiver.values[i]);
+  ASSERT_FALSE(receiver.wrong_thread);
+  ASSERT_FALSE(receiver.wrong_text);
+}
+
+/**
+ * @brief Emit in the thread of the event loop, the slot method is called at
+ * once.
+ */
+TEST_F(TestQueuedConnection, emit_2) {
+  EventLoop *event_loop = GetEventLoop();
+  Receiver receiver(event_loop);
+  base::Signal<int, const std::string &> signal;
+
+  ConnectQueued(signal, &receiver, &Receiver::OnValue, event_loop);
+  signal.Emit(1, "text");
+  ASSERT_EQ(std::vector<int>({1}), receiver.values);
+
+  // Unbind in the slot method:
+  signal.DisconnectAll();
+  ConnectQueued(signal, &receiver, &Receiver::OnUnbind, event_loop);
+  signal.Emit(2, "text");
+  signal.Emit(3, "text");
+  ASSERT_EQ(std::vector<int>({1, 2}), receiver.values);
+  ASSERT_EQ(0, signal.CountConnections());
+  ASSERT_EQ(0, receiver.CountSignalBindings());
+}
+
+/**
+ * @brief Destroy the receiver with messages in flight.
+ */
+TEST_F(TestQueuedConnection, receiver_destroyed_1) {
+  EventLoop *event_loop = GetEventLoop();
+  auto *receiver = new Receiver(event_loop);
+  Emitter emitter(100);
+
+  ConnectQueued(emitter.signal(), receiver, &Receiver::OnValue, event_loop);
+  emitter.Start();
+  emitter.Join();
+
+  int destroyed = Receiver::kDestroyed;
+  delete receiver;
+  ASSERT_EQ(destroyed + 1, Receiver::kDestroyed);
+
+  // The messages are dropped:
+  Flush(event_loop);
+
+  // And the token is disconnected in the next emission:
+  ASSERT_EQ(1, emitter.signal().CountConnections());
+  emitter.signal().Emit(0, "text");
+  ASSERT_EQ(0, emitter.signal().CountConnections());
+}
+
+/**
+ * @brief Destroy the signal with messages in flight.
+ */
+TEST_F(TestQueuedConnection, signal_destroyed_1) {
+  EventLoop *event_loop = GetEventLoop();
+  Receiver receiver(event_loop);
+  Emitter emitter(100);
+
+  emitter.destroy_signal = true;
+  ConnectQueued(emitter.signal(), &receiver, &Receiver::OnValue, event_loop);
+  emitter.Start();
+  emitter.Join();
+
+  // The messages in flight are delivered:
+  Flush(event_loop);
+  ASSERT_EQ(100, static_cast<int>(receiver.values.size()));
+  ASSERT_EQ(0, receiver.CountSignalBindings());
+}
+
+/**
+ * @brief Emit in another thread, prints the cost of each queued call
+ */
+TEST_F(TestQueuedConnection, benchmark_1) {
+  using Clock = std::chrono::steady_clock;
+
+  const int kCount = 1000000;
+
+  EventLoop *event_loop = GetEventLoop();
+  Receiver receiver(event_loop, kCount);
+  Emitter emitter(kCount);
+
+  receiver.values.reserve(kCount);
+  ConnectQueued(emitter.signal(), &receiver, &Receiver::OnValue, event_loop);
+
+  auto start = Clock::now();
+  emitter.Start();
+  event_loop->Run();
+  std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+  emitter.Join();
+
+  ASSERT_EQ(kCount, static_cast<int>(receiver.values.size()));
+  std::cout << kCount << " queued calls: " << elapsed.count() / kCount << " ns per call" << std::endl;
+}
@@ -0,0 +1,161 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "test-atom.hpp"
+
+#include "wiztk/base/atom.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace wiztk;
+using namespace wiztk::base;
+
+TEST_F(TestAtom, construct_1) {
+  Atom null;
+  ASSERT_FALSE(null);
+  ASSERT_STREQ("", null.c_str());
+
+  Atom empty("");
+  ASSERT_TRUE(empty);
+  ASSERT_TRUE(empty.empty());
+  ASSERT_TRUE(null != empty);
+
+  std::string text("wl_output");
+  Atom atom1("wl_output");
+  Atom atom2(text);
+  Atom atom3(text.data(), 2);
+
+  ASSERT_TRUE(atom1 == atom2);
+  ASSERT_EQ(atom1.c_str(), atom2.c_str());
+  ASSERT_TRUE(atom1 != atom3);
+  ASSERT_STREQ("wl", atom3.c_str());
+  ASSERT_EQ(9, atom1.size());
+  ASSERT_EQ(atom1.GetHash(), atom2.GetHash());
+}
+
+TEST_F(TestAtom, find_1) {
+  ASSERT_FALSE(Atom::Find("never interned in this test"));
+
+  size_t count = Atom::CountAll();
+  Atom atom("interned in find_1");
+  ASSERT_EQ(count + 1, Atom::CountAll());
+
+  ASSERT_TRUE(atom == Atom::Find("interned in find_1"));
+  ASSERT_EQ(count + 1, Atom::CountAll());
+}
+
+TEST_F(TestAtom, grow_1) {
+  std::vector<Atom> atoms;
+  for (int i = 0; i < 10000; ++i) {
+    atoms.push_back(Atom("grow_1 " + std::to_string(i)));
+  }
+
+  // The atoms stay valid after the table grows:
+  for (int i = 0; i < 10000; ++i) {
+    ASSERT_TRUE(atoms[i] == Atom("grow_1 " + std::to_string(i)));
+    ASSERT_EQ("grow_1 " + std::to_string(i), atoms[i].c_str());
+  }
+
+  std::unordered_map<Atom, int> map;
+  for (int i = 0; i < 100; ++i) map[atoms[i]] = i;
+  ASSERT_EQ(42, map[Atom("grow_1 42")]);
+}
+
+TEST_F(TestAtom, thread_1) {
+  const int kThreads = 4;
+  std::vector<std::vector<Atom>> results(kThreads);
+  std::vector<std::thread> threads;
+
+  for (int i = 0; i < kThreads; ++i) {
+    threads.emplace_back([i, &results]() {
+      for (int j = 0; j < 1000; ++j) results[i].push_back(Atom("thread_1 " + std::to_string(j)));
+    });
+  }
+  for (std::thread &thread : threads) thread.join();
+
+  for (int i = 1; i < kThreads; ++i) {
+    ASSERT_TRUE(results[0] == results[i]);
+  }
+}
+
+/**
+ * @brief Compare atoms with strcmp() chains and std::string keys
+ */
+TEST_F(TestAtom, benchmark_1) {
+  using Clock = std::chrono::steady_clock;
+
+  const int kCount = 1000000;
+  const char *names[] = {
+      "wl_compositor", "wl_subcompositor", "wl_shm", "wl_output",
+      "zxdg_shell_v6", "wl_shell", "wl_seat", "wl_data_device_manager"
+  };
+  std::vector<Atom> atoms(std::begin(names), std::end(names));
+  std::vector<std::string> strings(std::begin(names), std::end(names));
+
+  int found = 0;
+
+  auto start = Clock::now();
+  for (int i = 0; i < kCount; ++i) {
+    Atom atom = atoms[i % 8];
+    for (int j = 0; j < 8; ++j) {
+      if (atom == atoms[j]) {
+        found += j;
+        break;
+      }
+    }
+  }
+  std::chrono::duration<double, std::nano> atom_elapsed = Clock::now() - start;
+
+  start = Clock::now();
+  for (int i = 0; i < kCount; ++i) {
+    const char *name = strings[i % 8].c_str();
+    for (int j = 0; j < 8; ++j) {
+      if (0 == strcmp(name, names[j])) {
+        found -= j;
+        break;
+      }
+    }
+  }
+  std::chrono::duration<double, std::nano> strcmp_elapsed = Clock::now() - start;
+
+  std::unordered_map<Atom, int> atom_map;
+  std::unordered_map<std::string, int> string_map;
+  for (int i = 0; i < 8; ++i) {
+    atom_map[atoms[i]] = i;
+    string_map[strings[i]] = i;
+  }
+
+  start = Clock::now();
+  for (int i = 0; i < kCount; ++i) found += atom_map[atoms[i % 8]];
+  std::chrono::duration<double, std::nano> atom_map_elapsed = Clock::now() - start;
+
+  start = Clock::now();
+  for (int i = 0; i < kCount; ++i) found -= string_map[strings[i % 8]];
+  std::chrono::duration<double, std::nano> string_map_elapsed = Clock::now() - start;
+
+  std::cout << "Match 1 of 8 names, Atom: " << atom_elapsed.count() / kCount
+            << " ns, strcmp(): " << strcmp_elapsed.count() / kCount << " ns" << std::endl;
+  std::cout << "Hash map lookup, Atom: " << atom_map_elapsed.count() / kCount
+            << " ns, std::string: " << string_map_elapsed.count() / kCount << " ns" << std::endl;
+
+  ASSERT_EQ(0, found);
+}
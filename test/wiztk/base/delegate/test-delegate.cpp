@@ -6,6 +6,11 @@
 
 #include "wiztk/base/delegate.hpp"
 
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <vector>
+
 using namespace wiztk;
 using namespace wiztk::base;
 
@@ -258,3 +263,104 @@ TEST_F(TestDelegate, function_1) {
   // In this case, invoking d2 and d3 leads to the same result:
   ASSERT_TRUE(d3 != d2 && (d2(1, 1) == d3(1, 1)));
 }
+
+TEST_F(TestDelegate, callable_1) {
+  Mockup obj;
+  int offset = 10;
+
+  Delegate<int(int)> d = [&obj, offset](int x) -> int {
+    return obj.Foo(x) + offset;
+  };
+
+  ASSERT_TRUE(d.type() == kDelegateTypeCallable);
+  ASSERT_TRUE(d);
+  ASSERT_TRUE(11 == d(1));
+  ASSERT_TRUE(1 == obj.count());
+
+  // The captured values are copied:
+  offset = 20;
+  ASSERT_TRUE(12 == d(2));
+
+  Delegate<int(int)> d2 = d;
+  ASSERT_TRUE(d2 == d);
+  ASSERT_TRUE(13 == d2(3));
+
+  d.Reset();
+  ASSERT_FALSE(d);
+  ASSERT_TRUE(d.type() == kDelegateTypeUndefined);
+
+  // A lambda without capture list is stored as well:
+  auto d3 = Delegate<int(int, int)>::FromCallable([](int a, int b) -> int { return a * b; });
+  ASSERT_TRUE(d3.type() == kDelegateTypeCallable);
+  ASSERT_TRUE(6 == d3(2, 3));
+
+  ASSERT_TRUE(sizeof(Delegate<int(int)>) == sizeof(void *) * 2 + sizeof(&Mockup::Foo));
+}
+
+TEST_F(TestDelegate, callable_2) {
+  int count = 0;
+  Delegate<void()> d = [&count]() { ++count; };
+
+  // Outlives the lambda expression:
+  std::vector<Delegate<void()>> delegates(4, d);
+  for (const auto &i : delegates) i();
+  ASSERT_TRUE(4 == count);
+
+  // Re-assign to a static function:
+  Delegate<int(int, int)> d2 = [](int a, int b) -> int { return a - b; };
+  d2 = add;
+  ASSERT_TRUE(d2.type() == kDelegateTypeStatic);
+  ASSERT_TRUE(d2.EqualStatic(add));
+  ASSERT_TRUE(3 == d2(1, 2));
+}
+
+/**
+ * @brief Compare Delegate with std::function to store and invoke a lambda
+ * capturing 2 pointers, prints the cost per operation
+ */
+TEST_F(TestDelegate, benchmark_1) {
+  using Clock = std::chrono::steady_clock;
+
+  const int kCount = 1000;
+  const int kRounds = 10000;
+
+  long sum = 0;
+  long step = 1;
+  auto lambda = [&sum, &step](int x) { sum += x * step; };
+
+  std::vector<Delegate<void(int)>> delegates(kCount);
+  std::vector<std::function<void(int)>> functions(kCount);
+
+  auto start = Clock::now();
+  for (int i = 0; i < kRounds; ++i) {
+    for (auto &d : delegates) d = lambda;
+  }
+  std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+  std::cout << "Delegate construct: " << elapsed.count() / kRounds / kCount << " ns" << std::endl;
+
+  start = Clock::now();
+  for (int i = 0; i < kRounds; ++i) {
+    for (auto &f : functions) f = lambda;
+  }
+  elapsed = Clock::now() - start;
+  std::cout << "std::function construct: " << elapsed.count() / kRounds / kCount << " ns" << std::endl;
+
+  start = Clock::now();
+  for (int i = 0; i < kRounds; ++i) {
+    for (int j = 0; j < kCount; ++j) delegates[j](j);
+  }
+  elapsed = Clock::now() - start;
+  std::cout << "Delegate invoke: " << elapsed.count() / kRounds / kCount << " ns" << std::endl;
+
+  long expected = sum;
+  sum = 0;
+
+  start = Clock::now();
+  for (int i = 0; i < kRounds; ++i) {
+    for (int j = 0; j < kCount; ++j) functions[j](j);
+  }
+  elapsed = Clock::now() - start;
+  std::cout << "std::function invoke: " << elapsed.count() / kRounds / kCount << " ns" << std::endl;
+
+  ASSERT_EQ(expected, sum);
+}
@@ -5,6 +5,11 @@
 #include "test-deque.hpp"
 
 #include <wiztk/base/deque.hpp>
+#include <wiztk/base/counted-deque.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <vector>
 
 using namespace wiztk;
 using namespace wiztk::base;
@@ -26,6 +31,16 @@ class MyElement : public DequeNode<MyElement> {
 
 };
 
+class CountedElement : public CountedDequeNode<CountedElement> {
+
+ public:
+
+  CountedElement() = default;
+
+  ~CountedElement() final = default;
+
+};
+
 typedef std::function<void(BinodeBase *)> DeleterType;
 
 class MyDeque : public Deque<MyElement, DeleterType> {
@@ -369,3 +384,203 @@ TEST_F(TestDeque, clear_3) {
   delete item2;
   delete item3;
 }
+
+TEST_F(TestDeque, pop_1) {
+  MyElement item1(1);
+  MyElement item2(2);
+  MyElement item3(3);
+
+  MyDeque deque([](BinodeBase *obj) {});
+  deque.push_back(&item1);
+  deque.push_back(&item2);
+  deque.push_back(&item3);
+
+  ASSERT_TRUE(deque.pop_front() == &item1);
+  ASSERT_TRUE(deque.pop_back() == &item3);
+  ASSERT_TRUE(!item1.is_linked());
+  ASSERT_TRUE(!item3.is_linked());
+  ASSERT_TRUE(deque.pop_front() == &item2);
+
+  ASSERT_TRUE(deque.pop_front() == nullptr);
+  ASSERT_TRUE(deque.pop_back() == nullptr);
+  ASSERT_TRUE(deque.is_empty());
+}
+
+TEST_F(TestDeque, splice_1) {
+  MyElement item1(1);
+  MyElement item2(2);
+  MyElement item3(3);
+
+  MyDeque deque1([](BinodeBase *obj) {});
+  MyDeque deque2([](BinodeBase *obj) {});
+
+  // Splice an empty deque:
+  deque1.push_back(&item1);
+  deque1.splice_back(deque2);
+  ASSERT_TRUE(deque1.count() == 1);
+
+  deque2.push_back(&item2);
+  deque2.push_back(&item3);
+  deque1.splice_back(deque2);
+
+  ASSERT_TRUE(deque2.is_empty());
+  ASSERT_TRUE(deque1.count() == 3);
+  ASSERT_TRUE(deque1[0] == &item1 && deque1[1] == &item2 && deque1[2] == &item3);
+  ASSERT_TRUE(deque1.rbegin() == &item3);
+
+  // Splice into an empty deque:
+  deque2.splice_back(deque1);
+  ASSERT_TRUE(deque1.is_empty());
+  ASSERT_TRUE(deque1.begin() == deque1.end());
+  ASSERT_TRUE(deque2.count() == 3);
+  ASSERT_TRUE(item1.previous() == nullptr && item3.next() == nullptr);
+
+  deque2.clear();
+}
+
+TEST_F(TestDeque, swap_1) {
+  MyElement item1(1);
+  MyElement item2(2);
+  MyElement item3(3);
+
+  MyDeque deque1([](BinodeBase *obj) {});
+  MyDeque deque2([](BinodeBase *obj) {});
+
+  deque1.push_back(&item1);
+  deque1.push_back(&item2);
+  deque2.push_back(&item3);
+
+  deque1.swap(deque2);
+  ASSERT_TRUE(deque1.count() == 1 && deque1[0] == &item3);
+  ASSERT_TRUE(deque2.count() == 2 && deque2[0] == &item1 && deque2[1] == &item2);
+
+  // Swap with an empty deque:
+  MyDeque deque3([](BinodeBase *obj) {});
+  deque3.swap(deque2);
+  ASSERT_TRUE(deque2.is_empty());
+  ASSERT_TRUE(deque3.count() == 2);
+  ASSERT_TRUE(deque3.rbegin() == &item2);
+
+  // Unlinking a node still works after swapping:
+  item1.unlink();
+  ASSERT_TRUE(deque3.count() == 1 && deque3[0] == &item2);
+
+  deque1.clear();
+  deque3.clear();
+}
+
+TEST_F(TestDeque, remove_1) {
+  MyDeque deque;
+  for (int i = 0; i < 10; ++i) deque.push_back(new MyElement(i));
+
+  // Remove the odd ones while iterating:
+  MyDeque::Iterator it = deque.begin();
+  while (it != deque.end()) {
+    if (it->id() % 2) {
+      MyElement *element = it.get();
+      it.remove();
+      delete element;
+    } else {
+      ++it;
+    }
+  }
+
+  ASSERT_TRUE(deque.count() == 5);
+  for (int i = 0; i < 5; ++i) ASSERT_TRUE(deque[i]->id() == i * 2);
+
+  // Reverse:
+  MyDeque::ReverseIterator rit = deque.rbegin();
+  while (rit != deque.rend()) {
+    MyElement *element = rit.get();
+    rit.remove();
+    delete element;
+  }
+
+  ASSERT_TRUE(deque.is_empty());
+}
+
+/**
+ * @brief Drain a queue of 1000 nodes by re-reading begin() or by swapping,
+ * and compare count() with CountedDeque, prints the cost per node
+ */
+TEST_F(TestDeque, benchmark_1) {
+  using Clock = std::chrono::steady_clock;
+
+  const int kCount = 1000;
+  const int kRounds = 1000;
+
+  std::vector<MyElement *> elements;
+  for (int i = 0; i < kCount; ++i) elements.push_back(new MyElement(i));
+
+  Deque<MyElement, DeleterType> queue([](BinodeBase *obj) {});
+  Deque<MyElement, DeleterType> local([](BinodeBase *obj) {});
+  long sum = 0;
+
+  auto start = Clock::now();
+  for (int i = 0; i < kRounds; ++i) {
+    for (MyElement *element : elements) queue.push_back(element);
+    Deque<MyElement, DeleterType>::Iterator it = queue.begin();
+    while (it != queue.end()) {
+      MyElement *element = it.get();
+      it.remove();
+      sum += element->id();
+      it = queue.begin();
+    }
+  }
+  std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+  std::cout << "Drain by begin() and remove(): " << elapsed.count() / kRounds / kCount << " ns" << std::endl;
+
+  long expected = sum;
+  sum = 0;
+
+  start = Clock::now();
+  for (int i = 0; i < kRounds; ++i) {
+    for (MyElement *element : elements) queue.push_back(element);
+    local.swap(queue);
+    while (MyElement *element = local.pop_front()) sum += element->id();
+  }
+  elapsed = Clock::now() - start;
+  std::cout << "Drain by swap() and pop_front(): " << elapsed.count() / kRounds / kCount << " ns" << std::endl;
+  ASSERT_EQ(expected, sum);
+
+  // Join 2 queues:
+  for (MyElement *element : elements) queue.push_back(element);
+  start = Clock::now();
+  for (int i = 0; i < kRounds; ++i) {
+    local.splice_back(queue);
+    queue.splice_back(local);
+  }
+  elapsed = Clock::now() - start;
+  std::cout << "splice_back() " << kCount << " nodes: " << elapsed.count() / kRounds / 2 << " ns" << std::endl;
+  ASSERT_TRUE(queue.count() == kCount);
+  queue.clear();
+
+  // count() walks the nodes, CountedDeque keeps it:
+  for (MyElement *element : elements) queue.push_back(element);
+  size_t count = 0;
+  start = Clock::now();
+  for (int i = 0; i < kRounds; ++i) count += queue.count();
+  elapsed = Clock::now() - start;
+  std::cout << "Deque::count() of " << kCount << " nodes: " << elapsed.count() / kRounds << " ns" << std::endl;
+  ASSERT_EQ(kCount * kRounds, count);
+  queue.clear();
+
+  std::vector<CountedElement *> counted_elements;
+  CountedDeque<CountedElement> counted_queue;
+  for (int i = 0; i < kCount; ++i) {
+    counted_elements.push_back(new CountedElement);
+    counted_queue.push_back(counted_elements.back());
+  }
+  count = 0;
+  start = Clock::now();
+  for (int i = 0; i < kRounds; ++i) count += counted_queue.count();
+  elapsed = Clock::now() - start;
+  std::cout << "CountedDeque::count() of " << kCount << " nodes: " << elapsed.count() / kRounds << " ns" << std::endl;
+  ASSERT_EQ(kCount * kRounds, count);
+
+  std::cout << "Node size: " << sizeof(MyElement) << " bytes in Deque, "
+            << sizeof(CountedElement) << " bytes in CountedDeque" << std::endl;
+
+  counted_queue.clear([](CountedDequeNodeBase *obj) { delete obj; });
+  for (MyElement *element : elements) delete element;
+}
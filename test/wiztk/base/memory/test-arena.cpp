@@ -0,0 +1,207 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "test-arena.hpp"
+
+#include "wiztk/base/memory/arena.hpp"
+#include "wiztk/base/memory/allocation-counter.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using namespace wiztk;
+using namespace wiztk::base;
+using namespace wiztk::base::memory;
+
+/**
+ * @brief Records the order of destruction
+ */
+class Tracked {
+
+ public:
+
+  Tracked(std::vector<int> *log, int id)
+      : log_(log), id_(id) {}
+
+  ~Tracked() { log_->push_back(id_); }
+
+ private:
+
+  std::vector<int> *log_;
+
+  int id_;
+
+};
+
+struct Vertex {
+
+  float x = 0.f;
+
+  float y = 0.f;
+
+};
+
+TEST_F(TestArena, allocate_1) {
+  Arena arena(256);
+  ASSERT_EQ(0, arena.GetCapacity());
+  ASSERT_EQ(0, arena.GetUsedSize());
+
+  const size_t alignments[] = {1, 2, 4, 8, 16, 32, 64};
+  for (size_t alignment : alignments) {
+    void *memory = arena.Allocate(3, alignment);
+    ASSERT_EQ(0, reinterpret_cast<uintptr_t>(memory) % alignment);
+  }
+
+  ASSERT_EQ(256, arena.GetCapacity());
+  ASSERT_GE(arena.GetUsedSize(), 7 * 3);
+}
+
+TEST_F(TestArena, allocate_2) {
+  Arena arena(256);
+
+  // Larger than a chunk:
+  char *large = static_cast<char *>(arena.Allocate(1000, 1));
+  for (int i = 0; i < 1000; ++i) large[i] = 'a';
+  ASSERT_GE(arena.GetCapacity(), 1000);
+
+  // Then back to normal chunks:
+  void *small = arena.Allocate(16);
+  ASSERT_TRUE(nullptr != small);
+  ASSERT_EQ('a', large[999]);
+}
+
+TEST_F(TestArena, new_1) {
+  std::vector<int> log;
+  Arena arena;
+
+  arena.New<Tracked>(&log, 1);
+  arena.New<Tracked>(&log, 2);
+  arena.New<Tracked>(&log, 3);
+  ASSERT_TRUE(log.empty());
+
+  arena.Reset();
+  ASSERT_EQ(3, log.size());
+  ASSERT_EQ(3, log[0]);
+  ASSERT_EQ(2, log[1]);
+  ASSERT_EQ(1, log[2]);
+
+  // The arena destroys the objects left:
+  {
+    Arena another;
+    another.New<Tracked>(&log, 4);
+  }
+  ASSERT_EQ(4, log.back());
+}
+
+TEST_F(TestArena, new_2) {
+  Arena arena;
+
+  float *array = arena.NewArray<float>(8);
+  for (int i = 0; i < 8; ++i) ASSERT_EQ(0.f, array[i]);
+
+  Vertex *vertices = arena.NewArray<Vertex>(3);
+  ASSERT_EQ(0, reinterpret_cast<uintptr_t>(vertices) % alignof(Vertex));
+  ASSERT_EQ(0.f, vertices[2].y);
+}
+
+TEST_F(TestArena, reset_1) {
+  Arena arena(1024);
+
+  // The first frame grows the arena:
+  for (int i = 0; i < 100; ++i) arena.Allocate(100);
+  size_t capacity = arena.GetCapacity();
+  ASSERT_GE(capacity, 100 * 100);
+
+  // Later frames of the same size reuse the chunks:
+  for (int frame = 0; frame < 10; ++frame) {
+    arena.Reset();
+    ASSERT_EQ(0, arena.GetUsedSize());
+
+    size_t allocation_count = AllocationCounter::GetCount();
+    for (int i = 0; i < 100; ++i) arena.Allocate(100);
+    ASSERT_EQ(allocation_count, AllocationCounter::GetCount());
+  }
+
+  ASSERT_EQ(capacity, arena.GetCapacity());
+}
+
+TEST_F(TestArena, allocator_1) {
+  Arena arena;
+
+  std::vector<Vertex, ArenaAllocator<Vertex>> vertices((ArenaAllocator<Vertex>(&arena)));
+  for (int i = 0; i < 100; ++i) {
+    Vertex vertex;
+    vertex.x = i;
+    vertices.push_back(vertex);
+  }
+
+  ASSERT_EQ(100, vertices.size());
+  ASSERT_EQ(99.f, vertices.back().x);
+  ASSERT_TRUE(ArenaAllocator<int>(&arena) == vertices.get_allocator());
+}
+
+TEST_F(TestArena, counter_1) {
+  size_t allocation_count = AllocationCounter::GetCount();
+  std::unique_ptr<int> value(new int(1));
+
+  if (AllocationCounter::IsEnabled()) {
+    ASSERT_EQ(allocation_count + 1, AllocationCounter::GetCount());
+  } else {
+    ASSERT_EQ(0, AllocationCounter::GetCount());
+  }
+}
+
+/**
+ * @brief Create and destroy objects of a frame with the arena and the heap
+ */
+TEST_F(TestArena, benchmark_1) {
+  using Clock = std::chrono::steady_clock;
+
+  const int kFrames = 1000;
+  const int kObjects = 1000;
+
+  std::vector<int> log;
+  log.reserve(kObjects);
+
+  Arena arena;
+  std::chrono::duration<double, std::nano> arena_elapsed(0);
+  for (int frame = 0; frame < kFrames; ++frame) {
+    log.clear();
+    auto start = Clock::now();
+    for (int i = 0; i < kObjects; ++i) arena.New<Tracked>(&log, i);
+    arena.Reset();
+    arena_elapsed += Clock::now() - start;
+  }
+
+  std::vector<std::unique_ptr<Tracked>> objects;
+  objects.reserve(kObjects);
+  std::chrono::duration<double, std::nano> heap_elapsed(0);
+  for (int frame = 0; frame < kFrames; ++frame) {
+    log.clear();
+    auto start = Clock::now();
+    for (int i = 0; i < kObjects; ++i) objects.emplace_back(new Tracked(&log, i));
+    objects.clear();
+    heap_elapsed += Clock::now() - start;
+  }
+
+  std::cout << "Arena: " << arena_elapsed.count() / (kFrames * kObjects) << " ns per object" << std::endl;
+  std::cout << "new/delete: " << heap_elapsed.count() / (kFrames * kObjects) << " ns per object" << std::endl;
+
+  ASSERT_EQ(kObjects, log.size());
+}
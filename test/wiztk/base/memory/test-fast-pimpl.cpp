@@ -0,0 +1,205 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "test-fast-pimpl.hpp"
+
+#include "wiztk/base/memory/fast-pimpl.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+
+using namespace wiztk;
+using namespace wiztk::base;
+using namespace wiztk::base::memory;
+
+/**
+ * @brief A value type with inline private data, like graphics::Paint
+ */
+class Inline {
+
+ public:
+
+  struct Private;
+
+  Inline();
+
+  Inline(const Inline &other);
+
+  ~Inline();
+
+  Inline &operator=(const Inline &other);
+
+  int GetValue() const;
+
+  void SetValue(int value);
+
+  static int kCount;
+
+ private:
+
+  FastPimpl<Private, 32> p_;
+
+};
+
+/**
+ * @brief The same value type with private data on the heap
+ */
+class Heap {
+
+ public:
+
+  struct Private;
+
+  Heap();
+
+  Heap(const Heap &other);
+
+  ~Heap();
+
+  Heap &operator=(const Heap &other);
+
+  int GetValue() const;
+
+  void SetValue(int value);
+
+ private:
+
+  std::unique_ptr<Private> p_;
+
+};
+
+struct Inline::Private {
+
+  Private() { ++kCount; }
+
+  Private(const Private &other)
+      : value(other.value) { ++kCount; }
+
+  ~Private() { --kCount; }
+
+  Private &operator=(const Private &) = default;
+
+  int value = 0;
+
+  double data[3] = {};
+
+};
+
+int Inline::kCount = 0;
+
+Inline::Inline() = default;
+
+Inline::Inline(const Inline &other) = default;
+
+Inline::~Inline() = default;
+
+Inline &Inline::operator=(const Inline &other) = default;
+
+int Inline::GetValue() const {
+  return p_->value;
+}
+
+void Inline::SetValue(int value) {
+  p_->value = value;
+}
+
+struct Heap::Private {
+
+  int value = 0;
+
+  double data[3] = {};
+
+};
+
+Heap::Heap() {
+  p_ = std::make_unique<Private>();
+}
+
+Heap::Heap(const Heap &other) {
+  p_ = std::make_unique<Private>(*other.p_);
+}
+
+Heap::~Heap() = default;
+
+Heap &Heap::operator=(const Heap &other) {
+  *p_ = *other.p_;
+  return *this;
+}
+
+int Heap::GetValue() const {
+  return p_->value;
+}
+
+void Heap::SetValue(int value) {
+  p_->value = value;
+}
+
+TEST_F(TestFastPimpl, construct_1) {
+  {
+    Inline a;
+    a.SetValue(1);
+    ASSERT_EQ(1, Inline::kCount);
+
+    Inline b(a);
+    ASSERT_EQ(1, b.GetValue());
+    ASSERT_EQ(2, Inline::kCount);
+
+    Inline c;
+    c = b;
+    ASSERT_EQ(1, c.GetValue());
+    ASSERT_EQ(3, Inline::kCount);
+
+    c.SetValue(2);
+    ASSERT_EQ(1, a.GetValue());
+  }
+
+  ASSERT_EQ(0, Inline::kCount);
+}
+
+/**
+ * @brief Construct and copy the inline and the heap version
+ */
+TEST_F(TestFastPimpl, benchmark_1) {
+  using Clock = std::chrono::steady_clock;
+
+  const int kCount = 1000000;
+  long sum = 0;
+
+  auto start = Clock::now();
+  for (int i = 0; i < kCount; ++i) {
+    Inline a;
+    a.SetValue(i);
+    Inline b(a);
+    sum += b.GetValue();
+  }
+  std::chrono::duration<double, std::nano> inline_elapsed = Clock::now() - start;
+
+  start = Clock::now();
+  for (int i = 0; i < kCount; ++i) {
+    Heap a;
+    a.SetValue(i);
+    Heap b(a);
+    sum -= b.GetValue();
+  }
+  std::chrono::duration<double, std::nano> heap_elapsed = Clock::now() - start;
+
+  std::cout << "FastPimpl: " << inline_elapsed.count() / kCount << " ns per construct and copy" << std::endl;
+  std::cout << "std::unique_ptr: " << heap_elapsed.count() / kCount << " ns per construct and copy"
+            << std::endl;
+
+  ASSERT_EQ(0, sum);
+}
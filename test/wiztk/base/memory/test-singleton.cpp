@@ -18,6 +18,12 @@
 
 #include "wiztk/base/memory/singleton.hpp"
 
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
 using namespace wiztk;
 using namespace wiztk::base;
 using namespace wiztk::base::memory;
@@ -64,3 +70,96 @@ TEST_F(TestSingleton, construct_2) {
   ASSERT_TRUE(MySingleton::GetInstance() != nullptr);
   MySingleton::ReleaseInstance();
 }
+
+/**
+ * @brief A singleton which counts its constructions and is slow to create
+ */
+class SlowSingleton {
+
+  friend struct LeakySingletonTraits<SlowSingleton>;
+  friend struct DefaultSingletonTraits<SlowSingleton>;
+  friend class Singleton<SlowSingleton, LeakySingletonTraits<SlowSingleton>>;
+
+ public:
+
+  static SlowSingleton *GetInstance();
+
+  static SlowSingleton *GetOrCreateInstance();
+
+  static void ReleaseInstance();
+
+  static std::atomic<int> kCount;
+
+ private:
+
+  SlowSingleton() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ++kCount;
+  }
+
+  ~SlowSingleton() = default;
+
+};
+
+std::atomic<int> SlowSingleton::kCount(0);
+
+SlowSingleton *SlowSingleton::GetInstance() {
+  return Singleton<SlowSingleton, LeakySingletonTraits<SlowSingleton>>::get();
+}
+
+SlowSingleton *SlowSingleton::GetOrCreateInstance() {
+  return Singleton<SlowSingleton, LeakySingletonTraits<SlowSingleton>>::get_or_create();
+}
+
+void SlowSingleton::ReleaseInstance() {
+  Singleton<SlowSingleton, LeakySingletonTraits<SlowSingleton>>::release();
+}
+
+TEST_F(TestSingleton, thread_1) {
+  const int kThreads = 8;
+  std::vector<SlowSingleton *> instances(kThreads, nullptr);
+  std::vector<std::thread> threads;
+
+  for (int i = 0; i < kThreads; ++i) {
+    threads.emplace_back([i, &instances]() {
+      instances[i] = SlowSingleton::GetOrCreateInstance();
+    });
+  }
+  for (std::thread &thread : threads) thread.join();
+
+  ASSERT_EQ(1, SlowSingleton::kCount);
+  for (SlowSingleton *instance : instances) {
+    ASSERT_EQ(SlowSingleton::GetInstance(), instance);
+  }
+
+  // Create again after release:
+  SlowSingleton::ReleaseInstance();
+  ASSERT_TRUE(nullptr == SlowSingleton::GetInstance());
+  ASSERT_TRUE(nullptr != SlowSingleton::GetOrCreateInstance());
+  ASSERT_EQ(2, SlowSingleton::kCount);
+
+  // Left to leak at exit:
+  SlowSingleton::GetOrCreateInstance();
+}
+
+/**
+ * @brief The cost of getting an existing instance
+ */
+TEST_F(TestSingleton, benchmark_1) {
+  using Clock = std::chrono::steady_clock;
+
+  const int kCount = 10000000;
+  MySingleton *instance = MySingleton::GetOrCreateInstance();
+  int found = 0;
+
+  auto start = Clock::now();
+  for (int i = 0; i < kCount; ++i) {
+    if (MySingleton::GetOrCreateInstance() == instance) ++found;
+  }
+  std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+
+  std::cout << "GetOrCreateInstance(): " << elapsed.count() / kCount << " ns" << std::endl;
+
+  ASSERT_EQ(kCount, found);
+  MySingleton::ReleaseInstance();
+}
@@ -6,6 +6,10 @@
 
 #include <wiztk/base/object.hpp>
 
+#include <chrono>
+#include <iostream>
+#include <vector>
+
 using namespace wiztk;
 
 class TestableObject : public Object {
@@ -24,6 +28,20 @@ class TestableObject : public Object {
 
   inline void clear_children() { ClearChildren(); }
 
+  inline Object *remove_child(TestableObject *obj) { return RemoveChild(obj); }
+
+  inline Object *get_child_at(int index) const { return GetChildAt(index); }
+
+  inline int get_index() const { return index(); }
+
+  using Object::SwapIndex;
+  using Object::InsertSiblingBefore;
+  using Object::InsertSiblingAfter;
+  using Object::MoveToFirst;
+  using Object::MoveToLast;
+  using Object::MoveForward;
+  using Object::MoveBackward;
+
   inline Object *get_previous() const { return previous(); }
 
   inline Object *get_next() const { return next(); }
@@ -261,4 +279,102 @@ TEST_F(Test, clear_managed_objects_1) {
   manager.ClearSubjects();
 
   ASSERT_TRUE(manager.subjects_count() == 0);
-}
\ No newline at end of file
+}
+/**
+ * @brief Check the order of children in both the array and the links
+ */
+static bool CheckOrder(const TestableObject &parent, const std::vector<TestableObject *> &expected) {
+  if (parent.get_children_count() != expected.size()) return false;
+
+  Object *previous = nullptr;
+  for (size_t i = 0; i < expected.size(); ++i) {
+    TestableObject *child = expected[i];
+    if (parent.get_child_at(static_cast<int>(i)) != child) return false;
+    if (child->get_index() != static_cast<int>(i)) return false;
+    if (child->get_previous() != previous) return false;
+    previous = child;
+  }
+
+  return parent.get_first_child() == expected.front() &&
+      parent.get_last_child() == expected.back() &&
+      nullptr == expected.back()->get_next();
+}
+
+TEST_F(Test, index_1) {
+  TestableObject parent;
+  TestableObject *child1 = new TestableObject;
+  TestableObject *child2 = new TestableObject;
+  TestableObject *child3 = new TestableObject;
+  TestableObject *child4 = new TestableObject;
+
+  parent.push_back_child(child1);
+  parent.push_back_child(child2);
+  parent.push_back_child(child3);
+  parent.push_back_child(child4);
+  ASSERT_TRUE(CheckOrder(parent, {child1, child2, child3, child4}));
+  ASSERT_TRUE(parent.get_child_at(-1) == child4);
+  ASSERT_TRUE(parent.get_child_at(4) == nullptr);
+
+  TestableObject::SwapIndex(child1, child3);
+  ASSERT_TRUE(CheckOrder(parent, {child3, child2, child1, child4}));
+
+  TestableObject::MoveToLast(child3);
+  ASSERT_TRUE(CheckOrder(parent, {child2, child1, child4, child3}));
+
+  TestableObject::MoveToFirst(child4);
+  ASSERT_TRUE(CheckOrder(parent, {child4, child2, child1, child3}));
+
+  TestableObject::MoveForward(child4);
+  ASSERT_TRUE(CheckOrder(parent, {child2, child4, child1, child3}));
+
+  TestableObject::MoveBackward(child3);
+  ASSERT_TRUE(CheckOrder(parent, {child2, child4, child3, child1}));
+
+  TestableObject::InsertSiblingBefore(child4, child1);
+  ASSERT_TRUE(CheckOrder(parent, {child2, child1, child4, child3}));
+
+  TestableObject::InsertSiblingAfter(child3, child2);
+  ASSERT_TRUE(CheckOrder(parent, {child1, child4, child3, child2}));
+
+  parent.remove_child(child4);
+  ASSERT_TRUE(CheckOrder(parent, {child1, child3, child2}));
+  ASSERT_TRUE(child4->get_index() == -1);
+  delete child4;
+
+  parent.insert_child(child4 = new TestableObject, -2);
+  ASSERT_TRUE(CheckOrder(parent, {child1, child3, child4, child2}));
+
+  parent.clear_children();
+  ASSERT_TRUE(parent.get_children_count() == 0);
+}
+
+/**
+ * @brief Access children by index, prints the cost per access
+ */
+TEST_F(Test, benchmark_1) {
+  using Clock = std::chrono::steady_clock;
+
+  const int kCount = 10000;
+
+  TestableObject parent;
+  for (int i = 0; i < kCount; ++i) parent.push_back_child(new TestableObject);
+
+  auto start = Clock::now();
+  size_t sum = 0;
+  for (int i = 0; i < kCount; ++i) {
+    sum += static_cast<size_t>(static_cast<TestableObject *>(parent.get_child_at(i))->get_index());
+  }
+  std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+  ASSERT_EQ(static_cast<size_t>(kCount) * (kCount - 1) / 2, sum);
+  std::cout << kCount << " children, GetChildAt(): " << elapsed.count() / kCount << " ns" << std::endl;
+
+  start = Clock::now();
+  for (int i = 0; i < 1000; ++i) parent.insert_child(new TestableObject, kCount / 2);
+  elapsed = Clock::now() - start;
+  std::cout << kCount << " children, InsertChild() in the middle: " << elapsed.count() / 1000 << " ns" << std::endl;
+
+  start = Clock::now();
+  parent.clear_children();
+  elapsed = Clock::now() - start;
+  std::cout << kCount + 1000 << " children, ClearChildren(): " << elapsed.count() / 1e6 << " ms" << std::endl;
+}
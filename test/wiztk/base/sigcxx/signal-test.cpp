@@ -0,0 +1,318 @@
+#include "wiztk/base/sigcxx.hpp"
+
+#include "signal-test.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace wiztk;
+using namespace wiztk::base;
+
+/**
+ * @brief A quiet observer which sums the values it receives
+ */
+class Counter : public Trackable {
+
+ public:
+
+  Counter() = default;
+
+  ~Counter() final = default;
+
+  void OnAdd(int value, __SLOT__) { sum += value; }
+
+  void OnSub(int value, __SLOT__) { sum -= value; }
+
+  long sum = 0;
+
+};
+
+TEST_F(SignalTest, disconnect_1) {
+  Signal<int> signal;
+  Signal<int> chained;
+  Counter counter;
+
+  signal.Connect(&counter, &Counter::OnAdd);
+  signal.Connect(chained);
+  signal.Connect(&counter, &Counter::OnSub);
+  signal.Connect(&counter, &Counter::OnAdd);
+  chained.Connect(&counter, &Counter::OnAdd);
+
+  ASSERT_EQ(2, signal.CountConnections(&counter, &Counter::OnAdd));
+  ASSERT_EQ(1, signal.CountConnections(chained));
+  ASSERT_TRUE(signal.IsConnectedTo(&counter, &Counter::OnSub));
+
+  signal.Emit(1);
+  ASSERT_EQ(2, counter.sum);
+
+  // Only the tokens of the given kind are disconnected:
+  ASSERT_EQ(1, signal.Disconnect(chained));
+  ASSERT_EQ(0, signal.Disconnect(chained));
+  ASSERT_EQ(2, signal.Disconnect(&counter, &Counter::OnAdd, 0, -1));
+  ASSERT_FALSE(signal.IsConnectedTo(&counter, &Counter::OnAdd));
+  ASSERT_EQ(1, signal.CountConnections());
+
+  signal.DisconnectAll(&counter, &Counter::OnSub);
+  ASSERT_EQ(0, signal.CountConnections());
+  ASSERT_EQ(1, chained.CountConnections());
+}
+
+TEST_F(SignalTest, node_pool_1) {
+  Signal<int> signal;
+  Counter counter;
+
+  // Fill the cache of this thread:
+  for (int i = 0; i < 11; ++i) signal.Connect(&counter, &Counter::OnAdd);
+  signal.DisconnectAll();
+
+  size_t cached = internal::NodePool::GetCachedCount();
+  ASSERT_GE(cached, 22);
+
+  // A token and a binding are taken from the cache for each connection:
+  for (int i = 0; i < 10; ++i) signal.Connect(&counter, &Counter::OnAdd);
+  ASSERT_EQ(cached - 20, internal::NodePool::GetCachedCount());
+
+  // And returned when the observer is destroyed:
+  {
+    Counter observer;
+    signal.Connect(&observer, &Counter::OnAdd);
+    ASSERT_EQ(cached - 22, internal::NodePool::GetCachedCount());
+  }
+  ASSERT_EQ(cached - 20, internal::NodePool::GetCachedCount());
+
+  signal.Emit(1);
+  ASSERT_EQ(10, counter.sum);
+}
+
+/**
+ * @brief An observer which records the cached nodes when destroyed
+ */
+class ExitCounter : public Trackable {
+
+ public:
+
+  ExitCounter() = default;
+
+  ~ExitCounter() final {
+    kCachedCount = internal::NodePool::GetCachedCount();
+  }
+
+  void OnAdd(int value, __SLOT__) { sum += value; }
+
+  long sum = 0;
+
+  static size_t kCachedCount;
+
+};
+
+size_t ExitCounter::kCachedCount = 0;
+
+TEST_F(SignalTest, node_pool_2) {
+  // Destroyed at exit, after the free lists of the main thread:
+  static Signal<int> kSignal;
+  static Counter kCounter;
+  kSignal.Connect(&kCounter, &Counter::OnAdd);
+
+  long sum = 0;
+  ExitCounter::kCachedCount = 1;
+
+  std::thread thread([&sum]() {
+    // Constructed before the free lists of this thread, so destroyed after them:
+    thread_local Signal<int> signal;
+    thread_local ExitCounter counter;
+
+    for (int i = 0; i < 10; ++i) signal.Connect(&counter, &ExitCounter::OnAdd);
+    signal.DisconnectAll();
+    ASSERT_GE(internal::NodePool::GetCachedCount(), 20);
+
+    signal.Connect(&counter, &ExitCounter::OnAdd);
+    signal.Emit(1);
+    sum = counter.sum;
+  });
+  thread.join();
+
+  // The nodes were freed to the heap, not to the destroyed free lists:
+  ASSERT_EQ(1, sum);
+  ASSERT_EQ(0, ExitCounter::kCachedCount);
+}
+
+/**
+ * @brief An observer which changes the connections when called
+ */
+class Mutator : public Trackable {
+
+ public:
+
+  Mutator() = default;
+
+  ~Mutator() final = default;
+
+  void OnUnbind(int value, __SLOT__) {
+    log.push_back(value);
+    UnbindSignal(slot);
+  }
+
+  void OnConnect(int value, __SLOT__) {
+    log.push_back(value);
+    if (nullptr != signal) signal->Connect(this, &Mutator::OnLog);
+  }
+
+  void OnDisconnectNext(int value, __SLOT__) {
+    log.push_back(value);
+    if (nullptr != next) signal->DisconnectAll(next, &Mutator::OnLog);
+  }
+
+  void OnDeleteSignal(int value, __SLOT__) {
+    log.push_back(value);
+    delete signal;
+    signal = nullptr;
+  }
+
+  void OnEmitAgain(int value, __SLOT__) {
+    log.push_back(value);
+    if (value > 0) signal->Emit(value - 1);
+  }
+
+  void OnLog(int value, __SLOT__) {
+    log.push_back(value);
+  }
+
+  Signal<int> *signal = nullptr;
+
+  Mutator *next = nullptr;
+
+  std::vector<int> log;
+
+};
+
+TEST_F(SignalTest, emit_unbind_1) {
+  // Both the inline buffer and the token list:
+  for (int count : {3, 8}) {
+    Signal<int> signal;
+    std::vector<Mutator> mutators(static_cast<size_t>(count));
+
+    for (int i = 0; i < count; ++i) {
+      signal.Connect(&mutators[i], (i % 2) ? &Mutator::OnUnbind : &Mutator::OnLog);
+    }
+
+    signal.Emit(1);
+    signal.Emit(2);
+
+    for (int i = 0; i < count; ++i) {
+      if (i % 2) {
+        ASSERT_EQ(std::vector<int>({1}), mutators[i].log);
+      } else {
+        ASSERT_EQ(std::vector<int>({1, 2}), mutators[i].log);
+      }
+    }
+    ASSERT_EQ((count + 1) / 2, signal.CountConnections());
+  }
+}
+
+TEST_F(SignalTest, emit_connect_1) {
+  Signal<int> signal;
+  Mutator first;
+  Mutator second;
+  Mutator last;
+
+  first.signal = &signal;
+  first.next = &last;
+  signal.Connect(&first, &Mutator::OnConnect);
+  signal.Connect(&second, &Mutator::OnDisconnectNext);
+  signal.Connect(&last, &Mutator::OnLog);
+
+  // The new connection is called in the same emission:
+  signal.Emit(1);
+  ASSERT_EQ(std::vector<int>({1, 1}), first.log);
+  ASSERT_EQ(std::vector<int>({1}), last.log);
+  ASSERT_EQ(4, signal.CountConnections());
+
+  // The last one is disconnected before it's called:
+  second.signal = &signal;
+  second.next = &last;
+  signal.Emit(2);
+  ASSERT_EQ(std::vector<int>({1}), last.log);
+  ASSERT_EQ(std::vector<int>({1, 1, 2, 2, 2}), first.log);
+  ASSERT_EQ(4, signal.CountConnections());
+}
+
+TEST_F(SignalTest, emit_nested_1) {
+  Signal<int> signal;
+  Mutator mutator;
+  Mutator other;
+
+  mutator.signal = &signal;
+  signal.Connect(&mutator, &Mutator::OnEmitAgain);
+  signal.Connect(&other, &Mutator::OnUnbind);
+
+  // The nested emission unbinds 'other', the outer one does not call it again:
+  signal.Emit(2);
+  ASSERT_EQ(std::vector<int>({2, 1, 0}), mutator.log);
+  ASSERT_EQ(std::vector<int>({0}), other.log);
+  ASSERT_EQ(1, signal.CountConnections());
+}
+
+TEST_F(SignalTest, emit_delete_1) {
+  for (int count : {2, 8}) {
+    auto *signal = new Signal<int>;
+    std::vector<Mutator> mutators(static_cast<size_t>(count));
+
+    mutators[0].signal = signal;
+    signal->Connect(&mutators[0], &Mutator::OnDeleteSignal);
+    for (int i = 1; i < count; ++i) signal->Connect(&mutators[i], &Mutator::OnLog);
+
+    // Stops at once:
+    signal->Emit(1);
+    ASSERT_EQ(nullptr, mutators[0].signal);
+    for (int i = 1; i < count; ++i) {
+      ASSERT_TRUE(mutators[i].log.empty());
+      ASSERT_EQ(0, mutators[i].CountSignalBindings());
+    }
+  }
+}
+
+/**
+ * @brief Connect, disconnect and emit in rounds, prints the cost of each
+ * operation
+ */
+TEST_F(SignalTest, benchmark_1) {
+  using Clock = std::chrono::steady_clock;
+
+  const int kConnections = 1000;
+  const int kRounds = 100;
+  const int kEmits = 1000000;
+
+  Signal<int> signal;
+  Counter counter;
+  std::chrono::duration<double, std::nano> connect(0);
+  std::chrono::duration<double, std::nano> disconnect(0);
+
+  for (int i = 0; i < kRounds; ++i) {
+    auto start = Clock::now();
+    for (int j = 0; j < kConnections; ++j) signal.Connect(&counter, &Counter::OnAdd);
+    auto middle = Clock::now();
+    for (int j = 0; j < kConnections; ++j) signal.Disconnect(&counter, &Counter::OnAdd);
+    auto end = Clock::now();
+
+    connect += middle - start;
+    disconnect += end - middle;
+  }
+  ASSERT_EQ(0, signal.CountConnections());
+  std::cout << "Connect(): " << connect.count() / (kConnections * kRounds) << " ns" << std::endl;
+  std::cout << "Disconnect(): " << disconnect.count() / (kConnections * kRounds) << " ns" << std::endl;
+
+  // 1 and 4 slots are called from the inline buffer, 8 from the tokens:
+  for (int slots : {1, 4, 8}) {
+    signal.DisconnectAll();
+    counter.sum = 0;
+    for (int i = 0; i < slots; ++i) signal.Connect(&counter, &Counter::OnAdd);
+
+    auto start = Clock::now();
+    for (int i = 0; i < kEmits; ++i) signal.Emit(1);
+    std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+    std::cout << "Emit() to " << slots << " slots: " << elapsed.count() / kEmits << " ns" << std::endl;
+    ASSERT_EQ(static_cast<long>(slots) * kEmits, counter.sum);
+  }
+}
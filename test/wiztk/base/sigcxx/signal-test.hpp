@@ -0,0 +1,22 @@
+#ifndef WIZTK_TEST_BASE_SIGCXX_SIGNAL_HPP_
+#define WIZTK_TEST_BASE_SIGCXX_SIGNAL_HPP_
+
+#include <gtest/gtest.h>
+
+class SignalTest : public testing::Test {
+
+ public:
+
+  SignalTest() = default;
+
+  ~SignalTest() override = default;
+
+ protected:
+
+  void SetUp() final {}
+
+  void TearDown() final {}
+
+};
+
+#endif // WIZTK_TEST_BASE_SIGCXX_SIGNAL_HPP_
@@ -4,10 +4,12 @@
 
 #include "test-string.hpp"
 
+#include <chrono>
 #include <iostream>
 #include "wiztk/base/string.hpp"
 
 #include <unicode/unistr.h>
+#include <unicode/stringpiece.h>
 
 using namespace wiztk;
 using namespace wiztk::base;
@@ -23,3 +25,115 @@ TEST_F(TestString, print_1) {
 
   ASSERT_TRUE(true);
 }
+
+TEST_F(TestString, construct_1) {
+  String empty;
+  ASSERT_TRUE(empty.empty());
+
+  String ascii("Hello World!");
+  ASSERT_EQ(12, ascii.size());
+  ASSERT_EQ(12, ascii.CountCodePoints());
+  ASSERT_STREQ("Hello World!", ascii.c_str());
+
+  String utf8("汉字 Ünïcödé 😀");
+  ASSERT_EQ(12, utf8.CountCodePoints());
+  ASSERT_EQ(std::string("汉字 Ünïcödé 😀"), utf8.ToUTF8());
+
+  // The same text from UTF-16 and UTF-32:
+  ASSERT_TRUE(utf8 == String(u"汉字 Ünïcödé 😀"));
+  ASSERT_TRUE(utf8 == String(U"汉字 Ünïcödé 😀"));
+}
+
+TEST_F(TestString, construct_2) {
+  // Invalid sequences are replaced with U+FFFD:
+  String truncated("ab\xE6\xB1");
+  ASSERT_EQ(std::string("ab\xEF\xBF\xBD"), truncated.ToUTF8());
+
+  String overlong("\xC0\xAF" "a");
+  ASSERT_EQ(std::string("\xEF\xBF\xBD\xEF\xBF\xBD" "a"), overlong.ToUTF8());
+
+  String surrogate("\xED\xA0\x80");
+  ASSERT_EQ(3, surrogate.CountCodePoints());
+
+  String lone(u"a\xD800" "b");
+  ASSERT_EQ(std::string("a\xEF\xBF\xBD" "b"), lone.ToUTF8());
+
+  String beyond(U"\x110000");
+  ASSERT_EQ(std::string("\xEF\xBF\xBD"), beyond.ToUTF8());
+}
+
+TEST_F(TestString, valid_1) {
+  const char *valid[] = {
+      "", "abc", "\xC2\x80", "\xDF\xBF", "\xE0\xA0\x80", "\xED\x9F\xBF", "\xEE\x80\x80",
+      "\xF0\x90\x80\x80", "\xF4\x8F\xBF\xBF", "0123456789abcdef0123456789abcdef\xC3\xA9"
+  };
+  const char *invalid[] = {
+      "\x80", "\xC1\xBF", "\xE0\x9F\xBF", "\xED\xA0\x80", "\xF0\x8F\xBF\xBF",
+      "\xF4\x90\x80\x80", "\xF5\x80\x80\x80", "\xFF", "0123456789abcdef0123456789abcdef\xC3"
+  };
+
+  for (const char *str : valid) ASSERT_TRUE(String::IsValidUTF8(str, strlen(str))) << str;
+  for (const char *str : invalid) ASSERT_FALSE(String::IsValidUTF8(str, strlen(str))) << str;
+}
+
+TEST_F(TestString, convert_1) {
+  String str("a汉😀");
+
+  std::u16string utf16 = str.ToUTF16();
+  ASSERT_EQ(4, utf16.size());
+  ASSERT_TRUE(utf16 == u"a汉😀");
+
+  std::u32string utf32 = str.ToUTF32();
+  ASSERT_EQ(3, utf32.size());
+  ASSERT_TRUE(utf32 == U"a汉😀");
+
+  String sum = str + String("b");
+  ASSERT_EQ(4, sum.CountCodePoints());
+}
+
+/**
+ * @brief Construct from UTF-8 and get UTF-8 back, compared with the round trip
+ * through ICU, which is what a UTF-16 string costs
+ */
+TEST_F(TestString, benchmark_1) {
+  using Clock = std::chrono::steady_clock;
+
+  const int kCount = 100000;
+  std::string short_text = "Close Button";
+  std::string long_text;
+  for (int i = 0; i < 8; ++i) long_text += "The quick brown fox, 敏捷的棕色狐狸. ";
+
+  for (const std::string &text : {short_text, long_text}) {
+    size_t sum = 0;
+
+    auto start = Clock::now();
+    for (int i = 0; i < kCount; ++i) {
+      String str(text);
+      sum += str.ToUTF8().size();
+    }
+    std::chrono::duration<double, std::nano> string_elapsed = Clock::now() - start;
+
+    start = Clock::now();
+    for (int i = 0; i < kCount; ++i) {
+      icu::UnicodeString unicode = icu::UnicodeString::fromUTF8(icu::StringPiece(text));
+      std::string utf8;
+      unicode.toUTF8String(utf8);
+      sum -= utf8.size();
+    }
+    std::chrono::duration<double, std::nano> icu_elapsed = Clock::now() - start;
+
+    String str(text);
+    start = Clock::now();
+    for (int i = 0; i < kCount; ++i) {
+      sum += str.ToUTF16().size();
+    }
+    std::chrono::duration<double, std::nano> utf16_elapsed = Clock::now() - start;
+    sum -= str.ToUTF16().size() * kCount;
+
+    std::cout << text.size() << " bytes in and out, String: " << string_elapsed.count() / kCount
+              << " ns, ICU: " << icu_elapsed.count() / kCount << " ns, ToUTF16(): "
+              << utf16_elapsed.count() / kCount << " ns" << std::endl;
+
+    ASSERT_EQ(0, sum);
+  }
+}
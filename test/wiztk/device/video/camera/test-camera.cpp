@@ -4,13 +4,238 @@
 
 #include "test-camera.hpp"
 
+#include "common/event-loop.hpp"
+
 #include <wiztk/device/video/camera.hpp>
+#include <wiztk/device/video/file-frame-source.hpp>
+#include <wiztk/async/event-loop.hpp>
+
+#include <linux/videodev2.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
 
 using namespace wiztk;
 using namespace wiztk::device;
 
+using wiztk::test::GetEventLoop;
+using wiztk::test::RunFor;
+
+/**
+ * @brief Write a file of YUYV frames, each frame is filled with its index
+ */
+static std::string WriteFrames(const video::Format &format, int count) {
+  char path[] = "/tmp/wiztk-camera-XXXXXX";
+  int fd = mkstemp(path);
+  std::vector<char> data(format.size_image);
+  for (int i = 0; i < count; ++i) {
+    std::fill(data.begin(), data.end(), static_cast<char>(i));
+    write(fd, data.data(), data.size());
+  }
+  close(fd);
+  return path;
+}
+
+static video::Format MakeFormat(int width, int height) {
+  return video::Format::Make(V4L2_PIX_FMT_YUYV, width, height);
+}
+
+class FrameReceiver : public base::Trackable {
+
+ public:
+
+  explicit FrameReceiver(size_t hold)
+      : hold_(hold) {}
+
+  void OnFrame(const video::Frame &frame, base::SLOT /* slot */) {
+    ++received;
+    if (frame.GetUseCount() != 1) ++unexpected_use_count;
+
+    const auto *bytes = static_cast<const uint8_t *>(frame.GetData());
+    if (bytes[0] != bytes[frame.GetSize() - 1]) ++corrupted;
+    addresses[bytes[0] % 8] = bytes;
+
+    held.push_back(frame);
+    if (held.size() > hold_) held.erase(held.begin());
+  }
+
+  int received = 0;
+
+  int unexpected_use_count = 0;
+
+  int corrupted = 0;
+
+  const void *addresses[8] = {nullptr};
+
+  std::vector<video::Frame> held;
+
+ private:
+
+  size_t hold_ = 0;
+
+};
+
 TEST_F(TestCamera, query_all_1) {
   video::Camera::GetAll();
 
   ASSERT_TRUE(true);
-}
\ No newline at end of file
+}
+
+TEST_F(TestCamera, format_1) {
+  video::Format yuyv = video::Format::Make(V4L2_PIX_FMT_YUYV, 640, 480);
+  ASSERT_EQ(1280, yuyv.bytes_per_line);
+  ASSERT_EQ(1280 * 480, yuyv.size_image);
+
+  // Planar 4:2:0 has an 8-bit luma stride and 1.5 bytes per pixel:
+  video::Format nv12 = video::Format::Make(V4L2_PIX_FMT_NV12, 640, 480);
+  ASSERT_EQ(V4L2_PIX_FMT_NV12, nv12.pixel_format);
+  ASSERT_EQ(640, nv12.bytes_per_line);
+  ASSERT_EQ(640 * 480 * 3 / 2, nv12.size_image);
+
+  video::Format yu12 = video::Format::Make(V4L2_PIX_FMT_YUV420, 640, 481);
+  ASSERT_EQ(640, yu12.bytes_per_line);
+  ASSERT_EQ(640 * 481 + 640 * 241, yu12.size_image);
+
+  // A padded stride reported by the driver is kept, too small values are raised:
+  video::Format padded = video::Format::Make(V4L2_PIX_FMT_NV12, 640, 480, 704, 0);
+  ASSERT_EQ(704, padded.bytes_per_line);
+  ASSERT_EQ(704 * 480 * 3 / 2, padded.size_image);
+
+  video::Format small = video::Format::Make(V4L2_PIX_FMT_YUYV, 640, 480, 640, 1000);
+  ASSERT_EQ(1280, small.bytes_per_line);
+  ASSERT_EQ(1280 * 480, small.size_image);
+
+  // Compressed formats are kept as reported:
+  video::Format mjpeg = video::Format::Make(V4L2_PIX_FMT_MJPEG, 640, 480, 0, 100000);
+  ASSERT_EQ(0, mjpeg.bytes_per_line);
+  ASSERT_EQ(100000, mjpeg.size_image);
+}
+
+/**
+ * @brief Set NV12 on a real device, e.g. the vivid virtual driver
+ */
+TEST_F(TestCamera, set_format_1) {
+  video::Camera camera;
+
+  if (!camera.Open("/dev/video0")) {
+    std::cout << "No capture device, skip" << std::endl;
+    return;
+  }
+
+  if (!camera.SetFormat(V4L2_PIX_FMT_NV12, 640, 480)) {
+    std::cout << "NV12 is not supported, skip" << std::endl;
+    return;
+  }
+
+  const video::Format &format = camera.GetFormat();
+  ASSERT_EQ(V4L2_PIX_FMT_NV12, format.pixel_format);
+  ASSERT_GE(format.bytes_per_line, format.width);
+  ASSERT_LT(format.bytes_per_line, format.width * 2);
+  ASSERT_GE(format.size_image, static_cast<size_t>(format.bytes_per_line) * format.height * 3 / 2);
+}
+
+/**
+ * @brief Receive frames from a file without copy
+ */
+TEST_F(TestCamera, file_source_1) {
+  video::Format format = MakeFormat(64, 8);
+  std::string path = WriteFrames(format, 8);
+  async::EventLoop *event_loop = GetEventLoop();
+
+  FrameReceiver receiver(2);
+  video::FileFrameSource source;
+  ASSERT_TRUE(source.Open(path.c_str(), format));
+  ASSERT_EQ(8, source.GetFrameCount());
+
+  source.SetFrameRate(500);
+  source.SetBufferCount(4);
+  source.frame_ready().Connect(&receiver, &FrameReceiver::OnFrame);
+  ASSERT_TRUE(source.Start(event_loop));
+
+  RunFor(event_loop, 200);
+  source.Stop();
+
+  ASSERT_GT(receiver.received, 16);
+  ASSERT_EQ(0, receiver.unexpected_use_count);
+  ASSERT_EQ(0, receiver.corrupted);
+
+  // Held frames stay valid after the source stopped:
+  ASSERT_EQ(2, receiver.held.size());
+  const video::Frame &last = receiver.held.back();
+  ASSERT_EQ(format.size_image, last.GetSize());
+  ASSERT_EQ(last.GetData(), receiver.addresses[*static_cast<const uint8_t *>(last.GetData())]);
+
+  unlink(path.c_str());
+}
+
+/**
+ * @brief Frames are dropped while all buffers are held, and the source recovers after release
+ */
+TEST_F(TestCamera, file_source_2) {
+  video::Format format = MakeFormat(64, 8);
+  std::string path = WriteFrames(format, 8);
+  async::EventLoop *event_loop = GetEventLoop();
+
+  FrameReceiver receiver(100000);
+  video::FileFrameSource source;
+  ASSERT_TRUE(source.Open(path.c_str(), format));
+  source.SetFrameRate(500);
+  source.SetBufferCount(3);
+  source.frame_ready().Connect(&receiver, &FrameReceiver::OnFrame);
+  ASSERT_TRUE(source.Start(event_loop));
+
+  RunFor(event_loop, 100);
+  ASSERT_EQ(3, receiver.received);
+  ASSERT_GT(source.GetDroppedCount(), 0);
+
+  video::Frame copy = receiver.held.front();
+  ASSERT_EQ(2, copy.GetUseCount());
+  receiver.held.clear();
+  ASSERT_EQ(1, copy.GetUseCount());
+  copy.Reset();
+  ASSERT_FALSE(copy);
+
+  receiver.held.reserve(1024);
+  RunFor(event_loop, 100);
+  source.Stop();
+
+  ASSERT_EQ(6, receiver.received);
+
+  unlink(path.c_str());
+}
+
+/**
+ * @brief Capture from a real device, e.g. the vivid virtual driver
+ */
+TEST_F(TestCamera, capture_1) {
+  async::EventLoop *event_loop = GetEventLoop();
+  video::Camera camera;
+
+  if (!camera.Open("/dev/video0")) {
+    std::cout << "No capture device, skip" << std::endl;
+    return;
+  }
+
+  ASSERT_TRUE(camera.SetFormat(V4L2_PIX_FMT_YUYV, 640, 480));
+
+  for (auto method : {video::Camera::kIOMethodMmap, video::Camera::kIOMethodUserPtr}) {
+    FrameReceiver receiver(1);
+    camera.SetIOMethod(method);
+    camera.frame_ready().Connect(&receiver, &FrameReceiver::OnFrame);
+    if (!camera.Start(event_loop)) continue;  // userptr is optional for drivers
+
+    RunFor(event_loop, 500);
+    camera.Stop();
+    camera.frame_ready().DisconnectAll();
+
+    ASSERT_GT(receiver.received, 0);
+    ASSERT_EQ(0, receiver.unexpected_use_count);
+    ASSERT_EQ(1, receiver.held.size());
+    receiver.held.clear();
+  }
+}
@@ -0,0 +1,238 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "image-decoder-test.hpp"
+
+#include "common/event-loop.hpp"
+
+#include "wiztk/async/event-loop.hpp"
+#include "wiztk/graphics/bitmap.hpp"
+#include "wiztk/graphics/canvas.hpp"
+#include "wiztk/graphics/image-decoder.hpp"
+#include "wiztk/graphics/paint.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace wiztk;
+using namespace wiztk::base;
+using namespace wiztk::graphics;
+
+using wiztk::test::GetEventLoop;
+
+static const int kWidth = 640;
+static const int kHeight = 480;
+
+/**
+ * @brief Write a test image, the format is chosen by the extension
+ */
+static void WriteImage(const std::string &filename) {
+  Bitmap bitmap;
+  bitmap.AllocateN32Pixels(kWidth, kHeight);
+
+  Canvas canvas(bitmap);
+  canvas.Clear(0xFFFFFFFF);
+
+  Paint paint;
+  paint.SetColor(0xFFFF0000);
+  canvas.DrawRect(RectF::FromXYWH(100.f, 100.f, 200.f, 150.f), paint);
+  canvas.Flush();
+
+  bitmap.WriteToFile(filename);
+}
+
+/**
+ * @brief Collects the results and quits the event loop when enough are received
+ */
+class Collector : public Trackable {
+
+ public:
+
+  Collector(async::EventLoop *event_loop, size_t expected)
+      : event_loop_(event_loop), expected_(expected) {}
+
+  void OnDecoded(const ImageDecoder::Result &result, __SLOT__) {
+    results.push_back(result);
+    if (results.size() == expected_) event_loop_->Quit();
+  }
+
+  /**
+   * @brief Run the event loop until all results are received or timeout
+   */
+  void Run(int timeout_msec) {
+    std::atomic<bool> finished(false);
+    std::thread watchdog([this, &finished, timeout_msec]() {
+      auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_msec);
+      while (!finished && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      if (!finished) event_loop_->Quit();
+    });
+
+    event_loop_->Run();
+    finished = true;
+    watchdog.join();
+  }
+
+  std::vector<ImageDecoder::Result> results;
+
+ private:
+
+  async::EventLoop *event_loop_ = nullptr;
+
+  size_t expected_ = 0;
+
+};
+
+TEST_F(ImageDecoderTest, decode_1) {
+  WriteImage("image_decoder_1.png");
+
+  Image image = ImageDecoder::Decode("image_decoder_1.png");
+  ASSERT_TRUE(image.IsValid());
+  ASSERT_EQ(kWidth, image.GetWidth());
+  ASSERT_EQ(kHeight, image.GetHeight());
+
+  // Fit in 160x160 and keep the aspect ratio:
+  image = ImageDecoder::Decode("image_decoder_1.png", 160, 160);
+  ASSERT_EQ(160, image.GetWidth());
+  ASSERT_EQ(120, image.GetHeight());
+
+  // Never scale up:
+  image = ImageDecoder::Decode("image_decoder_1.png", 1280, 0);
+  ASSERT_EQ(kWidth, image.GetWidth());
+
+  ASSERT_FALSE(ImageDecoder::Decode("not_exist.png").IsValid());
+}
+
+TEST_F(ImageDecoderTest, load_1) {
+  WriteImage("image_decoder_2.png");
+  WriteImage("image_decoder_2.jpg");
+
+  async::EventLoop *event_loop = GetEventLoop();
+  ImageDecoder decoder(event_loop);
+  Collector collector(event_loop, 3);
+  decoder.decoded().Connect(&collector, &Collector::OnDecoded);
+
+  decoder.Load("image_decoder_2.png", 64, 64);
+  decoder.Load("image_decoder_2.png", 64, 64);  // Ignored, in progress
+  decoder.Load("image_decoder_2.jpg", 100, 0);
+  decoder.Load("not_exist.png");
+  collector.Run(5000);
+
+  ASSERT_EQ(3, collector.results.size());
+  for (const auto &result : collector.results) {
+    if (result.path == "image_decoder_2.png") {
+      ASSERT_EQ(64, result.image.GetWidth());
+      ASSERT_EQ(48, result.image.GetHeight());
+    } else if (result.path == "image_decoder_2.jpg") {
+      ASSERT_EQ(100, result.image.GetWidth());
+      ASSERT_EQ(75, result.image.GetHeight());
+    } else {
+      ASSERT_FALSE(result.image.IsValid());
+    }
+  }
+
+  ASSERT_TRUE(decoder.Find("image_decoder_2.png", 64, 64).IsValid());
+  ASSERT_FALSE(decoder.Find("image_decoder_2.png").IsValid());
+  ASSERT_EQ((64 * 48 + 100 * 75) * 4, decoder.GetCacheSize());
+
+  // A cached image is delivered in the event loop as well:
+  Collector cached(event_loop, 1);
+  decoder.decoded().Connect(&cached, &Collector::OnDecoded);
+  decoder.Load("image_decoder_2.png", 64, 64);
+  cached.Run(1000);
+  ASSERT_EQ(1, cached.results.size());
+  ASSERT_EQ(64, cached.results[0].image.GetWidth());
+}
+
+TEST_F(ImageDecoderTest, cache_1) {
+  WriteImage("image_decoder_3.png");
+
+  async::EventLoop *event_loop = GetEventLoop();
+  ImageDecoder decoder(event_loop);
+  decoder.SetCacheCapacity(100 * 75 * 4);
+
+  Collector collector(event_loop, 2);
+  decoder.decoded().Connect(&collector, &Collector::OnDecoded);
+  decoder.Load("image_decoder_3.png", 100, 100);
+  decoder.Load("image_decoder_3.png", 80, 80);
+  collector.Run(5000);
+  ASSERT_EQ(2, collector.results.size());
+
+  // Only the last one fits in the cache:
+  ASSERT_TRUE(decoder.Find("image_decoder_3.png", collector.results[1].width,
+                           collector.results[1].height).IsValid());
+  ASSERT_FALSE(decoder.Find("image_decoder_3.png", collector.results[0].width,
+                            collector.results[0].height).IsValid());
+
+  decoder.ClearCache();
+  ASSERT_EQ(0, decoder.GetCacheSize());
+}
+
+TEST_F(ImageDecoderTest, cancel_1) {
+  WriteImage("image_decoder_4.png");
+
+  async::EventLoop *event_loop = GetEventLoop();
+  ImageDecoder decoder(event_loop, 1);
+
+  for (int i = 1; i <= 200; ++i) decoder.Load("image_decoder_4.png", i, i);
+
+  int cancelled = 0;
+  for (int i = 200; i > 100; --i) {
+    if (decoder.Cancel("image_decoder_4.png", i, i)) ++cancelled;
+  }
+  ASSERT_TRUE(cancelled > 0);
+
+  Collector rest(event_loop, 200 - cancelled);
+  decoder.decoded().Connect(&rest, &Collector::OnDecoded);
+  rest.Run(10000);
+  ASSERT_EQ(200 - cancelled, rest.results.size());
+}
+
+/**
+ * @brief Load 200 thumbnails, prints the time until all are delivered
+ */
+TEST_F(ImageDecoderTest, benchmark_1) {
+  using Clock = std::chrono::steady_clock;
+
+  const int count = 200;
+  std::vector<std::string> files;
+  for (int i = 0; i < count; ++i) {
+    files.push_back("image_decoder_bench_" + std::to_string(i % 10) + ".jpg");
+    if (i < 10) WriteImage(files.back());
+  }
+
+  async::EventLoop *event_loop = GetEventLoop();
+
+  for (int threads : {1, 4}) {
+    ImageDecoder decoder(event_loop, threads);
+    Collector collector(event_loop, count);
+    decoder.decoded().Connect(&collector, &Collector::OnDecoded);
+
+    auto start = Clock::now();
+    for (int i = 0; i < count; ++i) decoder.Load(files[i], 96 + i / 10, 96 + i / 10);
+    std::chrono::duration<double, std::milli> queued = Clock::now() - start;
+    collector.Run(30000);
+    std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+
+    ASSERT_EQ(count, collector.results.size());
+    std::cout << count << " thumbnails, threads: " << threads
+              << " queued in " << queued.count() << " ms, delivered in "
+              << elapsed.count() << " ms" << std::endl;
+  }
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "picture-test.hpp"
+
+#include "wiztk/base/rect.hpp"
+#include "wiztk/graphics/bitmap.hpp"
+#include "wiztk/graphics/canvas.hpp"
+#include "wiztk/graphics/image-info.hpp"
+#include "wiztk/graphics/paint.hpp"
+#include "wiztk/graphics/picture-recorder.hpp"
+
+#include <vector>
+
+using namespace wiztk;
+using namespace wiztk::base;
+using namespace wiztk::graphics;
+
+static const int kWidth = 64;
+static const int kHeight = 48;
+
+/**
+ * @brief Draw a few shapes, used for both direct and recorded drawing
+ */
+static void DrawScene(Canvas *canvas) {
+  Paint paint;
+  paint.SetAntiAlias(true);
+
+  paint.SetColor(0xFFFF0000);
+  canvas->DrawRect(RectF::FromXYWH(4.f, 4.f, 24.f, 16.f), paint);
+
+  paint.SetColor(0xFF00FF00);
+  paint.SetStyle(Paint::kStyleStroke);
+  paint.SetStrokeWidth(3.f);
+  canvas->DrawLine(0.f, 0.f, kWidth, kHeight, paint);
+
+  paint.SetColor(0xFF0000FF);
+  paint.SetStyle(Paint::kStyleFill);
+  canvas->DrawCircle(40.f, 30.f, 10.f, paint);
+}
+
+/**
+ * @brief Render into a pixel buffer, the callable takes a Canvas*
+ */
+template<typename T>
+static std::vector<uint32_t> Render(T draw) {
+  std::vector<uint32_t> pixels(kWidth * kHeight, 0);
+  Bitmap bitmap;
+  bitmap.InstallPixels(ImageInfo::MakeN32Premul(kWidth, kHeight), pixels.data(), kWidth * 4);
+
+  Canvas canvas(bitmap);
+  canvas.Clear(0xFFFFFFFF);
+  draw(&canvas);
+  canvas.Flush();
+
+  return pixels;
+}
+
+static Picture Record() {
+  PictureRecorder recorder;
+  Canvas *canvas = recorder.BeginRecording(RectF::FromXYWH(0.f, 0.f, kWidth, kHeight));
+  DrawScene(canvas);
+  return recorder.FinishRecording();
+}
+
+TEST_F(PictureTest, record_1) {
+  PictureRecorder recorder;
+  ASSERT_TRUE(nullptr == recorder.GetRecordingCanvas());
+
+  Canvas *canvas = recorder.BeginRecording(RectF::FromXYWH(0.f, 0.f, kWidth, kHeight));
+  ASSERT_TRUE(nullptr != canvas);
+  ASSERT_TRUE(canvas == recorder.GetRecordingCanvas());
+
+  DrawScene(canvas);
+  Picture picture = recorder.FinishRecording();
+  ASSERT_TRUE(nullptr == recorder.GetRecordingCanvas());
+
+  ASSERT_TRUE(picture.IsValid());
+  ASSERT_GE(picture.GetApproximateOpCount(), 3);
+  ASSERT_TRUE(picture.GetUniqueID() != 0);
+
+  RectF cull = picture.GetCullRect();
+  ASSERT_EQ(0.f, cull.left);
+  ASSERT_EQ(0.f, cull.top);
+  ASSERT_EQ(kWidth, cull.right);
+  ASSERT_EQ(kHeight, cull.bottom);
+}
+
+TEST_F(PictureTest, empty_1) {
+  Picture picture;
+  ASSERT_FALSE(picture.IsValid());
+  ASSERT_EQ(0, picture.GetApproximateOpCount());
+  ASSERT_TRUE(picture.Serialize().empty());
+
+  PictureRecorder recorder;
+  ASSERT_FALSE(recorder.FinishRecording().IsValid());
+}
+
+TEST_F(PictureTest, playback_1) {
+  std::vector<uint32_t> expected = Render([](Canvas *canvas) { DrawScene(canvas); });
+
+  Picture picture = Record();
+  std::vector<uint32_t> played = Render([&picture](Canvas *canvas) { picture.Playback(canvas); });
+  std::vector<uint32_t> drawn = Render([&picture](Canvas *canvas) { canvas->DrawPicture(picture); });
+
+  ASSERT_TRUE(expected == played);
+  ASSERT_TRUE(expected == drawn);
+}
+
+TEST_F(PictureTest, serialize_1) {
+  Picture picture = Record();
+  std::vector<uint8_t> bytes = picture.Serialize();
+  ASSERT_FALSE(bytes.empty());
+
+  Picture copy = Picture::MakeFromData(bytes.data(), bytes.size());
+  ASSERT_TRUE(copy.IsValid());
+  ASSERT_NE(picture.GetUniqueID(), copy.GetUniqueID());
+
+  std::vector<uint32_t> expected = Render([&picture](Canvas *canvas) { picture.Playback(canvas); });
+  std::vector<uint32_t> actual = Render([&copy](Canvas *canvas) { copy.Playback(canvas); });
+  ASSERT_TRUE(expected == actual);
+}
+
+TEST_F(PictureTest, bbh_1) {
+  PictureRecorder recorder;
+  Canvas *canvas = recorder.BeginRecording(RectF::FromXYWH(0.f, 0.f, kWidth, kHeight), true);
+  DrawScene(canvas);
+  Picture picture = recorder.FinishRecording();
+
+  std::vector<uint32_t> expected = Render([](Canvas *canvas) { DrawScene(canvas); });
+  std::vector<uint32_t> actual = Render([&picture](Canvas *canvas) { picture.Playback(canvas); });
+  ASSERT_TRUE(expected == actual);
+}
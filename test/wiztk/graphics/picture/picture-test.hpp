@@ -0,0 +1,32 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef WIZTK_GRAPHICS_PICTURE_TEST_HPP_
+#define WIZTK_GRAPHICS_PICTURE_TEST_HPP_
+
+#include <gtest/gtest.h>
+
+class PictureTest : public testing::Test {
+ public:
+  PictureTest() = default;
+  ~PictureTest() override = default;
+
+ protected:
+  void SetUp() final {}
+  void TearDown() final {}
+};
+
+#endif // WIZTK_GRAPHICS_PICTURE_TEST_HPP_
@@ -0,0 +1,294 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "yuv-converter-test.hpp"
+
+#include <wiztk/graphics/yuv-converter.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace wiztk;
+using namespace wiztk::graphics;
+
+static const PixelFormat kFormats[] = {kPixelFormatYUYV, kPixelFormatNV12, kPixelFormatYUV420};
+
+static const YUVConverter::Path kPaths[] = {YUVConverter::kPathScalar,
+                                            YUVConverter::kPathSSE2,
+                                            YUVConverter::kPathAVX2};
+
+static const char *GetName(PixelFormat format) {
+  switch (format) {
+    case kPixelFormatYUYV: return "YUYV";
+    case kPixelFormatNV12: return "NV12";
+    case kPixelFormatYUV420: return "I420";
+    default: break;
+  }
+  return "Unknown";
+}
+
+static const char *GetName(YUVConverter::Path path) {
+  switch (path) {
+    case YUVConverter::kPathSSE2: return "SSE2";
+    case YUVConverter::kPathAVX2: return "AVX2";
+    default: break;
+  }
+  return "Scalar";
+}
+
+/**
+ * @brief Fill a synthetic frame with random bytes
+ */
+static std::vector<uint8_t> MakeRandomFrame(PixelFormat format, int width, int height) {
+  std::vector<uint8_t> data(YUVFrame::GetByteSize(format, width, height));
+  std::mt19937 generator(width * 31 + height);
+  std::uniform_int_distribution<int> distribution(0, 255);
+  for (auto &byte : data) byte = static_cast<uint8_t>(distribution(generator));
+  return data;
+}
+
+/**
+ * @brief Fill a synthetic frame with one color
+ */
+static std::vector<uint8_t> MakeSolidFrame(PixelFormat format, int width, int height,
+                                           uint8_t y, uint8_t u, uint8_t v) {
+  std::vector<uint8_t> data(YUVFrame::GetByteSize(format, width, height));
+  YUVFrame frame = YUVFrame::Make(format, width, height, data.data());
+  auto *y_plane = const_cast<uint8_t *>(frame.planes[0]);
+
+  switch (format) {
+    case kPixelFormatYUYV: {
+      for (size_t i = 0; i < data.size(); i += 4) {
+        data[i] = y;
+        data[i + 1] = u;
+        data[i + 2] = y;
+        data[i + 3] = v;
+      }
+      break;
+    }
+    case kPixelFormatNV12: {
+      std::fill(y_plane, y_plane + width * height, y);
+      for (auto *p = const_cast<uint8_t *>(frame.planes[1]); p < data.data() + data.size(); p += 2) {
+        p[0] = u;
+        p[1] = v;
+      }
+      break;
+    }
+    case kPixelFormatYUV420: {
+      std::fill(y_plane, y_plane + width * height, y);
+      std::fill(const_cast<uint8_t *>(frame.planes[1]), const_cast<uint8_t *>(frame.planes[2]), u);
+      std::fill(const_cast<uint8_t *>(frame.planes[2]), data.data() + data.size(), v);
+      break;
+    }
+    default: break;
+  }
+
+  return data;
+}
+
+/**
+ * @brief Floating point reference, returns B, G, R
+ */
+static void Reference(int y, int u, int v, bool bt709, float bgr[3]) {
+  float yy = 1.164f * (y - 16);
+  float uu = u - 128.f;
+  float vv = v - 128.f;
+
+  if (bt709) {
+    bgr[0] = yy + 2.112f * uu;
+    bgr[1] = yy - 0.213f * uu - 0.533f * vv;
+    bgr[2] = yy + 1.793f * vv;
+  } else {
+    bgr[0] = yy + 2.017f * uu;
+    bgr[1] = yy - 0.392f * uu - 0.813f * vv;
+    bgr[2] = yy + 1.596f * vv;
+  }
+
+  for (int i = 0; i < 3; ++i) {
+    bgr[i] = bgr[i] < 0.f ? 0.f : (bgr[i] > 255.f ? 255.f : bgr[i]);
+  }
+}
+
+TEST_F(YUVConverterTest, solid_colors) {
+  const int width = 64;
+  const int height = 4;
+  std::vector<uint8_t> pixels(width * height * 4);
+
+  struct {
+    uint8_t y, u, v;
+    uint8_t b, g, r;
+  } samples[] = {
+      {16, 128, 128, 0, 0, 0},        // black
+      {235, 128, 128, 255, 255, 255}, // white
+  };
+
+  for (auto format : kFormats) {
+    for (auto &sample : samples) {
+      std::vector<uint8_t> data = MakeSolidFrame(format, width, height, sample.y, sample.u, sample.v);
+      YUVConverter converter;
+      ASSERT_TRUE(converter.Convert(YUVFrame::Make(format, width, height, data.data()),
+                                    pixels.data(), width * 4));
+      for (int i = 0; i < width * height; ++i) {
+        ASSERT_EQ(sample.b, pixels[i * 4]);
+        ASSERT_EQ(sample.g, pixels[i * 4 + 1]);
+        ASSERT_EQ(sample.r, pixels[i * 4 + 2]);
+        ASSERT_EQ(0xFF, pixels[i * 4 + 3]);
+      }
+    }
+  }
+}
+
+TEST_F(YUVConverterTest, reference_i420) {
+  const int width = 33;
+  const int height = 17;
+  std::vector<uint8_t> data = MakeRandomFrame(kPixelFormatYUV420, width, height);
+  std::vector<uint8_t> pixels(width * height * 4);
+  YUVFrame frame = YUVFrame::Make(kPixelFormatYUV420, width, height, data.data());
+  float bgr[3];
+
+  for (auto matrix : {YUVConverter::kBT601, YUVConverter::kBT709}) {
+    YUVConverter converter(matrix, YUVConverter::kPathScalar);
+    ASSERT_TRUE(converter.Convert(frame, pixels.data(), width * 4));
+
+    for (int row = 0; row < height; ++row) {
+      for (int col = 0; col < width; ++col) {
+        Reference(frame.planes[0][row * frame.strides[0] + col],
+                  frame.planes[1][row / 2 * frame.strides[1] + col / 2],
+                  frame.planes[2][row / 2 * frame.strides[2] + col / 2],
+                  matrix == YUVConverter::kBT709,
+                  bgr);
+        const uint8_t *pixel = pixels.data() + (row * width + col) * 4;
+        for (int i = 0; i < 3; ++i) {
+          ASSERT_LE(std::fabs(bgr[i] - pixel[i]), 4.f);
+        }
+      }
+    }
+  }
+}
+
+TEST_F(YUVConverterTest, paths_match_scalar) {
+  const int sizes[][2] = {{1, 1}, {7, 3}, {37, 9}, {64, 2}, {1921, 3}};
+
+  for (auto format : kFormats) {
+    for (auto &size : sizes) {
+      int width = size[0];
+      int height = size[1];
+      std::vector<uint8_t> data = MakeRandomFrame(format, width, height);
+      YUVFrame frame = YUVFrame::Make(format, width, height, data.data());
+
+      std::vector<uint8_t> expected(width * height * 4);
+      YUVConverter scalar(YUVConverter::kBT709, YUVConverter::kPathScalar);
+      ASSERT_TRUE(scalar.Convert(frame, expected.data(), width * 4));
+
+      for (auto path : kPaths) {
+        if (!YUVConverter::IsSupported(path)) continue;
+
+        std::vector<uint8_t> pixels(width * height * 4);
+        YUVConverter converter(YUVConverter::kBT709, path);
+        ASSERT_EQ(path, converter.GetPath());
+        ASSERT_TRUE(converter.Convert(frame, pixels.data(), width * 4, kPixelFormatXRGB8888));
+        ASSERT_TRUE(expected == pixels) << GetName(format) << " " << GetName(path)
+                                        << " " << width << "x" << height;
+      }
+    }
+  }
+}
+
+TEST_F(YUVConverterTest, threads_match_single) {
+  const int width = 320;
+  const int height = 181;
+
+  for (auto format : kFormats) {
+    std::vector<uint8_t> data = MakeRandomFrame(format, width, height);
+    YUVFrame frame = YUVFrame::Make(format, width, height, data.data());
+
+    std::vector<uint8_t> expected(width * height * 4);
+    YUVConverter converter;
+    ASSERT_TRUE(converter.Convert(frame, expected.data(), width * 4));
+
+    for (int count : {2, 3, 8, YUVConverter::kMaxThreads}) {
+      std::vector<uint8_t> pixels(width * height * 4);
+      converter.SetThreadCount(count);
+      ASSERT_EQ(count, converter.GetThreadCount());
+
+      // The workers are reused for each frame:
+      for (int frame_count = 0; frame_count < 3; ++frame_count) {
+        ASSERT_TRUE(converter.Convert(frame, pixels.data(), width * 4));
+        ASSERT_TRUE(expected == pixels) << GetName(format) << " threads: " << count;
+      }
+    }
+  }
+}
+
+TEST_F(YUVConverterTest, unsupported_formats) {
+  uint8_t data[64] = {0};
+  uint8_t pixels[64] = {0};
+  YUVConverter converter;
+
+  ASSERT_FALSE(converter.Convert(YUVFrame::Make(kPixelFormatNV12, 4, 2, data), pixels, 16,
+                                 kPixelFormatRGB565));
+  ASSERT_FALSE(converter.Convert(YUVFrame::Make(kPixelFormatNV21, 4, 2, data), pixels, 16));
+
+  // Also reported when the rows are split across threads:
+  converter.SetThreadCount(4);
+  ASSERT_FALSE(converter.Convert(YUVFrame::Make(kPixelFormatNV12, 4, 8, data), pixels, 16,
+                                 kPixelFormatRGB565));
+  ASSERT_TRUE(converter.Convert(YUVFrame::Make(kPixelFormatNV12, 4, 2, data), pixels, 16));
+}
+
+/**
+ * @brief Benchmark at 1080p and 4K, prints milliseconds per frame
+ */
+TEST_F(YUVConverterTest, benchmark) {
+  using Clock = std::chrono::steady_clock;
+
+  const int sizes[][2] = {{1920, 1080}, {3840, 2160}};
+  const int frames = 10;
+
+  for (auto &size : sizes) {
+    int width = size[0];
+    int height = size[1];
+    std::vector<uint8_t> pixels(width * height * 4);
+
+    for (auto format : kFormats) {
+      std::vector<uint8_t> data = MakeRandomFrame(format, width, height);
+      YUVFrame frame = YUVFrame::Make(format, width, height, data.data());
+
+      for (auto path : kPaths) {
+        if (!YUVConverter::IsSupported(path)) continue;
+
+        for (int threads : {1, 4}) {
+          YUVConverter converter(YUVConverter::kBT709, path);
+          converter.SetThreadCount(threads);
+
+          auto start = Clock::now();
+          for (int i = 0; i < frames; ++i) {
+            converter.Convert(frame, pixels.data(), width * 4);
+          }
+          std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+
+          std::cout << width << "x" << height << " " << GetName(format) << " "
+                    << GetName(path) << " threads: " << threads << " "
+                    << elapsed.count() / frames << " ms/frame" << std::endl;
+        }
+      }
+    }
+  }
+}
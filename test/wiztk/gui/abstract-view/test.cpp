@@ -0,0 +1,187 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "test.hpp"
+
+#include "common/box.hpp"
+#include "common/event-loop.hpp"
+
+#include <wiztk/gui/abstract-view.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace wiztk;
+using namespace wiztk::gui;
+
+using wiztk::test::Box;
+using wiztk::test::GetEventLoop;
+
+/**
+ * @brief The result of a linear scan, to compare with
+ */
+static AbstractView *Scan(const std::vector<Box *> &children, int x, int y) {
+  for (Box *child : children) {
+    if (child->Contain(x, y)) return child;
+  }
+  return nullptr;
+}
+
+Test::Test()
+    : testing::Test() {
+}
+
+Test::~Test() {
+
+}
+
+TEST_F(Test, index_1) {
+  GetEventLoop();
+
+  Box *parent = new Box(100, 100);
+  std::vector<Box *> children;
+  for (int i = 0; i < 5; ++i) {
+    children.push_back(new Box(10, 10));
+    parent->PushBackChild(children.back());
+  }
+
+  Box *inserted = new Box(10, 10);
+  parent->InsertChild(inserted, 2);
+  children.insert(children.begin() + 2, inserted);
+
+  Box::SwapIndex(children[0], children[4]);
+  std::swap(children[0], children[4]);
+
+  Box::MoveToFirst(children[3]);
+  std::rotate(children.begin(), children.begin() + 3, children.begin() + 4);
+
+  Box::MoveForward(children[0]);
+  std::swap(children[0], children[1]);
+
+  children.back()->Destroy();
+  children.pop_back();
+
+  for (size_t i = 0; i < children.size(); ++i) {
+    ASSERT_EQ(children[i], parent->GetChildAt(static_cast<int>(i)));
+    ASSERT_EQ(static_cast<int>(i), children[i]->GetIndex());
+  }
+  ASSERT_EQ(children.back(), parent->GetChildAt(-1));
+  ASSERT_EQ(nullptr, parent->GetChildAt(static_cast<int>(children.size())));
+  ASSERT_EQ(-1, parent->GetIndex());
+
+  parent->Destroy();
+}
+
+TEST_F(Test, hit_test_1) {
+  GetEventLoop();
+
+  std::mt19937 generator(1);
+  std::uniform_int_distribution<int> position(0, 1000);
+  std::uniform_int_distribution<int> size(1, 300);
+
+  Box *parent = new Box(1000, 1000);
+  std::vector<Box *> children;
+
+  // Overlapped children with some large ones:
+  for (int i = 0; i < 500; ++i) {
+    Box *child = new Box(size(generator), size(generator));
+    parent->PushBackChild(child);
+    child->MoveTo(position(generator), position(generator));
+    children.push_back(child);
+  }
+
+  parent->SetHitTestIndexEnabled(true);
+  ASSERT_TRUE(parent->IsHitTestIndexEnabled());
+
+  for (int i = 0; i < 2000; ++i) {
+    int x = position(generator);
+    int y = position(generator);
+    ASSERT_EQ(Scan(children, x, y), parent->HitTest(x, y));
+  }
+
+  // The index follows geometry and order changes:
+  for (int i = 0; i < 50; ++i) {
+    children[i]->MoveTo(position(generator), position(generator));
+  }
+  Box::MoveToFirst(children.back());
+  children.insert(children.begin(), children.back());
+  children.pop_back();
+
+  children.back()->Destroy();
+  children.pop_back();
+
+  for (int i = 0; i < 2000; ++i) {
+    int x = position(generator);
+    int y = position(generator);
+    ASSERT_EQ(Scan(children, x, y), parent->HitTest(x, y));
+  }
+
+  ASSERT_EQ(nullptr, parent->HitTest(-10, -10));
+
+  parent->Destroy();
+}
+
+/**
+ * @brief Hover over 10k children, prints the cost per pointer motion
+ */
+TEST_F(Test, benchmark_1) {
+  using Clock = std::chrono::steady_clock;
+
+  GetEventLoop();
+
+  const int kCount = 10000;   // A 100 x 100 grid of 10 x 10 views
+  const int kMotions = 5000;
+
+  Box *parent = new Box(1000, 1000);
+  std::vector<Box *> children;
+  for (int i = 0; i < kCount; ++i) {
+    Box *child = new Box(10, 10);
+    parent->PushBackChild(child);
+    child->MoveTo((i % 100) * 10, (i / 100) * 10);
+    children.push_back(child);
+  }
+
+  std::mt19937 generator(1);
+  std::uniform_int_distribution<int> position(0, 999);
+  std::vector<std::pair<int, int>> motions;
+  for (int i = 0; i < kMotions; ++i) motions.emplace_back(position(generator), position(generator));
+
+  double costs[2] = {0.0, 0.0};
+
+  for (int indexed = 0; indexed < 2; ++indexed) {
+    parent->SetHitTestIndexEnabled(indexed != 0);
+    parent->HitTest(0, 0);  // Build the index
+
+    size_t hits = 0;
+    auto start = Clock::now();
+    for (const auto &motion : motions) {
+      if (nullptr != parent->HitTest(motion.first, motion.second)) ++hits;
+    }
+    std::chrono::duration<double, std::micro> elapsed = Clock::now() - start;
+
+    ASSERT_EQ(static_cast<size_t>(kMotions), hits);
+    costs[indexed] = elapsed.count() / kMotions;
+    std::cout << kCount << " children, " << (indexed ? "grid index: " : "linear scan: ")
+              << costs[indexed] << " us per motion" << std::endl;
+  }
+
+  ASSERT_LT(costs[1], costs[0]);
+
+  parent->Destroy();
+}
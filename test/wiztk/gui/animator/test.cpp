@@ -0,0 +1,272 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "test.hpp"
+
+#include "common/box.hpp"
+#include "common/event-loop.hpp"
+
+#include <wiztk/gui/animator.hpp>
+#include <wiztk/gui/abstract-view.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+using namespace wiztk;
+using namespace wiztk::gui;
+
+using base::ColorF;
+using base::RectF;
+
+using wiztk::test::GetEventLoop;
+
+/**
+ * @brief A box with the properties to animate
+ */
+class AnimatedBox : public wiztk::test::Box {
+
+ public:
+
+  float value = 0.f;
+
+  ColorF color;
+
+  RectF rect;
+
+ protected:
+
+  ~AnimatedBox() final = default;
+
+};
+
+Test::Test()
+    : testing::Test() {
+}
+
+Test::~Test() {
+
+}
+
+TEST_F(Test, ease_1) {
+  const Animator::Easing easings[] = {
+      Animator::kEasingLinear,
+      Animator::kEasingInQuad,
+      Animator::kEasingOutQuad,
+      Animator::kEasingInOutQuad,
+      Animator::kEasingInCubic,
+      Animator::kEasingOutCubic,
+      Animator::kEasingInOutCubic
+  };
+
+  for (Animator::Easing easing : easings) {
+    ASSERT_FLOAT_EQ(0.f, Animator::Ease(easing, 0.f));
+    ASSERT_FLOAT_EQ(1.f, Animator::Ease(easing, 1.f));
+    ASSERT_FLOAT_EQ(1.f, Animator::Ease(easing, 2.f));
+
+    float last = 0.f;
+    for (int i = 1; i <= 100; ++i) {
+      float value = Animator::Ease(easing, i / 100.f);
+      ASSERT_GE(value, last);
+      last = value;
+    }
+  }
+
+  ASSERT_FLOAT_EQ(0.5f, Animator::Ease(Animator::kEasingInOutQuad, 0.5f));
+  ASSERT_FLOAT_EQ(0.5f, Animator::Ease(Animator::kEasingInOutCubic, 0.5f));
+  ASSERT_LT(Animator::Ease(Animator::kEasingInQuad, 0.5f), 0.5f);
+  ASSERT_GT(Animator::Ease(Animator::kEasingOutQuad, 0.5f), 0.5f);
+}
+
+TEST_F(Test, float_1) {
+  GetEventLoop();
+
+  AnimatedBox *box = new AnimatedBox;
+  Animator animator;
+  int frame_requests = 0;
+  auto on_frame_request = [&frame_requests]() { ++frame_requests; };
+  animator.frame_request().Bind(on_frame_request);
+
+  Animator::Handle handle = animator.Animate(box, &box->value, 10.f, 20.f, 100);
+  ASSERT_TRUE(animator.IsRunning(handle));
+  ASSERT_EQ(1, frame_requests);
+  ASSERT_EQ(10.f, box->value);
+
+  // The first step sets the start time, the time wraps around:
+  uint32_t start = 0xFFFFFFF0;
+  animator.Step(start);
+  ASSERT_FLOAT_EQ(10.f, box->value);
+  ASSERT_EQ(2, frame_requests);
+
+  animator.Step(start + 25);
+  ASSERT_FLOAT_EQ(12.5f, box->value);
+
+  animator.Step(start + 50);
+  ASSERT_FLOAT_EQ(15.f, box->value);
+
+  // Dropped frames do not change the speed:
+  animator.Step(start + 120);
+  ASSERT_FLOAT_EQ(20.f, box->value);
+  ASSERT_FALSE(animator.IsRunning(handle));
+  ASSERT_EQ(0, animator.GetCount());
+  ASSERT_EQ(4, frame_requests);
+
+  box->Destroy();
+}
+
+TEST_F(Test, repeat_1) {
+  GetEventLoop();
+
+  AnimatedBox *box = new AnimatedBox;
+  Animator animator;
+
+  Animator::Handle once = animator.Animate(box, &box->rect, RectF(0.f, 0.f, 10.f, 10.f),
+                                           RectF(10.f, 10.f, 30.f, 50.f), 100, Animator::kEasingLinear, 1);
+  Animator::Handle forever = animator.Animate(box, &box->color, ColorF(0.f, 0.f, 0.f, 0.f),
+                                              ColorF(1.f, 1.f, 1.f, 1.f), 100,
+                                              Animator::kEasingLinear, Animator::kRepeatForever);
+  animator.Step(1000);
+
+  animator.Step(1150);
+  ASSERT_FLOAT_EQ(5.f, box->rect.left);
+  ASSERT_FLOAT_EQ(30.f, box->rect.bottom);
+  ASSERT_FLOAT_EQ(0.5f, box->color.r);
+
+  animator.Step(1210);
+  ASSERT_FALSE(animator.IsRunning(once));
+  ASSERT_FLOAT_EQ(30.f, box->rect.right);
+  ASSERT_FLOAT_EQ(0.1f, box->color.g);
+
+  animator.Step(100000 + 1075);
+  ASSERT_TRUE(animator.IsRunning(forever));
+  ASSERT_FLOAT_EQ(0.75f, box->color.a);
+
+  animator.Stop(forever);
+  ASSERT_FALSE(static_cast<bool>(forever));
+  ASSERT_EQ(0, animator.GetCount());
+
+  // Safe to stop again:
+  animator.Stop(forever);
+
+  box->Destroy();
+}
+
+TEST_F(Test, update_1) {
+  GetEventLoop();
+
+  AnimatedBox *animated = new AnimatedBox;
+  AnimatedBox *still = new AnimatedBox;
+  Animator animator;
+
+  animator.Animate(animated, &animated->value, 0.f, 1.f, 100);
+  animator.Animate(animated, &animated->color, ColorF(), ColorF(1.f, 1.f, 1.f), 100);
+  animator.Animate(animated, &animated->rect, RectF(), RectF(10.f, 10.f), 100);
+  ASSERT_EQ(3, animator.GetCount());
+
+  animated->update_count = 0;
+  for (int i = 0; i < 10; ++i) animator.Step(static_cast<uint32_t>(i * 10));
+
+  // Updated once per step for 3 values:
+  ASSERT_EQ(10, animated->update_count);
+  ASSERT_EQ(0, still->update_count);
+
+  still->Destroy();
+  animated->Destroy();
+}
+
+TEST_F(Test, stop_1) {
+  GetEventLoop();
+
+  std::vector<AnimatedBox *> boxes;
+  std::vector<Animator::Handle> handles;
+  Animator animator;
+
+  for (int i = 0; i < 10; ++i) {
+    boxes.push_back(new AnimatedBox);
+    handles.push_back(animator.Animate(boxes.back(), &boxes.back()->value, 0.f, 100.f, 100));
+  }
+  animator.Step(0);
+
+  // Stop from the middle, the others move on:
+  animator.Stop(handles[3]);
+  animator.Stop(boxes[7]);
+  boxes[0]->Destroy();
+  ASSERT_EQ(7, animator.GetCount());
+
+  animator.Step(50);
+  for (int i = 1; i < 10; ++i) {
+    if (3 == i || 7 == i) {
+      ASSERT_EQ(0.f, boxes[i]->value);
+    } else {
+      ASSERT_TRUE(animator.IsRunning(handles[i]));
+      ASSERT_FLOAT_EQ(50.f, boxes[i]->value);
+    }
+  }
+
+  // A new animation reuses the slot, the old handle stays invalid:
+  Animator::Handle handle = animator.Animate(boxes[3], &boxes[3]->value, 0.f, 1.f, 10);
+  ASSERT_TRUE(animator.IsRunning(handle));
+  ASSERT_FALSE(animator.IsRunning(handles[3]));
+
+  for (int i = 1; i < 10; ++i) boxes[i]->Destroy();
+  ASSERT_EQ(0, animator.GetCount());
+}
+
+/**
+ * @brief Step 10k animations of 1k views, prints the cost per frame
+ */
+TEST_F(Test, benchmark_1) {
+  using Clock = std::chrono::steady_clock;
+
+  GetEventLoop();
+
+  const int kViews = 1000;
+  const int kFrames = 1000;
+
+  std::vector<AnimatedBox *> boxes;
+  Animator animator;
+
+  for (int i = 0; i < kViews; ++i) {
+    AnimatedBox *box = new AnimatedBox;
+    boxes.push_back(box);
+    for (int j = 0; j < 8; ++j) {
+      animator.Animate(box, &box->value, 0.f, 360.f, 1000 + j, Animator::kEasingInOutCubic,
+                       Animator::kRepeatForever);
+    }
+    animator.Animate(box, &box->color, ColorF(), ColorF(1.f, 1.f, 1.f), 500,
+                     Animator::kEasingOutQuad, Animator::kRepeatForever);
+    animator.Animate(box, &box->rect, RectF(), RectF(100.f, 100.f), 700,
+                     Animator::kEasingLinear, Animator::kRepeatForever);
+  }
+  ASSERT_EQ(kViews * 10, animator.GetCount());
+
+  for (AnimatedBox *box : boxes) box->update_count = 0;
+
+  auto start = Clock::now();
+  for (int i = 0; i < kFrames; ++i) {
+    animator.Step(static_cast<uint32_t>(i * 16));
+  }
+  std::chrono::duration<double, std::micro> elapsed = Clock::now() - start;
+
+  std::cout << animator.GetCount() << " animations of " << kViews << " views: "
+            << elapsed.count() / kFrames << " us per frame" << std::endl;
+
+  for (AnimatedBox *box : boxes) {
+    ASSERT_EQ(kFrames, box->update_count);
+    box->Destroy();
+  }
+  ASSERT_EQ(0, animator.GetCount());
+}
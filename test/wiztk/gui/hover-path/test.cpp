@@ -0,0 +1,306 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "test.hpp"
+
+#include "common/event-loop.hpp"
+
+#include <wiztk/gui/hover-path.hpp>
+#include <wiztk/gui/abstract-view.hpp>
+#include <wiztk/gui/mouse-event.hpp>
+
+#include <wiztk/async/event-loop.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace wiztk;
+using namespace wiztk::gui;
+
+using wiztk::test::GetEventLoop;
+
+/**
+ * @brief A view which logs the enter/leave events it receives
+ */
+class Node : public AbstractView {
+
+ public:
+
+  enum Response {
+    kAccept,
+    kIgnore,
+    kReject
+  };
+
+  using AbstractView::PushBackChild;
+
+  Node(int x, int y, int width, int height, std::string *log = nullptr)
+      : AbstractView(width, height), log_(log) {
+    MoveTo(x, y);
+  }
+
+  Response response = kAccept;
+
+  char tag = '?';
+
+ protected:
+
+  ~Node() final = default;
+
+  void OnMouseEnter(MouseEvent *event) final {
+    if (nullptr != log_) *log_ += std::string("+") + tag;
+    switch (response) {
+      case kAccept: event->Accept();
+        break;
+      case kIgnore: event->Ignore();
+        break;
+      case kReject: event->Reject();
+        break;
+    }
+  }
+
+  void OnMouseLeave() final {
+    if (nullptr != log_) *log_ += std::string("-") + tag;
+  }
+
+  void OnMouseMove(MouseEvent *event) final {}
+
+  void OnMouseDown(MouseEvent *event) final {}
+
+  void OnMouseUp(MouseEvent *event) final {}
+
+  void OnKeyDown(KeyEvent *event) final {}
+
+  void OnKeyUp(KeyEvent *event) final {}
+
+  void OnDraw(const Context &context) final {}
+
+  void OnConfigureGeometry(const RectF &old_geometry, const RectF &new_geometry) final {
+    RequestSaveGeometry(new_geometry);
+  }
+
+  void OnSaveGeometry(const RectF &old_geometry, const RectF &new_geometry) final {}
+
+ private:
+
+  std::string *log_;
+
+};
+
+/**
+ * @brief A mouse event without a seat, only the response is used
+ */
+static MouseEvent *GetMouseEvent() {
+  static MouseEvent *event = new MouseEvent(nullptr);
+  return event;
+}
+
+/**
+ * @brief Build a chain of nested views, each one is inset by 1 pixel
+ */
+static std::vector<Node *> MakeChain(int depth, int x, int y, int size, std::string *log = nullptr) {
+  std::vector<Node *> chain;
+  for (int i = 0; i < depth; ++i) {
+    Node *node = new Node(x + i, y + i, size - i * 2, size - i * 2, log);
+    node->tag = static_cast<char>('a' + i % 26);
+    if (!chain.empty()) chain.back()->PushBackChild(node);
+    chain.push_back(node);
+  }
+  return chain;
+}
+
+Test::Test()
+    : testing::Test() {
+}
+
+Test::~Test() {
+
+}
+
+TEST_F(Test, enter_leave_1) {
+  GetEventLoop();
+
+  std::string log;
+  std::vector<Node *> chain = MakeChain(4, 0, 0, 100, &log);
+  Node *root = chain.front();
+  HoverPath path;
+
+  path.Update(root, 50, 50, GetMouseEvent());
+  ASSERT_EQ("+a+b+c+d", log);
+  ASSERT_EQ(4, path.GetDepth());
+  ASSERT_EQ(chain.back(), path.GetLeaf());
+
+  // Inside the same leaf:
+  log.clear();
+  path.Update(root, 51, 49, GetMouseEvent());
+  ASSERT_TRUE(log.empty());
+
+  // Between the borders of 'b' and 'c':
+  log.clear();
+  path.Update(root, 1, 50, GetMouseEvent());
+  ASSERT_EQ("-d-c", log);
+  ASSERT_EQ(chain[1], path.GetLeaf());
+
+  log.clear();
+  path.Update(root, 50, 50, GetMouseEvent());
+  ASSERT_EQ("+c+d", log);
+
+  // Outside the root:
+  log.clear();
+  path.Update(root, 200, 200, GetMouseEvent());
+  ASSERT_EQ("-d-c-b-a", log);
+  ASSERT_TRUE(path.IsEmpty());
+  ASSERT_EQ(nullptr, path.GetLeaf());
+
+  root->Destroy();
+}
+
+TEST_F(Test, enter_leave_2) {
+  GetEventLoop();
+
+  std::string log;
+  Node *root = new Node(0, 0, 100, 100, &log);
+  Node *left = new Node(0, 0, 50, 100, &log);
+  Node *right = new Node(50, 0, 50, 100, &log);
+  root->tag = 'r';
+  left->tag = 'L';
+  right->tag = 'R';
+  root->PushBackChild(left);
+  root->PushBackChild(right);
+
+  HoverPath path;
+  path.Update(root, 10, 10, GetMouseEvent());
+  ASSERT_EQ("+r+L", log);
+
+  // Leave before enter:
+  log.clear();
+  path.Update(root, 60, 10, GetMouseEvent());
+  ASSERT_EQ("-L+R", log);
+
+  log.clear();
+  path.Clear();
+  ASSERT_EQ("-R-r", log);
+
+  root->Destroy();
+}
+
+TEST_F(Test, ignore_reject_1) {
+  GetEventLoop();
+
+  std::string log;
+  std::vector<Node *> chain = MakeChain(4, 0, 0, 100, &log);
+  Node *root = chain.front();
+  HoverPath path;
+
+  chain[1]->response = Node::kIgnore;
+  chain[3]->response = Node::kReject;
+
+  path.Update(root, 50, 50, GetMouseEvent());
+  ASSERT_EQ("+a+b+c+d", log);
+  ASSERT_EQ(3, path.GetDepth());
+  ASSERT_TRUE(path.GetEntry(0).accepted);
+  ASSERT_FALSE(path.GetEntry(1).accepted);
+  ASSERT_EQ(chain[2], path.GetLeaf());
+
+  // The rejected view is asked again:
+  log.clear();
+  path.Update(root, 50, 50, GetMouseEvent());
+  ASSERT_EQ("+d", log);
+
+  // The ignored view does not receive leave event:
+  log.clear();
+  path.Update(root, 200, 200, GetMouseEvent());
+  ASSERT_EQ("-c-a", log);
+
+  root->Destroy();
+}
+
+TEST_F(Test, destroy_1) {
+  GetEventLoop();
+
+  std::string log;
+  std::vector<Node *> chain = MakeChain(5, 0, 0, 100, &log);
+  Node *root = chain.front();
+  HoverPath path;
+
+  path.Update(root, 50, 50, GetMouseEvent());
+  ASSERT_EQ(5, path.GetDepth());
+
+  // Destroy 'c' and its descendants, no callback:
+  log.clear();
+  chain[2]->Destroy();
+  ASSERT_TRUE(log.empty());
+  ASSERT_EQ(2, path.GetDepth());
+  ASSERT_EQ(chain[1], path.GetLeaf());
+
+  path.Update(root, 50, 50, GetMouseEvent());
+  ASSERT_TRUE(log.empty());
+
+  root->Destroy();
+  ASSERT_TRUE(path.IsEmpty());
+}
+
+/**
+ * @brief Move over a tree of depth 50, prints the cost per pointer motion
+ *
+ * Two chains of 25 views fork from a chain of 25 views, the pointer moves
+ * inside a leaf or jumps between the two leaves.
+ */
+TEST_F(Test, benchmark_1) {
+  using Clock = std::chrono::steady_clock;
+
+  GetEventLoop();
+
+  const int kDepth = 50;
+  const int kMotions = 100000;
+
+  std::vector<Node *> trunk = MakeChain(kDepth / 2, 0, 0, 1000);
+  std::vector<Node *> left = MakeChain(kDepth / 2, 100, 100, 300);
+  std::vector<Node *> right = MakeChain(kDepth / 2, 600, 100, 300);
+  trunk.back()->PushBackChild(left.front());
+  trunk.back()->PushBackChild(right.front());
+  Node *root = trunk.front();
+
+  HoverPath path;
+  MouseEvent *event = GetMouseEvent();
+
+  path.Update(root, 250, 250, event);
+  ASSERT_EQ(kDepth, path.GetDepth());
+  ASSERT_EQ(left.back(), path.GetLeaf());
+
+  auto start = Clock::now();
+  for (int i = 0; i < kMotions; ++i) {
+    path.Update(root, 250 + (i & 7), 250, event);
+  }
+  std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+  std::cout << "depth " << kDepth << ", inside the leaf: "
+            << elapsed.count() / kMotions << " ns per motion" << std::endl;
+
+  start = Clock::now();
+  for (int i = 0; i < kMotions; ++i) {
+    path.Update(root, (i & 1) ? 750 : 250, 250, event);
+  }
+  elapsed = Clock::now() - start;
+  std::cout << "depth " << kDepth << ", " << kDepth / 2 << " leaves and "
+            << kDepth / 2 << " enters: " << elapsed.count() / kMotions << " ns per motion" << std::endl;
+
+  ASSERT_EQ(kDepth, path.GetDepth());
+  ASSERT_EQ(right.back(), path.GetLeaf());
+
+  root->Destroy();
+}
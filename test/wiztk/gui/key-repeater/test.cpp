@@ -0,0 +1,126 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "test.hpp"
+
+#include "common/event-loop.hpp"
+
+#include <wiztk/gui/key-repeater.hpp>
+
+#include <vector>
+
+using namespace wiztk;
+using namespace wiztk::gui;
+
+using wiztk::test::GetEventLoop;
+using wiztk::test::RunFor;
+
+/**
+ * @brief A key repeater which records the repeats
+ */
+class Recorder : public KeyRepeater {
+
+ public:
+
+  Recorder() = default;
+
+  ~Recorder() final = default;
+
+  std::vector<uint32_t> keys;
+
+  std::vector<uint32_t> times;
+
+ protected:
+
+  void OnRepeat(uint32_t key, uint32_t time) final {
+    keys.push_back(key);
+    times.push_back(time);
+  }
+
+};
+
+Test::Test()
+    : testing::Test() {
+}
+
+Test::~Test() {
+
+}
+
+TEST_F(Test, repeat_1) {
+  async::EventLoop *event_loop = GetEventLoop();
+  Recorder recorder;
+
+  // 100 per second after 50 milliseconds:
+  recorder.SetInfo(100, 50);
+  recorder.Start(30, 1000);
+  ASSERT_TRUE(recorder.IsActive());
+  ASSERT_EQ(30, recorder.GetKey());
+
+  RunFor(event_loop, 150);
+  recorder.Stop();
+  ASSERT_FALSE(recorder.IsActive());
+  ASSERT_EQ(0, recorder.GetKey());
+
+  // The first repeat comes after the delay, the others at the rate:
+  ASSERT_LE(3, recorder.times.size());
+  ASSERT_EQ(1050, recorder.times[0]);
+  for (size_t i = 1; i < recorder.times.size(); ++i) {
+    ASSERT_EQ(10, recorder.times[i] - recorder.times[i - 1]);
+  }
+  for (uint32_t key : recorder.keys) ASSERT_EQ(30, key);
+
+  // No more repeats after Stop():
+  size_t count = recorder.times.size();
+  RunFor(event_loop, 50);
+  ASSERT_EQ(count, recorder.times.size());
+}
+
+TEST_F(Test, repeat_2) {
+  async::EventLoop *event_loop = GetEventLoop();
+  Recorder recorder;
+
+  recorder.SetInfo(100, 50);
+  recorder.Start(30, 1000);
+
+  // A new key restarts the delay:
+  RunFor(event_loop, 20);
+  recorder.Start(31, 1020);
+  RunFor(event_loop, 100);
+  recorder.Stop();
+
+  ASSERT_LE(1, recorder.keys.size());
+  ASSERT_EQ(1070, recorder.times[0]);
+  for (uint32_t key : recorder.keys) ASSERT_EQ(31, key);
+}
+
+TEST_F(Test, repeat_3) {
+  GetEventLoop();
+  Recorder recorder;
+
+  // A rate of 0 disables repeating:
+  recorder.SetInfo(0, 50);
+  recorder.Start(30, 1000);
+  ASSERT_FALSE(recorder.IsActive());
+
+  // And stops the key repeating:
+  recorder.SetInfo(25, 50);
+  recorder.Start(30, 1000);
+  ASSERT_TRUE(recorder.IsActive());
+  recorder.SetInfo(0, 50);
+  ASSERT_FALSE(recorder.IsActive());
+  ASSERT_EQ(0, recorder.GetKey());
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "test.hpp"
+
+#include "common/box.hpp"
+
+#include <wiztk/gui/application.hpp>
+#include <wiztk/gui/window.hpp>
+
+using namespace wiztk;
+using namespace wiztk::gui;
+
+using wiztk::test::Box;
+
+Test::Test()
+    : testing::Test() {
+}
+
+Test::~Test() {
+
+}
+
+/**
+ * @brief Set and get the keyboard focus of a window which is not shown
+ */
+TEST_F(Test, focus_1) {
+  int argc = 1;
+  char argv1[] = "focus_1";  // to avoid compile warning
+  char *argv[] = {argv1};
+
+  Application app(argc, argv);
+
+  Window win(400, 300, "Test Window");
+  Box *content = new Box(400, 300);
+  Box *child = new Box;
+  Box *other = new Box;
+  content->PushBackChild(child);
+  content->PushBackChild(other);
+  win.SetContentView(content);
+
+  ASSERT_EQ(nullptr, win.GetKeyboardFocus());
+
+  win.SetKeyboardFocus(child);
+  ASSERT_EQ(child, win.GetKeyboardFocus());
+
+  // Only one view has the focus:
+  win.SetKeyboardFocus(other);
+  ASSERT_EQ(other, win.GetKeyboardFocus());
+
+  win.SetKeyboardFocus(nullptr);
+  ASSERT_EQ(nullptr, win.GetKeyboardFocus());
+
+  // The focus is cleared when the view is destroyed:
+  win.SetKeyboardFocus(child);
+  child->Destroy();
+  ASSERT_EQ(nullptr, win.GetKeyboardFocus());
+
+  win.SetKeyboardFocus(content);
+  ASSERT_EQ(content, win.GetKeyboardFocus());
+}
@@ -0,0 +1,202 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "test.hpp"
+
+#include <wiztk/gui/keymap-cache.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace wiztk;
+using namespace wiztk::gui;
+
+/**
+ * @brief A minimal keymap text with one key, different for each keycode
+ */
+static std::string MakeKeymapText(int keycode) {
+  std::string name = "<K" + std::to_string(keycode) + ">";
+  return "xkb_keymap {\n"
+         "  xkb_keycodes \"test\" { minimum = 8; maximum = 255; " + name + " = " + std::to_string(keycode) + "; };\n"
+         "  xkb_types \"test\" { };\n"
+         "  xkb_compatibility \"test\" { };\n"
+         "  xkb_symbols \"test\" { key " + name + " { [ a ] }; };\n"
+         "};\n";
+}
+
+/**
+ * @brief Compiled keymaps without a display
+ */
+class Keymaps {
+
+ public:
+
+  explicit Keymaps(int count)
+      : xkb_context_(xkb_context_new(XKB_CONTEXT_NO_FLAGS)) {
+    for (int i = 0; i < count; ++i) {
+      texts.push_back(MakeKeymapText(10 + i));
+      keymaps.push_back(xkb_keymap_new_from_string(xkb_context_,
+                                                   texts.back().c_str(),
+                                                   XKB_KEYMAP_FORMAT_TEXT_V1,
+                                                   XKB_KEYMAP_COMPILE_NO_FLAGS));
+    }
+  }
+
+  ~Keymaps() {
+    for (struct xkb_keymap *keymap : keymaps) {
+      if (nullptr != keymap) xkb_keymap_unref(keymap);
+    }
+    xkb_context_unref(xkb_context_);
+  }
+
+  void Add(KeymapCache &cache, int index) const {
+    cache.Add(KeymapCache::Hash(texts[index].data(), texts[index].size()),
+              texts[index].data(), texts[index].size(),
+              XKB_KEYMAP_FORMAT_TEXT_V1, XKB_KEYMAP_COMPILE_NO_FLAGS,
+              keymaps[index]);
+  }
+
+  struct xkb_keymap *Find(KeymapCache &cache, int index) const {
+    return cache.Find(KeymapCache::Hash(texts[index].data(), texts[index].size()),
+                      texts[index].data(), texts[index].size(),
+                      XKB_KEYMAP_FORMAT_TEXT_V1, XKB_KEYMAP_COMPILE_NO_FLAGS);
+  }
+
+  /**
+   * @brief Find and release the reference at once, for the hit test only
+   */
+  bool Contains(KeymapCache &cache, int index) const {
+    struct xkb_keymap *keymap = Find(cache, index);
+    if (nullptr == keymap) return false;
+    xkb_keymap_unref(keymap);
+    return keymap == keymaps[index];
+  }
+
+  std::vector<std::string> texts;
+
+  std::vector<struct xkb_keymap *> keymaps;
+
+ private:
+
+  struct xkb_context *xkb_context_;
+
+};
+
+Test::Test()
+    : testing::Test() {
+}
+
+Test::~Test() {
+
+}
+
+TEST_F(Test, hash_1) {
+  // The 64-bit FNV-1a test vectors:
+  ASSERT_EQ(0xcbf29ce484222325ULL, KeymapCache::Hash("", 0));
+  ASSERT_EQ(0xaf63dc4c8601ec8cULL, KeymapCache::Hash("a", 1));
+  ASSERT_EQ(0x85944171f73967e8ULL, KeymapCache::Hash("foobar", 6));
+
+  std::string text = MakeKeymapText(10);
+  ASSERT_EQ(KeymapCache::Hash(text.data(), text.size()), KeymapCache::Hash(text.data(), text.size()));
+  ASSERT_NE(KeymapCache::Hash(text.data(), text.size()), KeymapCache::Hash(text.data(), text.size() - 1));
+}
+
+TEST_F(Test, find_1) {
+  Keymaps keymaps(2);
+  ASSERT_NE(nullptr, keymaps.keymaps[0]);
+  ASSERT_NE(nullptr, keymaps.keymaps[1]);
+
+  KeymapCache cache;
+  ASSERT_FALSE(keymaps.Contains(cache, 0));
+
+  keymaps.Add(cache, 0);
+  ASSERT_EQ(1, cache.GetCount());
+  ASSERT_TRUE(keymaps.Contains(cache, 0));
+  ASSERT_FALSE(keymaps.Contains(cache, 1));
+}
+
+TEST_F(Test, collision_1) {
+  Keymaps keymaps(2);
+  KeymapCache cache;
+
+  // Pretend both texts have the same hash:
+  const uint64_t hash = 1;
+  cache.Add(hash, keymaps.texts[0].data(), keymaps.texts[0].size(),
+            XKB_KEYMAP_FORMAT_TEXT_V1, XKB_KEYMAP_COMPILE_NO_FLAGS, keymaps.keymaps[0]);
+
+  ASSERT_EQ(nullptr, cache.Find(hash, keymaps.texts[1].data(), keymaps.texts[1].size(),
+                                XKB_KEYMAP_FORMAT_TEXT_V1, XKB_KEYMAP_COMPILE_NO_FLAGS));
+
+  // A prefix of the same text:
+  ASSERT_EQ(nullptr, cache.Find(hash, keymaps.texts[0].data(), keymaps.texts[0].size() - 1,
+                                XKB_KEYMAP_FORMAT_TEXT_V1, XKB_KEYMAP_COMPILE_NO_FLAGS));
+
+  struct xkb_keymap *keymap = cache.Find(hash, keymaps.texts[0].data(), keymaps.texts[0].size(),
+                                         XKB_KEYMAP_FORMAT_TEXT_V1, XKB_KEYMAP_COMPILE_NO_FLAGS);
+  ASSERT_EQ(keymaps.keymaps[0], keymap);
+  xkb_keymap_unref(keymap);
+}
+
+TEST_F(Test, evict_1) {
+  const int count = static_cast<int>(KeymapCache::kMaxEntries) + 1;
+  Keymaps keymaps(count);
+  KeymapCache cache;
+
+  for (int i = 0; i < count; ++i) keymaps.Add(cache, i);
+
+  // The first one is the least recently used:
+  ASSERT_EQ(KeymapCache::kMaxEntries, cache.GetCount());
+  ASSERT_FALSE(keymaps.Contains(cache, 0));
+  for (int i = 1; i < count; ++i) ASSERT_TRUE(keymaps.Contains(cache, i));
+}
+
+TEST_F(Test, evict_2) {
+  const int count = static_cast<int>(KeymapCache::kMaxEntries) + 1;
+  Keymaps keymaps(count);
+  KeymapCache cache;
+
+  for (int i = 0; i < count - 1; ++i) keymaps.Add(cache, i);
+
+  // A hit makes the first one the most recently used, the second is dropped:
+  ASSERT_TRUE(keymaps.Contains(cache, 0));
+  keymaps.Add(cache, count - 1);
+
+  ASSERT_EQ(KeymapCache::kMaxEntries, cache.GetCount());
+  ASSERT_TRUE(keymaps.Contains(cache, 0));
+  ASSERT_FALSE(keymaps.Contains(cache, 1));
+}
+
+TEST_F(Test, ref_1) {
+  const int count = static_cast<int>(KeymapCache::kMaxEntries) + 1;
+  Keymaps keymaps(count);
+  KeymapCache cache;
+
+  // The cache keeps the keymap after the compiler drops its reference:
+  keymaps.Add(cache, 0);
+  struct xkb_keymap *compiled = keymaps.keymaps[0];
+  xkb_keymap_unref(compiled);
+  keymaps.keymaps[0] = nullptr;
+
+  struct xkb_keymap *keymap = keymaps.Find(cache, 0);
+  ASSERT_EQ(compiled, keymap);
+  ASSERT_TRUE(xkb_keymap_key_repeats(keymap, 10));
+
+  // An evicted keymap stays valid until the last user releases it:
+  for (int i = 1; i < count; ++i) keymaps.Add(cache, i);
+  ASSERT_EQ(nullptr, keymaps.Find(cache, 0));
+  ASSERT_TRUE(xkb_keymap_key_repeats(keymap, 10));
+  xkb_keymap_unref(keymap);
+}
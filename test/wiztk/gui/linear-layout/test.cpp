@@ -16,10 +16,26 @@
 
 #include "test.hpp"
 
+#include "common/box.hpp"
+#include "common/event-loop.hpp"
+
 #include <wiztk/gui/application.hpp>
 #include <wiztk/gui/window.hpp>
 #include <wiztk/gui/linear-layout.hpp>
 
+#include <wiztk/async/event-loop.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+using namespace wiztk;
+using namespace wiztk::gui;
+
+using wiztk::test::Box;
+using wiztk::test::GetEventLoop;
+using wiztk::test::RunOneFrame;
+
 Test::Test()
     : testing::Test() {
 }
@@ -28,16 +44,140 @@ Test::~Test() {
 
 }
 
+TEST_F(Test, arrange_1) {
+  async::EventLoop *event_loop = GetEventLoop();
+
+  LinearLayout *layout = new LinearLayout(kHorizontal, AbstractView::Padding(5), 10);
+  layout->Resize(400, 100);
+
+  Box *fixed = new Box(50, 20);
+  fixed->SetLayoutPolicyOnX(kLayoutFixed);
+  Box *preferred = new Box(80, 30);
+  Box *expandable = new Box(10, 10);
+  expandable->SetLayoutPolicyOnX(kLayoutExpandable);
+  expandable->SetLayoutPolicyOnY(kLayoutExpandable);
+
+  layout->AddView(fixed);
+  layout->AddView(preferred);
+  layout->AddView(expandable);
+  ASSERT_TRUE(layout->IsLayoutDirty());
+
+  RunOneFrame(event_loop);
+  ASSERT_FALSE(layout->IsLayoutDirty());
+
+  // Each view is configured once no matter how many views are added:
+  ASSERT_EQ(1, fixed->configure_count);
+  ASSERT_EQ(1, preferred->configure_count);
+  ASSERT_EQ(1, expandable->configure_count);
+
+  ASSERT_EQ(5, fixed->GetLeft());
+  ASSERT_EQ(50, fixed->GetWidth());
+  ASSERT_EQ(65, preferred->GetLeft());
+  ASSERT_EQ(80, preferred->GetWidth());
+  ASSERT_EQ(30, preferred->GetHeight());
+  ASSERT_EQ(155, expandable->GetLeft());
+  ASSERT_EQ(240, expandable->GetWidth());   // 400 - 5 * 2 - 10 * 2 - 50 - 80
+  ASSERT_EQ(90, expandable->GetHeight());
+
+  // Changing a constraint marks the layout dirty only:
+  preferred->SetPreferredWidth(100);
+  ASSERT_EQ(80, preferred->GetWidth());
+  RunOneFrame(event_loop);
+  ASSERT_EQ(100, preferred->GetWidth());
+  ASSERT_EQ(220, expandable->GetWidth());
+
+  // Shrink to the minimal sizes if there's not enough space:
+  preferred->SetMinimalWidth(60);
+  expandable->SetMinimalWidth(20);
+  layout->Resize(200, 100);
+  RunOneFrame(event_loop);
+  ASSERT_EQ(50, fixed->GetWidth());
+  ASSERT_EQ(200 - 30 - 50, preferred->GetWidth() + expandable->GetWidth());
+
+  layout->SetOrientation(kVertical);
+  RunOneFrame(event_loop);
+  ASSERT_EQ(5, fixed->GetTop());
+  ASSERT_EQ(35, preferred->GetTop());
+
+  layout->Destroy();
+}
+
+TEST_F(Test, nested_1) {
+  async::EventLoop *event_loop = GetEventLoop();
+
+  LinearLayout *outer = new LinearLayout(kVertical, AbstractView::Padding(0), 0);
+  outer->Resize(300, 300);
+  LinearLayout *inner = new LinearLayout(kHorizontal, AbstractView::Padding(0), 0);
+  inner->SetLayoutPolicyOnY(kLayoutMinimal);
+  outer->AddView(inner);
+
+  Box *a = new Box(40, 40);
+  Box *b = new Box(60, 50);
+  inner->AddView(a);
+  inner->AddView(b);
+  RunOneFrame(event_loop);
+
+  ASSERT_EQ(100, inner->Measure().width);
+  ASSERT_EQ(50, inner->Measure().height);
+  ASSERT_EQ(40, b->GetLeft());
+  ASSERT_EQ(1, b->configure_count);
+
+  // A change in the inner layout propagates up:
+  a->SetPreferredWidth(70);
+  ASSERT_TRUE(outer->IsLayoutDirty());
+  RunOneFrame(event_loop);
+  ASSERT_EQ(130, inner->Measure().width);
+  ASSERT_EQ(70, b->GetLeft());
+
+  outer->Destroy();
+}
+
+/**
+ * @brief Insert many children and run one layout pass, prints the cost per child
+ *
+ * The layout cost of one frame must be linear to the number of children.
+ */
+TEST_F(Test, benchmark_1) {
+  using Clock = std::chrono::steady_clock;
+
+  async::EventLoop *event_loop = GetEventLoop();
+  std::vector<double> costs;
+
+  for (int count : {1250, 2500, 5000}) {
+    double best = 0.0;
+
+    for (int round = 0; round < 3; ++round) {
+      LinearLayout *layout = new LinearLayout(kVertical, AbstractView::Padding(0), 1);
+      layout->Resize(400, count * 11);
+
+      auto start = Clock::now();
+      for (int i = 0; i < count; ++i) {
+        layout->AddView(new Box(100, 10));
+      }
+      RunOneFrame(event_loop);
+      std::chrono::duration<double, std::micro> elapsed = Clock::now() - start;
+
+      ASSERT_FALSE(layout->IsLayoutDirty());
+      layout->Destroy();
+
+      if (0 == round || elapsed.count() < best) best = elapsed.count();
+    }
+
+    costs.push_back(best / count);
+    std::cout << count << " children: " << best / 1000.0 << " ms, "
+              << best / count << " us per child" << std::endl;
+  }
+
+  // Quadratic cost would grow the per-child cost 4 times:
+  ASSERT_LT(costs.back(), costs.front() * 2.5);
+}
+
 /**
  * @brief Show a linear layout in a simple window
  *
  * Expected result: display and resize a default window
  */
 TEST_F(Test, regular) {
-  using wiztk::gui::Application;
-  using wiztk::gui::Window;
-  using wiztk::gui::LinearLayout;
-
   int argc = 1;
   char argv1[] = "show";  // to avoid compile warning
   char *argv[] = {argv1};
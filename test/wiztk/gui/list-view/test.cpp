@@ -0,0 +1,232 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "test.hpp"
+
+#include "common/event-loop.hpp"
+
+#include <wiztk/gui/list-view.hpp>
+
+#include <wiztk/async/event-loop.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+
+using namespace wiztk;
+using namespace wiztk::gui;
+
+using wiztk::test::GetEventLoop;
+using wiztk::test::RunOneFrame;
+
+/**
+ * @brief A row view remembers the item bound to it
+ */
+class Row : public AbstractView {
+
+ public:
+
+  Row()
+      : AbstractView(100, 20) {}
+
+  int item = -1;
+
+ protected:
+
+  ~Row() final = default;
+
+  void OnMouseEnter(MouseEvent *event) final {}
+
+  void OnMouseLeave() final {}
+
+  void OnMouseMove(MouseEvent *event) final {}
+
+  void OnMouseDown(MouseEvent *event) final {}
+
+  void OnMouseUp(MouseEvent *event) final {}
+
+  void OnKeyDown(KeyEvent *event) final {}
+
+  void OnKeyUp(KeyEvent *event) final {}
+
+  void OnDraw(const Context &context) final {}
+
+  void OnConfigureGeometry(const RectF &old_geometry, const RectF &new_geometry) final {
+    RequestSaveGeometry(new_geometry);
+  }
+
+  void OnSaveGeometry(const RectF &old_geometry, const RectF &new_geometry) final {}
+
+};
+
+/**
+ * @brief An adapter of a million items, each has fixed or variable height
+ */
+class Adapter : public ListView::Adapter {
+
+ public:
+
+  explicit Adapter(bool fixed, int count = 1000000)
+      : fixed_(fixed), count_(count) {}
+
+  int GetItemCount() const final { return count_; }
+
+  int GetItemHeight(int index) const final { return fixed_ ? 20 : 10 + (index % 5) * 5; }
+
+  bool HasFixedItemHeight() const final { return fixed_; }
+
+  AbstractView *CreateItemView(int /*type*/) final {
+    ++create_count;
+    return new Row;
+  }
+
+  void BindItemView(AbstractView *view, int index) final {
+    ++bind_count;
+    static_cast<Row *>(view)->item = index;
+  }
+
+  int create_count = 0;
+
+  int bind_count = 0;
+
+ private:
+
+  bool fixed_;
+
+  int count_;
+
+};
+
+Test::Test()
+    : testing::Test() {
+}
+
+Test::~Test() {
+
+}
+
+TEST_F(Test, recycle_1) {
+  async::EventLoop *event_loop = GetEventLoop();
+  Adapter adapter(true);
+
+  ListView *list = new ListView(&adapter);
+  list->Resize(200, 300);
+  RunOneFrame(event_loop);
+
+  // 15 visible rows and 2 overscan rows after:
+  ASSERT_EQ(20000000, list->GetContentHeight());
+  ASSERT_EQ(17, list->GetLiveCount());
+  ASSERT_EQ(17, adapter.create_count);
+  ASSERT_EQ(0, list->GetItemView(0)->GetTop());
+  ASSERT_EQ(200, list->GetItemView(0)->GetWidth());
+  ASSERT_EQ(20, list->GetItemView(1)->GetTop());
+
+  list->ScrollBy(1005);
+  RunOneFrame(event_loop);
+  ASSERT_EQ(50, static_cast<Row *>(list->GetItemView(50))->item);
+  ASSERT_EQ(-5, list->GetItemView(50)->GetTop());
+  ASSERT_EQ(nullptr, list->GetItemView(47));
+  ASSERT_EQ(20, list->GetLiveCount());  // 50 - 2 ... 65 + 2
+  ASSERT_LE(adapter.create_count, 20);
+
+  // Jump to the end, the offset is clamped:
+  list->ScrollTo(1 << 30);
+  RunOneFrame(event_loop);
+  ASSERT_EQ(20000000 - 300, list->GetScrollOffset());
+  ASSERT_EQ(280, list->GetItemView(999999)->GetTop());
+  ASSERT_LE(adapter.create_count, 20);
+  ASSERT_EQ(adapter.create_count, list->GetLiveCount() + list->GetRecycledCount());
+
+  // Data changes rebind all live rows:
+  int bind_count = adapter.bind_count;
+  list->NotifyDataChanged();
+  RunOneFrame(event_loop);
+  ASSERT_EQ(bind_count + list->GetLiveCount(), adapter.bind_count);
+
+  list->Destroy();
+}
+
+TEST_F(Test, variable_1) {
+  async::EventLoop *event_loop = GetEventLoop();
+  Adapter adapter(false, 1000);
+
+  ListView *list = new ListView(&adapter);
+  list->Resize(200, 100);
+  list->SetOverscan(0);
+  list->ScrollTo(333);
+  RunOneFrame(event_loop);
+
+  // Heights are 10, 15, 20, 25, 30 repeatedly, 100 for every 5 items:
+  ASSERT_EQ(100 * 200, list->GetContentHeight());
+  int index = 17;  // From 325 to 345
+  ASSERT_EQ(325 - 333, list->GetItemView(index)->GetTop());
+  ASSERT_EQ(nullptr, list->GetItemView(index - 1));
+
+  int top = list->GetItemView(index)->GetTop();
+  for (int i = index; nullptr != list->GetItemView(i); ++i) {
+    ASSERT_EQ(top, list->GetItemView(i)->GetTop());
+    ASSERT_EQ(adapter.GetItemHeight(i), list->GetItemView(i)->GetHeight());
+    top += adapter.GetItemHeight(i);
+  }
+  ASSERT_GE(top, 100);
+
+  list->Destroy();
+}
+
+/**
+ * @brief Scroll a list of a million rows frame by frame, prints the cost per
+ * frame
+ *
+ * The number of row views and the cost of one frame must be constant.
+ */
+TEST_F(Test, benchmark_1) {
+  using Clock = std::chrono::steady_clock;
+
+  async::EventLoop *event_loop = GetEventLoop();
+
+  for (bool fixed : {true, false}) {
+    Adapter adapter(fixed);
+    ListView *list = new ListView(&adapter);
+    list->Resize(400, 1000);
+    RunOneFrame(event_loop);
+
+    const int kFrames = 2000;
+    std::mt19937 generator(1);
+    std::uniform_int_distribution<int> jump(0, list->GetContentHeight());
+    double costs[2] = {0.0, 0.0};
+
+    // Smooth scrolling, then random jumps:
+    for (int pass = 0; pass < 2; ++pass) {
+      auto start = Clock::now();
+      for (int i = 0; i < kFrames; ++i) {
+        if (0 == pass) list->ScrollBy(37);
+        else list->ScrollTo(jump(generator));
+        RunOneFrame(event_loop);
+      }
+      std::chrono::duration<double, std::micro> elapsed = Clock::now() - start;
+      costs[pass] = elapsed.count() / kFrames;
+    }
+
+    std::cout << (fixed ? "Fixed" : "Variable") << " item height, "
+              << list->GetLiveCount() << " live rows, "
+              << adapter.create_count << " row views created, scroll: "
+              << costs[0] << " us per frame, jump: " << costs[1] << " us per frame" << std::endl;
+
+    ASSERT_LE(adapter.create_count, 2 * (list->GetLiveCount() + 2 * list->GetOverscan()));
+
+    list->Destroy();
+  }
+}
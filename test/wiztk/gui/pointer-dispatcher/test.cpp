@@ -0,0 +1,280 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "test.hpp"
+
+#include "common/event-loop.hpp"
+
+#include <wiztk/gui/pointer-dispatcher.hpp>
+
+#include <vector>
+
+using namespace wiztk;
+using namespace wiztk::gui;
+
+using wiztk::test::GetEventLoop;
+using wiztk::test::RunOneFrame;
+using wiztk::test::RunFor;
+
+/**
+ * @brief A dispatcher which records the events in order
+ */
+class Recorder : public PointerDispatcher {
+
+ public:
+
+  enum Type {
+    kLeave,
+    kEnter,
+    kMotion,
+    kButton,
+    kAxis
+  };
+
+  struct Record {
+    Type type = kLeave;
+    base::Point2D surface_xy;
+    PointerFrame::Button button = {0, 0, 0, 0};
+    PointerAxis axis;
+  };
+
+  Recorder() = default;
+
+  ~Recorder() final = default;
+
+  std::vector<Record> records;
+
+ protected:
+
+  void OnLeave(uint32_t serial, Surface *surface) final {
+    Push(kLeave);
+  }
+
+  void OnEnter(uint32_t serial, Surface *surface, const base::Point2D &surface_xy) final {
+    Push(kEnter).surface_xy = surface_xy;
+  }
+
+  void OnMotion(uint32_t time, const base::Point2D &surface_xy) final {
+    Push(kMotion).surface_xy = surface_xy;
+  }
+
+  void OnButton(const PointerFrame::Button &button) final {
+    Push(kButton).button = button;
+  }
+
+  void OnAxis(const PointerAxis &axis) final {
+    Push(kAxis).axis = axis;
+  }
+
+ private:
+
+  Record &Push(Type type) {
+    records.emplace_back();
+    records.back().type = type;
+    return records.back();
+  }
+
+};
+
+static PointerFrame MotionFrame(uint32_t time, double x, double y) {
+  PointerFrame frame;
+  frame.mask = PointerFrame::kMotion;
+  frame.time = time;
+  frame.surface_xy = base::Point2D(x, y);
+  return frame;
+}
+
+static PointerFrame ButtonFrame(uint32_t time, uint32_t state) {
+  PointerFrame frame;
+  frame.mask = PointerFrame::kButton;
+  frame.buttons[0] = {1, time, kMouseButtonLeft, state};
+  frame.button_count = 1;
+  return frame;
+}
+
+static PointerFrame AxisFrame(uint32_t time, MouseAxisSource source, double value) {
+  PointerFrame frame;
+  frame.mask = PointerFrame::kAxis | PointerFrame::kAxisSource;
+  frame.axis = kMouseAxisVertical;
+  frame.axis_time = time;
+  frame.axis_value[kMouseAxisVertical] = value;
+  frame.axis_source = source;
+  return frame;
+}
+
+static PointerFrame AxisStopFrame(uint32_t time, MouseAxisSource source) {
+  PointerFrame frame;
+  frame.mask = PointerFrame::kAxisStop | PointerFrame::kAxisSource;
+  frame.axis = kMouseAxisVertical;
+  frame.axis_time = time;
+  frame.axis_stop[kMouseAxisVertical] = true;
+  frame.axis_source = source;
+  return frame;
+}
+
+Test::Test()
+    : testing::Test() {
+}
+
+Test::~Test() {
+
+}
+
+TEST_F(Test, coalesce_1) {
+  async::EventLoop *event_loop = GetEventLoop();
+  Recorder recorder;
+
+  for (int i = 1; i <= 5; ++i) {
+    recorder.Commit(MotionFrame(static_cast<uint32_t>(i), 10.0 * i, 20.0 * i));
+  }
+  ASSERT_TRUE(recorder.records.empty());
+
+  RunOneFrame(event_loop);
+
+  ASSERT_EQ(1, recorder.records.size());
+  ASSERT_EQ(Recorder::kMotion, recorder.records[0].type);
+  ASSERT_EQ(50.0, recorder.records[0].surface_xy.x);
+  ASSERT_EQ(100.0, recorder.records[0].surface_xy.y);
+
+  // Nothing is left for the next iteration:
+  RunOneFrame(event_loop);
+  ASSERT_EQ(1, recorder.records.size());
+}
+
+TEST_F(Test, coalesce_2) {
+  async::EventLoop *event_loop = GetEventLoop();
+  Recorder recorder;
+
+  PointerFrame frame = AxisFrame(1, kMouseAxisSourceWheel, 10.0);
+  frame.mask |= PointerFrame::kAxisDiscrete;
+  frame.axis_discrete[kMouseAxisVertical] = 1;
+  for (int i = 0; i < 3; ++i) recorder.Commit(frame);
+  ASSERT_TRUE(recorder.records.empty());
+
+  RunOneFrame(event_loop);
+
+  ASSERT_EQ(1, recorder.records.size());
+  const PointerAxis &axis = recorder.records[0].axis;
+  ASSERT_EQ(Recorder::kAxis, recorder.records[0].type);
+  ASSERT_EQ(kMouseAxisSourceWheel, axis.source);
+  ASSERT_DOUBLE_EQ(30.0, axis.value[kMouseAxisVertical]);
+  ASSERT_EQ(3, axis.discrete[kMouseAxisVertical]);
+  ASSERT_FALSE(axis.stop[kMouseAxisVertical]);
+}
+
+TEST_F(Test, button_1) {
+  async::EventLoop *event_loop = GetEventLoop();
+  Recorder recorder;
+
+  recorder.Commit(MotionFrame(1, 10.0, 10.0));
+  recorder.Commit(MotionFrame(2, 20.0, 20.0));
+  recorder.Commit(ButtonFrame(3, kMouseButtonPressed));
+
+  // The button is delivered at once, after the pending motion:
+  ASSERT_EQ(2, recorder.records.size());
+  ASSERT_EQ(Recorder::kMotion, recorder.records[0].type);
+  ASSERT_EQ(20.0, recorder.records[0].surface_xy.x);
+  ASSERT_EQ(Recorder::kButton, recorder.records[1].type);
+  ASSERT_EQ(kMouseButtonPressed, recorder.records[1].button.state);
+
+  RunOneFrame(event_loop);
+  ASSERT_EQ(2, recorder.records.size());
+}
+
+TEST_F(Test, axis_stop_1) {
+  GetEventLoop();
+  Recorder recorder;
+
+  recorder.Commit(AxisFrame(10, kMouseAxisSourceFinger, 5.0));
+  recorder.Commit(AxisFrame(20, kMouseAxisSourceFinger, 5.0));
+  recorder.Commit(AxisStopFrame(20, kMouseAxisSourceFinger));
+
+  // The stop is delivered at once with the pending scrolling:
+  ASSERT_EQ(1, recorder.records.size());
+  const PointerAxis &axis = recorder.records[0].axis;
+  ASSERT_DOUBLE_EQ(10.0, axis.value[kMouseAxisVertical]);
+  ASSERT_TRUE(axis.stop[kMouseAxisVertical]);
+
+  ASSERT_TRUE(recorder.IsKineticScrolling());
+  recorder.StopKineticScroll();
+  ASSERT_FALSE(recorder.IsKineticScrolling());
+}
+
+TEST_F(Test, kinetic_1) {
+  KineticScroll scroll;
+  const double sample[2] = {10.0, 0.0};
+
+  // 1 pixel per millisecond:
+  for (uint32_t time = 10; time <= 100; time += 10) scroll.Track(time, sample);
+  ASSERT_TRUE(scroll.Start(110));
+
+  double velocity = scroll.GetVelocity(kMouseAxisVertical);
+  ASSERT_NEAR(1.0, velocity, 0.01);
+
+  double value[2] = {0.0, 0.0};
+  double last = velocity * 16.0;
+  double total = 0.0;
+  int steps = 0;
+  bool stop = false;
+  while (!stop) {
+    stop = scroll.Step(16.0, value);
+    ASSERT_LT(value[kMouseAxisVertical], last);
+    ASSERT_EQ(0.0, value[kMouseAxisHorizontal]);
+    last = value[kMouseAxisVertical];
+    total += last;
+    ++steps;
+    ASSERT_LT(steps, 1000);
+  }
+
+  // The distance is the integral of the velocity from the start to the stop:
+  ASSERT_LT(scroll.GetVelocity(kMouseAxisVertical), KineticScroll::kMinVelocity);
+  ASSERT_NEAR(KineticScroll::kTimeConstant * (velocity - scroll.GetVelocity(kMouseAxisVertical)), total, 1e-6);
+}
+
+TEST_F(Test, kinetic_2) {
+  KineticScroll scroll;
+  const double sample[2] = {10.0, 0.0};
+
+  for (uint32_t time = 10; time <= 100; time += 10) scroll.Track(time, sample);
+
+  // The finger paused before lifting:
+  ASSERT_FALSE(scroll.Start(200));
+}
+
+TEST_F(Test, kinetic_3) {
+  async::EventLoop *event_loop = GetEventLoop();
+  Recorder recorder;
+
+  // 0.1 pixel per millisecond decays under kMinVelocity in about 0.5 second:
+  for (uint32_t time = 10; time <= 100; time += 10)
+    recorder.Commit(AxisFrame(time, kMouseAxisSourceFinger, 1.0));
+  recorder.Commit(AxisStopFrame(100, kMouseAxisSourceFinger));
+  ASSERT_TRUE(recorder.IsKineticScrolling());
+  recorder.records.clear();
+
+  RunFor(event_loop, 1000);
+
+  ASSERT_FALSE(recorder.IsKineticScrolling());
+  ASSERT_LT(1, recorder.records.size());
+
+  for (size_t i = 0; i < recorder.records.size(); ++i) {
+    const PointerAxis &axis = recorder.records[i].axis;
+    ASSERT_EQ(Recorder::kAxis, recorder.records[i].type);
+    ASSERT_EQ(kMouseAxisSourceKinetic, axis.source);
+    ASSERT_LT(0.0, axis.value[kMouseAxisVertical]);
+    ASSERT_EQ(i + 1 == recorder.records.size(), axis.stop[kMouseAxisVertical]);
+  }
+}
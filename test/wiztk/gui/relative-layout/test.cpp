@@ -16,6 +16,9 @@
 
 #include "test.hpp"
 
+#include "common/box.hpp"
+#include "common/event-loop.hpp"
+
 #include "wiztk/graphics/alignment.hpp"
 
 #include <wiztk/gui/application.hpp>
@@ -25,10 +28,20 @@
 #include <wiztk/gui/anchor-group.hpp>
 #include <wiztk/gui/anchor.hpp>
 
+#include <wiztk/async/event-loop.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
 using namespace wiztk;
 using namespace wiztk::gui;
 using namespace wiztk::graphics;
 
+using wiztk::test::Box;
+using wiztk::test::GetEventLoop;
+using wiztk::test::RunOneFrame;
+
 Test::Test()
     : testing::Test() {
 }
@@ -37,6 +50,147 @@ Test::~Test() {
 
 }
 
+TEST_F(Test, anchors_1) {
+  async::EventLoop *event_loop = GetEventLoop();
+
+  RelativeLayout *layout = new RelativeLayout(AbstractView::Padding(0));
+  layout->Resize(400, 300);
+
+  Box *left = new Box(50, 20);
+  Box *stretch = new Box(50, 20);
+  Box *free = new Box(30, 30);
+
+  layout->AddView(left);
+  layout->AddView(stretch);
+  layout->AddView(free);
+  free->MoveTo(100, 100);
+
+  left->AddAnchorTo(layout, Alignment::kLeft, 20);
+  left->AddAnchorTo(layout, Alignment::kBottom, -10);
+  stretch->AddAnchorTo(layout, Alignment::kLeft, 10);
+  stretch->AddAnchorTo(layout, Alignment::kRight, -10);
+  ASSERT_TRUE(layout->IsLayoutDirty());
+
+  RunOneFrame(event_loop);
+  ASSERT_FALSE(layout->IsLayoutDirty());
+
+  ASSERT_EQ(20, left->GetLeft());
+  ASSERT_EQ(50, left->GetWidth());
+  ASSERT_EQ(270, left->GetTop());
+  ASSERT_EQ(20, left->GetHeight());
+
+  // Anchored on both edges stretches:
+  ASSERT_EQ(10, stretch->GetLeft());
+  ASSERT_EQ(380, stretch->GetWidth());
+
+  // A view without anchors keeps its position:
+  ASSERT_EQ(100, free->GetLeft());
+  ASSERT_EQ(100, free->GetTop());
+
+  ASSERT_EQ(1, left->configure_count);
+  ASSERT_EQ(1, stretch->configure_count);
+
+  // Follow the size of the layout:
+  layout->Resize(200, 100);
+  RunOneFrame(event_loop);
+  ASSERT_EQ(180, stretch->GetWidth());
+  ASSERT_EQ(70, left->GetTop());
+
+  layout->Destroy();
+}
+
+TEST_F(Test, siblings_1) {
+  async::EventLoop *event_loop = GetEventLoop();
+
+  RelativeLayout *layout = new RelativeLayout(AbstractView::Padding(0));
+  layout->Resize(400, 300);
+
+  Box *a = new Box(40, 20);
+  Box *b = new Box(60, 20);
+  Box *c = new Box(30, 20);
+  Box *d = new Box(20, 20);
+
+  layout->AddView(a);
+  layout->AddView(b);
+  layout->AddView(c);
+  layout->AddView(d);
+
+  // Add the anchors in a different order than the views:
+  b->AddAnchorTo(c, Alignment::kLeft, 5);       // c.left = b.right + 5
+  a->AddAnchorTo(b, Alignment::kLeft, 5);       // b.left = a.right + 5
+  a->AddAnchorTo(layout, Alignment::kLeft, 10);
+  a->AddAnchorTo(layout, Alignment::kTop, 10);
+  d->AddAnchorTo(a, Alignment::kRight, 0);      // d.left = a.right
+  a->AddAnchorTo(d, Alignment::kTop, 7);        // d.top = a.bottom + 7
+
+  RunOneFrame(event_loop);
+
+  ASSERT_EQ(10, a->GetLeft());
+  ASSERT_EQ(55, b->GetLeft());
+  ASSERT_EQ(120, c->GetLeft());
+  ASSERT_EQ(50, d->GetLeft());
+  ASSERT_EQ(37, d->GetTop());
+
+  ASSERT_EQ(1, a->configure_count);
+  ASSERT_EQ(1, b->configure_count);
+  ASSERT_EQ(1, c->configure_count);
+  ASSERT_EQ(1, d->configure_count);
+
+  layout->Destroy();
+}
+
+/**
+ * @brief Solve a long chain of sibling anchors, prints the cost per child
+ *
+ * Each view is configured once and the cost of one frame must be linear to
+ * the number of children.
+ */
+TEST_F(Test, benchmark_1) {
+  using Clock = std::chrono::steady_clock;
+
+  async::EventLoop *event_loop = GetEventLoop();
+  std::vector<double> costs;
+
+  for (int count : {500, 1000, 2000}) {
+    double best = 0.0;
+
+    for (int round = 0; round < 3; ++round) {
+      RelativeLayout *layout = new RelativeLayout(AbstractView::Padding(0));
+      layout->Resize(400, count * 11);
+      std::vector<Box *> boxes;
+
+      auto start = Clock::now();
+      for (int i = 0; i < count; ++i) {
+        Box *box = new Box(100, 10);
+        layout->AddView(box);
+        if (boxes.empty()) {
+          box->AddAnchorTo(layout, Alignment::kTop, 0);
+        } else {
+          boxes.back()->AddAnchorTo(box, Alignment::kTop, 1);
+        }
+        box->AddAnchorTo(layout, Alignment::kLeft, 0);
+        box->AddAnchorTo(layout, Alignment::kRight, 0);
+        boxes.push_back(box);
+      }
+      RunOneFrame(event_loop);
+      std::chrono::duration<double, std::micro> elapsed = Clock::now() - start;
+
+      ASSERT_EQ((count - 1) * 11, boxes.back()->GetTop());
+      for (Box *box : boxes) ASSERT_EQ(1, box->configure_count);
+      layout->Destroy();
+
+      if (0 == round || elapsed.count() < best) best = elapsed.count();
+    }
+
+    costs.push_back(best / count);
+    std::cout << count << " children: " << best / 1000.0 << " ms, "
+              << best / count << " us per child" << std::endl;
+  }
+
+  // Quadratic cost would grow the per-child cost 4 times:
+  ASSERT_LT(costs.back(), costs.front() * 2.5);
+}
+
 /**
  * @brief Show a relative layout in a simple window
  *
@@ -17,10 +17,16 @@
 
 #include <wiztk/gui/context.hpp>
 
+#include "common/event-loop.hpp"
+
+#include <thread>
+
 using namespace wiztk;
 using namespace wiztk::gui;
 using namespace wiztk::base;
 
+using wiztk::test::RunFor;
+
 class TimerWatcher : public Trackable {
  public:
 
@@ -45,6 +51,24 @@ class TimerWatcher : public Trackable {
 
 };
 
+/**
+ * @brief Counts the timeouts without an application
+ */
+class TimeoutCounter : public Trackable {
+ public:
+
+  TimeoutCounter() = default;
+
+  ~TimeoutCounter() final = default;
+
+  void OnTimeout(__SLOT__) {
+    count++;
+  }
+
+  int count = 0;
+
+};
+
 Test::Test()
     : testing::Test() {
 }
@@ -74,3 +98,37 @@ TEST_F(Test, timer_1) {
 
   ASSERT_TRUE(result == 0);
 }
+
+/*
+ * The timer fires in the event loop of the thread which starts it
+ */
+TEST_F(Test, timer_2) {
+  int count_armed = 0;
+  int count_stopped = 0;
+  bool armed = false;
+
+  // A new thread, the event loop of this one is created by the Application:
+  std::thread thread([&]() {
+    async::EventLoop *event_loop = async::EventLoop::Create();
+
+    Timer timer(10000);
+    TimeoutCounter counter;
+    timer.timeout().Connect(&counter, &TimeoutCounter::OnTimeout);
+
+    timer.Start();
+    armed = timer.IsArmed();
+    RunFor(event_loop, 100);
+    count_armed = counter.count;
+
+    timer.Stop();
+    RunFor(event_loop, 50);
+    count_stopped = counter.count;
+
+    delete event_loop;
+  });
+  thread.join();
+
+  ASSERT_TRUE(armed);
+  ASSERT_LE(5, count_armed);
+  ASSERT_EQ(count_armed, count_stopped);
+}
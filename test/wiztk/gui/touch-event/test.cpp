@@ -0,0 +1,178 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "test.hpp"
+
+#include <wiztk/gui/touch-event.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+using namespace wiztk;
+using namespace wiztk::gui;
+
+/**
+ * @brief Move all points by the offset as a frame of motion
+ */
+static void Move(TouchPoint *points, int count, double dx, double dy) {
+  for (int i = 0; i < count; ++i) {
+    points[i].last_surface_xy = points[i].surface_xy;
+    points[i].surface_xy.x += dx;
+    points[i].surface_xy.y += dy;
+    points[i].state = kTouchMotion;
+  }
+}
+
+/**
+ * @brief Scale all points around the center as a frame of motion
+ */
+static void Scale(TouchPoint *points, int count, double cx, double cy, double scale) {
+  for (int i = 0; i < count; ++i) {
+    points[i].last_surface_xy = points[i].surface_xy;
+    points[i].surface_xy.x = cx + (points[i].surface_xy.x - cx) * scale;
+    points[i].surface_xy.y = cy + (points[i].surface_xy.y - cy) * scale;
+    points[i].state = kTouchMotion;
+  }
+}
+
+static void Down(TouchPoint &point, int32_t id, double x, double y) {
+  point.id = id;
+  point.state = kTouchDown;
+  point.surface_xy = base::Point2D(x, y);
+  point.last_surface_xy = point.surface_xy;
+}
+
+Test::Test()
+    : testing::Test() {
+}
+
+Test::~Test() {
+
+}
+
+TEST_F(Test, pan_1) {
+  TouchGesture gesture;
+  TouchPoint points[1];
+
+  Down(points[0], 1, 100.0, 100.0);
+  gesture.Update(points, 1);
+  ASSERT_FALSE(gesture.IsPanning());
+
+  // Within the slop:
+  Move(points, 1, 3.0, 0.0);
+  gesture.Update(points, 1);
+  ASSERT_FALSE(gesture.IsPanning());
+  ASSERT_EQ(0.0, gesture.GetPanDelta().x);
+
+  Move(points, 1, 10.0, 5.0);
+  gesture.Update(points, 1);
+  ASSERT_TRUE(gesture.IsPanning());
+  ASSERT_FALSE(gesture.IsPinching());
+  ASSERT_DOUBLE_EQ(10.0, gesture.GetPanDelta().x);
+  ASSERT_DOUBLE_EQ(5.0, gesture.GetPanDelta().y);
+  ASSERT_DOUBLE_EQ(13.0, gesture.GetPan().x);
+  ASSERT_DOUBLE_EQ(113.0, gesture.GetCentroid().x);
+}
+
+TEST_F(Test, pan_2) {
+  TouchGesture gesture;
+  TouchPoint points[2];
+
+  Down(points[0], 1, 100.0, 100.0);
+  gesture.Update(points, 1);
+  Move(points, 1, 20.0, 0.0);
+  gesture.Update(points, 1);
+  ASSERT_TRUE(gesture.IsPanning());
+
+  // A new finger down far away does not make the pan jump:
+  points[0].state = kTouchStationary;
+  points[0].last_surface_xy = points[0].surface_xy;
+  Down(points[1], 2, 300.0, 100.0);
+  gesture.Update(points, 2);
+  ASSERT_DOUBLE_EQ(0.0, gesture.GetPanDelta().x);
+  ASSERT_DOUBLE_EQ(210.0, gesture.GetCentroid().x);
+
+  Move(points, 2, 0.0, 4.0);
+  gesture.Update(points, 2);
+  ASSERT_DOUBLE_EQ(0.0, gesture.GetPanDelta().x);
+  ASSERT_DOUBLE_EQ(4.0, gesture.GetPanDelta().y);
+  ASSERT_FALSE(gesture.IsPinching());
+}
+
+TEST_F(Test, pinch_1) {
+  TouchGesture gesture;
+  TouchPoint points[2];
+
+  Down(points[0], 1, 100.0, 100.0);
+  Down(points[1], 2, 200.0, 100.0);
+  gesture.Update(points, 2);
+  ASSERT_FALSE(gesture.IsPinching());
+
+  // The spread grows from 50 to 55, within the slop:
+  Scale(points, 2, 150.0, 100.0, 1.1);
+  gesture.Update(points, 2);
+  ASSERT_FALSE(gesture.IsPinching());
+  ASSERT_DOUBLE_EQ(1.0, gesture.GetScaleDelta());
+
+  Scale(points, 2, 150.0, 100.0, 2.0);
+  gesture.Update(points, 2);
+  ASSERT_TRUE(gesture.IsPinching());
+  ASSERT_FALSE(gesture.IsPanning());
+  ASSERT_DOUBLE_EQ(2.0, gesture.GetScaleDelta());
+
+  Scale(points, 2, 150.0, 100.0, 0.5);
+  gesture.Update(points, 2);
+  ASSERT_DOUBLE_EQ(0.5, gesture.GetScaleDelta());
+  ASSERT_DOUBLE_EQ(1.0, gesture.GetScale());
+
+  // Lift a finger:
+  points[1].state = kTouchUp;
+  points[0].state = kTouchStationary;
+  points[0].last_surface_xy = points[0].surface_xy;
+  gesture.Update(points, 2);
+  ASSERT_FALSE(gesture.IsPinching());
+  ASSERT_DOUBLE_EQ(1.0, gesture.GetScaleDelta());
+}
+
+/**
+ * @brief Measure the recognizers with the max number of points
+ */
+TEST_F(Test, benchmark_1) {
+  using Clock = std::chrono::steady_clock;
+
+  const int frames = 1000000;
+  TouchGesture gesture;
+  TouchPoint points[TouchEvent::kMaxPoints];
+
+  for (int i = 0; i < TouchEvent::kMaxPoints; ++i) {
+    Down(points[i], i, 100.0 + 50.0 * std::cos(i), 100.0 + 50.0 * std::sin(i));
+  }
+  gesture.Update(points, TouchEvent::kMaxPoints);
+
+  auto start = Clock::now();
+  for (int i = 0; i < frames; ++i) {
+    if (i % 2) Move(points, TouchEvent::kMaxPoints, 1.0, 0.5);
+    else Scale(points, TouchEvent::kMaxPoints, 100.0, 100.0, 1.001);
+    gesture.Update(points, TouchEvent::kMaxPoints);
+  }
+  std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+
+  ASSERT_TRUE(gesture.IsPanning());
+  ASSERT_TRUE(gesture.IsPinching());
+
+  std::cout << TouchEvent::kMaxPoints << " points: " << elapsed.count() / frames << " ns/frame" << std::endl;
+}
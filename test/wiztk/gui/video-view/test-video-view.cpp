@@ -0,0 +1,160 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "test-video-view.hpp"
+
+#include <wiztk/gui/application.hpp>
+#include <wiztk/gui/window.hpp>
+#include <wiztk/gui/video-view.hpp>
+
+#include <wiztk/graphics/yuv-converter.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <ctime>
+
+using namespace wiztk;
+using namespace wiztk::gui;
+
+static int64_t GetMonotonicTime() {
+  struct timespec now = {0, 0};
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return static_cast<int64_t>(now.tv_sec) * 1000000 + now.tv_nsec / 1000;
+}
+
+/**
+ * @brief A synthetic frame source which pushes YUYV frames with a moving bar at 60 fps in its own thread
+ */
+class SyntheticSource {
+
+ public:
+
+  SyntheticSource(VideoView *view, int width, int height)
+      : view_(view), width_(width), height_(height) {}
+
+  ~SyntheticSource() {
+    Stop();
+  }
+
+  void Start() {
+    running_ = true;
+    thread_ = std::thread(&SyntheticSource::Run, this);
+  }
+
+  void Stop() {
+    running_ = false;
+    if (thread_.joinable()) thread_.join();
+  }
+
+ private:
+
+  void Run() {
+    std::vector<uint8_t> data(graphics::YUVFrame::GetByteSize(kPixelFormatYUYV, width_, height_));
+    auto next = std::chrono::steady_clock::now();
+    int count = 0;
+
+    while (running_) {
+      int bar = (count * 8) % width_;
+      for (int row = 0; row < height_; ++row) {
+        uint8_t *line = data.data() + row * width_ * 2;
+        for (int col = 0; col < width_; ++col) {
+          line[col * 2] = (col >= bar && col < bar + 32) ? 235 : 16;
+          line[col * 2 + 1] = 128;
+        }
+      }
+
+      // The timestamp is taken when the frame is "captured", as a camera does:
+      int64_t timestamp = GetMonotonicTime();
+      view_->PushFrame(graphics::YUVFrame::Make(kPixelFormatYUYV, width_, height_, data.data()), timestamp);
+
+      ++count;
+      next += std::chrono::microseconds(16667);
+      std::this_thread::sleep_until(next);
+    }
+  }
+
+  VideoView *view_ = nullptr;
+
+  int width_ = 0;
+
+  int height_ = 0;
+
+  std::atomic<bool> running_ = {false};
+
+  std::thread thread_;
+
+};
+
+class LatencyWatcher : public base::Trackable {
+
+ public:
+
+  LatencyWatcher(VideoView *view, SyntheticSource *source)
+      : view_(view), source_(source) {}
+
+  void OnPresented(int64_t latency, __SLOT__) {
+    if (++count_ < 300) return;
+
+    source_->Stop();
+    VideoView::Statistics statistics = view_->GetStatistics();
+    std::cout << "Frames pushed: " << statistics.pushed
+              << ", presented: " << statistics.presented
+              << ", dropped: " << statistics.dropped << std::endl;
+    std::cout << "Glass-to-glass latency (us), average: " << statistics.average_latency
+              << ", max: " << statistics.max_latency << std::endl;
+
+    Application::GetInstance()->Exit();
+  }
+
+ private:
+
+  VideoView *view_ = nullptr;
+
+  SyntheticSource *source_ = nullptr;
+
+  int count_ = 0;
+
+};
+
+/**
+ * @brief Show synthetic frames pushed from another thread and measure the latency
+ */
+TEST_F(TestVideoView, latency_1) {
+  int argc = 1;
+  char argv1[] = "gui-video-view";  // to avoid compile warning
+  char *argv[] = {argv1};
+
+  Application app(argc, argv);
+
+  auto *win = new Window(640, 480, "Test VideoView");
+  auto *view = new VideoView(640, 480);
+  win->SetContentView(view);
+
+  SyntheticSource source(view, 640, 360);
+  LatencyWatcher watcher(view, &source);
+  view->presented().Connect(&watcher, &LatencyWatcher::OnPresented);
+  source.Start();
+
+  win->Show();
+
+  int result = app.Run();
+
+  ASSERT_TRUE(result == 0);
+}